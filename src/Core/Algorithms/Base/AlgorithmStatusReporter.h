@@ -32,6 +32,7 @@
 #include <boost/function.hpp>
 #include <boost/noncopyable.hpp>
 #include <Core/Utils/ProgressReporter.h>
+#include <Core/Logging/Profiler.h>
 #include <Core/Algorithms/Base/share.h>
 
 namespace SCIRun {
@@ -69,6 +70,7 @@ namespace Algorithms {
     ~ScopedAlgorithmStatusReporter();
   private:
     const AlgorithmStatusReporter* asr_;
+    Logging::ScopedProfileEvent profile_;
   };
 
   #define REPORT_STATUS(className) ScopedAlgorithmStatusReporter __asr(this, #className);
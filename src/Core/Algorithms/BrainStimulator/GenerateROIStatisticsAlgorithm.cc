@@ -36,6 +36,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/String.h>
+#include <Core/Math/Statistics.h>
 #include <boost/range/algorithm/count.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -45,6 +46,7 @@ DEALINGS IN THE SOFTWARE.
 #include <boost/assign.hpp>
 #include <Core/Logging/Log.h>
 #include <string> 
+#include <algorithm>
 #include <iostream>
 
 using namespace SCIRun::Core::Datatypes;
@@ -136,90 +138,64 @@ boost::tuple<DenseMatrixHandle, VariableHandle> GenerateROIStatisticsAlgorithm::
 
   size_t number_of_atlas_materials;
 
-  std::set<int> labelSet;
+  std::vector<int> labels;
+  vfield2->get_values(labels);
 
+  std::vector<int> labelVector;
   if (target_material==-1 || radius==0) /// if default consider all materials
   {
-    for (VMesh::Elem::index_type i=0; i < vfield2->vmesh()->num_elems(); i++) // loop over all tetrahedral elements (mesh)
-    {
-      int Label;
-      vfield2->get_value(Label, i);
-      labelSet.insert(Label);  
-    }
+    labelVector = labels;
+    std::sort(labelVector.begin(), labelVector.end());
+    labelVector.erase(std::unique(labelVector.begin(), labelVector.end()), labelVector.end());
   } else
   {
-    labelSet.insert(static_cast<int>(target_material));
+    labelVector.push_back(static_cast<int>(target_material));
   }
 
-  number_of_atlas_materials = labelSet.size();
-
-  std::vector<int> labelVector(labelSet.begin(), labelSet.end()); 
+  number_of_atlas_materials = labelVector.size();
 
   std::ostringstream ostr; /// sort element labels ascending 
-  std::copy(labelSet.begin(), labelSet.end(), std::ostream_iterator<int>(ostr, ", "));
+  std::copy(labelVector.begin(), labelVector.end(), std::ostream_iterator<int>(ostr, ", "));
   LOG_DEBUG("Sorted set of label numbers: {}", ostr.str());
 
-  std::vector<double> value_avr(number_of_atlas_materials);
-  std::vector<int> value_count(number_of_atlas_materials);
-  std::vector<double> value_min(number_of_atlas_materials);
-  std::vector<double> value_max(number_of_atlas_materials);
-  std::vector<double> value_std(number_of_atlas_materials); 
-  std::vector<double> Sxsqr(number_of_atlas_materials);
-  std::vector<double> stddev(number_of_atlas_materials);
-  std::vector<double> var(number_of_atlas_materials);
-
-  /// to do the actual statistics we need to precompute parts of it to make it efficient (don't loop over elements twice)
-  for (VMesh::Elem::index_type i=0; i < vfield1->vmesh()->num_elems(); i++) /// loop over all tetrahedral elements (AtlasMesh)
+  /// map every selected element to its ROI index (-1: not part of any ROI), then gather all ROI statistics in one parallel pass
+  const bool all_selected_in_one_roi = target_material==0 && number_of_atlas_materials==1;
+  std::vector<int> roi(labels.size(), -1);
+  for (size_t i=0; i < roi.size(); i++)
   {
-
-    if(element_selection[i]) ///is an particular element selected?
+    if (element_selection[i]) ///is an particular element selected?
     {
-      double value = 0;
-      vfield1->get_value(value, i); 
-
-      int Label = 0;
-      vfield2->get_value(Label, i);   
-
-      for (VMesh::Elem::index_type j=0; j < number_of_atlas_materials; ++j) /// loop over determined materials
+      if (all_selected_in_one_roi)
+        roi[i] = 0;
+      else
       {
-        if (Label==labelVector[j] || (target_material==0 && number_of_atlas_materials==1) ) /// if label is known or if default situation precalculate sum, min, max, sum^2, number of selected elements
-        {
-          value_avr[j] += value; 
-          value_count[j]++;   
-          if (value>value_max[j]) value_max[j]=value;
-          if (value<value_min[j] || value_min[j]==0) value_min[j]=value;
-          Sxsqr[j]+=value*value;
-        }
+        auto label = std::lower_bound(labelVector.begin(), labelVector.end(), labels[i]);
+        if (label != labelVector.end() && *label == labels[i])
+          roi[i] = static_cast<int>(label - labelVector.begin());
       }
     }
   }
 
+  std::vector<double> values;
+  vfield1->get_values(values);
+  if (values.size() != roi.size())
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Internal Error: Number of data values does not match number of atlas labels ");
+  }
+  auto stats = Core::Math::computeGroupedStatistics(values.empty() ? nullptr : &values[0], roi.empty() ? nullptr : &roi[0], values.size(), number_of_atlas_materials);
+
   DenseMatrixHandle output(new DenseMatrix(number_of_atlas_materials, 5));
   const double invalidDouble = std::numeric_limits<double>::quiet_NaN();
 
-  /// efficient way to compute std dev. in just one loop over all mesh elements: sqrt ( 1/(n-1) (Sx^2 - avr Sx + n avr^2 )
   for (VMesh::Elem::index_type j=0; j < number_of_atlas_materials; ++j)
   {
-    double Sx=value_avr[j];
-
-    if (value_count[j]!=0)
+    if (stats[j].count()!=0)
     {
-      value_avr[j]/=value_count[j]; 
-      if (value_count[j]>1)
-      {
-        var[j]=static_cast<double>(1./(value_count[j]-1)*(Sxsqr[j]-2*value_avr[j]*Sx+value_count[j]*value_avr[j]*value_avr[j]));
-        stddev[j]=static_cast<double>(std::sqrt(var[j])); /// compute standard deviation, average, variance
-      } else
-      {
-        var[j]=invalidDouble;
-        stddev[j]=invalidDouble;
-      }
-
-      (*output)(j,0)=value_avr[j]; /// save statistical measures in output (DenseMatrix)
-      (*output)(j,1)=stddev[j];
-      (*output)(j,2)=value_min[j];
-      (*output)(j,3)=value_max[j];  
-      (*output)(j,4)=value_count[j];  
+      (*output)(j,0)=stats[j].mean(); /// save statistical measures in output (DenseMatrix)
+      (*output)(j,1)=stats[j].stddev(); /// NaN for a single element
+      (*output)(j,2)=stats[j].min();
+      (*output)(j,3)=stats[j].max();  
+      (*output)(j,4)=static_cast<double>(stats[j].count());  
     } else
     {
       (*output)(j,0)=invalidDouble;  /// if the number of elements is 0, provide NaN as output
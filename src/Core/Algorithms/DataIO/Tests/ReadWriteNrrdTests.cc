@@ -30,10 +30,17 @@
 #include <Core/IEPlugin/NrrdField_Plugin.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <Core/Algorithms/Legacy/Converter/FieldToNrrd.h>
+#include <Core/Algorithms/Legacy/Converter/NrrdToField.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::TestUtils;
 
 namespace
@@ -126,4 +133,60 @@ TEST(WriteNrrdTests, CanWriteNrrdFileHeader)
 
   boost::filesystem::path out(TestResources::rootDir() / "TransientOutput" / "fieldOutUnitHeader.nhdr");
   ASSERT_TRUE(FieldToNrrd_writer(nullptr, field, out.string().c_str()));
-}
\ No newline at end of file
+}
+
+TEST(ConvertNrrdFieldTests, ScalarLatVolRoundTripKeepsTypeAndValues)
+{
+  FieldInformation fi(LATVOLMESH_E, LINEARDATA_E, FLOAT_E);
+  MeshHandle mesh = CreateMesh(fi, 4, 3, 2, Point(0, 0, 0), Point(3, 2, 1));
+  FieldHandle field = CreateField(fi, mesh);
+  VField* vfield = field->vfield();
+
+  std::vector<float> values(vfield->num_values());
+  for (size_t k = 0; k < values.size(); k++)
+    values[k] = 0.5f * k;
+  vfield->set_values(values);
+
+  NrrdDataHandle nrrd;
+  ASSERT_TRUE(FieldToNrrdAlgo().fieldToNrrd(nullptr, field, nrrd));
+  ASSERT_EQ(nrrdTypeFloat, nrrd->getNrrd()->type);
+  const float* nrrdvalues = static_cast<const float*>(nrrd->getNrrd()->data);
+  for (size_t k = 0; k < values.size(); k++)
+    EXPECT_EQ(values[k], nrrdvalues[k]);
+
+  FieldHandle output;
+  ASSERT_TRUE(NrrdToFieldAlgo().nrrdToField(nullptr, nrrd, output));
+  FieldInformation fo(output);
+  EXPECT_TRUE(fo.is_latvolmesh());
+  EXPECT_TRUE(fo.is_float());
+
+  std::vector<float> result;
+  output->vfield()->get_values(result);
+  EXPECT_EQ(values, result);
+}
+
+TEST(ConvertNrrdFieldTests, VectorLatVolRoundTripKeepsValues)
+{
+  FieldInformation fi(LATVOLMESH_E, CONSTANTDATA_E, VECTOR_E);
+  MeshHandle mesh = CreateMesh(fi, 4, 3, 3, Point(0, 0, 0), Point(3, 2, 2));
+  FieldHandle field = CreateField(fi, mesh);
+  VField* vfield = field->vfield();
+
+  for (VMesh::index_type idx = 0; idx < vfield->num_values(); idx++)
+    vfield->set_value(Vector(idx, 2.0 * idx, -1.0 * idx), idx);
+
+  NrrdDataHandle nrrd;
+  ASSERT_TRUE(FieldToNrrdAlgo().fieldToNrrd(nullptr, field, nrrd));
+
+  FieldHandle output;
+  ASSERT_TRUE(NrrdToFieldAlgo().nrrdToField(nullptr, nrrd, output, "Element", "VectorField"));
+  VField* ofield = output->vfield();
+  ASSERT_EQ(vfield->num_values(), ofield->num_values());
+  for (VMesh::index_type idx = 0; idx < vfield->num_values(); idx++)
+  {
+    Vector expected, actual;
+    vfield->get_value(expected, idx);
+    ofield->get_value(actual, idx);
+    EXPECT_EQ(expected, actual);
+  }
+}
@@ -46,6 +46,7 @@
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
@@ -715,7 +716,8 @@ SparseRowMatrixHandle RefineTetMeshLocallyAlgorithm::ChoseEdgesToCut(FieldHandle
   size_t number = elems_to_split.size();
   SparseRowMatrixHandle cut_edges;
   std::vector<double> edge_lengths;
-  SparseRowMatrixFromMap::Values cut_edges_val; /// all tet element counting starts from 1 (0 denotes blank)
+  /// all tet element counting starts from 1 (0 denotes blank); an edge shared by several tets is recorded once
+  SparseRowMatrixTripletBuilder cut_edges_val(input_vmesh->num_nodes(), input_vmesh->num_nodes(), 1, SparseRowMatrixTripletBuilder::LAST_WINS);
 
   VMesh::Node::array_type onodes(4);
   Point p1, p2, p3, p4;
@@ -763,13 +765,13 @@ SparseRowMatrixHandle RefineTetMeshLocallyAlgorithm::ChoseEdgesToCut(FieldHandle
       {
         std::vector<int> edgecode = getEdgeCoding(pos[j]);
         long e1 = onodes[edgecode[0] - 1], e2 = onodes[edgecode[1] - 1];
-        cut_edges_val[e1 < e2 ? e1 : e2][e2 >= e1 ? e2 : e1] = 1;
+        cut_edges_val.add(e1 < e2 ? e1 : e2, e2 >= e1 ? e2 : e1, 1);
       }
     }
     split_it = true;
   }
 
-  cut_edges = SparseRowMatrixFromMap::make(input_vmesh->num_nodes(), input_vmesh->num_nodes(), cut_edges_val);
+  cut_edges = cut_edges_val.build();
   return cut_edges;
 }
 
@@ -0,0 +1,154 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateIsInsideField.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // 8x8x8 cells of size 0.25, offset so that no node lies on a unit cube face
+  FieldHandle LatVolAround(const Point& cubeMin)
+  {
+    FieldInformation fi(LATVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+    Vector offset(0.45, 0.45, 0.45);
+    MeshHandle mesh = CreateMesh(fi, 9, 9, 9, cubeMin - offset, cubeMin - offset + Vector(2, 2, 2));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  // The same 8x8x8 cells, but aligned with the unit cube: nodes lie on its
+  // faces, edges and corners. Structured meshes take the per-point path.
+  FieldHandle LatticeAlignedAround(const Point& cubeMin, bool structured)
+  {
+    const Point min = cubeMin - Vector(0.5, 0.5, 0.5);
+    if (!structured)
+    {
+      FieldInformation fi(LATVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+      FieldHandle field = CreateField(fi, CreateMesh(fi, 9, 9, 9, min, min + Vector(2, 2, 2)));
+      field->vfield()->resize_values();
+      return field;
+    }
+
+    FieldInformation fi(STRUCTHEXVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+    MeshHandle mesh = CreateMesh(fi, 9, 9, 9);
+    for (VMesh::index_type k = 0; k < 9; ++k)
+      for (VMesh::index_type j = 0; j < 9; ++j)
+        for (VMesh::index_type i = 0; i < 9; ++i)
+          mesh->vmesh()->set_point(min + Vector(0.25*i, 0.25*j, 0.25*k), VMesh::Node::index_type(i + 9*(j + 9*k)));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  int countInside(FieldHandle field)
+  {
+    int count = 0;
+    double value;
+    for (VMesh::index_type i = 0; i < field->vfield()->num_values(); ++i)
+    {
+      field->vfield()->get_value(value, i);
+      if (value == 1.0) count++;
+    }
+    return count;
+  }
+
+  FieldHandle runIsInside(FieldHandle input, FieldHandle object, const std::string& method)
+  {
+    CalculateIsInsideFieldAlgo algo;
+    algo.setOption(Parameters::CalcInsideMethod, method);
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(input, object, output));
+    return output;
+  }
+}
+
+// The surface cube spans [0,1]x[0,1]x[-1,0]: three cells per axis lie fully
+// inside it, five per axis touch it.
+TEST(CalculateIsInsideFieldTests, LatVolInsideClosedSurface)
+{
+  FieldHandle input = LatVolAround(Point(0, 0, -1));
+  FieldHandle cube = CubeTriSurfLinearBasis(DOUBLE_E);
+
+  EXPECT_EQ(27, countInside(runIsInside(input, cube, "all")));
+  EXPECT_EQ(125, countInside(runIsInside(input, cube, "one")));
+}
+
+TEST(CalculateIsInsideFieldTests, LatVolInsideTetVolume)
+{
+  FieldHandle input = LatVolAround(Point(0, 0, 0));
+  FieldHandle cube = CubeTetVolLinearBasis(DOUBLE_E);
+
+  EXPECT_EQ(27, countInside(runIsInside(input, cube, "all")));
+  EXPECT_EQ(125, countInside(runIsInside(input, cube, "one")));
+}
+
+TEST(CalculateIsInsideFieldTests, SurfaceAndVolumeObjectsAgree)
+{
+  FieldHandle surfaceResult = runIsInside(LatVolAround(Point(0, 0, -1)), CubeTriSurfLinearBasis(DOUBLE_E), "most");
+  FieldHandle volumeResult = runIsInside(LatVolAround(Point(0, 0, 0)), CubeTetVolLinearBasis(DOUBLE_E), "most");
+
+  ASSERT_EQ(surfaceResult->vfield()->num_values(), volumeResult->vfield()->num_values());
+  double a, b;
+  for (VMesh::index_type i = 0; i < surfaceResult->vfield()->num_values(); ++i)
+  {
+    surfaceResult->vfield()->get_value(a, i);
+    volumeResult->vfield()->get_value(b, i);
+    EXPECT_EQ(a, b) << "element " << i;
+  }
+}
+
+// Samples on the cube's faces, edges and corners are classified as if they
+// were moved slightly along the ray, so the cube acts as a half-open box:
+// exactly one of two opposite faces counts as inside. Along each axis three
+// cells are then fully inside and five have a sample inside, whatever the
+// cell order or triangulation.
+TEST(CalculateIsInsideFieldTests, SamplesOnSurfaceAreClassifiedConsistently)
+{
+  FieldHandle cube = CubeTriSurfLinearBasis(DOUBLE_E);
+  for (bool structured : { false, true })
+  {
+    FieldHandle input = LatticeAlignedAround(Point(0, 0, -1), structured);
+    EXPECT_EQ(27, countInside(runIsInside(input, cube, "all"))) << "structured " << structured;
+    EXPECT_EQ(125, countInside(runIsInside(input, cube, "one"))) << "structured " << structured;
+  }
+}
@@ -0,0 +1,109 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/SmoothMesh/FairMesh.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+namespace
+{
+  // n x n node grid in the z = 0 plane, with the center node raised to z = height
+  FieldHandle BumpedTriSurf(int n, double height)
+  {
+    FieldInformation fi(TRISURFMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle field = CreateField(fi);
+    VMesh* mesh = field->vmesh();
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+        mesh->add_point(Point(i, j, (i == n/2 && j == n/2) ? height : 0.0));
+
+    VMesh::Node::array_type tri(3);
+    for (int j = 0; j < n - 1; ++j)
+      for (int i = 0; i < n - 1; ++i)
+      {
+        const VMesh::index_type a = i + n*j;
+        tri[0] = a; tri[1] = a + 1; tri[2] = a + n + 1;
+        mesh->add_elem(tri);
+        tri[0] = a; tri[1] = a + n + 1; tri[2] = a + n;
+        mesh->add_elem(tri);
+      }
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  double centerHeight(FieldHandle field, int n)
+  {
+    Point p;
+    field->vmesh()->get_point(p, VMesh::Node::index_type(n/2 + n*(n/2)));
+    return p.z();
+  }
+}
+
+TEST(FairMeshTests, FastMethodFlattensBump)
+{
+  FairMeshAlgo algo;
+  algo.setOption(Parameters::FairMeshMethod, "fast");
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(BumpedTriSurf(9, 1.0), output));
+
+  EXPECT_LT(std::abs(centerHeight(output, 9)), 0.5);
+}
+
+TEST(FairMeshTests, DesbrunMethodFlattensBump)
+{
+  FairMeshAlgo algo;
+  algo.setOption(Parameters::FairMeshMethod, "desbrun");
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(BumpedTriSurf(9, 1.0), output));
+
+  EXPECT_LT(std::abs(centerHeight(output, 9)), 0.5);
+}
+
+TEST(FairMeshTests, FlatMeshStaysInPlane)
+{
+  FairMeshAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(BumpedTriSurf(250, 0.0), output));
+
+  Point p;
+  for (VMesh::Node::index_type i = 0; i < output->vmesh()->num_nodes(); ++i)
+  {
+    output->vmesh()->get_point(p, i);
+    EXPECT_EQ(0.0, p.z());
+  }
+}
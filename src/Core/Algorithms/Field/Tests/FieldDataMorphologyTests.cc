@@ -0,0 +1,213 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/DilateFieldData.h>
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/ErodeFieldData.h>
+#include <Core/Algorithms/Legacy/Fields/ConvertMeshType/ConvertMeshToTetVolMesh.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  FieldHandle LatVol(size_type n, data_info_type type, bool elemData)
+  {
+    FieldInformation fi(LATVOLMESH_E, elemData ? CONSTANTDATA_E : LINEARDATA_E, type);
+    MeshHandle mesh = CreateMesh(fi, n, n, n, Point(0, 0, 0), Point(1, 1, 1));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->clear_all_values();
+    return field;
+  }
+
+  void FillPattern(FieldHandle field)
+  {
+    VField* values = field->vfield();
+    for (VMesh::index_type idx = 0; idx < values->num_values(); ++idx)
+      values->set_value(static_cast<double>((idx * 7919) % 13), idx);
+  }
+
+  std::vector<double> Values(FieldHandle field)
+  {
+    std::vector<double> values;
+    field->vfield()->get_values(values);
+    return values;
+  }
+
+  // One dilation step at a time through the virtual mesh interface, as the
+  // original filter did
+  std::vector<double> ReferenceDilate(FieldHandle field, int iterations)
+  {
+    VMesh* mesh = field->vmesh();
+    const bool elemData = field->vfield()->basis_order() == 0;
+    mesh->synchronize(elemData ? Mesh::ELEM_NEIGHBORS_E : Mesh::NODE_NEIGHBORS_E);
+
+    std::vector<double> current = Values(field);
+    for (int it = 0; it < iterations; ++it)
+    {
+      std::vector<double> next(current);
+      for (VMesh::index_type idx = 0; idx < static_cast<VMesh::index_type>(current.size()); ++idx)
+      {
+        VMesh::Node::array_type nodes;
+        VMesh::Elem::array_type elems;
+        std::vector<VMesh::index_type> nbrs;
+        if (elemData)
+        {
+          mesh->get_neighbors(elems, VMesh::Elem::index_type(idx));
+          nbrs.assign(elems.begin(), elems.end());
+        }
+        else
+        {
+          mesh->get_neighbors(nodes, VMesh::Node::index_type(idx));
+          nbrs.assign(nodes.begin(), nodes.end());
+        }
+        for (size_t q = 0; q < nbrs.size(); ++q) next[idx] = std::max(next[idx], current[nbrs[q]]);
+      }
+      current.swap(next);
+    }
+    return current;
+  }
+}
+
+TEST(FieldDataMorphologyTests, DilateGrowsSpikeIntoCross)
+{
+  FieldHandle field = LatVol(5, INT_E, false);
+  field->vfield()->set_value(9, VMesh::index_type(62));
+
+  DilateFieldDataAlgo algo;
+  algo.set(Parameters::MorphologyIterations, 1);
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(field, output));
+
+  std::vector<double> values = Values(output);
+  EXPECT_EQ(7, std::count(values.begin(), values.end(), 9.0));
+  EXPECT_EQ(9.0, values[62 + 25]);
+  EXPECT_EQ(0.0, values[62 + 26]);
+
+  // The input keeps its values
+  values = Values(field);
+  EXPECT_EQ(1, std::count(values.begin(), values.end(), 9.0));
+}
+
+TEST(FieldDataMorphologyTests, LatticeMatchesNeighborSweep)
+{
+  const bool elemData[] = { false, true };
+  for (bool elems : elemData)
+  {
+    FieldHandle field = LatVol(6, DOUBLE_E, elems);
+    FillPattern(field);
+
+    DilateFieldDataAlgo algo;
+    algo.set(Parameters::MorphologyIterations, 2);
+    FieldHandle output;
+    ASSERT_TRUE(algo.runImpl(field, output));
+    EXPECT_EQ(ReferenceDilate(field, 2), Values(output));
+  }
+}
+
+TEST(FieldDataMorphologyTests, UnstructuredMatchesNeighborSweep)
+{
+  FieldHandle fields[] = { CubeTetVolLinearBasis(DOUBLE_E), CubeTetVolConstantBasis(DOUBLE_E) };
+  for (FieldHandle field : fields)
+  {
+    FillPattern(field);
+
+    DilateFieldDataAlgo algo;
+    algo.set(Parameters::MorphologyIterations, 1);
+    FieldHandle output;
+    ASSERT_TRUE(algo.runImpl(field, output));
+    EXPECT_EQ(ReferenceDilate(field, 1), Values(output));
+  }
+}
+
+TEST(FieldDataMorphologyTests, OpeningRemovesSpikeAndClosingFillsHole)
+{
+  FieldHandle spike = LatVol(5, UNSIGNED_CHAR_E, false);
+  spike->vfield()->set_value(1, VMesh::index_type(62));
+
+  OpenFieldDataAlgo open;
+  open.set(Parameters::MorphologyIterations, 1);
+  FieldHandle opened;
+  ASSERT_TRUE(open.runImpl(spike, opened));
+  std::vector<double> values = Values(opened);
+  EXPECT_EQ(0, std::count(values.begin(), values.end(), 1.0));
+
+  FieldHandle hole = LatVol(5, UNSIGNED_CHAR_E, false);
+  hole->vfield()->set_all_values(1);
+  hole->vfield()->set_value(0, VMesh::index_type(62));
+
+  CloseFieldDataAlgo close;
+  close.set(Parameters::MorphologyIterations, 1);
+  FieldHandle closed;
+  ASSERT_TRUE(close.runImpl(hole, closed));
+  values = Values(closed);
+  EXPECT_EQ(125, std::count(values.begin(), values.end(), 1.0));
+}
+
+TEST(FieldDataMorphologyTests, ErodeRejectsVectorData)
+{
+  FieldHandle field = LatVol(3, VECTOR_E, false);
+  ErodeFieldDataAlgo algo;
+  FieldHandle output;
+  EXPECT_FALSE(algo.runImpl(field, output));
+}
+
+TEST(FieldDataMorphologyTests, DISABLED_LabelFieldTiming)
+{
+  // 27M cell labels on a lattice, and 6M tets with the same labels
+  FieldHandle labels = LatVol(301, INT_E, true);
+  FillPattern(labels);
+  DilateFieldDataAlgo dilate;
+  dilate.set(Parameters::MorphologyIterations, 3);
+  FieldHandle output;
+  {
+    ScopedTimer t("Dilate, 3 iterations, 27M lattice cells");
+    dilate.runImpl(labels, output);
+  }
+
+  FieldHandle tets;
+  ConvertMeshToTetVolMeshAlgo convert;
+  convert.run(LatVol(101, INT_E, true), tets);
+  FillPattern(tets);
+  {
+    ScopedTimer t("Dilate, 3 iterations, 6M tets");
+    dilate.runImpl(tets, output);
+  }
+}
@@ -0,0 +1,183 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/StreamLines/GenerateStreamLines.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/GeometryPrimitives/Vector.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+namespace
+{
+  // Linear vector field on a unit cube lattice: a swirl around the z axis
+  // through the center, plus a drift along z
+  FieldHandle SwirlLatVol(size_type size, double drift)
+  {
+    FieldInformation fi(LATVOLMESH_E, LINEARDATA_E, VECTOR_E);
+    MeshHandle mesh = CreateMesh(fi, size, size, size, Point(0, 0, 0), Point(1, 1, 1));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    VMesh* vmesh = field->vmesh();
+    Point p;
+    for (VMesh::Node::index_type i = 0; i < vmesh->num_nodes(); ++i)
+    {
+      vmesh->get_center(p, i);
+      field->vfield()->set_value(Vector(0.5 - p.y(), p.x() - 0.5, drift), i);
+    }
+    return field;
+  }
+
+  FieldHandle SeedPoints(const std::vector<Point>& points)
+  {
+    FieldInformation fi(POINTCLOUDMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle field = CreateField(fi);
+    for (size_t i = 0; i < points.size(); ++i)
+      field->vmesh()->add_point(points[i]);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  std::vector<Point> SeedGrid(int n)
+  {
+    std::vector<Point> points;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        points.push_back(Point(0.2 + 0.6*i/(n-1), 0.2 + 0.6*j/(n-1), 0.1));
+    return points;
+  }
+
+  FieldHandle RunStreamLines(GenerateStreamLinesAlgo& algo, FieldHandle field, FieldHandle seeds)
+  {
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(field, seeds, output));
+    return output;
+  }
+
+  void ExpectSameNodes(FieldHandle expected, FieldHandle actual, VMesh::Node::size_type count)
+  {
+    Point p, q;
+    for (VMesh::Node::index_type i = 0; i < count; ++i)
+    {
+      expected->vmesh()->get_center(p, i);
+      actual->vmesh()->get_center(q, i);
+      EXPECT_EQ(p, q);
+    }
+  }
+}
+
+TEST(GenerateStreamLinesAlgoTests, UniformFieldGivesStraightLineForEverySeed)
+{
+  FieldHandle field = SwirlLatVol(5, 0.0);
+  // Overwrite with a constant field along x
+  for (VMesh::Node::index_type i = 0; i < field->vmesh()->num_nodes(); ++i)
+    field->vfield()->set_value(Vector(1, 0, 0), i);
+
+  std::vector<Point> points = { Point(0.1, 0.2, 0.3), Point(0.2, 0.5, 0.5), Point(0.3, 0.8, 0.7) };
+  FieldHandle seeds = SeedPoints(points);
+
+  GenerateStreamLinesAlgo algo;
+  algo.setOption(Parameters::StreamlineDirection, "Positive");
+  algo.setOption(Parameters::StreamlineMethod, "RungeKutta");
+  algo.set(Parameters::StreamlineStepSize, 0.05);
+  algo.set(Parameters::StreamlineMaxSteps, 100);
+  FieldHandle output = RunStreamLines(algo, field, seeds);
+
+  VMesh* omesh = output->vmesh();
+  ASSERT_GT(omesh->num_nodes(), 3);
+  // One polyline per seed
+  EXPECT_EQ(omesh->num_nodes() - points.size(), omesh->num_elems());
+
+  std::vector<bool> seen(points.size(), false);
+  Point p;
+  double seedIndex;
+  for (VMesh::Node::index_type i = 0; i < omesh->num_nodes(); ++i)
+  {
+    omesh->get_center(p, i);
+    output->vfield()->get_value(seedIndex, i);
+    size_t s = static_cast<size_t>(seedIndex);
+    ASSERT_LT(s, points.size());
+    seen[s] = true;
+    EXPECT_NEAR(points[s].y(), p.y(), 1e-10);
+    EXPECT_NEAR(points[s].z(), p.z(), 1e-10);
+    EXPECT_LE(p.x(), 1.0 + 1e-7);
+  }
+  for (size_t s = 0; s < seen.size(); ++s)
+    EXPECT_TRUE(seen[s]) << "no streamline for seed " << s;
+}
+
+TEST(GenerateStreamLinesAlgoTests, MultithreadedOutputMatchesSingleThreaded)
+{
+  FieldHandle field = SwirlLatVol(8, 0.2);
+  FieldHandle seeds = SeedPoints(SeedGrid(5));
+
+  GenerateStreamLinesAlgo serial;
+  serial.set(Parameters::UseMultithreading, false);
+  FieldHandle expected = RunStreamLines(serial, field, seeds);
+
+  GenerateStreamLinesAlgo threaded;
+  FieldHandle actual = RunStreamLines(threaded, field, seeds);
+
+  ASSERT_EQ(expected->vmesh()->num_nodes(), actual->vmesh()->num_nodes());
+  ASSERT_EQ(expected->vmesh()->num_elems(), actual->vmesh()->num_elems());
+  ExpectSameNodes(expected, actual, expected->vmesh()->num_nodes());
+}
+
+TEST(GenerateStreamLinesAlgoTests, AddingSeedsKeepsExistingStreamLines)
+{
+  FieldHandle field = SwirlLatVol(8, 0.2);
+  std::vector<Point> points = SeedGrid(4);
+
+  GenerateStreamLinesAlgo algo;
+  FieldHandle first = RunStreamLines(algo, field, SeedPoints(points));
+  EXPECT_EQ(points.size(), algo.integratedSeedCount());
+
+  // Only the new seed is traced
+  points.push_back(Point(0.45, 0.55, 0.3));
+  FieldHandle second = RunStreamLines(algo, field, SeedPoints(points));
+  EXPECT_EQ(1u, algo.integratedSeedCount());
+
+  ASSERT_GT(second->vmesh()->num_nodes(), first->vmesh()->num_nodes());
+  ExpectSameNodes(first, second, first->vmesh()->num_nodes());
+
+  // A fresh algorithm without cached lines produces the same output
+  GenerateStreamLinesAlgo fresh;
+  FieldHandle reference = RunStreamLines(fresh, field, SeedPoints(points));
+  EXPECT_EQ(points.size(), fresh.integratedSeedCount());
+  ASSERT_EQ(reference->vmesh()->num_nodes(), second->vmesh()->num_nodes());
+  ExpectSameNodes(reference, second, reference->vmesh()->num_nodes());
+}
@@ -155,4 +155,44 @@ TEST(GetFieldBoundaryTest, CanLogErrorMessage)
   EXPECT_FALSE(algo.run(input, output, mapping));
 
   EXPECT_FALSE(algo.run(input, output));
-}
\ No newline at end of file
+}
+
+TEST(GetFieldBoundaryTest, LargeLatVolBoundaryKeepsNodesAndValues)
+{
+  FieldInformation lfi("LatVolMesh", 1, "double");
+  size_type size = 20;
+  MeshHandle mesh = CreateMesh(lfi, size, size, size, Point(0, 0, 0), Point(1, 1, 1));
+  FieldHandle input = CreateField(lfi, mesh);
+  for (VMesh::Node::index_type i = 0; i < input->vmesh()->num_nodes(); ++i)
+    input->vfield()->set_value(static_cast<double>(i), i);
+
+  GetFieldBoundaryAlgo algo;
+  FieldHandle boundary;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.run(input, boundary, mapping));
+
+  VMesh* omesh = boundary->vmesh();
+  EXPECT_EQ(size*size*size - (size-2)*(size-2)*(size-2), omesh->num_nodes());
+  EXPECT_EQ(6*(size-1)*(size-1), omesh->num_elems());
+
+  auto sparse = convertMatrix::toSparse(mapping);
+  ASSERT_TRUE(sparse != nullptr);
+  ASSERT_EQ(omesh->num_nodes(), sparse->nrows());
+  for (VMesh::Node::index_type j = 0; j < omesh->num_nodes(); ++j)
+  {
+    ASSERT_EQ(1, sparse->get_rows()[j + 1] - sparse->get_rows()[j]);
+    VMesh::Node::index_type source = sparse->get_cols()[sparse->get_rows()[j]];
+    Point expected, actual;
+    input->vmesh()->get_center(expected, source);
+    omesh->get_center(actual, j);
+    EXPECT_EQ(expected, actual);
+    double value;
+    boundary->vfield()->get_value(value, j);
+    EXPECT_EQ(static_cast<double>(source), value);
+  }
+
+  FieldHandle withoutMapping;
+  ASSERT_TRUE(algo.run(input, withoutMapping));
+  EXPECT_EQ(omesh->num_nodes(), withoutMapping->vmesh()->num_nodes());
+  EXPECT_EQ(omesh->num_elems(), withoutMapping->vmesh()->num_elems());
+}
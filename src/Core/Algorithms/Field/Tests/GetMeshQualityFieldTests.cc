@@ -0,0 +1,101 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/MeshData/GetMeshQualityFieldAlgo.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  void expectMatchesMeshMetric(const std::string& metric, double (VMesh::*meshMetric)(VMesh::Elem::index_type) const)
+  {
+    FieldHandle input = CubeTetVolLinearBasis(DOUBLE_E);
+    GetMeshQualityFieldAlgo algo;
+    algo.setOption(Parameters::Metric, metric);
+    FieldHandle output;
+    MeshQualitySummary summary;
+    ASSERT_TRUE(algo.run(input, output, summary));
+
+    VMesh* mesh = input->vmesh();
+    ASSERT_EQ(mesh->num_elems(), output->vfield()->num_values());
+    double value;
+    for (VMesh::Elem::index_type i = 0; i < mesh->num_elems(); ++i)
+    {
+      output->vfield()->get_value(value, i);
+      EXPECT_NEAR((mesh->*meshMetric)(i), value, 1e-12) << metric << " of element " << i;
+    }
+  }
+}
+
+TEST(GetMeshQualityFieldTests, TetScaledJacobianMatchesMesh)
+{
+  expectMatchesMeshMetric("scaled_jacobian", &VMesh::scaled_jacobian_metric);
+}
+
+TEST(GetMeshQualityFieldTests, TetJacobianMatchesMesh)
+{
+  expectMatchesMeshMetric("jacobian", &VMesh::jacobian_metric);
+}
+
+TEST(GetMeshQualityFieldTests, TetVolumeMatchesMesh)
+{
+  expectMatchesMeshMetric("volume", &VMesh::volume_metric);
+}
+
+TEST(GetMeshQualityFieldTests, SummaryCoversAllElements)
+{
+  FieldHandle input = CubeTetVolLinearBasis(DOUBLE_E);
+  GetMeshQualityFieldAlgo algo;
+  FieldHandle output;
+  MeshQualitySummary summary;
+  ASSERT_TRUE(algo.run(input, output, summary));
+
+  size_type total = 0;
+  for (size_t b = 0; b < summary.histogram.size(); ++b)
+    total += summary.histogram[b];
+  EXPECT_EQ(input->vmesh()->num_elems(), total);
+
+  ASSERT_EQ(static_cast<size_t>(input->vmesh()->num_elems()), summary.worst.size());
+  EXPECT_EQ(summary.min, summary.worst.front().first);
+  EXPECT_EQ(summary.max, summary.worst.back().first);
+  for (size_t w = 1; w < summary.worst.size(); ++w)
+    EXPECT_LE(summary.worst[w-1].first, summary.worst[w].first);
+  EXPECT_LE(summary.min, summary.mean);
+  EXPECT_LE(summary.mean, summary.max);
+}
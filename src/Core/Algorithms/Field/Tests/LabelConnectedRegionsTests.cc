@@ -0,0 +1,228 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/LabelConnectedRegions.h>
+#include <Core/Algorithms/Legacy/Fields/DomainFields/SplitFieldByDomainAlgo.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // n x n x n unit hexes, element i + n*(j + n*k) at cell (i,j,k), with
+  // label(i,j,k) as element data
+  template <class Label>
+  FieldHandle LabelledHexGrid(int n, Label label)
+  {
+    FieldInformation fi(HEXVOLMESH_E, CONSTANTDATA_E, INT_E);
+    FieldHandle field = CreateField(fi);
+    VMesh* mesh = field->vmesh();
+    for (int k = 0; k <= n; ++k)
+      for (int j = 0; j <= n; ++j)
+        for (int i = 0; i <= n; ++i)
+          mesh->add_point(Point(i, j, k));
+
+    auto node = [n](int i, int j, int k) { return VMesh::index_type(i + (n+1)*(j + (n+1)*k)); };
+    VMesh::Node::array_type hex(8);
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+        {
+          hex[0] = node(i, j, k);     hex[1] = node(i+1, j, k);
+          hex[2] = node(i+1, j+1, k); hex[3] = node(i, j+1, k);
+          hex[4] = node(i, j, k+1);   hex[5] = node(i+1, j, k+1);
+          hex[6] = node(i+1, j+1, k+1); hex[7] = node(i, j+1, k+1);
+          mesh->add_elem(hex);
+        }
+
+    VField* values = field->vfield();
+    values->resize_values();
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+          values->set_value(label(i, j, k), VMesh::index_type(i + n*(j + n*k)));
+    return field;
+  }
+
+  // Three slabs along x: label 1, label 2, label 1 again
+  int Slabs(int i, int, int) { return (i < 2 || i >= 4) ? 1 : 2; }
+
+  std::vector<int> ElementLabels(FieldHandle field)
+  {
+    std::vector<int> labels;
+    field->vfield()->get_values(labels);
+    return labels;
+  }
+}
+
+TEST(LabelConnectedRegionsTests, CornerContactJoinsOnlyThroughNodes)
+{
+  FieldInformation fi(QUADSURFMESH_E, CONSTANTDATA_E, DOUBLE_E);
+  FieldHandle field = CreateField(fi);
+  VMesh* mesh = field->vmesh();
+  mesh->add_point(Point(0, 0, 0)); mesh->add_point(Point(1, 0, 0));
+  mesh->add_point(Point(1, 1, 0)); mesh->add_point(Point(0, 1, 0));
+  mesh->add_point(Point(2, 1, 0)); mesh->add_point(Point(2, 2, 0));
+  mesh->add_point(Point(1, 2, 0));
+  VMesh::Node::array_type quad(4);
+  quad[0] = 0; quad[1] = 1; quad[2] = 2; quad[3] = 3;
+  mesh->add_elem(quad);
+  quad[0] = 2; quad[1] = 4; quad[2] = 5; quad[3] = 6;
+  mesh->add_elem(quad);
+
+  std::vector<index_type> regions;
+  EXPECT_EQ(1, labelConnectedRegions(mesh, ElementConnectivity::SharedNode, regions));
+  EXPECT_EQ(0, regions[1]);
+
+  EXPECT_EQ(2, labelConnectedRegions(mesh, ElementConnectivity::SharedFace, regions));
+  EXPECT_EQ(0, regions[0]);
+  EXPECT_EQ(1, regions[1]);
+}
+
+TEST(LabelConnectedRegionsTests, LabelAwareSplitsEveryTissuePiece)
+{
+  const int n = 6;
+  FieldHandle field = LabelledHexGrid(n, Slabs);
+  VMesh* mesh = field->vmesh();
+  const std::vector<int> labels = ElementLabels(field);
+
+  std::vector<index_type> regions;
+  EXPECT_EQ(1, labelConnectedRegions(mesh, ElementConnectivity::SharedFace, regions));
+
+  const ElementConnectivity connectivities[] = { ElementConnectivity::SharedNode, ElementConnectivity::SharedFace };
+  for (auto connectivity : connectivities)
+  {
+    ASSERT_EQ(3, labelConnectedRegions(mesh, connectivity, regions, &labels));
+    // Numbered by lowest element, which lies in the k = j = 0 row
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+          EXPECT_EQ(i / 2, regions[i + n*(j + n*k)]);
+  }
+}
+
+TEST(LabelConnectedRegionsTests, GroupByRegionKeepsAscendingOrder)
+{
+  const std::vector<index_type> regions = { 1, 0, -1, 1, 0, 1 };
+  std::vector<index_type> offsets, items;
+  groupByRegion(regions, 2, offsets, items);
+
+  EXPECT_EQ((std::vector<index_type>{ 0, 2, 5 }), offsets);
+  EXPECT_EQ((std::vector<index_type>{ 1, 4, 0, 3, 5 }), items);
+}
+
+TEST(LabelConnectedRegionsTests, SplitFieldByDomainGroupsEqualLabels)
+{
+  const int n = 6;
+  FieldHandle field = LabelledHexGrid(n, Slabs);
+
+  SplitFieldByDomainAlgo algo;
+  FieldList output;
+  ASSERT_TRUE(algo.runImpl(field, output));
+  ASSERT_EQ(2, output.size());
+
+  // Both outer slabs, 2 x 6 x 6 cells on 3 x 7 x 7 nodes each
+  EXPECT_EQ(144, output[0]->vmesh()->num_elems());
+  EXPECT_EQ(294, output[0]->vmesh()->num_nodes());
+  EXPECT_EQ(72, output[1]->vmesh()->num_elems());
+  EXPECT_EQ(147, output[1]->vmesh()->num_nodes());
+
+  int value;
+  output[1]->vfield()->get_value(value, VMesh::index_type(0));
+  EXPECT_EQ(2, value);
+
+  // Nodes are numbered as they first appear on the elements
+  Point p;
+  output[1]->vmesh()->get_point(p, VMesh::Node::index_type(1));
+  EXPECT_EQ(Point(3, 0, 0), p);
+}
+
+TEST(LabelConnectedRegionsTests, SplitFieldByDomainHandlesPointClouds)
+{
+  FieldInformation fi(POINTCLOUDMESH_E, CONSTANTDATA_E, INT_E);
+  FieldHandle field = CreateField(fi);
+  const int labels[] = { 1, 2, 1, 3 };
+  for (int i = 0; i < 4; ++i)
+    field->vmesh()->add_point(Point(i, 0, 0));
+  field->vfield()->resize_values();
+  for (int i = 0; i < 4; ++i)
+    field->vfield()->set_value(labels[i], VMesh::index_type(i));
+
+  SplitFieldByDomainAlgo algo;
+  FieldList output;
+  ASSERT_TRUE(algo.runImpl(field, output));
+  ASSERT_EQ(3, output.size());
+
+  EXPECT_EQ(2, output[0]->vmesh()->num_nodes());
+  EXPECT_EQ(2, output[0]->vmesh()->num_elems());
+  EXPECT_EQ(1, output[1]->vmesh()->num_nodes());
+  EXPECT_EQ(1, output[2]->vmesh()->num_nodes());
+
+  Point p;
+  output[0]->vmesh()->get_point(p, VMesh::Node::index_type(1));
+  EXPECT_EQ(Point(2, 0, 0), p);
+}
+
+TEST(LabelConnectedRegionsTests, DISABLED_MultiTissueTiming)
+{
+  // Nested spherical shells of 5 cells, 8M hexes
+  const int n = 200;
+  auto shells = [n](int i, int j, int k)
+  {
+    const double c = 0.5*n;
+    const double r = std::sqrt((i-c)*(i-c) + (j-c)*(j-c) + (k-c)*(k-c));
+    return static_cast<int>(r / 5.0);
+  };
+  FieldHandle field = LabelledHexGrid(n, shells);
+  const std::vector<int> labels = ElementLabels(field);
+  std::vector<index_type> regions;
+  {
+    ScopedTimer t("Label-aware face connectivity, 8M hexes");
+    labelConnectedRegions(field->vmesh(), ElementConnectivity::SharedFace, regions, &labels);
+  }
+  {
+    ScopedTimer t("Label-aware node connectivity, 8M hexes");
+    labelConnectedRegions(field->vmesh(), ElementConnectivity::SharedNode, regions, &labels);
+  }
+
+  SplitFieldByDomainAlgo algo;
+  FieldList output;
+  ScopedTimer t("SplitFieldByDomain, 8M hexes");
+  algo.runImpl(field, output);
+}
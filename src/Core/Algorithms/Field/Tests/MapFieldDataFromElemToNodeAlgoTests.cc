@@ -38,6 +38,8 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Core/Datatypes/DenseMatrix.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <boost/timer.hpp>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -249,3 +251,74 @@ TEST(MapFieldDataFromElemToNode, TetMeshTestMed)
  }
 
 }
+
+namespace
+{
+  FieldHandle ConstantLatVol(size_type size)
+  {
+    FieldInformation fi(LATVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+    MeshHandle mesh = CreateMesh(fi, size, size, size, Point(0, 0, 0), Point(1, 1, 1));
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    std::vector<double> values(field->vfield()->num_values());
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = static_cast<double>((i * 7919) % 101);
+    field->vfield()->set_values(values);
+    return field;
+  }
+
+  // Per-value reference: one virtual get_elems/get_value call per adjacency.
+  std::vector<double> averageElemValuesPerNode(FieldHandle field)
+  {
+    VMesh* mesh = field->vmesh();
+    VField* vfield = field->vfield();
+    mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+    std::vector<double> result(mesh->num_nodes());
+    VMesh::Elem::array_type elems;
+    for (VMesh::Node::index_type n = 0; n < mesh->num_nodes(); ++n)
+    {
+      mesh->get_elems(elems, n);
+      double val = 0, tval;
+      for (size_t p = 0; p < elems.size(); ++p)
+      {
+        vfield->get_value(tval, elems[p]);
+        val += tval;
+      }
+      result[n] = val / elems.size();
+    }
+    return result;
+  }
+}
+
+TEST(MapFieldDataFromElemToNode, BulkAverageMatchesPerValueReference)
+{
+  FieldHandle input = ConstantLatVol(6);
+  std::vector<double> expected = averageElemValuesPerNode(input);
+
+  MapFieldDataFromElemToNodeAlgo algo;
+  algo.setOption(MapFieldDataFromElemToNodeAlgo::Method, "Average");
+  FieldHandle result = algo.runImpl(input);
+
+  std::vector<double> actual;
+  result->vfield()->get_values(actual);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(expected[i], actual[i], 1e-12);
+}
+
+TEST(MapFieldDataFromElemToNode, DISABLED_TimingBulkVersusPerValue)
+{
+  FieldHandle input = ConstantLatVol(80);
+
+  boost::timer t;
+  std::vector<double> reference = averageElemValuesPerNode(input);
+  std::cout << "per-value access: " << t.elapsed() << " s" << std::endl;
+
+  t.restart();
+  MapFieldDataFromElemToNodeAlgo algo;
+  algo.setOption(MapFieldDataFromElemToNodeAlgo::Method, "Average");
+  FieldHandle result = algo.runImpl(input);
+  std::cout << "bulk access: " << t.elapsed() << " s" << std::endl;
+
+  EXPECT_EQ(reference.size(), result->vfield()->num_values());
+}
@@ -32,6 +32,14 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataFromSourceToDestination.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/BuildMappingMatrixAlgo.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
@@ -53,3 +61,169 @@ TEST(MapFieldDataFromSourceToDestinationAlgoTests, ThrowsOnNullInput)
   AlgorithmInput empty;
   EXPECT_THROW(algo.run(empty), AlgorithmProcessingException);
 }
+
+namespace
+{
+  double linearFunction(const Point& p)
+  {
+    return 1.0 + p.x() - 2.0*p.y() + 0.5*p.z();
+  }
+
+  FieldHandle LinearLatVol(size_type ni, size_type nj, size_type nk, const Point& min, const Point& max)
+  {
+    FieldInformation fi(LATVOLMESH_E, LINEARDATA_E, DOUBLE_E);
+    MeshHandle mesh = CreateMesh(fi, ni, nj, nk, min, max);
+    FieldHandle field = CreateField(fi, mesh);
+    field->vfield()->resize_values();
+    VMesh* vmesh = field->vmesh();
+    Point p;
+    for (VMesh::Node::index_type i = 0; i < vmesh->num_nodes(); ++i)
+    {
+      vmesh->get_center(p, i);
+      field->vfield()->set_value(linearFunction(p), i);
+    }
+    return field;
+  }
+
+  Point clampToUnitCube(const Point& p)
+  {
+    return Point(std::min(std::max(p.x(), 0.0), 1.0),
+                 std::min(std::max(p.y(), 0.0), 1.0),
+                 std::min(std::max(p.z(), 0.0), 1.0));
+  }
+}
+
+// Trilinear interpolation reproduces a linear function exactly, so the
+// structured fast paths can be checked against the analytic values.
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, AlignedLatVolToLatVolReproducesLinearData)
+{
+  FieldHandle source = LinearLatVol(5, 6, 7, Point(0, 0, 0), Point(2, 3, 4));
+  FieldHandle destination = LinearLatVol(9, 8, 7, Point(0.1, 0.2, 0.3), Point(1.9, 2.8, 3.7));
+
+  MapFieldDataFromSourceToDestinationAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(source, destination, output));
+
+  VMesh* mesh = output->vmesh();
+  Point p;
+  double val;
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    mesh->get_center(p, i);
+    output->vfield()->get_value(val, i);
+    EXPECT_NEAR(linearFunction(p), val, 1e-10);
+  }
+}
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, LatVolToTetVolReproducesLinearData)
+{
+  FieldHandle source = LinearLatVol(4, 4, 4, Point(-1, -1, -1), Point(2, 2, 2));
+  FieldHandle destination = CubeTetVolLinearBasis(DOUBLE_E);
+
+  MapFieldDataFromSourceToDestinationAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(source, destination, output));
+
+  VMesh* mesh = output->vmesh();
+  Point p;
+  double val;
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    mesh->get_center(p, i);
+    output->vfield()->get_value(val, i);
+    EXPECT_NEAR(linearFunction(p), val, 1e-10);
+  }
+}
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, PointsOutsideLatVolUseClosestElement)
+{
+  FieldHandle source = LinearLatVol(3, 3, 3, Point(0, 0, 0), Point(1, 1, 1));
+  FieldHandle destination = LinearLatVol(5, 5, 5, Point(-0.5, -0.5, -0.5), Point(1.5, 1.5, 1.5));
+
+  MapFieldDataFromSourceToDestinationAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(source, destination, output));
+
+  VMesh* mesh = output->vmesh();
+  Point p;
+  double val;
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    mesh->get_center(p, i);
+    output->vfield()->get_value(val, i);
+    EXPECT_NEAR(linearFunction(clampToUnitCube(p)), val, 1e-10);
+  }
+}
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, MappingMatrixFromLatVolReproducesLinearData)
+{
+  FieldHandle source = LinearLatVol(5, 6, 7, Point(0, 0, 0), Point(2, 3, 4));
+  FieldHandle destination = LinearLatVol(9, 8, 7, Point(0.1, 0.2, 0.3), Point(1.9, 2.8, 3.7));
+
+  BuildMappingMatrixAlgo algo;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.runImpl(source, destination, mapping));
+
+  auto sparse = castMatrix::toSparse(mapping);
+  ASSERT_TRUE(sparse != nullptr);
+  ASSERT_EQ(destination->vmesh()->num_nodes(), sparse->nrows());
+  ASSERT_EQ(source->vmesh()->num_nodes(), sparse->ncols());
+
+  std::vector<double> values;
+  source->vfield()->get_values(values);
+  DenseColumnMatrix sourceValues(values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    sourceValues[i] = values[i];
+
+  DenseColumnMatrix mapped(*sparse * sourceValues);
+
+  VMesh* mesh = destination->vmesh();
+  Point p;
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    mesh->get_center(p, i);
+    EXPECT_NEAR(linearFunction(p), mapped[i], 1e-10);
+  }
+}
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, PointsOffImagePlaneRespectMaxDistance)
+{
+  FieldInformation fi(IMAGEMESH_E, LINEARDATA_E, DOUBLE_E);
+  MeshHandle mesh = CreateMesh(fi, 3, 3, Point(0, 0, 0), Point(1, 1, 0));
+  FieldHandle source = CreateField(fi, mesh);
+  source->vfield()->resize_values();
+  Point p;
+  for (VMesh::Node::index_type i = 0; i < source->vmesh()->num_nodes(); ++i)
+  {
+    source->vmesh()->get_center(p, i);
+    source->vfield()->set_value(linearFunction(p), i);
+  }
+
+  FieldInformation pfi(POINTCLOUDMESH_E, LINEARDATA_E, DOUBLE_E);
+  FieldHandle destination = CreateField(pfi);
+  destination->vmesh()->add_point(Point(0.25, 0.5, 0.0));
+  destination->vmesh()->add_point(Point(0.25, 0.5, 5.0));
+  destination->vfield()->resize_values();
+
+  MapFieldDataFromSourceToDestinationAlgo algo;
+  algo.set(Parameters::MaxDistance, 1.0);
+  algo.set(Parameters::DefaultValue, -7.0);
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(source, destination, output));
+
+  double val;
+  output->vfield()->get_value(val, VMesh::index_type(0));
+  EXPECT_NEAR(linearFunction(Point(0.25, 0.5, 0.0)), val, 1e-10);
+  output->vfield()->get_value(val, VMesh::index_type(1));
+  EXPECT_EQ(-7.0, val);
+
+  BuildMappingMatrixAlgo build;
+  build.set(Parameters::MaxDistance, 1.0);
+  MatrixHandle mapping;
+  ASSERT_TRUE(build.runImpl(source, destination, mapping));
+  auto sparse = castMatrix::toSparse(mapping);
+  ASSERT_TRUE(sparse != nullptr);
+  EXPECT_NE(0, sparse->row(0).nonZeros());
+  EXPECT_EQ(0, sparse->row(1).nonZeros());
+}
@@ -0,0 +1,105 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Algorithms/Legacy/Fields/RegisterWithCorrespondences.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  FieldHandle PointCloud(const std::vector<Point>& points)
+  {
+    FieldInformation fi(POINTCLOUDMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle field = CreateField(fi);
+    for (size_t i = 0; i < points.size(); ++i)
+      field->vmesh()->add_point(points[i]);
+    field->vfield()->resize_values();
+    return field;
+  }
+
+  // Scattered, non-coplanar landmarks in the unit cube
+  std::vector<Point> Landmarks(int n)
+  {
+    std::vector<Point> points;
+    for (int i = 0; i < n; ++i)
+      points.push_back(Point(fmod(0.618034 * i, 1.0), fmod(0.754878 * i, 1.0), fmod(0.569840 * i, 1.0)));
+    return points;
+  }
+
+  std::vector<Point> Warped(const std::vector<Point>& points)
+  {
+    std::vector<Point> warped;
+    for (const auto& p : points)
+      warped.push_back(Point(p.x() + 0.1 * sin(3 * p.y()), 1.2 * p.y() + 0.3, p.z() + 0.05 * p.x() * p.x()));
+    return warped;
+  }
+}
+
+TEST(RegisterWithCorrespondencesTests, ThinPlateSplineMapsCorrespondencesOntoEachOther)
+{
+  auto moving = Landmarks(60);
+  auto fixed = Warped(moving);
+
+  RegisterWithCorrespondencesAlgo algo;
+  FieldHandle output;
+  ASSERT_TRUE(algo.runM(PointCloud(moving), PointCloud(fixed), PointCloud(moving), output));
+
+  ASSERT_EQ(moving.size(), static_cast<size_t>(output->vmesh()->num_nodes()));
+  for (VMesh::Node::index_type i = 0; i < output->vmesh()->num_nodes(); ++i)
+  {
+    Point p;
+    output->vmesh()->get_point(p, i);
+    EXPECT_NEAR(fixed[i].x(), p.x(), 1e-8);
+    EXPECT_NEAR(fixed[i].y(), p.y(), 1e-8);
+    EXPECT_NEAR(fixed[i].z(), p.z(), 1e-8);
+  }
+}
+
+TEST(RegisterWithCorrespondencesTests, DISABLED_ThinPlateSplineTiming)
+{
+  auto moving = Landmarks(3000);
+  auto fixed = Warped(moving);
+  FieldHandle input = PointCloud(Landmarks(200000));
+
+  RegisterWithCorrespondencesAlgo algo;
+  FieldHandle output;
+  ScopedTimer t("Thin plate spline, 3000 landmarks, 200000 nodes");
+  algo.runM(input, PointCloud(fixed), PointCloud(moving), output);
+}
@@ -398,11 +398,11 @@ ConvertToNrrdAlgo::runImpl(FieldHandle input, NrrdDataHandle& points,
 
       if (field->is_vector())
       {
-        Vector vec;
+        const Vector* values = field->get_values_pointer_as<Vector>();
         float* data_ptr = reinterpret_cast<float*>(data->getNrrd()->data);
         for(VField::index_type idx=0; idx<num_values; idx++)
         {
-          field->get_value(vec,idx);
+          const Vector& vec = values[idx];
           data_ptr[0] = static_cast<float>(vec.x());
           data_ptr[1] = static_cast<float>(vec.y());
           data_ptr[2] = static_cast<float>(vec.z());
@@ -411,11 +411,11 @@ ConvertToNrrdAlgo::runImpl(FieldHandle input, NrrdDataHandle& points,
       }
       else
       {
-        Tensor tensor;
+        const Tensor* values = field->get_values_pointer_as<Tensor>();
         float* data_ptr = reinterpret_cast<float*>(data->getNrrd()->data);
         for(VField::index_type idx=0; idx<num_values; idx++)
         {
-          field->get_value(tensor,idx);
+          const Tensor& tensor = values[idx];
           data_ptr[0] = static_cast<float>(1.0);
           data_ptr[1] = static_cast<float>(tensor.val(0,0));
           data_ptr[2] = static_cast<float>(tensor.val(0,1));
@@ -315,20 +315,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -356,20 +353,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
@@ -396,20 +390,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -436,20 +427,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
@@ -475,20 +463,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -514,20 +499,17 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Vector* values = field->get_values_pointer_as<Vector>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Vector v;
-      field->get_value(v,*it);
+      const Vector& v = values[idx];
       data[k] = v.x(); k++;
       data[k] = v.y(); k++;
       data[k] = v.z(); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
@@ -623,23 +605,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0,0); k++;
       data[k] = t.val(0,1); k++;
       data[k] = t.val(0,2); k++;
       data[k] = t.val(1,1); k++;
       data[k] = t.val(1,2); k++;
       data[k] = t.val(2,2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -667,23 +646,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0, 0); k++;
       data[k] = t.val(0, 1); k++;
       data[k] = t.val(0, 2); k++;
       data[k] = t.val(1, 1); k++;
       data[k] = t.val(1, 2); k++;
       data[k] = t.val(2, 2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
@@ -711,23 +687,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0, 0); k++;
       data[k] = t.val(0, 1); k++;
       data[k] = t.val(0, 2); k++;
       data[k] = t.val(1, 1); k++;
       data[k] = t.val(1, 2); k++;
       data[k] = t.val(2, 2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -754,23 +727,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0, 0); k++;
       data[k] = t.val(0, 1); k++;
       data[k] = t.val(0, 2); k++;
       data[k] = t.val(1, 1); k++;
       data[k] = t.val(1, 2); k++;
       data[k] = t.val(2, 2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
@@ -797,23 +767,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0, 0); k++;
       data[k] = t.val(0, 1); k++;
       data[k] = t.val(0, 2); k++;
       data[k] = t.val(1, 1); k++;
       data[k] = t.val(1, 2); k++;
       data[k] = t.val(2, 2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterNode;
@@ -839,23 +806,20 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
+    const Tensor* values = field->get_values_pointer_as<Tensor>();
+    VMesh::size_type num_values = field->num_values();
     size_t k = 0;
 
     double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
+    for (VMesh::index_type idx = 0; idx < num_values; idx++)
     {
-      Tensor t;
-      field->get_value(t,*it);
+      const Tensor& t = values[idx];
       data[k] = t.val(0, 0); k++;
       data[k] = t.val(0, 1); k++;
       data[k] = t.val(0, 2); k++;
       data[k] = t.val(1, 1); k++;
       data[k] = t.val(1, 2); k++;
       data[k] = t.val(2, 2); k++;
-      ++it;
     }
 
     nrrdcenter = nrrdCenterCell;
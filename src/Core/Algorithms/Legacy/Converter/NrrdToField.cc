@@ -326,8 +326,6 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
 
   if (rdim == 1)
   {
-    int k = 0;
-
     if (datalocation == "Node")
     {
       FieldInformation fi(SCANLINEMESH_E,LINEARDATA_E,DOUBLE_E);
@@ -339,16 +337,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
 
       if (use_tf)
       {
@@ -368,15 +357,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
       if (use_tf)
       {
         Transform trans = vmesh->get_transform();
@@ -392,8 +373,6 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
   }
   else if (rdim == 2)
   {
-    int k = 0;
-
     if (datalocation == "Node")
     {
       FieldInformation fi(IMAGEMESH_E,LINEARDATA_E,DOUBLE_E);
@@ -405,16 +384,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
 
       if (use_tf)
       {
@@ -434,15 +404,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
       if (use_tf)
       {
         Transform trans = vmesh->get_transform();
@@ -458,8 +420,6 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
   }
   else if (rdim == 3)
   {
-    int k = 0;
-
     if (datalocation == "Node")
     {
       FieldInformation fi(LATVOLMESH_E,LINEARDATA_E,DOUBLE_E);
@@ -471,16 +431,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
 
       if (use_tf)
       {
@@ -500,15 +451,7 @@ bool NrrdToFieldAlgoT::nrrdToField(LoggerHandle pr,NrrdDataHandle input, FieldHa
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it, it_end;
-      vmesh->begin(it);
-      vmesh->end(it_end);
-      while (it != it_end)
-      {
-        vfield->set_value(dataptr[k],*it);
-        ++it;
-        k++;
-      }
+      vfield->set_values(dataptr,vfield->num_values());
 
       if (use_tf)
       {
@@ -842,8 +785,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t x=0; x<space_size[0]; x+= space_offset[0])
       {
@@ -851,8 +794,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
         const double v2 = static_cast<double>(dataptr[x+vector_offset]);
         const double v3 = static_cast<double>(dataptr[x+2*vector_offset]);
         Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-        vfield->set_value(v,*it);
-        ++it;
+        values[idx++] = v;
       }
 
       if (use_tf)
@@ -872,8 +814,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t x=0; x<space_size[0]; x+= space_offset[0])
       {
@@ -881,8 +823,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
         const double v2 = static_cast<double>(dataptr[x+vector_offset]);
         const double v3 = static_cast<double>(dataptr[x+2*vector_offset]);
         Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-        vfield->set_value(v,*it);
-        ++it;
+        values[idx++] = v;
       }
 
       if (use_tf)
@@ -911,8 +852,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t y=0; y<space_size[1]; y+= space_offset[1])
       {
@@ -923,8 +864,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
           const double v2 = static_cast<double>(dataptr[a+vector_offset]);
           const double v3 = static_cast<double>(dataptr[a+2*vector_offset]);
           Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-          vfield->set_value(v,*it);
-          ++it;
+          values[idx++] = v;
         }
       }
 
@@ -945,8 +885,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t y=0; y<space_size[1]; y+= space_offset[1])
       {
@@ -957,8 +897,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
           const double v2 = static_cast<double>(dataptr[a+vector_offset]);
           const double v3 = static_cast<double>(dataptr[a+2*vector_offset]);
           Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-          vfield->set_value(v,*it);
-          ++it;
+          values[idx++] = v;
         }
       }
 
@@ -987,8 +926,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t z = 0; z < space_size[2]; z += space_offset[2])
       {
@@ -1001,8 +940,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
             const double v2 = static_cast<double>(dataptr[a+vector_offset]);
             const double v3 = static_cast<double>(dataptr[a+2*vector_offset]);
             Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-            vfield->set_value(v,*it);
-            ++it;
+            values[idx++] = v;
           }
         }
       }
@@ -1024,8 +962,8 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Vector* values = vfield->get_values_pointer_as<Vector>();
+      VMesh::index_type idx = 0;
 
       for (size_t z = 0; z < space_size[2]; z += space_offset[2])
       {
@@ -1038,8 +976,7 @@ bool NrrdToFieldAlgoT::nrrdToVectorField(LoggerHandle pr,NrrdDataHandle input, F
             const double v2 = static_cast<double>(dataptr[a+vector_offset]);
             const double v3 = static_cast<double>(dataptr[a+2*vector_offset]);
             Vector v(M[0][0]*v1+M[0][1]*v2+M[0][2]*v3,M[1][0]*v1+M[1][1]*v2+M[1][2]*v3,M[2][0]*v1+M[2][1]*v2+M[2][2]*v3);
-            vfield->set_value(v,*it);
-            ++it;
+            values[idx++] = v;
           }
         }
       }
@@ -1446,8 +1383,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t x = 0; x < space_size[0]; x += space_offset[0])
       {
@@ -1469,8 +1406,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
         Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                  m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-        vfield->set_value(t,*it);
-        ++it;
+        values[idx++] = t;
       }
 
       if (use_tf)
@@ -1490,8 +1426,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t x = 0; x < space_size[0]; x += space_offset[0])
       {
@@ -1513,8 +1449,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
         Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                  m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-        vfield->set_value(t,*it);
-        ++it;
+        values[idx++] = t;
       }
 
       if (use_tf)
@@ -1542,8 +1477,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t y = 0; y < space_size[1]; y += space_offset[1])
       {
@@ -1568,8 +1503,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
           Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                    m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-          vfield->set_value(t,*it);
-          ++it;
+          values[idx++] = t;
         }
       }
 
@@ -1590,8 +1524,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t y = 0; y < space_size[1]; y += space_offset[1])
       {
@@ -1616,8 +1550,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
           Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                    m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-          vfield->set_value(t,*it);
-          ++it;
+          values[idx++] = t;
         }
       }
 
@@ -1646,8 +1579,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Node::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t z = 0; z < space_size[2]; z += space_offset[2])
       {
@@ -1674,8 +1607,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
             Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                      m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-            vfield->set_value(t,*it);
-            ++it;
+            values[idx++] = t;
           }
         }
       }
@@ -1697,8 +1629,8 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
       VMesh*  vmesh = output->vmesh();
       VField* vfield = output->vfield();
 
-      VMesh::Elem::iterator it;
-      vmesh->begin(it);
+      Tensor* values = vfield->get_values_pointer_as<Tensor>();
+      VMesh::index_type idx = 0;
 
       for (size_t z = 0; z < space_size[2]; z += space_offset[2])
       {
@@ -1725,8 +1657,7 @@ bool NrrdToFieldAlgoT::nrrdToTensorField(LoggerHandle pr,NrrdDataHandle input, F
 
             Tensor t(m00*y0+m01*y1+m02*y2,m10*y0+m11*y1+m12*y2,m20*y0+m21*y1+m22*y2,
                      m10*y3+m11*y4+m12*y5,m20*y3+m21*y4+m22*y5,m20*y6+m21*y7+m22*y8);
-            vfield->set_value(t,*it);
-            ++it;
+            values[idx++] = t;
           }
         }
       }
@@ -36,7 +36,7 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/DenseMatrix.h>
-#include <Core/Datatypes/SparseRowMatrixFromMap.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Logging/Log.h>
 
@@ -213,34 +213,34 @@ ClipMeshBySelectionAlgo::runImpl(FieldHandle input,
       {
         if (num_elems > 0 && num_oelems > 0)
         {
-          SparseRowMatrixFromMap::Values map;
-
           n =   num_elems;
           m =   num_oelems;
 
+          SparseRowMatrixTripletBuilder builder(m, n);
+          builder.reserve(m);
           for (index_type idx=0;idx<m;idx++)
           {
-            map[idx][elem_mapping2[idx]] = 1.0;
+            builder.add(idx, elem_mapping2[idx], 1.0);
           }
 
-          mapping = SparseRowMatrixFromMap::make(m, n, map);
+          mapping = builder.build();
         }
       }
       else if (ofield->basis_order() == 1)
       {
         if (num_nodes > 0 && num_onodes >0)
         {
-          SparseRowMatrixFromMap::Values map;
-
           n =   num_nodes;
           m =   num_onodes;
 
+          SparseRowMatrixTripletBuilder builder(m, n);
+          builder.reserve(m);
           for (index_type idx=0;idx<m;idx++)
           {
-            map[idx][node_mapping2[idx]] = 1.0;
+            builder.add(idx, node_mapping2[idx], 1.0);
           }
 
-          mapping = SparseRowMatrixFromMap::make(m, n, map);
+          mapping = builder.build();
         }
       }
       // provide an empty matrix
@@ -330,34 +330,34 @@ ClipMeshBySelectionAlgo::runImpl(FieldHandle input,
       {
         if (num_elems > 0 && num_oelems > 0)
         {
-          SparseRowMatrixFromMap::Values map;
-
           n =   num_elems;
           m =   num_oelems;
 
+          SparseRowMatrixTripletBuilder builder(m, n);
+          builder.reserve(m);
           for (index_type idx=0;idx<m;idx++)
           {
-            map[idx][elem_mapping2[idx]] = 1.0;
+            builder.add(idx, elem_mapping2[idx], 1.0);
           }
 
-          mapping = SparseRowMatrixFromMap::make(m, n, map);
+          mapping = builder.build();
         }
       }
       else if (ofield->basis_order() == 1)
       {
         if (num_nodes > 0 && num_onodes > 0)
         {
-          SparseRowMatrixFromMap::Values map;
-
           n =   num_nodes;
           m =   num_onodes;
 
+          SparseRowMatrixTripletBuilder builder(m, n);
+          builder.reserve(m);
           for (index_type idx=0;idx<m;idx++)
           {
-            map[idx][node_mapping2[idx]] = 1.0;
+            builder.add(idx, node_mapping2[idx], 1.0);
           }
 
-          mapping = SparseRowMatrixFromMap::make(m, n, map);
+          mapping = builder.build();
         }
       }
       // provide an empty matrix
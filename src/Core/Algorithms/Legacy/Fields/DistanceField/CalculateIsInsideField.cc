@@ -33,12 +33,19 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/GeometryPrimitives/Transform.h>
+#include <Core/Thread/Parallel.h>
+#include <boost/scoped_ptr.hpp>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields, SamplingScheme);
 ALGORITHM_PARAMETER_DEF(Fields, InsideFieldValue);
@@ -46,6 +53,286 @@ ALGORITHM_PARAMETER_DEF(Fields, OutsideFieldValue);
 ALGORITHM_PARAMETER_DEF(Fields, FieldOutputType);
 ALGORITHM_PARAMETER_DEF(Fields, CalcInsideMethod);
 
+namespace detail
+{
+
+/// Point-in-volume test against a closed surface: a point is inside when a
+/// ray from it crosses the surface an odd number of times. The faces are
+/// split into triangles and kept in a bounding volume hierarchy, so a ray
+/// only tests the triangles along its way.
+class SurfaceParityTest
+{
+  public:
+    explicit SurfaceParityTest(VMesh* mesh);
+
+    /// Sorted line parameters t at which origin + t*dir crosses the surface.
+    /// A line through an edge or vertex is counted by exactly one of the
+    /// triangles sharing it, so the parity does not depend on rounding.
+    void crossings(const Point& origin, const Vector& dir, std::vector<double>& t) const;
+
+    /// Number of crossings past the point at parameter s. Crossings at s
+    /// itself count as behind it, as if the point were moved slightly along
+    /// the line, so points on the surface are classified consistently.
+    static size_t crossings_beyond(const std::vector<double>& t, double s);
+
+    bool is_inside(const Point& p) const;
+
+  private:
+    struct Box
+    {
+      double lo[3], hi[3];
+    };
+
+    struct Node
+    {
+      Box box;
+      int left, right;    // children, when count == 0
+      int start, count;   // range in order_ for leaves
+    };
+
+    int build(int start, int end);
+    bool hits(const Box& box, const double* o, const double* d) const;
+
+    std::vector<Point> vertices_;   // three per triangle
+    std::vector<Point> centers_;
+    std::vector<int> order_;
+    std::vector<Node> nodes_;
+};
+
+SurfaceParityTest::SurfaceParityTest(VMesh* mesh)
+{
+  VMesh::Node::array_type nodes;
+  VMesh::size_type num_elems = mesh->num_elems();
+  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  {
+    mesh->get_nodes(nodes,idx);
+    Point p0;
+    mesh->get_center(p0,nodes[0]);
+    // Fan triangulation, for quadrilateral surfaces
+    for (size_t q=2; q<nodes.size(); q++)
+    {
+      Point p1, p2;
+      mesh->get_center(p1,nodes[q-1]);
+      mesh->get_center(p2,nodes[q]);
+      vertices_.push_back(p0);
+      vertices_.push_back(p1);
+      vertices_.push_back(p2);
+      centers_.push_back(Point((Vector(p0)+Vector(p1)+Vector(p2))/3.0));
+    }
+  }
+
+  order_.resize(centers_.size());
+  for (size_t j=0; j<order_.size(); j++) order_[j] = static_cast<int>(j);
+  if (!order_.empty()) build(0,static_cast<int>(order_.size()));
+}
+
+int
+SurfaceParityTest::build(int start, int end)
+{
+  Node node;
+  for (int a=0; a<3; a++)
+  {
+    node.box.lo[a] = std::numeric_limits<double>::max();
+    node.box.hi[a] = -std::numeric_limits<double>::max();
+  }
+
+  Box centers = node.box;
+  for (int j=start; j<end; j++)
+  {
+    for (int v=0; v<3; v++)
+    {
+      const Point& p = vertices_[3*order_[j]+v];
+      for (int a=0; a<3; a++)
+      {
+        node.box.lo[a] = std::min(node.box.lo[a],p[a]);
+        node.box.hi[a] = std::max(node.box.hi[a],p[a]);
+      }
+    }
+    const Point& c = centers_[order_[j]];
+    for (int a=0; a<3; a++)
+    {
+      centers.lo[a] = std::min(centers.lo[a],c[a]);
+      centers.hi[a] = std::max(centers.hi[a],c[a]);
+    }
+  }
+
+  // Pad the box so that rounding in the slab test never drops a triangle
+  // the line only touches at an edge
+  for (int a=0; a<3; a++)
+  {
+    const double pad = 1e-9*(1.0 + std::max(std::abs(node.box.lo[a]),std::abs(node.box.hi[a])));
+    node.box.lo[a] -= pad;
+    node.box.hi[a] += pad;
+  }
+
+  const int index = static_cast<int>(nodes_.size());
+  nodes_.push_back(node);
+
+  if (end - start <= 4)
+  {
+    nodes_[index].start = start;
+    nodes_[index].count = end - start;
+    return (index);
+  }
+
+  // Split at the median center along the widest axis
+  int axis = 0;
+  for (int a=1; a<3; a++)
+  {
+    if (centers.hi[a]-centers.lo[a] > centers.hi[axis]-centers.lo[axis]) axis = a;
+  }
+
+  const int mid = (start + end)/2;
+  std::nth_element(order_.begin()+start,order_.begin()+mid,order_.begin()+end,
+    [this,axis](int a, int b) { return (centers_[a][axis] < centers_[b][axis]); });
+
+  const int left = build(start,mid);
+  const int right = build(mid,end);
+  nodes_[index].left = left;
+  nodes_[index].right = right;
+  nodes_[index].start = 0;
+  nodes_[index].count = 0;
+  return (index);
+}
+
+bool
+SurfaceParityTest::hits(const Box& box, const double* o, const double* d) const
+{
+  double tmin = -std::numeric_limits<double>::max();
+  double tmax = std::numeric_limits<double>::max();
+  for (int a=0; a<3; a++)
+  {
+    if (d[a] == 0.0)
+    {
+      if (o[a] < box.lo[a] || o[a] > box.hi[a]) return (false);
+      continue;
+    }
+    double t1 = (box.lo[a]-o[a])/d[a];
+    double t2 = (box.hi[a]-o[a])/d[a];
+    if (t1 > t2) std::swap(t1,t2);
+    tmin = std::max(tmin,t1);
+    tmax = std::min(tmax,t2);
+    if (tmin > tmax) return (false);
+  }
+  return (true);
+}
+
+void
+SurfaceParityTest::crossings(const Point& origin, const Vector& dir, std::vector<double>& t) const
+{
+  t.clear();
+  if (nodes_.empty()) return;
+
+  const double o[3] = { origin.x(), origin.y(), origin.z() };
+  const double d[3] = { dir.x(), dir.y(), dir.z() };
+
+  // Watertight test: the vertices are sheared into a frame where the line
+  // runs along kz and passes through the origin of the (kx,ky) plane. A
+  // vertex gets the same projected coordinates in every triangle it
+  // belongs to, so the edge tests of neighboring triangles agree exactly.
+  int kz = 0;
+  for (int a=1; a<3; a++)
+  {
+    if (std::abs(d[a]) > std::abs(d[kz])) kz = a;
+  }
+  if (d[kz] == 0.0) return;
+  const int kx = (kz+1)%3;
+  const int ky = (kx+1)%3;
+  const double sx = d[kx]/d[kz];
+  const double sy = d[ky]/d[kz];
+
+  struct Projected { double x, y, z; };
+  auto project = [&](const Point& p)
+  {
+    const double a[3] = { p.x()-o[0], p.y()-o[1], p.z()-o[2] };
+    Projected q = { a[kx]-sx*a[kz], a[ky]-sy*a[kz], a[kz] };
+    return (q);
+  };
+
+  // Side of the line relative to the edge a->b. Comparing the rounded
+  // products makes the result for b->a exactly the opposite.
+  auto side = [](const Projected& a, const Projected& b)
+  {
+    const double l = a.x*b.y;
+    const double r = a.y*b.x;
+    return ((l > r) - (l < r));
+  };
+
+  // A line through an edge belongs to the triangle that has it on its left
+  // (in counterclockwise order) when the edge points up, or left when it is
+  // horizontal. The neighbor sees the edge reversed and does not own it.
+  auto owns = [](const Projected& a, const Projected& b, int orientation)
+  {
+    const double ex = (b.x-a.x)*orientation;
+    const double ey = (b.y-a.y)*orientation;
+    return (ey > 0.0 || (ey == 0.0 && ex < 0.0));
+  };
+
+  std::vector<int> stack(1,0);
+  while (!stack.empty())
+  {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+    if (!hits(node.box,o,d)) continue;
+
+    if (node.count == 0)
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+      continue;
+    }
+
+    for (int j=node.start; j<node.start+node.count; j++)
+    {
+      const Projected p0 = project(vertices_[3*order_[j]]);
+      const Projected p1 = project(vertices_[3*order_[j]+1]);
+      const Projected p2 = project(vertices_[3*order_[j]+2]);
+
+      // sides[e] is the side of the edge opposite vertex e
+      const int sides[3] = { side(p1,p2), side(p2,p0), side(p0,p1) };
+      const bool pos = sides[0] > 0 || sides[1] > 0 || sides[2] > 0;
+      const bool neg = sides[0] < 0 || sides[1] < 0 || sides[2] < 0;
+      // Outside, or a triangle seen edge on
+      if (pos == neg) continue;
+      const int orientation = pos ? 1 : -1;
+
+      if ((sides[0] == 0 && !owns(p1,p2,orientation)) ||
+          (sides[1] == 0 && !owns(p2,p0,orientation)) ||
+          (sides[2] == 0 && !owns(p0,p1,orientation))) continue;
+
+      const double u = p1.x*p2.y - p1.y*p2.x;
+      const double v = p2.x*p0.y - p2.y*p0.x;
+      const double w = p0.x*p1.y - p0.y*p1.x;
+      const double det = u + v + w;
+      if (det == 0.0) continue;
+      t.push_back((u*p0.z + v*p1.z + w*p2.z)/(det*d[kz]));
+    }
+  }
+
+  std::sort(t.begin(),t.end());
+}
+
+size_t
+SurfaceParityTest::crossings_beyond(const std::vector<double>& t, double s)
+{
+  const double tolerance = 1e-9*(1.0 + std::abs(s));
+  return (t.end() - std::upper_bound(t.begin(),t.end(),s + tolerance));
+}
+
+bool
+SurfaceParityTest::is_inside(const Point& p) const
+{
+  // An oblique direction, so rays rarely run along the faces of axis aligned
+  // surfaces
+  static const Vector dir(0.5964, 0.5309, 0.6019);
+
+  std::vector<double> t;
+  crossings(p,dir,t);
+  return ((crossings_beyond(t,0.0) % 2) == 1);
+}
+
+}
+
 CalculateIsInsideFieldAlgo::CalculateIsInsideFieldAlgo()
 {
   // How many samples inside the elements to test for being inside the
@@ -126,14 +413,19 @@ CalculateIsInsideFieldAlgo::runImpl(FieldHandle input, FieldHandle objfield, Fie
 
   ofield->set_all_values(outside_value);
 
-  objmesh->synchronize(Mesh::ELEM_LOCATE_E);
+  // A surface encloses a volume, but has no elements to locate a point in:
+  // classify by ray parity instead.
+  boost::scoped_ptr<detail::SurfaceParityTest> surface;
+  if (objmesh->is_surface())
+  {
+    surface.reset(new detail::SurfaceParityTest(objmesh));
+  }
+  else
+  {
+    objmesh->synchronize(Mesh::ELEM_LOCATE_E);
+  }
 
   VMesh::size_type num_elems = omesh->num_elems();
-  VMesh::Node::array_type nodes;
-  VMesh::Elem::index_type cidx;
-
-  std::vector<Point> points;
-  std::vector<Point> points2;
 
   std::vector<VMesh::coords_type> coords;
   std::vector<double> weights;
@@ -147,92 +439,117 @@ CalculateIsInsideFieldAlgo::runImpl(FieldHandle input, FieldHandle objfield, Fie
 
   std::string method = getOption(Parameters::CalcInsideMethod);
 
-  if (method == "one")
+  // Whether an element with the given number of inside samples is inside
+  auto decide = [&method](int inside, int total)
   {
-    for(VMesh::Elem::index_type idx=0; idx<num_elems;idx++)
-    {
-      omesh->get_nodes(nodes,idx);
-      omesh->get_centers(points,nodes);
-      omesh->minterpolate(points2,coords,idx);
-
-      bool is_inside = false;
+    if (method == "one") return (inside > 0);
+    if (method == "all") return (inside == total);
+    return (inside >= total - inside);
+  };
 
-      for (size_t r=0; r< points2.size(); r++)
-      {
-        if (objmesh->locate(cidx,points2[r]))
-        {
-          is_inside = true; break;
-        }
-      }
-
-      if (!is_inside)
-      {
-        for (size_t r=0; r< points.size(); r++)
-        {
-          if (objmesh->locate(cidx,points[r]))
-          {
-            is_inside = true; break;
-          }
-        }
-      }
+  std::vector<char> is_inside(num_elems, 0);
+  const int np = Parallel::NumCores();
 
-      if (is_inside) ofield->set_value(inside_value,idx);
-    }
-  }
-  else if (method == "all")
+  if (surface && omesh->is_latvolmesh())
   {
-    for(VMesh::Elem::index_type idx=0; idx<num_elems;idx++)
+    // Scan-convert along the lattice rows: every sample of every element in a
+    // row lies on one of a few lines along x, so one ray per line classifies
+    // the whole row.
+    VMesh::dimension_type dims;
+    omesh->get_dimensions(dims);
+    const VMesh::index_type ni = dims[0]-1, nj = dims[1]-1, nk = dims[2]-1;
+
+    Transform tf = omesh->get_transform();
+    const Vector row_dir = tf.project(Vector(1.0,0.0,0.0));
+
+    // Local coordinates of all samples: the element nodes, then the interior
+    // points
+    std::vector<VMesh::coords_type> samples;
+    for (int c=0; c<8; c++)
     {
-      omesh->get_nodes(nodes,idx);
-      omesh->get_centers(points,nodes);
-      omesh->minterpolate(points2,coords,idx);
+      VMesh::coords_type corner;
+      corner.resize(3);
+      corner[0] = (c & 1) ? 1.0 : 0.0;
+      corner[1] = (c & 2) ? 1.0 : 0.0;
+      corner[2] = (c & 4) ? 1.0 : 0.0;
+      samples.push_back(corner);
+    }
+    samples.insert(samples.end(),coords.begin(),coords.end());
 
-      bool is_inside = true;
+    std::vector<std::pair<double,double> > lines;
+    std::vector<size_t> sample_line(samples.size());
+    for (size_t r=0; r<samples.size(); r++)
+    {
+      std::pair<double,double> line(samples[r][1],samples[r][2]);
+      sample_line[r] = std::find(lines.begin(),lines.end(),line) - lines.begin();
+      if (sample_line[r] == lines.size()) lines.push_back(line);
+    }
 
-      for (size_t r=0; r< points2.size(); r++)
+    const VMesh::index_type num_rows = nj*nk;
+    auto task = [&](int proc)
+    {
+      const VMesh::index_type begin = num_rows * proc / np;
+      const VMesh::index_type end = num_rows * (proc + 1) / np;
+      std::vector<std::vector<double> > crossings(lines.size());
+
+      for (VMesh::index_type row=begin; row<end; row++)
       {
-        if (!(objmesh->locate(cidx,points2[r])))
+        const VMesh::index_type j = row % nj;
+        const VMesh::index_type k = row / nj;
+
+        for (size_t l=0; l<lines.size(); l++)
         {
-          is_inside = false; break;
+          Point origin = tf.project(Point(0.0,j+lines[l].first,k+lines[l].second));
+          surface->crossings(origin,row_dir,crossings[l]);
         }
-      }
 
-      if (is_inside)
-      {
-        for (size_t r=0; r< points.size(); r++)
+        for (VMesh::index_type i=0; i<ni; i++)
         {
-          if (!(objmesh->locate(cidx,points[r])))
+          int inside = 0;
+          for (size_t r=0; r<samples.size(); r++)
           {
-            is_inside = false; break;
+            const std::vector<double>& t = crossings[sample_line[r]];
+            if (detail::SurfaceParityTest::crossings_beyond(t,i+samples[r][0]) % 2) inside++;
           }
+          is_inside[i+ni*row] = decide(inside,static_cast<int>(samples.size()));
         }
       }
-
-      if (is_inside) ofield->set_value(inside_value,idx);
-    }
+    };
+    Parallel::RunTasks(task,np);
   }
   else
   {
-    for(VMesh::Elem::index_type idx=0; idx<num_elems;idx++)
+    auto task = [&](int proc)
     {
-      omesh->get_nodes(nodes,idx);
-      omesh->get_centers(points,nodes);
-      omesh->minterpolate(points2,coords,idx);
+      const VMesh::index_type begin = num_elems * proc / np;
+      const VMesh::index_type end = num_elems * (proc + 1) / np;
 
-      int outside = 0;
-      int inside = 0;
-      for (size_t r=0; r< points2.size(); r++)
-      {
-        if (objmesh->locate(cidx,points2[r])) inside++; else outside++;
-      }
+      VMesh::Node::array_type nodes;
+      VMesh::Elem::index_type cidx;
+      std::vector<Point> points;
+      std::vector<Point> points2;
 
-      for (size_t r=0; r< points.size(); r++)
+      for (VMesh::Elem::index_type idx=begin; idx<end; idx++)
       {
-        if (objmesh->locate(cidx,points[r])) inside++; else outside++;
+        omesh->get_nodes(nodes,idx);
+        omesh->get_centers(points,nodes);
+        omesh->minterpolate(points2,coords,idx);
+        points.insert(points.end(),points2.begin(),points2.end());
+
+        int inside = 0;
+        for (size_t r=0; r<points.size(); r++)
+        {
+          if (surface ? surface->is_inside(points[r]) : objmesh->locate(cidx,points[r])) inside++;
+        }
+        is_inside[idx] = decide(inside,static_cast<int>(points.size()));
       }
+    };
+    Parallel::RunTasks(task,np);
+  }
 
-      if (inside >= outside) ofield->set_value(inside_value,idx);
-    }
+  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  {
+    if (is_inside[idx]) ofield->set_value(inside_value,idx);
   }
 
   return (true);
@@ -32,7 +32,13 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/LabelConnectedRegions.h>
+#include <Core/Thread/Parallel.h>
+#include <boost/scoped_array.hpp>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <set>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms::Fields;
@@ -40,6 +46,7 @@ using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmParameterName SplitFieldByDomainAlgo::SortAscending("SortAscending");
 AlgorithmParameterName SplitFieldByDomainAlgo::SortBySize("SortBySize");
@@ -80,6 +87,100 @@ class AscSortSizes : public std::binary_function<index_type,index_type,bool>
   private:
     const std::vector<double>& sizes_;
 };
+
+  /// Calls task(proc, begin, end) over contiguous ranges of [0, size); small
+  /// ranges stay on the calling thread
+  template <class Task>
+  void runRanges(size_type size, Task task)
+  {
+    const int np = static_cast<int>(std::max<size_type>(1,
+      std::min<size_type>(Parallel::NumCores(), size / 10000)));
+    auto range = [&](int proc) { task(proc, size * proc / np, size * (proc + 1) / np); };
+    if (np == 1)
+      range(0);
+    else
+      Parallel::RunTasks(range, np);
+  }
+
+  const index_type unseen = std::numeric_limits<index_type>::max();
+
+  /// Copies the elements elems[0..num_elems) of mesh into omesh. Nodes are
+  /// numbered in the order in which they first appear on these elements, as
+  /// in a serial sweep. first holds the first slot of every input node and
+  /// must be all unseen; it is left that way on return.
+  void extractDomain(VMesh* mesh, const index_type* elems, size_type num_elems,
+    std::atomic<index_type>* first, VMesh* omesh)
+  {
+    const size_type per_elem = static_cast<size_type>(mesh->num_nodes_per_elem());
+    const size_type num_slots = num_elems * per_elem;
+
+    std::vector<index_type> slots(num_slots);
+    runRanges(num_elems, [&](int, index_type begin, index_type end)
+    {
+      VMesh::Node::array_type nodes;
+      for (index_type i = begin; i < end; ++i)
+      {
+        mesh->get_nodes(nodes, VMesh::Elem::index_type(elems[i]));
+        for (size_type p = 0; p < per_elem; p++)
+        {
+          const index_type q = i * per_elem + p;
+          slots[q] = nodes[p];
+          std::atomic<index_type>& f = first[nodes[p]];
+          index_type current = f.load();
+          while (q < current && !f.compare_exchange_weak(current, q)) {}
+        }
+      }
+    });
+
+    // Number the first appearances with a prefix sum over the slots
+    std::vector<size_type> count(Parallel::NumCores() + 1, 0);
+    runRanges(num_slots, [&](int proc, index_type begin, index_type end)
+    {
+      size_type c = 0;
+      for (index_type q = begin; q < end; ++q)
+        if (first[slots[q]] == q) c++;
+      count[proc + 1] = c;
+    });
+    for (size_t proc = 1; proc < count.size(); proc++) count[proc] += count[proc - 1];
+
+    std::vector<index_type> nodes(count.back());
+    std::vector<index_type> rank(num_slots);
+    runRanges(num_slots, [&](int proc, index_type begin, index_type end)
+    {
+      index_type next = count[proc];
+      for (index_type q = begin; q < end; ++q)
+      {
+        if (first[slots[q]] == q)
+        {
+          nodes[next] = slots[q];
+          rank[q] = next++;
+        }
+      }
+    });
+    runRanges(num_slots, [&](int, index_type begin, index_type end)
+    {
+      for (index_type q = begin; q < end; ++q) slots[q] = rank[first[slots[q]]];
+    });
+
+    const size_type num_nodes = static_cast<size_type>(nodes.size());
+    omesh->resize_nodes(num_nodes);
+    Point* points = omesh->get_points_pointer();
+    runRanges(num_nodes, [&](int, index_type begin, index_type end)
+    {
+      for (index_type j = begin; j < end; ++j)
+      {
+        mesh->get_center(points[j], VMesh::Node::index_type(nodes[j]));
+        first[nodes[j]] = unseen;
+      }
+    });
+
+    // The elements of a point cloud are its nodes, there is no connectivity
+    if (omesh->is_pointcloudmesh()) return;
+
+    omesh->resize_elems(num_elems);
+    if (num_slots > 0)
+      std::copy(slots.begin(), slots.end(), omesh->get_elems_pointer());
+  }
 }
 
 
@@ -119,30 +220,43 @@ SplitFieldByDomainAlgo::runImpl(FieldHandle input, FieldList& output) const
     return (false);
   }
 
-  VMesh::Elem::iterator bei, eei;
-  VMesh::Node::iterator bni, eni;
-  
   VMesh::size_type num_elems = mesh->num_elems();
   VMesh::size_type num_nodes = mesh->num_nodes();
 
-
-  std::vector<VMesh::Node::index_type> idxarray(num_nodes);
-  std::vector<bool> newidxarray(num_nodes);
-  VMesh::Node::array_type nodes;
-  VMesh::Node::array_type newnodes;
-  VMesh::Node::index_type node;
-    
   std::vector<int> labels;
   field->get_values(labels);
-  
-  int flabel = 0;
-  if (labels.size()) flabel = labels[0];
-  for (size_t j=0; j<labels.size();j++) { if (labels[j] < flabel) flabel = labels[j]; }
 
-  index_type k = 0;
-  
-  int cnt = 0;
-  while (true)
+  /// Domains in ascending label order. Labels come in long runs, so every
+  /// range only records where the label changes.
+  std::vector<std::set<int> > rangelabels(Parallel::NumCores());
+  runRanges(num_elems, [&](int proc, index_type begin, index_type end)
+  {
+    for (index_type idx = begin; idx < end; ++idx)
+      if (idx == begin || labels[idx] != labels[idx-1]) rangelabels[proc].insert(labels[idx]);
+  });
+  std::set<int> alllabels;
+  for (size_t p = 0; p < rangelabels.size(); p++) alllabels.insert(rangelabels[p].begin(), rangelabels[p].end());
+  std::vector<int> domainlabels(alllabels.begin(), alllabels.end());
+  if (domainlabels.empty()) domainlabels.push_back(0);
+
+  std::vector<index_type> domains(num_elems);
+  runRanges(num_elems, [&](int, index_type begin, index_type end)
+  {
+    for (index_type idx = begin; idx < end; ++idx)
+      domains[idx] = std::lower_bound(domainlabels.begin(), domainlabels.end(), labels[idx]) - domainlabels.begin();
+  });
+
+  std::vector<index_type> offsets, elems;
+  const size_type num_domains = static_cast<size_type>(domainlabels.size());
+  groupByRegion(domains, num_domains, offsets, elems);
+
+  boost::scoped_array<std::atomic<index_type> > first(new std::atomic<index_type>[num_nodes]);
+  runRanges(num_nodes, [&](int, index_type begin, index_type end)
+  {
+    for (index_type idx = begin; idx < end; ++idx) first[idx] = unseen;
+  });
+
+  for (index_type d = 0; d < num_domains; d++)
   {
     FieldHandle output_field = CreateField(fo);
     
@@ -162,56 +276,13 @@ SplitFieldByDomainAlgo::runImpl(FieldHandle input, FieldList& output) const
       output.clear();
       return(false); 
     }
-    
-    for (size_type p =0; p<num_nodes; p++) newidxarray[p] = true;
 
-    for (VMesh::Elem::index_type idx=0; idx< num_elems; idx++)
-    {
-      if (labels[idx] == flabel)
-      {
-        mesh->get_nodes(nodes,idx);
-        newnodes.resize(nodes.size());
-        for (size_t p=0; p< nodes.size(); p++)
-        {
-          node = nodes[p];
-          if (newidxarray[node])
-          {
-            Point pt;
-            mesh->get_center(pt,nodes[p]);
-            idxarray[node] = omesh->add_point(pt);
-            newidxarray[node] = false;
-          }
-          newnodes[p] = idxarray[node];
-        }
-        omesh->add_elem(newnodes);
-        cnt++; 
-        if (cnt == 400) 
-        { 
-          cnt = 0; 
-          update_progress_max(k,num_elems); 
-        }   
-        k++;
-      }
-    }
+    extractDomain(mesh, elems.data() + offsets[d], offsets[d+1] - offsets[d], first.get(), omesh);
 
     ofield->resize_values();
-    ofield->set_all_values(flabel);
+    ofield->set_all_values(domainlabels[d]);
     output.push_back(output_field);
-
-    int elabel = 0;
-    bool found = false;
-    
-    for (VMesh::index_type lidx = 0; lidx < num_elems; lidx++)
-    {
-      if (labels[lidx] > flabel)
-      {
-        if (!found) { elabel = labels[lidx]; found = true;}
-        if (labels[lidx] < elabel) elabel = labels[lidx]; 
-      }
-    }
-    // check whether we are done
-    if (!found) break;
-    flabel = elabel;    
+    update_progress_max(d+1, num_domains);
   }
   
   
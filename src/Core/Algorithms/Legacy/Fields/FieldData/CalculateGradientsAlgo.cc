@@ -89,15 +89,18 @@ CalculateGradientsAlgo::run(FieldHandle input, FieldHandle& output) const
   if ((num_fielddata != num_nodes) && (num_fielddata != num_elems))
     THROW_ALGORITHM_INPUT_ERROR("Input data inconsistent");
 
+  /// The output was created with Vector data, so write it in place
+  Vector* gradients = ofield->get_values_pointer_as<Vector>();
+  if (!gradients)
+    THROW_ALGORITHM_PROCESSING_ERROR("Could not access output vector data");
+
   int cnt = 0;
   StackVector<double, 3> grad;
   for (VMesh::Elem::index_type idx = 0; idx < num_elems; ++idx)
   {
-    ifield->gradient(grad, coords, idx); /** Segmentation Fault Here **/
-
-    Vector v(grad[0], grad[1], grad[2]);
+    ifield->gradient(grad, coords, idx);
 
-    ofield->set_value(v, idx);
+    gradients[idx] = Vector(grad[0], grad[1], grad[2]);
 
     cnt++;
     if (cnt == 400)
@@ -0,0 +1,336 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Legacy/Fields/FilterFieldData/FieldDataMorphology.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+ALGORITHM_PARAMETER_DEF(Fields, MorphologyIterations);
+
+namespace
+{
+  struct Larger
+  {
+    template <class T> T operator()(T a, T b) const { return (a < b ? b : a); }
+  };
+
+  struct Smaller
+  {
+    template <class T> T operator()(T a, T b) const { return (b < a ? b : a); }
+  };
+
+  /// Calls task(begin, end) over contiguous ranges of [0, size); small
+  /// ranges stay on the calling thread
+  template <class Task>
+  void runRanges(size_type size, Task task)
+  {
+    const int np = static_cast<int>(std::max<size_type>(1,
+      std::min<size_type>(Parallel::NumCores(), size / 10000)));
+    auto range = [&](int proc) { task(size * proc / np, size * (proc + 1) / np); };
+    if (np == 1)
+      range(0);
+    else
+      Parallel::RunTasks(range, np);
+  }
+
+  /// Where the values of a field sit relative to each other. A lattice is
+  /// stored with i running fastest and compares with the six axis
+  /// neighbors; any other mesh keeps the neighbors of every value in
+  /// compressed rows, so the sweeps do not go through the mesh.
+  struct Neighborhood
+  {
+    size_type size;
+    bool lattice;
+    VMesh::dimension_type dims;
+    std::vector<index_type> offsets;
+    std::vector<index_type> neighbors;
+  };
+
+  template <class ARRAY, class INDEX>
+  void compressNeighbors(VMesh* mesh, Neighborhood& hood)
+  {
+    const size_type size = hood.size;
+    hood.offsets.assign(size + 1, 0);
+    runRanges(size, [&](index_type begin, index_type end)
+    {
+      ARRAY nbrs;
+      for (index_type idx = begin; idx < end; ++idx)
+      {
+        mesh->get_neighbors(nbrs, INDEX(idx));
+        hood.offsets[idx + 1] = static_cast<index_type>(nbrs.size());
+      }
+    });
+    for (index_type idx = 0; idx < size; ++idx) hood.offsets[idx + 1] += hood.offsets[idx];
+
+    hood.neighbors.resize(hood.offsets[size]);
+    runRanges(size, [&](index_type begin, index_type end)
+    {
+      ARRAY nbrs;
+      for (index_type idx = begin; idx < end; ++idx)
+      {
+        mesh->get_neighbors(nbrs, INDEX(idx));
+        std::copy(nbrs.begin(), nbrs.end(), hood.neighbors.begin() + hood.offsets[idx]);
+      }
+    });
+  }
+
+  /// One step over a lattice. The cross-shaped neighborhood is the union of
+  /// three line segments, so every row takes the extreme along i and then
+  /// merges the whole rows around it; all inner loops are branch free over
+  /// contiguous memory and vectorize.
+  template <class DATA, class OP>
+  void latticeStep(const VMesh::dimension_type& dims, const DATA* src, DATA* dst, OP op)
+  {
+    const size_type ni = dims[0];
+    const size_type nj = dims[1];
+    const size_type nk = dims[2];
+    const size_type nij = ni * nj;
+
+    runRanges(nj * nk, [&](index_type begin, index_type end)
+    {
+      for (index_type r = begin; r < end; ++r)
+      {
+        const index_type j = r % nj;
+        const index_type k = r / nj;
+        const DATA* row = src + r * ni;
+        DATA* out = dst + r * ni;
+
+        if (ni == 1)
+        {
+          out[0] = row[0];
+        }
+        else
+        {
+          out[0] = op(row[0], row[1]);
+          for (index_type i = 1; i < ni - 1; ++i) out[i] = op(op(row[i-1], row[i]), row[i+1]);
+          out[ni-1] = op(row[ni-2], row[ni-1]);
+        }
+
+        auto merge = [&](const DATA* other)
+        {
+          for (index_type i = 0; i < ni; ++i) out[i] = op(out[i], other[i]);
+        };
+        if (j > 0) merge(row - ni);
+        if (j < nj - 1) merge(row + ni);
+        if (k > 0) merge(row - nij);
+        if (k < nk - 1) merge(row + nij);
+      }
+    });
+  }
+
+  template <class DATA, class OP>
+  void meshStep(const Neighborhood& hood, const DATA* src, DATA* dst, OP op)
+  {
+    const index_type* offsets = &hood.offsets[0];
+    const index_type* neighbors = hood.neighbors.empty() ? 0 : &hood.neighbors[0];
+    runRanges(hood.size, [&](index_type begin, index_type end)
+    {
+      for (index_type idx = begin; idx < end; ++idx)
+      {
+        DATA val = src[idx];
+        for (index_type q = offsets[idx]; q < offsets[idx + 1]; ++q) val = op(val, src[neighbors[q]]);
+        dst[idx] = val;
+      }
+    });
+  }
+
+  template <class DATA, class OP>
+  void step(const Neighborhood& hood, const DATA* src, DATA* dst, OP op)
+  {
+    if (hood.lattice)
+      latticeStep(hood.dims, src, dst, op);
+    else
+      meshStep(hood, src, dst, op);
+  }
+
+  /// Runs the passes on data in place, swapping between data and a single
+  /// buffer
+  template <class DATA, class PROGRESS>
+  void filter(const Neighborhood& hood, void* values,
+    const std::vector<FieldDataMorphologyAlgo::Operation>& passes, int num_iter, PROGRESS progress)
+  {
+    DATA* data = static_cast<DATA*>(values);
+    std::vector<DATA> buffer(hood.size);
+    DATA* src = data;
+    DATA* dst = buffer.empty() ? 0 : &buffer[0];
+
+    const int num_steps = static_cast<int>(passes.size()) * num_iter;
+    for (int s = 0; s < num_steps; s++)
+    {
+      if (passes[s / num_iter] == FieldDataMorphologyAlgo::Dilate)
+        step(hood, src, dst, Larger());
+      else
+        step(hood, src, dst, Smaller());
+      std::swap(src, dst);
+      progress(s + 1, num_steps);
+    }
+
+    if (src != data)
+    {
+      runRanges(hood.size, [&](index_type begin, index_type end)
+      {
+        std::copy(src + begin, src + end, data + begin);
+      });
+    }
+  }
+}
+
+FieldDataMorphologyAlgo::FieldDataMorphologyAlgo(const std::string& name, const std::vector<Operation>& passes) :
+  name_(name), passes_(passes)
+{
+  addParameter(Parameters::MorphologyIterations, 2);
+}
+
+OpenFieldDataAlgo::OpenFieldDataAlgo() :
+  FieldDataMorphologyAlgo("OpenFieldData", { Erode, Dilate })
+{
+}
+
+CloseFieldDataAlgo::CloseFieldDataAlgo() :
+  FieldDataMorphologyAlgo("CloseFieldData", { Dilate, Erode })
+{
+}
+
+bool
+FieldDataMorphologyAlgo::runImpl(FieldHandle input, FieldHandle& output) const
+{
+  ScopedAlgorithmStatusReporter asr(this, name_);
+
+  if (!input)
+  {
+    error("No input field");
+    return (false);
+  }
+
+  FieldInformation fi(input);
+
+  if (fi.is_nonlinear())
+  {
+    error("This function has not yet been defined for non-linear elements");
+    return (false);
+  }
+
+  if (fi.is_nodata())
+  {
+    error("There is no data defined in the input field");
+    return (false);
+  }
+
+  if (!fi.is_scalar())
+  {
+    error("The field data is not scalar data");
+    return (false);
+  }
+
+  if (!fi.is_constantdata() && !fi.is_lineardata())
+  {
+    error("This function only works for data located at the nodes or the elements");
+    return (false);
+  }
+
+  /// Only the values change, so the mesh is shared with the input
+  output.reset(input->clone());
+  if (!output)
+  {
+    error("Could not allocate output field");
+    return (false);
+  }
+
+  VMesh* mesh = output->vmesh();
+  VField* field = output->vfield();
+
+  Neighborhood hood;
+  hood.size = field->num_values();
+  hood.lattice = fi.is_latvolmesh();
+  if (hood.lattice)
+  {
+    if (fi.is_constantdata())
+      mesh->get_elem_dimensions(hood.dims);
+    else
+      mesh->get_dimensions(hood.dims);
+  }
+  else if (fi.is_constantdata())
+  {
+    mesh->synchronize(Mesh::ELEM_NEIGHBORS_E);
+    compressNeighbors<VMesh::Elem::array_type, VMesh::Elem::index_type>(mesh, hood);
+  }
+  else
+  {
+    mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+    compressNeighbors<VMesh::Node::array_type, VMesh::Node::index_type>(mesh, hood);
+  }
+
+  const int num_iter = get(Parameters::MorphologyIterations).toInt();
+  if (num_iter < 1 || hood.size == 0) return (true);
+
+  auto progress = [this](int step, int total) { update_progress_max(step, total); };
+  void* values = field->fdata_pointer();
+
+  if (fi.is_char()) filter<char>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_unsigned_char()) filter<unsigned char>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_short()) filter<short>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_unsigned_short()) filter<unsigned short>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_int()) filter<int>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_unsigned_int()) filter<unsigned int>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_longlong()) filter<long long>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_unsigned_longlong()) filter<unsigned long long>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_float()) filter<float>(hood, values, passes_, num_iter, progress);
+  else if (fi.is_double()) filter<double>(hood, values, passes_, num_iter, progress);
+  else
+  {
+    error("The field data type is not supported");
+    return (false);
+  }
+
+  return (true);
+}
+
+AlgorithmOutput FieldDataMorphologyAlgo::run(const AlgorithmInput& input) const
+{
+  auto field = input.get<Field>(Variables::InputField);
+
+  FieldHandle outputField;
+  if (!runImpl(field, outputField))
+    THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
+
+  AlgorithmOutput output;
+  output[Variables::OutputField] = outputField;
+  return output;
+}
@@ -0,0 +1,79 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_FIELDDATAMORPHOLOGY_H
+#define CORE_ALGORITHMS_FIELDS_FILTERFIELDDATA_FIELDDATAMORPHOLOGY_H 1
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+        ALGORITHM_PARAMETER_DECL(MorphologyIterations);
+
+        /// Grey-value morphology on scalar field data. Node values are compared
+        /// with the nodes they share an edge with, element values with the
+        /// elements they share a face with. Every pass of the filter is
+        /// repeated MorphologyIterations times.
+        class SCISHARE FieldDataMorphologyAlgo : public AlgorithmBase
+        {
+        public:
+          enum Operation { Dilate, Erode };
+
+          bool runImpl(FieldHandle input, FieldHandle& output) const;
+
+          virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+
+        protected:
+          FieldDataMorphologyAlgo(const std::string& name, const std::vector<Operation>& passes);
+
+        private:
+          std::string name_;
+          std::vector<Operation> passes_;
+        };
+
+        /// Erosion followed by dilation: removes small bright features
+        class SCISHARE OpenFieldDataAlgo : public FieldDataMorphologyAlgo
+        {
+        public:
+          OpenFieldDataAlgo();
+        };
+
+        /// Dilation followed by erosion: fills small dark holes
+        class SCISHARE CloseFieldDataAlgo : public FieldDataMorphologyAlgo
+        {
+        public:
+          CloseFieldDataAlgo();
+        };
+
+      }}}}
+
+#endif
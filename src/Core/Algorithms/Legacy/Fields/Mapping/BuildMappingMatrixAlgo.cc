@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/Mapping/BuildMappingMatrixAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RegularGridInterpolator.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Thread/Parallel.h>
@@ -39,6 +40,8 @@
 #include <Core/Datatypes/SparseRowMatrixFromMap.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 
+#include <boost/scoped_ptr.hpp>
+
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms;
@@ -360,11 +363,17 @@ namespace detail
   {
   public:
     explicit BuildMappingMatrixInterpolatedDataPAlgo(int nproc) :
-        BuildMappingMatrixPAlgoBase("BuildMappingMatrixInterpolatedDataPAlgo Barrier", nproc), e_(0) {}
+        BuildMappingMatrixPAlgoBase("BuildMappingMatrixInterpolatedDataPAlgo Barrier", nproc), e_(0), regular_(0) {}
 
         void parallel(int proc);
 
         size_type e_;
+
+        // Direct kernel for sources on a regular grid, null otherwise
+        const RegularGridInterpolator* regular_;
+
+  private:
+        void parallel_regular(int proc, VField::index_type start, VField::index_type end);
   };
 
   void BuildMappingMatrixInterpolatedDataPAlgo::parallel(int proc)
@@ -380,7 +389,11 @@ namespace detail
 
     int cnt = 0;
 
-    if (dfield_->basis_order() == 0 && sfield_->basis_order() == 0)
+    if (regular_)
+    {
+      parallel_regular(proc,start,end);
+    }
+    else if (dfield_->basis_order() == 0 && sfield_->basis_order() == 0)
     {
       Point p, r;
       VMesh::Elem::index_type didx;
@@ -522,7 +535,68 @@ namespace detail
       }
     }
   }
-  
+
+  void BuildMappingMatrixInterpolatedDataPAlgo::parallel_regular(int proc, VField::index_type start, VField::index_type end)
+  {
+    index_type nodes[RegularGridInterpolator::MAX_STENCIL];
+    double weights[RegularGridInterpolator::MAX_STENCIL];
+    size_type sz;
+
+    Point p, r;
+    VMesh::coords_type coords;
+    VMesh::Elem::index_type didx;
+    VMesh::ElemInterpolate interp;
+
+    int cnt = 0;
+    for (VMesh::index_type idx=start; idx<end; idx++)
+    {
+      index_type* cc = cc_ + idx*e_;
+      double* vv = vv_ + idx*e_;
+
+      for (index_type j=0;j<e_;j++)
+      {
+        cc[j] = -1;
+        vv[j] = 0.0;
+      }
+
+      if (regular_->get_stencil(idx,nodes,weights,sz))
+      {
+        for (index_type j=0;j<sz && j<e_;j++)
+        {
+          cc[j] = nodes[j];
+          vv[j] = weights[j];
+        }
+      }
+      else
+      {
+        // Outside of the grid: use the closest element as before
+        if (dfield_->basis_order() == 0) dmesh_->get_center(p,VMesh::Elem::index_type(idx));
+        else dmesh_->get_center(p,VMesh::Node::index_type(idx));
+
+        double dist;
+        if (smesh_->find_closest_elem(dist,r,coords,didx,p) &&
+            (maxdist_ < 0.0 || dist < maxdist_))
+        {
+          if (sfield_->basis_order() == 0)
+          {
+            cc[0] = didx;
+            vv[0] = 1.0;
+          }
+          else
+          {
+            smesh_->get_interpolate_weights(coords,didx,interp,1);
+            for (index_type j=0;j<e_;j++)
+            {
+              cc[j] = interp.node_index[j];
+              vv[j] = interp.weights[j];
+            }
+          }
+        }
+      }
+      if (proc == 0) { cnt++; if (cnt == 4096) {cnt = 0; algo_->update_progress_max(idx,end); } }
+    }
+  }
+
 }
 
 bool BuildMappingMatrixAlgo::runImpl(FieldHandle source, FieldHandle destination, MatrixHandle& output) const
@@ -653,7 +727,17 @@ bool BuildMappingMatrixAlgo::runImpl(FieldHandle source, FieldHandle destination
   }
   else if (method == "interpolateddata")
   { 
+    // Sources on a LatVol mesh get their weights from a direct
+    // kernel, which is separable when the destination is an aligned regular grid
+    boost::scoped_ptr<RegularGridInterpolator> regular;
+    if (maxdist != 0.0 && RegularGridInterpolator::is_supported(sfield))
+    {
+      regular.reset(new RegularGridInterpolator(sfield));
+      regular->set_destination(dfield);
+    }
+
     detail::BuildMappingMatrixInterpolatedDataPAlgo algo(np);
+    algo.regular_ = regular.get();
     algo.sfield_ = sfield;
     algo.dfield_ = dfield;
     algo.smesh_ = smesh;
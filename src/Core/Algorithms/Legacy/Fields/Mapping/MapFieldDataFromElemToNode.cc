@@ -38,6 +38,7 @@ TODO: Nrrd aoutput
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <algorithm>
 
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
@@ -64,159 +65,111 @@ bool
 
   VMesh* mesh = input->vmesh();
 
-  VMesh::Elem::array_type elems;
-  VMesh::Node::iterator it, eit;
-  VMesh::Node::size_type sz;
-
-  mesh->synchronize(SCIRun::Mesh::NODE_NEIGHBORS_E);
-
-  mesh->begin(it);
-  mesh->end(eit);
-
-  mesh->size(sz);
-
-  index_type cnt = 0, c = 0;
+  const VMesh::size_type num_nodes = mesh->num_nodes();
+  const VMesh::size_type num_elems = mesh->num_elems();
+  const VMesh::size_type nodes_per_elem = mesh->num_nodes_per_elem();
 
   if (method == "Interpolation")
   {
     algo->remark("Interpolation of piecewise constant data is done by averaging adjoining values");
   }
 
-  if ((method == "Interpolation") || (method == "Average"))
+  if (method != "Interpolation" && method != "Average" && method != "Max" &&
+      method != "Min" && method != "Sum" && method != "Median")
+  {
+    algo->remark("Method is not implemented!");
+    return false;
+  }
+
+  /// Pull element values and connectivity in bulk, then invert the
+  /// connectivity into a node-to-element table. Elements are visited in
+  /// index order, matching the order of the mesh's node neighbor lists.
+  std::vector<DATA> elem_values;
+  ifield->get_values(elem_values);
+
+  std::vector<VMesh::index_type> connectivity(num_elems*nodes_per_elem);
+  if (!connectivity.empty())
+    mesh->get_elem_nodes(&connectivity[0], VMesh::Elem::index_type(0), VMesh::Elem::size_type(num_elems));
+
+  std::vector<VMesh::index_type> offsets(num_nodes + 1, 0);
+  for (size_t k = 0; k < connectivity.size(); k++)
+    offsets[connectivity[k] + 1]++;
+  for (VMesh::index_type n = 0; n < num_nodes; n++)
+    offsets[n + 1] += offsets[n];
+
+  /// ends[n] marks the filled part of node n's slot; degenerate elements that
+  /// list a node twice are only counted once, leaving the slot partly unused.
+  std::vector<VMesh::index_type> node_elems(connectivity.size());
+  std::vector<VMesh::index_type> ends(offsets.begin(), offsets.end() - 1);
+  for (VMesh::index_type e = 0; e < num_elems; e++)
   {
-    while (it != eit)
+    const VMesh::index_type* enodes = &connectivity[e*nodes_per_elem];
+    for (VMesh::index_type k = 0; k < nodes_per_elem; k++)
     {
-      Interruptible::checkForInterruption();
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
-      DATA val(0);
-      DATA tval;
-      for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval, elems[p]);
-        val += tval;
-      }
-      val = static_cast<DATA>(val*(1.0 / static_cast<double>(nsize)));
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
-      }
+      if (std::find(enodes, enodes + k, enodes[k]) == enodes + k)
+        node_elems[ends[enodes[k]]++] = e;
     }
   }
-  else if (method == "Max")
+
+  std::vector<DATA> node_values(num_nodes);
+  std::vector<DATA> valarray;
+
+  for (VMesh::index_type n = 0; n < num_nodes; n++)
   {
-    while (it != eit)
+    if ((n & 0x3FF) == 0)
     {
       Interruptible::checkForInterruption();
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
-      DATA val(0);
-      DATA tval(0);
+      algo->update_progress_max(n, num_nodes);
+    }
+
+    const VMesh::index_type* elems = node_elems.data() + offsets[n];
+    const size_t nsize = static_cast<size_t>(ends[n] - offsets[n]);
+
+    DATA val(0);
+    if ((method == "Interpolation") || (method == "Average"))
+    {
+      for (size_t p = 0; p < nsize; p++)
+        val += elem_values[elems[p]];
+      val = static_cast<DATA>(val*(1.0 / static_cast<double>(nsize)));
+    }
+    else if (method == "Max")
+    {
       if (nsize > 0)
       {
-        ifield->get_value(val, elems[0]);
+        val = elem_values[elems[0]];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->get_value(tval, elems[p]);
-          if (tval > val) val = tval;
-        }
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+          if (elem_values[elems[p]] > val) val = elem_values[elems[p]];
       }
     }
-  }
-  else if (method == "Min")
-  {
-    while (it != eit)
+    else if (method == "Min")
     {
-      Interruptible::checkForInterruption();
-      mesh->get_elems(elems, *it);
-      size_t nsize = elems.size();
-      DATA val(0);
-      DATA tval(0);
       if (nsize > 0)
       {
-        ifield->get_value(val, elems[0]);
+        val = elem_values[elems[0]];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->value(tval, elems[p]);
-          if (tval < val) val = tval;
-        }
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+          if (elem_values[elems[p]] < val) val = elem_values[elems[p]];
       }
     }
-  }
-  else if (method == "Sum")
-  {
-    while (it != eit)
+    else if (method == "Sum")
     {
-      Interruptible::checkForInterruption();
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
-      DATA val(0);
-      DATA tval(0);
       for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval, elems[p]);
-        val += tval;
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
-      }
+        val += elem_values[elems[p]];
     }
-  }
-  else if (method == "Median")
-  {
-    std::vector<DATA> valarray;
-    while (it != eit)
+    else if (method == "Median")
     {
-      Interruptible::checkForInterruption();
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
-      valarray.resize(nsize);
-      for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(valarray[p], elems[p]);
-      }
-      sort(valarray.begin(), valarray.end());
-      int idx = static_cast<int>((valarray.size() / 2));
-      ofield->set_value(valarray[idx], *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
+      if (nsize > 0)
       {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+        valarray.resize(nsize);
+        for (size_t p = 0; p < nsize; p++)
+          valarray[p] = elem_values[elems[p]];
+        sort(valarray.begin(), valarray.end());
+        val = valarray[nsize / 2];
       }
     }
+    node_values[n] = val;
   }
-  else
-  {
-    algo->remark("Method is not implemented!");
-    return false;
-  }
+
+  ofield->set_values(node_values);
 
   return true;
 }
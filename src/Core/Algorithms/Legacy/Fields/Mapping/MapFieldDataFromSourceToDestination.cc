@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataFromSourceToDestination.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RegularGridInterpolator.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Thread/Parallel.h>
@@ -70,7 +71,7 @@ namespace detail
   public:
     explicit MapFieldDataFromSourceToDestinationPAlgoBase(const std::string& name, int nproc) :
       sfield_(0), dfield_(0), smesh_(0), dmesh_(0), maxdist_(0), algo_(0),
-      barrier_(name, nproc), nproc_(nproc) {}
+      regular_(0), barrier_(name, nproc), nproc_(nproc) {}
 
     virtual void parallel(int proc) = 0;
 
@@ -82,6 +83,9 @@ namespace detail
     double  maxdist_;
     const AlgorithmBase* algo_;
 
+    // Direct kernel for sources on a regular grid, null otherwise
+    const RegularGridInterpolator* regular_;
+
   protected:
     Barrier barrier_;
     int nproc_;
@@ -348,6 +352,10 @@ class MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo : public MapField
       MapFieldDataFromSourceToDestinationPAlgoBase(" MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo Barrier", nproc) {}
 
     virtual void parallel(int proc) override;
+
+  private:
+    void parallel_regular(int proc, VField::index_type start, VField::index_type end);
+    void map_closest(VMesh::index_type idx);
 };
 
 void
@@ -363,7 +371,11 @@ MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo::parallel(int proc)
   barrier_.wait();
 
   int cnt = 0;
-  if (dfield_->basis_order() == 0 && sfield_->basis_order() == 0)
+  if (regular_)
+  {
+    parallel_regular(proc,start,end);
+  }
+  else if (dfield_->basis_order() == 0 && sfield_->basis_order() == 0)
   {
     Point p, r;
     VMesh::Elem::index_type didx;
@@ -453,6 +465,86 @@ MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo::parallel(int proc)
   barrier_.wait();
 }
 
+void
+MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo::parallel_regular(int proc, VField::index_type start, VField::index_type end)
+{
+  index_type nodes[RegularGridInterpolator::MAX_STENCIL];
+  double weights[RegularGridInterpolator::MAX_STENCIL];
+  size_type sz;
+
+  // Both fields have the same data type; for doubles skip the virtual
+  // value access altogether
+  const double* svalues = sfield_->get_values_pointer_as<double>();
+  double* dvalues = dfield_->get_values_pointer_as<double>();
+
+  std::vector<VMesh::index_type> outside;
+
+  int cnt = 0;
+  for (VMesh::index_type idx=start; idx<end; idx++)
+  {
+    if (regular_->get_stencil(idx,nodes,weights,sz))
+    {
+      if (svalues && dvalues)
+      {
+        double val = 0.0;
+        for (size_type q=0; q<sz; q++) val += weights[q]*svalues[nodes[q]];
+        dvalues[idx] = val;
+      }
+      else if (sz == 1)
+      {
+        dfield_->copy_value(sfield_,nodes[0],idx);
+      }
+      else
+      {
+        dfield_->copy_weighted_value(sfield_,nodes,weights,sz,idx);
+      }
+    }
+    else
+    {
+      outside.push_back(idx);
+    }
+
+    if (proc == 0) { cnt++; if (cnt == 4096) {cnt = 0; checkForInterruption(); algo_->update_progress_max(idx,end); } }
+  }
+
+  // Points outside the grid take the value of the closest element
+  for (size_t j=0; j<outside.size(); j++)
+  {
+    checkForInterruption();
+    map_closest(outside[j]);
+  }
+}
+
+void
+MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo::map_closest(VMesh::index_type idx)
+{
+  Point p, r;
+  VMesh::coords_type coords;
+  VMesh::Elem::index_type didx;
+
+  if (dfield_->basis_order() == 0) dmesh_->get_center(p,VMesh::Elem::index_type(idx));
+  else dmesh_->get_center(p,VMesh::Node::index_type(idx));
+
+  double dist;
+  if (smesh_->find_closest_elem(dist,r,coords,didx,p))
+  {
+    if (maxdist_ < 0.0 || dist < maxdist_)
+    {
+      if (sfield_->basis_order() == 0)
+      {
+        dfield_->copy_value(sfield_,didx,idx);
+      }
+      else
+      {
+        VMesh::ElemInterpolate interp;
+        smesh_->get_interpolate_weights(coords,didx,interp,1);
+        dfield_->copy_weighted_value(sfield_,&(interp.node_index[0]),
+            &(interp.weights[0]),interp.node_index.size(),idx);
+      }
+    }
+  }
+}
+
 }
 
 bool
@@ -540,6 +632,16 @@ MapFieldDataFromSourceToDestinationAlgo::runImpl(FieldHandle source, FieldHandle
 
   double maxdist = get(MaxDistance).toDouble();
 
+  // Sources on a LatVol mesh are interpolated with a direct kernel,
+  // which is separable when the destination is an aligned regular grid
+  boost::scoped_ptr<RegularGridInterpolator> regular;
+  if (method == "interpolateddata" && maxdist != 0.0 &&
+      RegularGridInterpolator::is_supported(sfield))
+  {
+    regular.reset(new RegularGridInterpolator(sfield));
+    regular->set_destination(dfield);
+  }
+
   boost::scoped_ptr<detail::MapFieldDataFromSourceToDestinationPAlgoBase> algoP;
   int np = Parallel::NumCores();
   if (method == "closestdata")
@@ -565,6 +667,7 @@ MapFieldDataFromSourceToDestinationAlgo::runImpl(FieldHandle source, FieldHandle
   algoP->dmesh_ = dmesh;
   algoP->maxdist_ = maxdist;
   algoP->algo_ = this;
+  algoP->regular_ = regular.get();
 
   auto task_i = [&algoP,this](int i) { algoP->parallel(i); };
   Parallel::RunTasks(task_i, np);
@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/Mapping/MappingDataSource.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RegularGridInterpolator.h>
 #include <Core/Math/MiscMath.h>
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodes.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
@@ -136,6 +137,77 @@ class InterpolatedDataSource : public MappingDataSource {
     mutable VMesh::MultiElemInterpolate  mei_;
 };
 
+// RegularInterpolatedDataSource: same as InterpolatedDataSource, but for
+// LatVol meshes the stencil is computed directly from the grid
+// transform instead of locating the element
+
+class RegularInterpolatedDataSource : public MappingDataSource {
+  public:
+    virtual void get_data(double& data, const Point& p) const override
+    {
+      get_value(data,p,def_value_);
+    }
+
+    virtual void get_data(Vector& data, const Point& p) const override
+    {
+      get_value(data,p,Vector(def_value_,def_value_,def_value_));
+    }
+
+    virtual void get_data(Tensor& data, const Point& p) const override
+    {
+      get_value(data,p,Tensor(def_value_));
+    }
+
+    virtual void get_data(std::vector<double>& data, const std::vector<Point>& p) const override
+    {
+      get_values(data,p,def_value_);
+    }
+
+    virtual void get_data(std::vector<Vector>& data, const std::vector<Point>& p) const override
+    {
+      get_values(data,p,Vector(def_value_,def_value_,def_value_));
+    }
+
+    virtual void get_data(std::vector<Tensor>& data, const std::vector<Point>& p) const override
+    {
+      get_values(data,p,Tensor(def_value_));
+    }
+
+    RegularInterpolatedDataSource(FieldHandle sfield,double def_value) :
+      interp_(sfield->vfield())
+    {
+      sfield_ = sfield->vfield();
+      def_value_ = def_value;
+
+      if (sfield_->is_scalar()) is_double_ = true;
+      if (sfield_->is_vector()) is_vector_ = true;
+      if (sfield_->is_tensor()) is_tensor_ = true;
+    }
+
+  private:
+    template<class DATA>
+    void get_value(DATA& data, const Point& p, const DATA& def) const
+    {
+      index_type idx[RegularGridInterpolator::MAX_STENCIL];
+      double w[RegularGridInterpolator::MAX_STENCIL];
+      size_type sz;
+
+      if (interp_.get_stencil(p,idx,w,sz)) sfield_->get_weighted_value(data,idx,w,sz);
+      else data = def;
+    }
+
+    template<class DATA>
+    void get_values(std::vector<DATA>& data, const std::vector<Point>& p, const DATA& def) const
+    {
+      data.resize(p.size());
+      for (size_t j=0; j<p.size(); j++) get_value(data[j],p[j],def);
+    }
+
+    VField                      *sfield_;
+    double                       def_value_;
+    RegularGridInterpolator      interp_;
+};
+
 class InterpolatedWeightedDataSource : public MappingDataSource {
   public:
     virtual void get_data(double& data, const Point& p) const override
@@ -3160,6 +3232,10 @@ MappingDataSourceHandle SCIRun::Core::Algorithms::Fields::CreateDataSource(Field
         return validHandle(new InterpolatedWeightedTensorDataSource(sfield,wfield,def_value));
       }
     }
+    else if (RegularGridInterpolator::is_supported(sfield->vfield()))
+    {
+      return validHandle(new RegularInterpolatedDataSource(sfield,def_value));
+    }
     else
     {
       return validHandle(new InterpolatedDataSource(sfield,def_value));
@@ -3196,6 +3272,10 @@ MappingDataSourceHandle SCIRun::Core::Algorithms::Fields::CreateDataSource(Field
         return validHandle(new InterpolatedWeightedTensorDataSource(sfield,wfield,nan_value));
       }
     }
+    else if (RegularGridInterpolator::is_supported(sfield->vfield()))
+    {
+      return validHandle(new RegularInterpolatedDataSource(sfield,nan_value));
+    }
     else
     {
       return validHandle(new InterpolatedDataSource(sfield,nan_value));
@@ -0,0 +1,235 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Legacy/Fields/Mapping/RegularGridInterpolator.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Transform.h>
+#include <Core/GeometryPrimitives/Point.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+
+bool
+RegularGridInterpolator::is_supported(VField* field)
+{
+  if (!field) return (false);
+
+  VMesh* mesh = field->vmesh();
+  if (!mesh->is_latvolmesh()) return (false);
+  if (!mesh->is_linearmesh()) return (false);
+
+  const int basis_order = field->basis_order();
+  if (basis_order != 0 && basis_order != 1) return (false);
+
+  // Need at least one element along every axis
+  VMesh::dimension_type dims;
+  mesh->get_dimensions(dims);
+  for (size_t d=0; d<dims.size(); d++)
+  {
+    if (dims[d] < 2) return (false);
+  }
+
+  return (true);
+}
+
+RegularGridInterpolator::RegularGridInterpolator(VField* sfield) :
+  smesh_(sfield->vmesh()),
+  basis_order_(sfield->basis_order()),
+  dmesh_(0),
+  dbasis_order_(0),
+  separable_(false)
+{
+  VMesh::dimension_type dims;
+  smesh_->get_dimensions(dims);
+
+  for (int d=0; d<3; d++)
+  {
+    n_[d] = dims[d];
+    dn_[d] = 1;
+  }
+
+  // Copy the inverse transform so unprojecting is thread safe
+  Transform t = smesh_->get_transform();
+  t.compute_imat();
+  for (int i=0; i<3; i++)
+    for (int j=0; j<4; j++)
+      imat_[i][j] = t.get_imat_val(i,j);
+}
+
+bool
+RegularGridInterpolator::axis_coord(double r, size_type n, AxisCoord& c) const
+{
+  // Same tolerance as LatVolMesh::locate
+  const double epsilon = 1e-7;
+  const double nn = static_cast<double>(n-1);
+
+  if (r < -epsilon || r > nn + epsilon)
+  {
+    c.i = -1;
+    c.f = 0.0;
+    return (false);
+  }
+
+  index_type i = static_cast<index_type>(std::floor(r));
+  if (i < 0) i = 0;
+  if (i > n-2) i = n-2;
+
+  c.i = i;
+  c.f = std::min(std::max(r - static_cast<double>(i), 0.0), 1.0);
+  return (true);
+}
+
+void
+RegularGridInterpolator::make_stencil(const AxisCoord* c, index_type* idx, double* w, size_type& sz) const
+{
+  if (basis_order_ == 0)
+  {
+    idx[0] = c[0].i + (n_[0]-1)*(c[1].i + (n_[1]-1)*c[2].i);
+    w[0] = 1.0;
+    sz = 1;
+    return;
+  }
+
+  const index_type sj = n_[0];
+  const index_type sk = n_[0]*n_[1];
+  const index_type base = c[0].i + sj*c[1].i + sk*c[2].i;
+
+  const double fx = c[0].f, gx = 1.0 - fx;
+  const double fy = c[1].f, gy = 1.0 - fy;
+
+  idx[0] = base;        w[0] = gx*gy;
+  idx[1] = base+1;      w[1] = fx*gy;
+  idx[2] = base+sj;     w[2] = gx*fy;
+  idx[3] = base+sj+1;   w[3] = fx*fy;
+
+  const double fz = c[2].f, gz = 1.0 - fz;
+  for (int q=0; q<4; q++)
+  {
+    idx[q+4] = idx[q] + sk;
+    w[q+4] = w[q]*fz;
+    w[q] *= gz;
+  }
+  sz = 8;
+}
+
+bool
+RegularGridInterpolator::get_stencil(const Point& p, index_type* idx, double* w, size_type& sz) const
+{
+  AxisCoord c[3] = { {0,0.0}, {0,0.0}, {0,0.0} };
+
+  for (int d=0; d<3; d++)
+  {
+    const double r = imat_[d][0]*p.x() + imat_[d][1]*p.y() + imat_[d][2]*p.z() + imat_[d][3];
+    if (!axis_coord(r,n_[d],c[d])) return (false);
+  }
+
+  make_stencil(c,idx,w,sz);
+  return (true);
+}
+
+bool
+RegularGridInterpolator::set_destination(VField* dfield)
+{
+  dmesh_ = dfield->vmesh();
+  dbasis_order_ = dfield->basis_order();
+  separable_ = false;
+
+  if (!is_supported(dfield)) return (false);
+
+  VMesh::dimension_type dims;
+  dmesh_->get_dimensions(dims);
+
+  // Grid coordinates of the destination in grid space of the source:
+  // M = inverse(source transform) * destination transform
+  Transform t = dmesh_->get_transform();
+  double m[3][4];
+  for (int i=0; i<3; i++)
+  {
+    for (int j=0; j<4; j++)
+    {
+      m[i][j] = imat_[i][3]*t.get_mat_val(3,j);
+      for (int k=0; k<3; k++) m[i][j] += imat_[i][k]*t.get_mat_val(k,j);
+    }
+  }
+
+  // Separable only if every source axis depends on the matching destination
+  // axis alone
+  for (int d=0; d<3; d++)
+  {
+    const double scale = std::fabs(m[d][0]) + std::fabs(m[d][1]) + std::fabs(m[d][2]);
+    for (int e=0; e<3; e++)
+    {
+      if (e != d && std::fabs(m[d][e]) > 1e-10*scale) return (false);
+    }
+  }
+
+  const double offset = (dbasis_order_ == 0) ? 0.5 : 0.0;
+  for (int e=0; e<3; e++)
+  {
+    dn_[e] = (dbasis_order_ == 0) ? dims[e]-1 : dims[e];
+
+    table_[e].resize(dn_[e]);
+    for (index_type i=0; i<dn_[e]; i++)
+    {
+      axis_coord(m[e][e]*(static_cast<double>(i) + offset) + m[e][3],n_[e],table_[e][i]);
+    }
+  }
+
+  separable_ = true;
+  return (true);
+}
+
+bool
+RegularGridInterpolator::get_stencil(index_type didx, index_type* idx, double* w, size_type& sz) const
+{
+  if (separable_)
+  {
+    const index_type i = didx % dn_[0];
+    const index_type jk = didx / dn_[0];
+    const index_type j = jk % dn_[1];
+    const index_type k = jk / dn_[1];
+
+    const AxisCoord c[3] = { table_[0][i], table_[1][j], table_[2][k] };
+    if (c[0].i < 0 || c[1].i < 0 || c[2].i < 0) return (false);
+
+    make_stencil(c,idx,w,sz);
+    return (true);
+  }
+
+  Point p;
+  if (dbasis_order_ == 0) dmesh_->get_center(p,VMesh::Elem::index_type(didx));
+  else dmesh_->get_center(p,VMesh::Node::index_type(didx));
+
+  return (get_stencil(p,idx,w,sz));
+}
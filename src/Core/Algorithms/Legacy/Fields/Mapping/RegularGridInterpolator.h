@@ -0,0 +1,113 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORTIHMS_FIELDS_MAPPING_REGULAR_GRID_INTERPOLATOR_H__
+#define CORE_ALGORTIHMS_FIELDS_MAPPING_REGULAR_GRID_INTERPOLATOR_H__
+
+#include <vector>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/GeometryPrimitives/GeomFwd.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+// Direct interpolation kernel for fields defined on a LatVolMesh. Instead
+// of locating every point in the mesh and asking the basis for its weights,
+// the point is unprojected once into grid space and the trilinear stencil is
+// computed directly. When the destination is a
+// regular grid whose axes are aligned with the source grid, the grid
+// coordinates are separable and are tabulated once per axis.
+//
+// ImageMesh sources are not handled: unprojecting drops the distance to the
+// image plane, which the MaxDistance checks of the callers depend on.
+//
+// Stencils list the source value indices in increasing order. All methods
+// are const and can be called from multiple threads once the object has been
+// constructed and set_destination has been called.
+
+class SCISHARE RegularGridInterpolator
+{
+  public:
+    // Maximum number of entries in a stencil (trilinear hexahedron)
+    static const int MAX_STENCIL = 8;
+
+    // Checks whether the data of this field can be handled: the mesh needs
+    // to be a LatVolMesh with linear geometry and the data needs
+    // to be located on the nodes or the elements.
+    static bool is_supported(VField* field);
+
+    explicit RegularGridInterpolator(VField* sfield);
+
+    // Stencil for an arbitrary point. Returns false if the point is outside
+    // of the grid, in which case the caller needs to fall back to a search.
+    bool get_stencil(const Geometry::Point& p, index_type* idx, double* w, size_type& sz) const;
+
+    // Set the field whose value locations will be queried with the
+    // index version of get_stencil. Returns true if the separable tables
+    // could be used.
+    bool set_destination(VField* dfield);
+
+    // Stencil for the location of value 'didx' of the destination field
+    bool get_stencil(index_type didx, index_type* idx, double* w, size_type& sz) const;
+
+    bool is_separable() const { return (separable_); }
+    int  basis_order() const  { return (basis_order_); }
+
+  private:
+    // Grid coordinates along one axis: lower index and fractional weight of
+    // the upper neighbor. A negative index marks a location outside the grid.
+    struct AxisCoord
+    {
+      index_type i;
+      double     f;
+    };
+
+    bool axis_coord(double r, size_type n, AxisCoord& c) const;
+    void make_stencil(const AxisCoord* c, index_type* idx, double* w, size_type& sz) const;
+
+    VMesh* smesh_;
+    int    basis_order_;
+    // Number of nodes along each axis
+    size_type n_[3];
+    // Inverse transform: world to grid space
+    double imat_[3][4];
+
+    VMesh* dmesh_;
+    int    dbasis_order_;
+    bool   separable_;
+    size_type dn_[3];
+    std::vector<AxisCoord> table_[3];
+};
+
+}}}}
+
+#endif
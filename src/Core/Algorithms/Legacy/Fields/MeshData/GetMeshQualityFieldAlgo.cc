@@ -32,11 +32,17 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
+#include <cfloat>
+#include <sstream>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields,Metric);
 
@@ -60,10 +66,110 @@ AlgorithmOutput GetMeshQualityFieldAlgo::run(const AlgorithmInput& input) const
     return output;
 }
 
+namespace
+{
+  const int histogramBins = 10;
+  const size_t worstCount = 10;
+
+  typedef std::pair<double, VMesh::index_type> ElemValue;
+
+  /// Running minimum, maximum, sum and lowest values of one thread's elements
+  struct MetricStatistics
+  {
+    MetricStatistics() : min(DBL_MAX), max(-DBL_MAX), sum(0.0) {}
+
+    void add(double value, VMesh::index_type idx)
+    {
+      if (value < min) min = value;
+      if (value > max) max = value;
+      sum += value;
+      keep(value, idx);
+    }
+
+    void keep(double value, VMesh::index_type idx)
+    {
+      if (worst.size() < worstCount || value < worst.front().first)
+      {
+        worst.push_back(ElemValue(value, idx));
+        std::push_heap(worst.begin(), worst.end());
+        if (worst.size() > worstCount)
+        {
+          std::pop_heap(worst.begin(), worst.end());
+          worst.pop_back();
+        }
+      }
+    }
+
+    double min, max, sum;
+    std::vector<ElemValue> worst;   // max-heap of the lowest values
+  };
+
+  const VMesh::index_type blockSize = 64;
+
+  inline double length(double dx, double dy, double dz)
+  {
+    return (std::sqrt(dx*dx + dy*dy + dz*dz));
+  }
+
+  /// Jacobian and scaled jacobian of linear tetrahedra, which are constant
+  /// over the element. Vertices are gathered block by block into separate
+  /// coordinate arrays so that the arithmetic below vectorizes.
+  void linearTetMetric(const Point* points, const VMesh::index_type* cells, bool scaled,
+    VMesh::index_type begin, VMesh::index_type end, double* values)
+  {
+    double x[4][blockSize], y[4][blockSize], z[4][blockSize];
+
+    for (VMesh::index_type block = begin; block < end; block += blockSize)
+    {
+      const VMesh::index_type n = std::min(blockSize, end - block);
+      for (VMesh::index_type k = 0; k < n; k++)
+      {
+        for (int v = 0; v < 4; v++)
+        {
+          const Point& p = points[cells[4*(block + k) + v]];
+          x[v][k] = p.x(); y[v][k] = p.y(); z[v][k] = p.z();
+        }
+      }
+
+      double* out = values + block;
+      for (VMesh::index_type k = 0; k < n; k++)
+      {
+        const double a = x[1][k]-x[0][k], b = y[1][k]-y[0][k], c = z[1][k]-z[0][k];
+        const double d = x[2][k]-x[0][k], e = y[2][k]-y[0][k], f = z[2][k]-z[0][k];
+        const double g = x[3][k]-x[0][k], h = y[3][k]-y[0][k], i = z[3][k]-z[0][k];
+        out[k] = a*e*i-c*e*g+b*f*g+c*d*h-a*f*h-b*d*i;
+      }
+
+      if (!scaled) continue;
+
+      for (VMesh::index_type k = 0; k < n; k++)
+      {
+        const double l0 = length(x[1][k]-x[0][k], y[1][k]-y[0][k], z[1][k]-z[0][k]);
+        const double l1 = length(x[2][k]-x[1][k], y[2][k]-y[1][k], z[2][k]-z[1][k]);
+        const double l2 = length(x[0][k]-x[2][k], y[0][k]-y[2][k], z[0][k]-z[2][k]);
+        const double l3 = length(x[3][k]-x[0][k], y[3][k]-y[0][k], z[3][k]-z[0][k]);
+        const double l4 = length(x[3][k]-x[1][k], y[3][k]-y[1][k], z[3][k]-z[1][k]);
+        const double l5 = length(x[3][k]-x[2][k], y[3][k]-y[2][k], z[3][k]-z[2][k]);
+
+        double scale = std::max(std::max(l0*l2*l3, l0*l1*l4), std::max(l1*l2*l5, l3*l4*l5));
+        scale = std::max(scale, out[k]);
+        out[k] = std::sqrt(2.0)*out[k]/scale;
+      }
+    }
+  }
+}
+
 bool
 GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
 {
-    std::string Metric = getOption(Parameters::Metric);
+  MeshQualitySummary summary;
+  return (run(input, output, summary));
+}
+
+bool
+GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output, MeshQualitySummary& summary) const
+{
+  std::string Metric = getOption(Parameters::Metric);
   
   if (!input)
   {
@@ -72,6 +178,10 @@ GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
   }
 
   FieldInformation fi(input);
+  // Jacobians of linear tets are closed forms of the vertex positions
+  const bool linear_tets = fi.is_tetvolmesh() && fi.is_linearmesh() &&
+    (Metric == "scaled_jacobian" || Metric == "jacobian");
+
   fi.make_double();
   fi.make_constantdata();
   
@@ -85,40 +195,80 @@ GetMeshQualityFieldAlgo::run(FieldHandle input, FieldHandle& output) const
   
   VField* ofield = output->vfield();
   VMesh*  imesh  = input->vmesh();
-  
-  if (Metric == "scaled_jacobian")
+
+  double (VMesh::*metric)(VMesh::Elem::index_type) const = 0;
+  if (Metric == "scaled_jacobian") metric = &VMesh::scaled_jacobian_metric;
+  else if (Metric == "jacobian") metric = &VMesh::jacobian_metric;
+  else if (Metric == "volume") metric = &VMesh::volume_metric;
+  else if (Metric == "insc_circ_ratio") metric = &VMesh::inscribed_circumscribed_radius_metric;
+  else return true;
+
+  const VMesh::Elem::size_type num_values = imesh->num_elems();
+  std::vector<double> values(num_values);
+
+  const Point* points = linear_tets ? imesh->get_points_pointer() : 0;
+  const VMesh::index_type* cells = linear_tets ? imesh->get_elems_pointer() : 0;
+
+  const int np = Parallel::NumCores();
+  std::vector<MetricStatistics> stats(np);
+
+  auto task = [&](int proc)
   {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
+    const VMesh::index_type begin = num_values * proc / np;
+    const VMesh::index_type end = num_values * (proc + 1) / np;
+
+    if (linear_tets)
     {
-      ofield->set_value(imesh->scaled_jacobian_metric(j),j);
+      linearTetMetric(points, cells, Metric == "scaled_jacobian", begin, end, &values[0]);
     }
-  }
-  else if (Metric == "jacobian")
-  {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
+    else
     {
-      ofield->set_value(imesh->jacobian_metric(j),j);
-    }  
-  }
-  else if (Metric == "volume")
+      for (VMesh::Elem::index_type j=begin; j<end; j++)
+        values[j] = (imesh->*metric)(j);
+    }
+
+    for (VMesh::index_type j=begin; j<end; j++)
+      stats[proc].add(values[j], j);
+  };
+  Parallel::RunTasks(task, np);
+
+  ofield->set_values(values);
+
+  if (num_values == 0) return true;
+
+  MetricStatistics all;
+  for (size_t p = 0; p < stats.size(); p++)
   {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->volume_metric(j),j);
-    }  
+    all.min = std::min(all.min, stats[p].min);
+    all.max = std::max(all.max, stats[p].max);
+    all.sum += stats[p].sum;
+    for (size_t w = 0; w < stats[p].worst.size(); w++)
+      all.keep(stats[p].worst[w].first, stats[p].worst[w].second);
   }
-  else if (Metric == "insc_circ_ratio")
+
+  summary.min = all.min;
+  summary.max = all.max;
+  summary.mean = all.sum / num_values;
+  summary.worst.assign(all.worst.begin(), all.worst.end());
+  std::sort(summary.worst.begin(), summary.worst.end());
+
+  summary.histogram.assign(histogramBins, 0);
+  const double range = all.max - all.min;
+  for (VMesh::index_type j=0; j<num_values; j++)
   {
-    VMesh::Elem::size_type num_values = imesh->num_elems();
-    for (VMesh::Elem::index_type j=0; j<num_values; j++)
-    {
-      ofield->set_value(imesh->inscribed_circumscribed_radius_metric(j),j);
-    }  
-  }  
+    int bin = (range > 0.0) ? static_cast<int>(histogramBins * (values[j] - all.min) / range) : 0;
+    summary.histogram[std::min(bin, histogramBins - 1)]++;
+  }
 
-    return true;
-}
+  std::ostringstream report;
+  report << Metric << ": min " << summary.min << ", max " << summary.max << ", mean " << summary.mean;
+  report << "\nHistogram:";
+  for (int b = 0; b < histogramBins; b++)
+    report << " " << summary.histogram[b];
+  report << "\nWorst elements:";
+  for (size_t w = 0; w < summary.worst.size(); w++)
+    report << " " << summary.worst[w].second << " (" << summary.worst[w].first << ")";
+  remark(report.str());
 
+  return true;
+}
@@ -32,6 +32,8 @@
 //Base class for algorithm
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <vector>
 
 //For Windows support
 #include <Core/Algorithms/Legacy/Fields/share.h>
@@ -43,6 +45,18 @@ namespace SCIRun {
                 
 ALGORITHM_PARAMETER_DECL(Metric);
 
+/// Distribution of the metric over all elements
+struct SCISHARE MeshQualitySummary
+{
+  MeshQualitySummary() : min(0), max(0), mean(0) {}
+
+  double min, max, mean;
+  /// Element counts in equal bins spanning [min, max]
+  std::vector<size_type> histogram;
+  /// The lowest metric values with their element indices, lowest first
+  std::vector<std::pair<double, index_type> > worst;
+};
+
 class SCISHARE GetMeshQualityFieldAlgo : public AlgorithmBase
 {
   public:
@@ -51,6 +65,7 @@ class SCISHARE GetMeshQualityFieldAlgo : public AlgorithmBase
     
     ///Run the algorithm
     bool run(FieldHandle input, FieldHandle& output) const;
+    bool run(FieldHandle input, FieldHandle& output, MeshQualitySummary& summary) const;
     virtual AlgorithmOutput run(const AlgorithmInput& input) const;
 };
 
@@ -34,6 +34,7 @@
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms::Fields;
@@ -41,6 +42,7 @@ using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
 
 bool 
 SetMeshNodesAlgo::run(FieldHandle input, DenseMatrixHandle matrix, FieldHandle& output) const
@@ -87,7 +89,28 @@ SetMeshNodesAlgo::run(FieldHandle input, DenseMatrixHandle matrix, FieldHandle&
 
   VMesh* mesh = output->vmesh();
   VMesh::size_type size = mesh->num_nodes();
-  
+
+  // Irregular meshes expose their node array, so it can be filled in parallel.
+  Point* points = mesh->is_irregularmesh() ? mesh->get_points_pointer() : nullptr;
+  if (points)
+  {
+    const DenseMatrix& m = *matrix;
+    const int numTasks = static_cast<int>(std::max<VMesh::size_type>(1,
+      std::min<VMesh::size_type>(Parallel::NumCores(), size / 10000)));
+    auto task = [&](int t)
+    {
+      const VMesh::index_type begin = size * t / numTasks;
+      const VMesh::index_type end = size * (t + 1) / numTasks;
+      for (VMesh::index_type i = begin; i < end; ++i)
+        points[i] = Point(m(i, 0), m(i, 1), m(i, 2));
+    };
+    if (numTasks == 1)
+      task(0);
+    else
+      Parallel::RunTasks(task, numTasks);
+    return (true);
+  }
+
   Point p;
   int cnt =0;
   for (VMesh::Node::index_type i=0; i<size; ++i)
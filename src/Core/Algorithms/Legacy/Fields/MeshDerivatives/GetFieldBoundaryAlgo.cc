@@ -37,13 +37,18 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
 
-#include <boost/unordered_map.hpp>
+#include <Core/Thread/Parallel.h>
+
+#include <boost/scoped_array.hpp>
+#include <algorithm>
+#include <atomic>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmOutputName GetFieldBoundaryAlgo::BoundaryField("BoundaryField");
 AlgorithmOutputName GetFieldBoundaryAlgo::MappingMatrix("Mapping");
@@ -53,266 +58,233 @@ GetFieldBoundaryAlgo::GetFieldBoundaryAlgo()
   addOption(AlgorithmParameterName("mapping"),"auto","auto|node|elem|none");
 }
 
-struct IndexHash 
-{
-  size_t operator()(const index_type &idx) const
-    { return (static_cast<size_t>(idx)); }
-};
-
-bool 
-GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const
+namespace
 {
-  ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
-
-  /// Define types we need for mapping
-  using hash_map_type = boost::unordered_map<index_type,index_type,IndexHash>;
-
-  hash_map_type node_map;
-  hash_map_type elem_map;
-  
-  /// Check whether we have an input field
-  if (!input)
-  {
-    error("No input field");
-    return (false);
-  }
-
-  /// Figure out what the input type and output type have to be
-  FieldInformation fi(input);
-  FieldInformation fo(input);
-  
-  /// We do not yet support Quadratic and Cubic Meshes here
-  if (fi.is_nonlinear())
-  {
-    error("This function has not yet been defined for non-linear elements");
-    return (false);
-  }
-  
-  /// Figure out which type of field the output is:
-  auto found_method = false;
-  if (fi.is_hex_element())    { fo.make_quadsurfmesh(); found_method = true; }
-  if (fi.is_prism_element())  { fo.make_quadsurfmesh(); found_method = true; }
-  if (fi.is_tet_element())    { fo.make_trisurfmesh(); found_method = true; }
-  if (fi.is_quad_element())   { fo.make_curvemesh(); found_method = true; }
-  if (fi.is_tri_element())    { fo.make_curvemesh(); found_method = true; }
-  if (fi.is_pnt_element())
-  {
-    remark("The field boundary of a point cloud is the same point cloud");
-    output = input;
-    return (true);
-  }
-  
-  /// Check whether we could make a conversion
-  if (!found_method)
+  /// Boundary of a mesh: output element i is a face of input element elems[i],
+  /// output node j is input node nodes[j]. Nodes are numbered in the order in
+  /// which they first appear on the boundary faces.
+  struct Boundary
   {
-    error("No method available for mesh of type: " + fi.get_mesh_type());
-    return (false);
-  }
+    std::vector<index_type> elems;
+    std::vector<index_type> nodes;
+  };
 
-  /// Create the output field
-  output = CreateField(fo);
-  if (!output)
+  /// Contiguous range of [0, size) handled by task proc of np
+  inline void taskRange(size_type size, int proc, int np, index_type& begin, index_type& end)
   {
-    error("Could not create output field");
-    return (false);
+    begin = size * proc / np;
+    end = size * (proc + 1) / np;
   }
-  
-  /// Get the virtual interfaces:
-  auto imesh = input->vmesh();
-  auto omesh = output->vmesh();
-  auto ifield = input->vfield();
-  auto ofield = output->vfield();
-
-  imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
-
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems; 
-  VMesh::Node::array_type inodes; 
-  VMesh::Node::array_type onodes; 
-  VMesh::Node::index_type a;
 
-  inodes.clear();
-  onodes.clear();  
-  Point point;
-
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-  
-  imesh->begin(be); 
-  imesh->end(ee);
-
-  while (be != ee)
+  /// Finds the faces without a neighbor and writes them to omesh. Every step
+  /// runs in parallel over contiguous ranges, and the ranges are visited in
+  /// order, so the output matches a serial sweep over the elements.
+  void extractBoundary(VMesh* imesh, VMesh* omesh, Boundary& boundary)
   {
-    checkForInterruption();
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
+    const int np = Parallel::NumCores();
+    const VMesh::Elem::size_type num_elems = imesh->num_elems();
+    const VMesh::Node::size_type num_nodes = imesh->num_nodes();
+
+    // Boundary faces found by each task: the element, the face size and
+    // the face nodes
+    std::vector<std::vector<index_type> > taskElems(np), taskSizes(np), taskNodes(np);
+    Parallel::RunTasks([&](int proc)
     {
-      auto includeface = false;
+      index_type begin, end;
+      taskRange(num_elems, proc, np, begin, end);
+      VMesh::DElem::array_type delems;
+      VMesh::Node::array_type inodes;
+      VMesh::Elem::index_type nci;
 
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
-
-      if (includeface)
+      for (VMesh::Elem::index_type ci = begin; ci < end; ++ci)
       {
-        imesh->get_nodes(inodes, delems[p]);
-        onodes.resize(inodes.size());
-
-        for (size_t q = 0; q < inodes.size(); q++)
+        imesh->get_delems(delems, ci);
+        for (size_t p = 0; p < delems.size(); p++)
         {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
-          {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
+          if (imesh->get_neighbor(nci, ci, delems[p])) continue;
+          imesh->get_nodes(inodes, delems[p]);
+          taskElems[proc].push_back(ci);
+          taskSizes[proc].push_back(static_cast<index_type>(inodes.size()));
+          taskNodes[proc].insert(taskNodes[proc].end(), inodes.begin(), inodes.end());
         }
-        elem_map[omesh->add_elem(onodes)] = ci;
       }
-    }
-    ++be;
-  }
-
-  mapping.reset();
-
-  ofield->resize_fdata();
-
-  if (
-    (
-    (ifield->basis_order() == 0)
-#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-      && checkOption("mapping","auto")
-      )
-      ||
-       checkOption("mapping","elem")
-#else
-    )
-#endif
-      )
-  {
-    VMesh::Elem::size_type isize;
-    VMesh::Elem::size_type osize;
-    imesh->size(isize);
-    omesh->size(osize);
-
-    size_type nrows = osize;
-    size_type ncols = isize;
-
-    typedef SparseRowMatrix::Triplet T;
-    std::vector<T> tripletList;
-    tripletList.reserve(nrows);
+    }, np);
 
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
+    std::vector<size_type> faceOffset(np + 1, 0), slotOffset(np + 1, 0);
+    for (int proc = 0; proc < np; proc++)
     {
-      tripletList.push_back(T(it->first, it->second, 1));
-      ++it;
+      faceOffset[proc + 1] = faceOffset[proc] + taskElems[proc].size();
+      slotOffset[proc + 1] = slotOffset[proc] + taskNodes[proc].size();
     }
-    SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
-    mat->setFromTriplets(tripletList.begin(), tripletList.end());
-    mapping = mat;
-  }
-  else if (
-    ((ifield->basis_order() == 1) 
-#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-    && checkOption("mapping","auto"))
-    ||
-      checkOption("mapping","node")
-#else
-    )
-#endif
-      )
-  {
-    VMesh::Node::size_type isize;
-    VMesh::Node::size_type osize;
-    imesh->size(isize);
-    omesh->size(osize);
+    const size_type num_faces = faceOffset[np];
+    const size_type num_slots = slotOffset[np];
 
-    size_type nrows = osize;
-    size_type ncols = isize;
-
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> tripletList;
-    tripletList.reserve(nrows);
+    boundary.elems.resize(num_faces);
+    std::vector<index_type> faceSizes(num_faces);
+    std::vector<index_type> slots(num_slots);
+    Parallel::RunTasks([&](int proc)
+    {
+      std::copy(taskElems[proc].begin(), taskElems[proc].end(), boundary.elems.begin() + faceOffset[proc]);
+      std::copy(taskSizes[proc].begin(), taskSizes[proc].end(), faceSizes.begin() + faceOffset[proc]);
+      std::copy(taskNodes[proc].begin(), taskNodes[proc].end(), slots.begin() + slotOffset[proc]);
+      std::vector<index_type>().swap(taskNodes[proc]);
+    }, np);
+
+    // First slot at which every input node appears
+    boost::scoped_array<std::atomic<index_type> > first(new std::atomic<index_type>[num_nodes]);
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(num_nodes, proc, np, begin, end);
+      for (index_type a = begin; a < end; ++a) first[a] = num_slots;
+    }, np);
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(num_slots, proc, np, begin, end);
+      for (index_type q = begin; q < end; ++q)
+      {
+        std::atomic<index_type>& f = first[slots[q]];
+        index_type current = f.load();
+        while (q < current && !f.compare_exchange_weak(current, q)) {}
+      }
+    }, np);
 
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
+    // Number the first appearances with a prefix sum over the slots
+    std::vector<index_type> rank(num_slots);
+    std::vector<size_type> taskCount(np + 1, 0);
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(num_slots, proc, np, begin, end);
+      size_type count = 0;
+      for (index_type q = begin; q < end; ++q)
+        if (first[slots[q]] == q) count++;
+      taskCount[proc + 1] = count;
+    }, np);
+    for (int proc = 0; proc < np; proc++) taskCount[proc + 1] += taskCount[proc];
+
+    boundary.nodes.resize(taskCount[np]);
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(num_slots, proc, np, begin, end);
+      index_type next = taskCount[proc];
+      for (index_type q = begin; q < end; ++q)
+      {
+        if (first[slots[q]] == q)
+        {
+          boundary.nodes[next] = slots[q];
+          rank[q] = next++;
+        }
+      }
+    }, np);
 
-    while (it != it_end)
+    // Output connectivity: every slot takes the number of its node's first slot
+    Parallel::RunTasks([&](int proc)
     {
-      tripletList.push_back(T(it->second, it->first, 1));
-      ++it;
+      index_type begin, end;
+      taskRange(num_slots, proc, np, begin, end);
+      for (index_type q = begin; q < end; ++q) slots[q] = rank[first[slots[q]]];
+    }, np);
+
+    const size_type num_out = static_cast<size_type>(boundary.nodes.size());
+    omesh->resize_nodes(num_out);
+    Point* points = omesh->get_points_pointer();
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(num_out, proc, np, begin, end);
+      for (index_type j = begin; j < end; ++j)
+        imesh->get_center(points[j], VMesh::Node::index_type(boundary.nodes[j]));
+    }, np);
+
+    const index_type per_elem = static_cast<index_type>(omesh->num_nodes_per_elem());
+    if (num_slots == num_faces * per_elem)
+    {
+      omesh->resize_elems(num_faces);
+      if (num_slots > 0)
+        std::copy(slots.begin(), slots.end(), omesh->get_elems_pointer());
+    }
+    else
+    {
+      // Mixed face types, as on prisms
+      VMesh::Node::array_type onodes;
+      index_type q = 0;
+      for (index_type i = 0; i < num_faces; ++i)
+      {
+        onodes.assign(slots.begin() + q, slots.begin() + q + faceSizes[i]);
+        q += faceSizes[i];
+        omesh->add_elem(onodes);
+      }
     }
-    SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
-    mat->setFromTriplets(tripletList.begin(), tripletList.end());
-    mapping = mat;
   }
-  
-  if (ifield->basis_order() == 0)
+
+  /// Matrix with a single one per row, in column columns[row]
+  SparseRowMatrixHandle selectionMatrix(size_type ncols, const std::vector<index_type>& columns)
   {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
-    {      
-      checkForInterruption();
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);  
-      
-      /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
-    }
+    const size_type nrows = static_cast<size_type>(columns.size());
+    SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
+    mat->resizeNonZeros(nrows);
+    auto rows = mat->outerIndexPtr();
+    auto cols = mat->innerIndexPtr();
+    auto data = mat->valuePtr();
+    const int np = Parallel::NumCores();
+    Parallel::RunTasks([&](int proc)
+    {
+      index_type begin, end;
+      taskRange(nrows, proc, np, begin, end);
+      for (index_type r = begin; r < end; ++r)
+      {
+        rows[r] = r;
+        cols[r] = columns[r];
+        data[r] = 1.0;
+      }
+    }, np);
+    rows[nrows] = nrows;
+    return mat;
   }
-  else if (input->basis_order() == 1)
+
+  /// Copies the field values that live on the boundary
+  void copyBoundaryValues(VField* ifield, VField* ofield, const Boundary& boundary)
   {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-    
-    while (it != it_end)
+    const std::vector<index_type>* source = 0;
+    if (ifield->basis_order() == 0) source = &boundary.elems;
+    else if (ifield->basis_order() == 1) source = &boundary.nodes;
+    if (!source) return;
+
+    const size_type size = static_cast<size_type>(source->size());
+    const int np = Parallel::NumCores();
+    Parallel::RunTasks([&](int proc)
     {
-      checkForInterruption();
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
-    }
+      index_type begin, end;
+      taskRange(size, proc, np, begin, end);
+      for (index_type j = begin; j < end; ++j)
+        ofield->copy_value(ifield, (*source)[j], j);
+    }, np);
   }
-  
-  CopyProperties(*input, *output);
-  
-  return (true);
 }
 
+bool 
+GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const
+{
+  return (runImpl(input, output, &mapping));
+}
 
-/// A copy of the algorithm without creating the mapping matrix. 
-/// Need this for the various algorithms that only use the boundary to
-/// project nodes on.
+/// Without the mapping matrix, for the various algorithms that only use the
+/// boundary to project nodes on.
 
 bool 
 GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
+{
+  return (runImpl(input, output, 0));
+}
+
+bool 
+GetFieldBoundaryAlgo::runImpl(FieldHandle input, FieldHandle& output, MatrixHandle* mapping) const
 {
   ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
 
-  /// Define types we need for mapping
-  using hash_map_type = boost::unordered_map<index_type,index_type,IndexHash>;
-  
-  hash_map_type node_map;
-  hash_map_type elem_map;
-  
   /// Check whether we have an input field
   if (!input)
   {
@@ -365,101 +337,57 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
   auto omesh = output->vmesh();
   auto ifield = input->vfield();
   auto ofield = output->vfield();
-  
-  imesh->synchronize(Mesh::DELEMS_E|Mesh::ELEM_NEIGHBORS_E);
-  
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems; 
-  VMesh::Node::array_type inodes; 
-  VMesh::Node::array_type onodes; 
-  VMesh::Node::index_type a;
-
-  inodes.clear();
-  onodes.clear();  
-  Point point;
-
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-  
-  imesh->begin(be); 
-  imesh->end(ee);
 
-  while (be != ee)
-  {
-    checkForInterruption();
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
-    {
-      auto includeface = false;
+  imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
 
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
+  Boundary boundary;
+  extractBoundary(imesh, omesh, boundary);
+  checkForInterruption();
 
-      if (includeface)
-      {
-        imesh->get_nodes(inodes, delems[p]);
-        if (onodes.size() == 0) onodes.resize(inodes.size());
-        for (size_t q = 0; q < onodes.size(); q++)
-        {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
-          {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
-        }
-        elem_map[omesh->add_elem(onodes)] = ci;
-      }
-    }
-    ++be;
-  }
-  
   ofield->resize_fdata();
-  
-  if (ifield->basis_order() == 0)
+
+  if (mapping)
   {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-    
-    while (it != it_end)
-    {      
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);  
-      
-      /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+    mapping->reset();
+
+    if (
+      (
+      (ifield->basis_order() == 0)
+#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
+        && checkOption("mapping","auto")
+        )
+        ||
+         checkOption("mapping","elem")
+#else
+      )
+#endif
+        )
+    {
+      *mapping = selectionMatrix(imesh->num_elems(), boundary.elems);
     }
-  }
-  else if (input->basis_order() == 1)
-  {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-    
-    while (it != it_end)
+    else if (
+      ((ifield->basis_order() == 1) 
+#ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
+      && checkOption("mapping","auto"))
+      ||
+        checkOption("mapping","node")
+#else
+      )
+#endif
+        )
     {
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      *mapping = selectionMatrix(imesh->num_nodes(), boundary.nodes);
     }
   }
   
+  copyBoundaryValues(ifield, ofield, boundary);
+  
   CopyProperties(*input, *output);
   
   return (true);
 }
 
+
 AlgorithmOutput GetFieldBoundaryAlgo::run(const AlgorithmInput& input) const
 {
   auto field = input.get<Field>(Variables::InputField);
@@ -55,6 +55,10 @@ public:
   bool run(FieldHandle input, FieldHandle& output) const;
 
   AlgorithmOutput run(const AlgorithmInput& input) const;
+
+private:
+  /// Builds the mapping matrix only when mapping is given
+  bool runImpl(FieldHandle input, FieldHandle& output, Datatypes::MatrixHandle* mapping) const;
 };
 
 }}}}
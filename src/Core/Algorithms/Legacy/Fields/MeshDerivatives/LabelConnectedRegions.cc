@@ -0,0 +1,261 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/LabelConnectedRegions.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
+
+#include <boost/scoped_array.hpp>
+#include <algorithm>
+#include <atomic>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  /// Splitting only pays off once the per-thread ranges are large.
+  int taskCount(size_type size)
+  {
+    return static_cast<int>(std::max<size_type>(1,
+      std::min<size_type>(Parallel::NumCores(), size / 10000)));
+  }
+
+  /// Calls body(proc, begin, end) for numTasks contiguous ranges of [0, size)
+  template <class Body>
+  void runTasks(int numTasks, size_type size, Body body)
+  {
+    auto task = [&](int proc)
+    {
+      body(proc, size * proc / numTasks, size * (proc + 1) / numTasks);
+    };
+
+    if (numTasks == 1)
+      task(0);
+    else
+      Parallel::RunTasks(task, numTasks);
+  }
+
+  /// Union-find that can be joined from several threads at once. A root is
+  /// always linked below a smaller root, so every set ends up rooted at its
+  /// lowest index and parent(i) <= i holds throughout.
+  class DisjointSets
+  {
+  public:
+    explicit DisjointSets(size_type size) : parent_(new std::atomic<index_type>[size]) {}
+
+    void make(index_type i) { parent_[i].store(i); }
+
+    index_type find(index_type i)
+    {
+      while (true)
+      {
+        index_type p = parent_[i].load();
+        if (p == i) return (i);
+        // Path halving: skip a level, unless another thread got there first
+        index_type gp = parent_[p].load();
+        if (gp != p) parent_[i].compare_exchange_weak(p, gp);
+        i = gp;
+      }
+    }
+
+    void unite(index_type a, index_type b)
+    {
+      while (true)
+      {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);
+        // Fails when another thread linked a in the meantime; retry from the new roots
+        index_type expected = a;
+        if (parent_[a].compare_exchange_strong(expected, b)) return;
+      }
+    }
+
+    /// Points i straight at its root; only call once all joins are done
+    index_type flatten(index_type i)
+    {
+      const index_type root = find(i);
+      parent_[i].store(root);
+      return (root);
+    }
+
+    index_type parent(index_type i) const { return (parent_[i].load()); }
+
+  private:
+    boost::scoped_array<std::atomic<index_type> > parent_;
+  };
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Fields {
+
+size_type
+labelConnectedRegions(VMesh* mesh, ElementConnectivity connectivity,
+  std::vector<index_type>& regions, const std::vector<int>* elemLabels)
+{
+  const VMesh::Elem::size_type num_elems = mesh->num_elems();
+  regions.resize(num_elems);
+  if (num_elems == 0) return (0);
+
+  const int numTasks = taskCount(num_elems);
+  DisjointSets sets(num_elems);
+  runTasks(numTasks, num_elems, [&](int, index_type begin, index_type end)
+  {
+    for (index_type e = begin; e < end; ++e) sets.make(e);
+  });
+
+  auto joins = [elemLabels](index_type a, index_type b)
+  {
+    return (!elemLabels || (*elemLabels)[a] == (*elemLabels)[b]);
+  };
+
+  if (connectivity == ElementConnectivity::SharedNode)
+  {
+    mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+    const VMesh::Node::size_type num_nodes = mesh->num_nodes();
+    runTasks(taskCount(num_nodes), num_nodes, [&](int, index_type begin, index_type end)
+    {
+      VMesh::Elem::array_type elems;
+      for (VMesh::Node::index_type idx = begin; idx < end; ++idx)
+      {
+        mesh->get_elems(elems, idx);
+        // Joining each element to the first earlier one it may join with
+        // connects all of them, per label
+        for (size_t p = 1; p < elems.size(); p++)
+        {
+          for (size_t q = 0; q < p; q++)
+          {
+            if (joins(elems[p], elems[q]))
+            {
+              sets.unite(elems[p], elems[q]);
+              break;
+            }
+          }
+        }
+      }
+    });
+  }
+  else
+  {
+    mesh->synchronize(Mesh::ELEM_NEIGHBORS_E|Mesh::DELEMS_E);
+    runTasks(numTasks, num_elems, [&](int, index_type begin, index_type end)
+    {
+      VMesh::DElem::array_type delems;
+      VMesh::Elem::index_type nci;
+      for (VMesh::Elem::index_type ci = begin; ci < end; ++ci)
+      {
+        mesh->get_delems(delems, ci);
+        for (size_t p = 0; p < delems.size(); p++)
+        {
+          if (mesh->get_neighbor(nci, ci, delems[p]) && nci < ci && joins(ci, nci))
+            sets.unite(ci, nci);
+        }
+      }
+    });
+  }
+
+  // Number the roots in ascending order with a prefix sum over the ranges
+  std::vector<size_type> roots(numTasks + 1, 0);
+  runTasks(numTasks, num_elems, [&](int proc, index_type begin, index_type end)
+  {
+    size_type count = 0;
+    for (index_type e = begin; e < end; ++e)
+      if (sets.flatten(e) == e) count++;
+    roots[proc + 1] = count;
+  });
+  for (int proc = 0; proc < numTasks; proc++) roots[proc + 1] += roots[proc];
+
+  runTasks(numTasks, num_elems, [&](int proc, index_type begin, index_type end)
+  {
+    index_type next = roots[proc];
+    for (index_type e = begin; e < end; ++e)
+      if (sets.parent(e) == e) regions[e] = next++;
+  });
+  runTasks(numTasks, num_elems, [&](int, index_type begin, index_type end)
+  {
+    for (index_type e = begin; e < end; ++e)
+    {
+      const index_type root = sets.parent(e);
+      if (root != e) regions[e] = regions[root];
+    }
+  });
+
+  return (roots[numTasks]);
+}
+
+void
+groupByRegion(const std::vector<index_type>& regions, size_type num_regions,
+  std::vector<index_type>& offsets, std::vector<index_type>& items)
+{
+  const size_type size = static_cast<size_type>(regions.size());
+  int numTasks = taskCount(size);
+  // Every task keeps a count per region, which does not pay off for many
+  // small regions
+  if (num_regions * numTasks > size) numTasks = 1;
+
+  std::vector<index_type> counts(numTasks * num_regions, 0);
+  runTasks(numTasks, size, [&](int proc, index_type begin, index_type end)
+  {
+    index_type* count = counts.data() + proc * num_regions;
+    for (index_type i = begin; i < end; ++i)
+      if (regions[i] >= 0) count[regions[i]]++;
+  });
+
+  // Turn the counts into the first slot of every task within every region,
+  // so the ranges land in order
+  offsets.assign(num_regions + 1, 0);
+  index_type total = 0;
+  for (index_type r = 0; r < num_regions; r++)
+  {
+    offsets[r] = total;
+    for (int proc = 0; proc < numTasks; proc++)
+    {
+      index_type& count = counts[proc * num_regions + r];
+      const index_type c = count;
+      count = total;
+      total += c;
+    }
+  }
+  offsets[num_regions] = total;
+
+  items.resize(total);
+  runTasks(numTasks, size, [&](int proc, index_type begin, index_type end)
+  {
+    index_type* slot = counts.data() + proc * num_regions;
+    for (index_type i = begin; i < end; ++i)
+      if (regions[i] >= 0) items[slot[regions[i]]++] = i;
+  });
+}
+
+}}}}
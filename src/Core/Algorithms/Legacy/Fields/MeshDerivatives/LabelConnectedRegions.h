@@ -0,0 +1,73 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+///
+///@file LabelConnectedRegions
+///@brief
+/// Parallel connected-component labelling of mesh elements.
+///
+///@details
+/// Elements are joined with a lock-free union-find, either through shared
+/// nodes or through shared faces. Given element labels, only neighbors with
+/// the same label are joined, which splits a multi-tissue mesh into its
+/// connected tissue pieces.
+
+#ifndef CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_LABELCONNECTEDREGIONS_H
+#define CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_LABELCONNECTEDREGIONS_H 1
+
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+#include <vector>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Fields {
+
+enum class ElementConnectivity
+{
+  SharedNode,
+  SharedFace
+};
+
+/// Sets regions[e] to the connected region of element e and returns the
+/// number of regions. Regions are numbered in the order of their lowest
+/// element index. With elemLabels, only elements with the same label join.
+SCISHARE size_type labelConnectedRegions(VMesh* mesh, ElementConnectivity connectivity,
+  std::vector<index_type>& regions, const std::vector<int>* elemLabels = 0);
+
+/// Counting sort of the indices 0..regions.size()-1 by region: the items of
+/// region r are items[offsets[r]] to items[offsets[r+1]-1], in ascending
+/// order. Indices with a negative region are left out.
+SCISHARE void groupByRegion(const std::vector<index_type>& regions, size_type num_regions,
+  std::vector<index_type>& offsets, std::vector<index_type>& items);
+
+}}}}
+
+#endif
@@ -28,17 +28,20 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/SplitByConnectedRegion.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/LabelConnectedRegions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/Mesh.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmInputName SplitFieldByConnectedRegionAlgo::InputField("InputField");
 AlgorithmOutputName SplitFieldByConnectedRegionAlgo::OutputField1("OutputField1");
@@ -113,6 +116,7 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
   {
     output.push_back(input);
     remark("Structured meshes consist always of one piece. Hence there is no algorithm to perform."); 
+    return output;
   }  
   
   if (fi.is_pointcloudmesh())
@@ -123,156 +127,100 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
   VField* ifield = input->vfield();
   VMesh*  imesh  = input->vmesh();
 
-  VField::index_type k = 0;
+  VMesh::Node::size_type num_nodes = imesh->num_nodes();
 
-  VMesh::size_type num_nodes = imesh->num_nodes(); 
-  VMesh::size_type num_elems = imesh->num_elems(); 
-  
-  VField::size_type surfsize = static_cast<VField::size_type>(pow(num_elems, 2.0 / 3.0));
-  std::vector<VMesh::Elem::index_type> buffer;
-  buffer.reserve(surfsize);
-  
-  imesh->synchronize(Mesh::NODE_NEIGHBORS_E|Mesh::ELEM_NEIGHBORS_E|Mesh::DELEMS_E); 
-
-  std::vector<index_type> elemmap(num_elems, 0);
-  std::vector<index_type> nodemap(num_nodes, 0);
-  std::vector<index_type> renumber(num_nodes,0);
-  std::vector<short> visited(num_elems, 0);
+  /// Regions are numbered in the order of their lowest element index
+  std::vector<index_type> elemmap;
+  const size_type k = labelConnectedRegions(imesh, ElementConnectivity::SharedNode, elemmap);
 
-  VMesh::Node::array_type nnodes;
-  VMesh::Elem::array_type neighbors;
- 
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  /// A node belongs to the region of the elements around it, unused nodes
+  /// to none
+  const int np = Parallel::NumCores();
+  std::vector<index_type> nodemap(num_nodes);
+  Parallel::RunTasks([&](int proc)
   {
-    // if list of elements to process is empty ad the next one
-    if (buffer.size() == 0)
-    {
-      if(visited[idx] == 0) { buffer.push_back(idx); k++; }
-    }
-    
-    if (buffer.size() > 0)
+    VMesh::Elem::array_type elems;
+    for (index_type q = num_nodes*proc/np; q < num_nodes*(proc+1)/np; q++)
     {
-      for (size_t i=0; i< buffer.size(); i++)
-      {
-        VField::index_type j = buffer[i];
-        if (visited[j] > 0) { continue; }
-        visited[j] = 1;
-        
-        imesh->get_nodes(nnodes,buffer[i]);
-        for (size_t q=0; q<nnodes.size(); q++)
-        {
-          imesh->get_elems(neighbors,nnodes[q]);
-          for (size_t p=0; p<neighbors.size(); p++)
-          {
-            if(visited[neighbors[p]] == 0)
-            {
-              buffer.push_back(neighbors[p]);
-              visited[neighbors[p]] = -1;            
-            }
-          }
-        }
-         
-        if (j >= static_cast<index_type>(elemmap.size())) elemmap.resize(j+1);
-        
-        elemmap[j] = k;
-        for (size_t p=0;p<nnodes.size();p++)
-        {
-          if (static_cast<size_t>(nnodes[p]) >= nodemap.size())
-            nodemap.resize(nnodes[p]+1);      
-          nodemap[nnodes[p]] = k;
-        }
-      }
-      buffer.clear();
+      imesh->get_elems(elems, VMesh::Node::index_type(q));
+      nodemap[q] = elems.empty() ? -1 : elemmap[elems[0]];
     }
-  }
- 
- output.resize(k);
-  for (size_type p=0; p<k; p++)
+  }, np);
+
+  /// Both lists stay in ascending order within every region
+  std::vector<index_type> nodeoffsets, nodes, elemoffsets, elems;
+  groupByRegion(nodemap, k, nodeoffsets, nodes);
+  groupByRegion(elemmap, k, elemoffsets, elems);
+
+  const size_type num_region_nodes = static_cast<size_type>(nodes.size());
+  const size_type num_region_elems = static_cast<size_type>(elems.size());
+
+  std::vector<index_type> renumber(num_nodes, 0);
+  Parallel::RunTasks([&](int proc)
   {
-    VField* ofield;
-    VMesh* omesh;
-    MeshHandle mesh;
-    FieldHandle field;
+    for (index_type j = num_region_nodes*proc/np; j < num_region_nodes*(proc+1)/np; j++)
+      renumber[nodes[j]] = j - nodeoffsets[nodemap[nodes[j]]];
+  }, np);
 
-    VField::size_type nn = 0;
-    VField::size_type ne = 0;
-    
-    for (VField::index_type q=0;q<num_nodes;q++) if (nodemap[q] == p+1) nn++;
-    for (VField::index_type q=0;q<num_elems;q++) if (elemmap[q] == p+1) ne++;
-    
-    mesh = CreateMesh(fi);
+  output.resize(k);
+  std::vector<VField*> ofields(k);
+  std::vector<Point*> opoints(k);
+  std::vector<VMesh::index_type*> oelems(k);
+  for (size_type p=0; p<k; p++)
+  {
+    MeshHandle mesh = CreateMesh(fi);
     if (!mesh)
     {
       THROW_ALGORITHM_INPUT_ERROR("Could not create output field.");
     }
-    omesh = mesh->vmesh();
-
-    omesh->node_reserve(nn);
-    omesh->elem_reserve(ne);
+    VMesh* omesh = mesh->vmesh();
+    omesh->resize_nodes(nodeoffsets[p+1] - nodeoffsets[p]);
+    omesh->resize_elems(elemoffsets[p+1] - elemoffsets[p]);
 
-    field = CreateField(fi,mesh);
+    FieldHandle field = CreateField(fi,mesh);
     if (field == nullptr)
     {
       THROW_ALGORITHM_INPUT_ERROR("Could not create output field");
-    }      
-    
-    ofield = field->vfield();
+    }
+
+    ofields[p] = field->vfield();
+    ofields[p]->resize_fdata();
+    opoints[p] = omesh->get_points_pointer();
+    oelems[p] = omesh->get_elems_pointer();
     output[p] = field;
 
-    Point point;
-    for (index_type q=0;q<num_nodes;q++) 
-    {  
-      if (nodemap[q] == p+1) 
-      {
-        imesh->get_center(point,VMesh::Node::index_type(q));
-        renumber[q] = omesh->add_point(point);
-      }
-    }
-    
-    VMesh::Node::array_type elemnodes;
-    for (index_type q=0;q<num_elems;q++) 
-    {  
-      if (elemmap[q] == p+1) 
-      {   
-        imesh->get_nodes(elemnodes,VMesh::Elem::index_type(q));
-        for (size_t r=0; r< elemnodes.size(); r++)
-        {
-          elemnodes[r] = VMesh::Node::index_type(renumber[elemnodes[r]]);
-        }
-        omesh->add_elem(elemnodes);
-      }
-    }
-    
-    ofield->resize_fdata();
+   #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
+    ofields[p]->copy_properties(ifield);
+   #endif
+  }
 
-    if (ifield->basis_order() == 1)
+  /// Fill all regions at once, so one large region does not end up on a
+  /// single thread
+  const size_type nodes_per_elem = static_cast<size_type>(imesh->num_nodes_per_elem());
+  Parallel::RunTasks([&](int proc)
+  {
+    for (index_type j = num_region_nodes*proc/np; j < num_region_nodes*(proc+1)/np; j++)
     {
-      VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_nodes;q++) 
-      {  
-        if (nodemap[q] == p+1) 
-        {
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
-      }
+      const index_type q = nodes[j];
+      const index_type p = nodemap[q];
+      imesh->get_center(opoints[p][renumber[q]], VMesh::Node::index_type(q));
+      if (ifield->basis_order() == 1) ofields[p]->copy_value(ifield, q, renumber[q]);
     }
-    
-    if (ifield->basis_order() == 0)
+
+    VMesh::Node::array_type elemnodes;
+    for (index_type j = num_region_elems*proc/np; j < num_region_elems*(proc+1)/np; j++)
     {
-      VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_elems;q++) 
-      {  
-        if (elemmap[q] == p+1) 
-        {   
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
-      }    
+      const index_type q = elems[j];
+      const index_type p = elemmap[q];
+      const index_type qq = j - elemoffsets[p];
+      imesh->get_nodes(elemnodes, VMesh::Elem::index_type(q));
+      for (size_t r=0; r< elemnodes.size(); r++)
+      {
+        oelems[p][qq*nodes_per_elem + r] = renumber[elemnodes[r]];
+      }
+      if (ifield->basis_order() == 0) ofields[p]->copy_value(ifield, q, qq);
     }
-   
-   #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-    ofield->copy_properties(ifield);
-   #endif
-  }
+  }, np);
 
   if (sortDomainBySize)
   {
@@ -36,7 +36,9 @@
 #include <Core/GeometryPrimitives/Point.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Eigen/SVD>
+#include <Eigen/LU>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Thread/Parallel.h>
 
 #include <sstream>
 
@@ -46,6 +48,7 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 static void printMatrix(const DenseMatrix& m, const std::string& tag = "tag")
 {
@@ -142,7 +145,6 @@ bool RegisterWithCorrespondencesAlgo::runM(FieldHandle input, FieldHandle Cors1,
   imesh->size(num_pts);
 
   std::vector<double> coefs;//(3*num_cors1+9);
-  std::vector<double> rside;//(3*num_cors1+9);
   if (num_cors1 != num_cors2)
   {
     error("Number of correspondence points does not match");
@@ -219,15 +221,16 @@ bool RegisterWithCorrespondencesAlgo::runM(FieldHandle input, FieldHandle Cors1,
     imesh->set_point(mypoint, idx);
   }
 
-  //create B for big matrix//
-  DenseMatrix Bm(num_cors1 + 4, num_cors1 + 4);
-  VMesh::Node::iterator it;
+  // The full system is block diagonal, with the same (n+4) block for x, y
+  // and z: factor that block once and solve it for all three coordinates.
+  const int n = static_cast<int>(num_cors1);
+  DenseMatrix Bm(n + 4, n + 4);
+  Bm.setZero();
   SCIRun::Core::Geometry::Point P;
 
-  for (int L1 = 0; L1 < num_cors1; ++L1)
+  for (int L1 = 0; L1 < n; ++L1)
   {
-    it = L1;
-    icors2->get_point(P, *(it));
+    icors2->get_point(P, VMesh::Node::index_type(L1));
     //horizontal x,y,z
     Bm(0, L1) = P.x();
     Bm(1, L1) = P.y();
@@ -235,126 +238,38 @@ bool RegisterWithCorrespondencesAlgo::runM(FieldHandle input, FieldHandle Cors1,
     Bm(3, L1) = 1;
 
     //vertical x,y,z
-    Bm(L1 + 4, num_cors1) = P.x();
-    Bm(L1 + 4, num_cors1 + 1) = P.y();
-    Bm(L1 + 4, num_cors1 + 2) = P.z();
-    Bm(L1 + 4, num_cors1 + 3) = 1;
-  }
-
-  for (int L1 = num_cors1; L1 < num_cors1 + 4; ++L1)
-  {
-    Bm(0, L1) = 0;
-    Bm(1, L1) = 0;
-    Bm(2, L1) = 0;
-    Bm(3, L1) = 0;
+    Bm(L1 + 4, n) = P.x();
+    Bm(L1 + 4, n + 1) = P.y();
+    Bm(L1 + 4, n + 2) = P.z();
+    Bm(L1 + 4, n + 3) = 1;
   }
 
   //put in sigmas
   DenseMatrixHandle SMat;
   radial_basis_func(icors2, icors2, SMat);
-
-  for (int i = 0; i < num_cors1; ++i)
-  {
-    for (int j = 0; j < num_cors1; ++j)
-    {
-      Bm(4 + i, j) = SMat->get(i, j);
-    }
-  }
-
-  //Create big matrix //
-  DenseMatrix BigMat(3 * num_cors1 + 12, 3 * num_cors1 + 12);
-
-  for (int i = 0; i < (3 * num_cors1 + 12); ++i)
-  {
-    for (int j = 0; j < (3 * num_cors1 + 12); ++j)
-    {
-      BigMat(i, j) = 0;
-    }
-  }
-  for (int i = 0; i < (num_cors1 + 4); ++i)
-  {
-    for (int j = 0; j < (num_cors1 + 4); ++j)
-    {
-      BigMat(i, j) = Bm(i, j);
-    }
-  }
-  for (int i = 0; i < (num_cors1 + 4); ++i)
-  {
-    for (int j = 0; j < (num_cors1 + 4); ++j)
-    {
-      BigMat(num_cors1 + 4 + i, num_cors1 + 4 + j) = Bm(i, j);
-    }
-  }
-  for (int i = 0; i < (num_cors1 + 4); ++i)
-  {
-    for (int j = 0; j < (num_cors1 + 4); ++j)
-    {
-      BigMat(2 * num_cors1 + 8 + i, 2 * num_cors1 + 8 + j) = Bm(i, j); 
-    }
-  }
+  Bm.block(4, 0, n, n) = *SMat;
 
   //create right side of equation//
-  for (int i = 0; i < 4; ++i){ rside.push_back(0); }
-  for (int i = 0; i < num_cors1; ++i)
-  {
-    it = i;
-    icors1->get_point(P, *(it));
-    rside.push_back(P.x());
-  }
-  for (int i = 0; i < 4; ++i){ rside.push_back(0); }
-  for (int i = 0; i < num_cors1; ++i)
+  DenseMatrix RsideMat(n + 4, 3);
+  RsideMat.setZero();
+  for (int i = 0; i < n; ++i)
   {
-    it = i;
-    icors1->get_point(P, *(it));
-    rside.push_back(P.y());
-  }
-  for (int i = 0; i < 4; ++i){ rside.push_back(0); }
-  for (int i = 0; i < num_cors1; ++i)
-  {
-    it = i;
-    icors1->get_point(P, *(it));
-    rside.push_back(P.z());
+    icors1->get_point(P, VMesh::Node::index_type(i));
+    RsideMat(i + 4, 0) = P.x();
+    RsideMat(i + 4, 1) = P.y();
+    RsideMat(i + 4, 2) = P.z();
   }
 
   //Solve system of equations//
-  // Bigm->solve(rside,coefs,0);
-  //Use svd linear least squares
-
-  //Create sparse matrix for sigmas of svd
-
-  int m = 3 * num_cors1 + 12;
-  int n = 3 * num_cors1 + 12;
+  Eigen::PartialPivLU<DenseMatrix::EigenBase> lu(Bm);
+  DenseMatrix CoefMat = lu.solve(RsideMat);
 
-  //create the U and V matrix
-  Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(BigMat, Eigen::ComputeFullU | Eigen::ComputeFullV);
-  DenseMatrix UMat = svd_mat.matrixU();
-  DenseMatrix VMat = svd_mat.matrixV();
-  DenseMatrix matSingularValues = svd_mat.singularValues();
-
-  //Make more storage for the solving the linear least squares
-  DenseMatrix RsideMat(m, 1);
-  DenseMatrix CMat(n, 1);
-  DenseMatrix YMat(n, 1);
-  DenseMatrix CoefMat(n, 1);
-
-  for (int loop = 0; loop < n; ++loop)
-  {
-    RsideMat(loop, 0) = rside[loop];
-  }
-
-  //c=trans(Um)*rside;
-  CMat = UMat.transpose() * RsideMat;
-
-  for (int k = 0; k<n; k++)
+  for (int xyz = 0; xyz < 3; ++xyz)
   {
-    YMat(k, 0) = CMat(k, 0) / matSingularValues(k, 0);
-  }
-
-  CoefMat = VMat * YMat;
-
-  for (int p = 0; p < n; p++)
-  {
-    coefs.push_back(CoefMat(p, 0));
+    for (int p = 0; p < n + 4; p++)
+    {
+      coefs.push_back(CoefMat(p, xyz));
+    }
   }
 
   //done with solve, make the new field
@@ -905,116 +820,115 @@ bool RegisterWithCorrespondencesAlgo::runN(FieldHandle input, FieldHandle Cors1,
   return (true);
 }
 
-bool RegisterWithCorrespondencesAlgo::radial_basis_func(VMesh* Cors, VMesh* points, DenseMatrixHandle& Sigma) const
+namespace
 {
-  VMesh::Node::size_type num_cors, num_pts;
-  VMesh::Node::iterator iti, itj;
-  Point Pc, Pp;
-
-  Cors->size(num_cors);
-  points->size(num_pts);
-
-  double xcomp = 0.0, ycomp = 0.0, zcomp = 0.0, mag = 0.0;
+  // Thin plate spline kernel r^2 log(r), written in terms of r^2
+  inline double thin_plate_kernel(double r2)
+  {
+    return (r2 == 0.0 ? 0.0 : 0.5 * r2 * log(r2));
+  }
 
-  Sigma.reset(new DenseMatrix(num_pts, num_cors));
+  std::vector<Point> mesh_points(VMesh* mesh)
+  {
+    VMesh::Node::size_type num;
+    mesh->size(num);
+    std::vector<Point> points(num);
+    for (VMesh::Node::index_type i = 0; i < num; ++i)
+      mesh->get_point(points[i], i);
+    return points;
+  }
 
-  for (int i = 0; i < num_pts; ++i)
+  // Runs body(begin, end) over contiguous index ranges, one per core
+  template <class Body>
+  void run_ranges(VMesh::size_type size, Body body)
   {
-    for (int j = 0; j < num_cors; ++j)
+    const int np = Parallel::NumCores();
+    auto task = [&](int proc)
     {
-      iti = i;
-      itj = j;
+      body(static_cast<VMesh::index_type>(size * proc / np),
+           static_cast<VMesh::index_type>(size * (proc + 1) / np));
+    };
+    Parallel::RunTasks(task, np);
+  }
+}
 
-      Cors->get_point(Pc, *(itj));
-      points->get_point(Pp, *(iti));
+bool RegisterWithCorrespondencesAlgo::radial_basis_func(VMesh* Cors, VMesh* points, DenseMatrixHandle& Sigma) const
+{
+  const std::vector<Point> cors = mesh_points(Cors);
+  const std::vector<Point> pts = mesh_points(points);
+  const VMesh::size_type num_cors = static_cast<VMesh::size_type>(cors.size());
 
-      xcomp = Pc.x() - Pp.x();
-      ycomp = Pc.y() - Pp.y();
-      zcomp = Pc.z() - Pp.z();
+  Sigma.reset(new DenseMatrix(pts.size(), cors.size()));
+  DenseMatrix& S = *Sigma;
 
-      mag = sqrt(pow(xcomp, 2.0) + pow(ycomp, 2.0) + pow(zcomp, 2.0));
-      if (mag == 0)
-      {
-        (*Sigma)(i, j) = 0;
-      }
-      else
+  run_ranges(static_cast<VMesh::size_type>(pts.size()), [&](VMesh::index_type begin, VMesh::index_type end)
+  {
+    for (VMesh::index_type i = begin; i < end; ++i)
+    {
+      for (VMesh::index_type j = 0; j < num_cors; ++j)
       {
-        double temp = pow(mag, 2.0)*log(mag);
-        (*Sigma)(i, j) = temp;
+        S(i, j) = thin_plate_kernel((cors[j] - pts[i]).length2());
       }
     }
-  }
+  });
   return true;
 }
 
 bool RegisterWithCorrespondencesAlgo::make_new_points(VMesh* points, VMesh* Cors, const std::vector<double>& coefs, VMesh& omesh, double sumx, double sumy, double sumz) const
 {
-  VMesh::Node::size_type num_cors, num_pts;
-  VMesh::Node::iterator it, itp;
-  Point P, Pp;
-
-  Cors->size(num_cors);
+  VMesh::Node::size_type num_pts;
   points->size(num_pts);
 
-  int sz = 0;
-  double sumerx = 0, sumery = 0, sumerz = 0;
-  double sigma = 0.0;
-  DenseMatrixHandle SMat;
-  radial_basis_func(Cors, points, SMat);
+  // The kernel is summed on the fly: an explicit points x correspondences
+  // matrix does not fit in memory for large meshes.
+  const std::vector<Point> cors = mesh_points(Cors);
+  const int sz = static_cast<int>(cors.size());
 
-  for (int i = 0; i < num_pts; ++i)
+  run_ranges(num_pts, [&](VMesh::index_type begin, VMesh::index_type end)
   {
-    sumerx = 0; sumery = 0; sumerz = 0;
-    for (int j = 0; j < num_cors; ++j)
+    Point P, Pp;
+    for (VMesh::Node::index_type i = begin; i < end; ++i)
     {
-      sigma = SMat->get(i, j);
-      sumerx += coefs[j] * sigma;
-      sumery += coefs[j + 4 + num_cors] * sigma;
-      sumerz += coefs[j + 8 + 2 * num_cors] * sigma;
-    }
-
-    itp = i;
-    points->get_point(Pp, *(itp));
-    sz = (int)num_cors;
+      points->get_point(Pp, i);
 
+      double sumerx = 0, sumery = 0, sumerz = 0;
+      for (int j = 0; j < sz; ++j)
+      {
+        const double sigma = thin_plate_kernel((cors[j] - Pp).length2());
+        sumerx += coefs[j] * sigma;
+        sumery += coefs[j + 4 + sz] * sigma;
+        sumerz += coefs[j + 8 + 2 * sz] * sigma;
+      }
 
-    P.x(sumx + sumerx + (Pp.x()) * (coefs[sz]) + (Pp.y()) * (coefs[sz + 1]) + (Pp.z()) * (coefs[sz + 2]) + coefs[sz + 3]);
-    P.y(sumy + sumery + (Pp.x()) * coefs[2 * sz + 4] + (Pp.y())*coefs[2 * sz + 5] + (Pp.z())*coefs[2 * sz + 6] + coefs[2 * sz + 7]);
-    P.z(sumz + sumerz + (Pp.x()) * coefs[3 * sz + 8] + (Pp.y())*coefs[3 * sz + 9] + (Pp.z())*coefs[3 * sz + 10] + coefs[3 * sz + 11]);
+      P.x(sumx + sumerx + (Pp.x()) * (coefs[sz]) + (Pp.y()) * (coefs[sz + 1]) + (Pp.z()) * (coefs[sz + 2]) + coefs[sz + 3]);
+      P.y(sumy + sumery + (Pp.x()) * coefs[2 * sz + 4] + (Pp.y())*coefs[2 * sz + 5] + (Pp.z())*coefs[2 * sz + 6] + coefs[2 * sz + 7]);
+      P.z(sumz + sumerz + (Pp.x()) * coefs[3 * sz + 8] + (Pp.y())*coefs[3 * sz + 9] + (Pp.z())*coefs[3 * sz + 10] + coefs[3 * sz + 11]);
 
-    omesh.set_point(P, *(itp));
-  }
+      omesh.set_point(P, i);
+    }
+  });
   return true;
 }
 
 bool RegisterWithCorrespondencesAlgo::make_new_pointsA(VMesh* points, VMesh* Cors, const std::vector<double>& coefs, VMesh& omesh, double sumx, double sumy, double sumz) const
 {
-  VMesh::Node::size_type num_cors, num_pts;
-  VMesh::Node::iterator it, itp;
-  Point P, Pp;
-
+  VMesh::Node::size_type num_pts;
   points->size(num_pts);
 
-#if 0
-  std::cout << "make new points A inputs" <<
-    "\ncoefs: " << coefs.size()
-    << "\nsumx: " << sumx
-    << "\nsumy: " << sumy
-    << "\nsumz: " << sumz << "\n" << std::endl;
-  std::copy(coefs.begin(), coefs.end(), std::ostream_iterator<double>(std::cout, "\n"));
-#endif
-
-  for (int i = 0; i < num_pts; ++i)
+  run_ranges(num_pts, [&](VMesh::index_type begin, VMesh::index_type end)
   {
-    itp = i;
-    points->get_point(Pp, *(itp));
+    Point P, Pp;
+    for (VMesh::Node::index_type i = begin; i < end; ++i)
+    {
+      points->get_point(Pp, i);
 
-    P.x(sumx + (Pp.x()) * (coefs[0]) + (Pp.y()) * (coefs[1]) + (Pp.z()) * (coefs[2]) + coefs[3]);
-    P.y(sumy + (Pp.x()) * coefs[4] + (Pp.y())*coefs[5] + (Pp.z())*coefs[6] + coefs[7]);
-    P.z(sumz + (Pp.x()) * coefs[8] + (Pp.y())*coefs[9] + (Pp.z())*coefs[10] + coefs[11]);
+      P.x(sumx + (Pp.x()) * (coefs[0]) + (Pp.y()) * (coefs[1]) + (Pp.z()) * (coefs[2]) + coefs[3]);
+      P.y(sumy + (Pp.x()) * coefs[4] + (Pp.y())*coefs[5] + (Pp.z())*coefs[6] + coefs[7]);
+      P.z(sumz + (Pp.x()) * coefs[8] + (Pp.y())*coefs[9] + (Pp.z())*coefs[10] + coefs[11]);
 
-    omesh.set_point(P, *(itp));
-  }
+      omesh.set_point(P, i);
+    }
+  });
   return true;
 }
 
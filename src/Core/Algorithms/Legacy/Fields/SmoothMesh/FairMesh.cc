@@ -30,6 +30,8 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -37,12 +39,81 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
 
 ALGORITHM_PARAMETER_DEF(Fields, FairMeshMethod);
 ALGORITHM_PARAMETER_DEF(Fields, NumIterations);
 ALGORITHM_PARAMETER_DEF(Fields, Lambda);
 ALGORITHM_PARAMETER_DEF(Fields, FilterCutoff);
 
+namespace detail
+{
+
+/// Node positions as separate coordinate arrays
+struct NodeCoordinates
+{
+  std::vector<double> x, y, z;
+
+  Point point(VMesh::index_type idx) const { return (Point(x[idx],y[idx],z[idx])); }
+};
+
+/// Taubin lambda/mu smoothing: even iterations move every node by lambda
+/// times its displacement, odd ones by mu. Each iteration reads one copy of
+/// the coordinates and writes the other, so the nodes can be updated in
+/// parallel.
+template <class Displacement, class Progress>
+void smooth(Point* point, VMesh::size_type num_nodes, int num_iter, double lambda, double mu,
+  const Displacement& displacement, const Progress& progress)
+{
+  NodeCoordinates current;
+  current.x.resize(num_nodes);
+  current.y.resize(num_nodes);
+  current.z.resize(num_nodes);
+  for (VMesh::index_type idx=0; idx<num_nodes; idx++)
+  {
+    current.x[idx] = point[idx].x();
+    current.y[idx] = point[idx].y();
+    current.z[idx] = point[idx].z();
+  }
+  NodeCoordinates next = current;
+
+  // Splitting only pays off once the per-thread ranges are large.
+  const int numTasks = static_cast<int>(std::max<VMesh::size_type>(1,
+    std::min<VMesh::size_type>(Parallel::NumCores(), num_nodes / 10000)));
+
+  for (int it = 0; it<num_iter; it++)
+  {
+    const double factor = (it % 2 == 0) ? lambda : mu;
+    auto task = [&](int i)
+    {
+      const VMesh::index_type begin = num_nodes * i / numTasks;
+      const VMesh::index_type end = num_nodes * (i + 1) / numTasks;
+      for (VMesh::index_type idx=begin; idx<end; idx++)
+      {
+        const Vector d = displacement(current,idx);
+        next.x[idx] = current.x[idx] + factor*d.x();
+        next.y[idx] = current.y[idx] + factor*d.y();
+        next.z[idx] = current.z[idx] + factor*d.z();
+      }
+    };
+
+    if (numTasks == 1)
+      task(0);
+    else
+      Parallel::RunTasks(task, numTasks);
+
+    std::swap(current,next);
+    progress(it,num_iter);
+  }
+
+  for (VMesh::index_type idx=0; idx<num_nodes; idx++)
+  {
+    point[idx] = current.point(idx);
+  }
+}
+
+}
+
 FairMeshAlgo::FairMeshAlgo()
 {
   addOption(Parameters::FairMeshMethod,"fast","fast|desbrun");
@@ -88,52 +159,48 @@ bool FairMeshAlgo::runImpl(FieldHandle input,FieldHandle& output) const
   VMesh::size_type num_nodes = mesh->num_nodes();
   mesh->unsynchronize(Mesh::NORMALS_E);
 
+  auto progress = [this](int it, int num) { update_progress_max(it,num); };
+  Point* point = mesh->get_points_pointer();
+
   if (method == "fast")
   {
-    // Fast neighborhoods
-    std::vector<VMesh::Node::array_type > neighborhoods(num_nodes);
+    // Fast neighborhoods, stored flat: the neighbors of node idx are
+    // neighbors[offsets[idx]] .. neighbors[offsets[idx+1]-1]
+    std::vector<VMesh::index_type> offsets(num_nodes+1,0);
+    std::vector<VMesh::index_type> neighbors;
     mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
 
+    VMesh::Node::array_type nodes;
     for (VMesh::Node::index_type idx=0; idx<num_nodes; idx++)
     {
-      mesh->get_neighbors(neighborhoods[idx],idx);
+      mesh->get_neighbors(nodes,idx);
+      neighbors.insert(neighbors.end(),nodes.begin(),nodes.end());
+      offsets[idx+1] = static_cast<VMesh::index_type>(neighbors.size());
     }
 
-    std::vector<Vector> disp(num_nodes);
-    Point*  point = mesh->get_points_pointer();
-    Point p0;
-    for (int it = 0; it<num_iter; it++)
+    auto displacement = [&](const detail::NodeCoordinates& c, VMesh::index_type idx) -> Vector
     {
-      for (VMesh::index_type idx=0; idx<num_nodes;idx++)
-      {
-        p0 = point[idx];
-        Vector d(0.0,0.0,0.0);
-        VMesh::Node::array_type &neighbors = neighborhoods[idx];
-        double w = 1.0/(neighbors.size());
-        for (size_t j=0; j<neighbors.size(); j++)
-        {
-          d += w* (point[neighbors[j]]-p0);
-        }
-        disp[idx] = d;
-      }
+      const VMesh::index_type begin = offsets[idx];
+      const VMesh::index_type end = offsets[idx+1];
+      if (begin == end) return (Vector(0.0,0.0,0.0));
 
-      if (it % 2 == 0)
+      double dx = 0.0, dy = 0.0, dz = 0.0;
+      for (VMesh::index_type j=begin; j<end; j++)
       {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+ lambda*disp[idx];
-      }  
-      else
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+  mu*disp[idx];      
+        const VMesh::index_type n = neighbors[j];
+        dx += c.x[n]; dy += c.y[n]; dz += c.z[n];
       }
-      update_progress_max(it,num_iter);
-    }
+      const double w = 1.0/(end-begin);
+      return (Vector(w*dx-c.x[idx],w*dy-c.y[idx],w*dz-c.z[idx]));
+    };
+
+    detail::smooth(point,num_nodes,num_iter,lambda,mu,displacement,progress);
   }
   else
   {
-    // desbrun method
-    std::vector<std::vector<std::pair<VMesh::index_type,VMesh::index_type> > > neighborhoods(num_nodes);
+    // desbrun method, with the opposite edges of each node stored flat
+    std::vector<VMesh::index_type> offsets(num_nodes+1,0);
+    std::vector<std::pair<VMesh::index_type,VMesh::index_type> > neighborhoods;
     mesh->synchronize(Mesh::NODE_NEIGHBORS_E|Mesh::EPSILON_E);
 
     VMesh::Elem::array_type elems;
@@ -141,110 +208,83 @@ bool FairMeshAlgo::runImpl(FieldHandle input,FieldHandle& output) const
 
     for (VMesh::Node::index_type idx=0; idx<num_nodes; idx++)
     {
-      std::vector<std::pair<VMesh::index_type,VMesh::index_type> > &neighborhood = neighborhoods[idx];
       mesh->get_elems(elems,idx);
       for (size_t j = 0; j<elems.size(); j++)
       {
         mesh->get_nodes(nodes,elems[j]);
         // make it circular
         nodes.push_back(nodes[0]);
- 
+
         for (size_t k=1;k < nodes.size();k++)
         {
           // get all edges that are not connected to the node itself
           if(nodes[k-1] != idx && nodes[k] != idx)
           {
-            neighborhood.push_back(std::pair<VMesh::index_type,VMesh::index_type>(nodes[k-1],nodes[k]));
+            neighborhoods.push_back(std::pair<VMesh::index_type,VMesh::index_type>(nodes[k-1],nodes[k]));
           }
         }
       }
+      offsets[idx+1] = static_cast<VMesh::index_type>(neighborhoods.size());
     }
-    
-    std::vector<Vector> disp(num_nodes);
-    Point*  point = mesh->get_points_pointer();
-    Point p0;
 
     double epsilon = mesh->get_epsilon();
 
-    for (int it = 0; it<num_iter; it++)
+    auto displacement = [&](const detail::NodeCoordinates& c, VMesh::index_type idx) -> Vector
     {
-    
-      for (VMesh::index_type idx=0; idx<num_nodes;idx++)
+      // Center location of this node
+      const Point p0 = c.point(idx);
+      Vector d(0.0,0.0,0.0);
+
+      // total weight
+      double totw = 0.0;
+
+      for (VMesh::index_type j = offsets[idx]; j < offsets[idx+1]; j++)
       {
-        // Center location of this node
-        p0 = point[idx];
-        Vector d(0.0,0.0,0.0);
-        
-        // neighborhood points
-        Point p1, p2, p3;
-        Vector p12;
-        
-        // get local neighborhood pairs
-        const std::vector<std::pair<VMesh::index_type,VMesh::index_type> > &neighborhood = neighborhoods[idx];
-        
-        // if no neighborhood continue
-        if (neighborhood.empty()) continue;
-  
-        // total weight
-        double totw = 0.0;
-    
-        for (size_t j = 0; j < neighborhood.size(); j++) 
+        const Point p1 = c.point(neighborhoods[j].first);
+        const Point p2 = c.point(neighborhoods[j].second);
+
+        // vectors pointing to the two neighbor nodes
+        Vector e1 = p2-p0;
+        Vector e2 = p1-p0;
+
+        // Get vector between neighbors
+        Vector p12 = p1-p2;
+
+        // Squared distance between neighbors
+        double e = Dot(p12,p12);
+
+        if (e > 0.0)
         {
-          p1 = point[neighborhood[j].first];
-          p2 = point[neighborhood[j].second];
-
-          // vectors pointing to the two neighbor nodes
-          Vector e1 = p2-p0;
-          Vector e2 = p1-p0;
-          
-          // Get vector between neighbors
-          p12 = p1-p2;
-          
-          // Squared distance between neighbors
-          double e = Dot(p12,p12);
-          
-          if (e > 0.0)
+          double dot = Dot(p1-p0,p12)/e;
+          Point p3 = p1 - dot*p12;
+
+          double A = (p1-p3).length();
+          double B = (p0-p3).length();
+          double C = (p2-p3).length();
+
+          // if B approaches zero, we have a flat
+          // triangle, hence we need to bounce back the node
+          // towards the other side. Hence ignoring these
+          // directions
+          if (B >= 10*epsilon)
           {
-            double dot = Dot(p1-p0,p12)/e;
-            p3 = p1 - dot*p12;
-            
-            double A = (p1-p3).length();
-            double B = (p0-p3).length();
-            double C = (p2-p3).length();
-            
-            // if B approaches zero, we have a flat
-            // triangle, hence we need to bounce back the node 
-            // towards the other side. Hence ignoring these
-            // directions
-            if (B >= 10*epsilon)
-            {
-              if (dot < 0.0) A = -A;
-              if (dot > 1.0) C = -C;
-              totw += (A+C)/B;
-         
-              d += (A/B)*e1 + (C/B)*e2;
-            }
+            if (dot < 0.0) A = -A;
+            if (dot > 1.0) C = -C;
+            totw += (A+C)/B;
+
+            d += (A/B)*e1 + (C/B)*e2;
           }
         }
-
-        /// set the displacement vector for this node.
-        if (totw != 0.0) disp[idx] = d * (1.0 / totw);
       }
 
-      if (it % 2 == 0)
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+ lambda*disp[idx];
-      }  
-      else
-      {
-        for (VMesh::Node::index_type idx=0; idx<num_nodes;idx++)
-          point[idx] = point[idx]+  mu*disp[idx];      
-      }
-      update_progress_max(it,num_iter);
-    }
+      /// the displacement vector for this node.
+      if (totw != 0.0) return (d * (1.0 / totw));
+      return (Vector(0.0,0.0,0.0));
+    };
+
+    detail::smooth(point,num_nodes,num_iter,lambda,mu,displacement,progress);
   }
-  
+
   return (true);
 } 
 
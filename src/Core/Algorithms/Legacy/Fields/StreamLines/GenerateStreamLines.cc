@@ -42,6 +42,10 @@
 #include <Core/Thread/Barrier.h>
 #include <Core/Thread/Parallel.h>
 
+#include <atomic>
+#include <map>
+#include <tuple>
+
 using namespace SCIRun;
 using namespace SCIRun::Core;
 using namespace SCIRun::Core::Geometry;
@@ -60,7 +64,84 @@ ALGORITHM_PARAMETER_DEF(Fields, AutoParameters);
 ALGORITHM_PARAMETER_DEF(Fields, NumStreamlines);
 ALGORITHM_PARAMETER_DEF(Fields, UseMultithreading);
 
-GenerateStreamLinesAlgo::GenerateStreamLinesAlgo()
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+// Points of the streamline of one seed. These are stored per seed, so the
+// output does not depend on how the seeds were distributed over the threads.
+struct StreamLinePoints
+{
+  StreamLinePoints() : first_index(0) {}
+
+  std::vector<Point> nodes;
+  int first_index;           // integration index of the first node
+};
+
+// Everything besides the seeds that determines the shape of a streamline
+struct StreamLineSettings
+{
+  StreamLineSettings() :
+    field_id(-1), generation(-1), method(AdamsBashforth), step_size(0), tolerance(0),
+    max_steps(0), direction(0), remove_colinear_pts(false) {}
+
+  bool operator==(const StreamLineSettings& s) const
+  {
+    return std::tie(field_id, generation, method, step_size, tolerance, max_steps, direction, remove_colinear_pts) ==
+      std::tie(s.field_id, s.generation, s.method, s.step_size, s.tolerance, s.max_steps, s.direction, s.remove_colinear_pts);
+  }
+
+  int field_id;
+  int generation;
+  IntegrationMethod method;
+  double step_size;
+  double tolerance;
+  int max_steps;
+  int direction;
+  bool remove_colinear_pts;
+};
+
+// Streamlines of the last execution keyed by seed location. When only the
+// seeds change, the lines of the seeds that did not move are reused.
+class StreamLineCache
+{
+  public:
+    void set_settings(const StreamLineSettings& settings)
+    {
+      if (!(settings == settings_)) lines_.clear();
+      settings_ = settings;
+    }
+
+    bool find(const Point& seed, StreamLinePoints& line) const
+    {
+      auto it = lines_.find(key(seed));
+      if (it == lines_.end()) return (false);
+      line = it->second;
+      return (true);
+    }
+
+    void store(const std::vector<Point>& seeds, const std::vector<StreamLinePoints>& lines)
+    {
+      lines_.clear();
+      for (size_t j=0; j<seeds.size(); j++) lines_[key(seeds[j])] = lines[j];
+    }
+
+    void set_integrated(size_t count) { integrated_ = count; }
+    size_t integrated() const { return integrated_; }
+
+  private:
+    typedef std::tuple<double,double,double> SeedKey;
+    static SeedKey key(const Point& p) { return SeedKey(p.x(),p.y(),p.z()); }
+
+    StreamLineSettings settings_;
+    std::map<SeedKey,StreamLinePoints> lines_;
+    size_t integrated_ = 0;
+};
+
+}}}}
+
+GenerateStreamLinesAlgo::GenerateStreamLinesAlgo() : cache_(new StreamLineCache)
 {
   addParameter(Parameters::StreamlineStepSize, 0.01);
   addParameter(Parameters::StreamlineTolerance, 0.0001);
@@ -78,6 +159,11 @@ GenerateStreamLinesAlgo::GenerateStreamLinesAlgo()
   addParameter(Parameters::UseMultithreading, true);
 }
 
+size_t GenerateStreamLinesAlgo::integratedSeedCount() const
+{
+  return cache_->integrated();
+}
+
 namespace detail
 {
 
@@ -161,32 +247,35 @@ StreamlineValue convertValue(const std::string& option)
 }
 
 
-class GenerateStreamLinesAlgoP : public Core::Thread::Interruptible
+// Common driver: seeds whose streamline is not cached are handed out to the
+// threads one at a time from a shared counter, so that a few long
+// streamlines do not keep one thread busy while the others are idle.
+class GenerateStreamLinesBase : public Core::Thread::Interruptible
 {
-
   public:
-     GenerateStreamLinesAlgoP(const AlgorithmBase* algo) :
-      algo_(algo), numprocessors_(Parallel::NumCores()), barrier_("FEMVolRHSBuilder Barrier", numprocessors_),
-      tolerance_(0), step_size_(0), max_steps_(0), direction_(0), value_(SeedIndex), remove_colinear_pts_(false),
-      method_(AdamsBashforth), seed_field_(0), seed_mesh_(0), field_(0), mesh_(0), ofield_(0), omesh_(0)
+    explicit GenerateStreamLinesBase(const AlgorithmBase* algo) :
+      algo_(algo), numprocessors_(Parallel::NumCores()),
+      max_steps_(0), direction_(0), value_(SeedIndex), remove_colinear_pts_(false),
+      seed_field_(0), seed_mesh_(0), field_(0), mesh_(0), next_(0), failed_(false)
     {}
+    virtual ~GenerateStreamLinesBase() {}
 
-    bool run(FieldHandle input,
-             FieldHandle seeds, FieldHandle& output,
-             IntegrationMethod method);
+    bool run(FieldHandle input, FieldHandle seeds, FieldHandle& output,
+             StreamLineCache* cache, StreamLineSettings settings);
+
+  protected:
+    virtual void parallel(int proc_num) = 0;
+
+    bool next_seed(index_type& idx, int proc_num);
+    void report_error(const std::string& msg);
+    void assemble(FieldHandle output) const;
 
-  private:
-    void runImpl();
     const AlgorithmBase* algo_;
     int numprocessors_;
-    Barrier barrier_;
-    double tolerance_;
-    double step_size_;
     int    max_steps_;
     int    direction_;
     StreamlineValue    value_;
     bool   remove_colinear_pts_;
-    IntegrationMethod method_;
 
     VField* seed_field_;
     VMesh*  seed_mesh_;
@@ -194,50 +283,217 @@ class GenerateStreamLinesAlgoP : public Core::Thread::Interruptible
     VField* field_;
     VMesh*  mesh_;
 
-    VField* ofield_;
-    VMesh*  omesh_;
+    std::vector<Point> seeds_;
+    std::vector<StreamLinePoints> lines_;
+    std::vector<index_type> pending_;
+    std::atomic<size_t> next_;
+    std::atomic<bool> failed_;
+};
+
+bool GenerateStreamLinesBase::next_seed(index_type& idx, int proc_num)
+{
+  if (failed_) return false;
+
+  const size_t k = next_++;
+  if (k >= pending_.size()) return false;
+
+  if (proc_num == 0)
+    algo_->update_progress_max(k, pending_.size());
+
+  idx = pending_[k];
+  return true;
+}
+
+void GenerateStreamLinesBase::report_error(const std::string& msg)
+{
+  algo_->error(msg);
+  failed_ = true;
+}
+
+bool GenerateStreamLinesBase::run(FieldHandle input,
+                                  FieldHandle seeds,
+                                  FieldHandle& output,
+                                  StreamLineCache* cache,
+                                  StreamLineSettings settings)
+{
+  seed_field_ = seeds->vfield();
+  seed_mesh_ = seeds->vmesh();
+  field_ = input->vfield();
+  mesh_ = input->vmesh();
+  max_steps_ = algo_->get(Parameters::StreamlineMaxSteps).toInt();
+  direction_ = convertDirectionOption(algo_->getOption(Parameters::StreamlineDirection));
+  value_ = convertValue(algo_->getOption(Parameters::StreamlineValue));
+  remove_colinear_pts_ = algo_->get(Parameters::RemoveColinearPoints).toBool();
+
+  settings.field_id = input->id();
+  settings.generation = mesh_->generation();
+  settings.max_steps = max_steps_;
+  settings.direction = direction_;
+  settings.remove_colinear_pts = remove_colinear_pts_;
+  if (cache) cache->set_settings(settings);
+
+  const VMesh::Node::size_type num_seeds = seed_mesh_->num_nodes();
+  seeds_.resize(num_seeds);
+  lines_.assign(num_seeds, StreamLinePoints());
+  pending_.clear();
+
+  for (VMesh::Node::index_type idx=0; idx<num_seeds; ++idx)
+  {
+    seed_mesh_->get_point(seeds_[idx], idx);
+    if (!cache || !cache->find(seeds_[idx], lines_[idx]))
+      pending_.push_back(idx);
+  }
+  if (cache) cache->set_integrated(pending_.size());
+
+  if (!pending_.empty())
+  {
+    if (numprocessors_ > 16) numprocessors_ = 16;  // request from Dan White to limit the number of threads
+    if (static_cast<size_t>(numprocessors_) > pending_.size()) numprocessors_ = static_cast<int>(pending_.size());
+    if (numprocessors_ < 1 || !algo_->get(Parameters::UseMultithreading).toBool())
+      numprocessors_ = 1;
+
+    next_ = 0;
+    failed_ = false;
+    Parallel::RunTasks([this](int i) { parallel(i); }, numprocessors_);
+    if (failed_) return false;
+  }
+
+  if (cache) cache->store(seeds_, lines_);
+
+  assemble(output);
+  return true;
+}
+
+void GenerateStreamLinesBase::assemble(FieldHandle output) const
+{
+  VField* ofield = output->vfield();
+  VMesh*  omesh = output->vmesh();
+
+  size_t num_nodes = 0;
+  size_t num_elems = 0;
+  for (size_t idx=0; idx<lines_.size(); idx++)
+  {
+    if (lines_[idx].nodes.empty()) continue;
+    num_nodes += lines_[idx].nodes.size();
+    num_elems += lines_[idx].nodes.size() - 1;
+  }
+
+  omesh->node_reserve(num_nodes);
+  omesh->elem_reserve(num_elems);
+
+  std::vector<double> values;
+  std::vector<index_type> node_seeds;
+  values.reserve(num_nodes);
+  if (value_ == SeedValue) node_seeds.reserve(num_nodes);
+
+  VMesh::Node::index_type n1, n2;
+  VMesh::Node::array_type newnodes(2);
+
+  for (size_t idx=0; idx<lines_.size(); idx++)
+  {
+    const std::vector<Point>& nodes = lines_[idx].nodes;
+    if (nodes.empty()) continue;
+
+    double length = 0;
+    if (value_ == StreamlineLength)
+    {
+      for (size_t j=1; j<nodes.size(); j++)
+        length += Vector(nodes[j]-nodes[j-1]).length();
+    }
+
+    int cc = lines_[idx].first_index;
+    const Point& p1 = nodes[0];
+    n1 = omesh->add_point(p1);
+
+    if (value_ == SeedValue) node_seeds.push_back(idx);
+    else if (value_ == SeedIndex) values.push_back(static_cast<double>(idx));
+    else if (value_ == IntegrationIndex) values.push_back(abs(cc));
+    else if (value_ == StreamlineLength) values.push_back(length);
+    else values.push_back(0.0);
+
+    cc++;
+
+    for (size_t j=1; j<nodes.size(); j++)
+    {
+      n2 = omesh->add_point(nodes[j]);
+
+      if (value_ == SeedValue) node_seeds.push_back(idx);
+      else if (value_ == SeedIndex) values.push_back(static_cast<double>(idx));
+      else if (value_ == IntegrationIndex) values.push_back(abs(cc));
+      else if (value_ == IntegrationStep)
+      {
+        length = Vector(nodes[j]-p1).length();
+        values.push_back(length);
+      }
+      else if (value_ == DistanceFromSeed)
+      {
+        length += Vector(nodes[j]-p1).length();
+        values.push_back(length);
+      }
+      else if (value_ == StreamlineLength) values.push_back(length);
+
+      newnodes[0] = n1;
+      newnodes[1] = n2;
+      omesh->add_elem(newnodes);
+
+      n1 = n2;
+      cc++;
+    }
+  }
+
+  ofield->resize_values();
+
+  if (value_ == SeedValue)
+  {
+    for (size_t j=0; j<node_seeds.size(); j++)
+      ofield->copy_value(seed_field_, node_seeds[j], VMesh::index_type(j));
+  }
+  else
+  {
+    ofield->set_values(values);
+  }
+}
+
+
+class GenerateStreamLinesAlgoP : public GenerateStreamLinesBase
+{
+  public:
+    explicit GenerateStreamLinesAlgoP(const AlgorithmBase* algo) :
+      GenerateStreamLinesBase(algo), tolerance_(0), step_size_(0), method_(AdamsBashforth)
+    {}
+
+    bool run(FieldHandle input,
+             FieldHandle seeds, FieldHandle& output,
+             IntegrationMethod method, StreamLineCache* cache);
+
+  protected:
+    virtual void parallel(int proc_num) override;
 
-    FieldHandle input_;
-    std::vector<bool> success_;
-    FieldList outputs_;
-    VMesh::Node::index_type global_dimension_;
-    void parallel(int proc);
-    FieldHandle StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num);
+  private:
+    double tolerance_;
+    double step_size_;
+    IntegrationMethod method_;
 };
 
-FieldHandle GenerateStreamLinesAlgoP::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
+void GenerateStreamLinesAlgoP::parallel(int proc_num)
 {
-  FieldHandle out;
   try
   {
-    VMesh::Node::index_type n1, n2;
     Vector test;
-    FieldInformation fi(input_);
-    fi.make_curvemesh();
-    fi.make_lineardata();
-    fi.make_linearmesh();
-    fi.make_double();
-    out = CreateField(fi);
-    VField* ofield=out->vfield();
-    VMesh*  omesh=out->vmesh();
 
     StreamLineIntegrators BI;
     BI.nodes_.reserve(max_steps_);                  // storage for points
     BI.tolerance2_  = tolerance_ * tolerance_;      // square error tolerance
     BI.max_steps_    = max_steps_;                  // max number of steps
-    BI.vfield_      = field_;                       // the vector field
-    std::vector<Point>::iterator node_iter;
-
-    // Try to find the streamline for each seed point.
-    //VMesh::size_type num_seeds = seed_mesh_->num_nodes();
-    VMesh::Node::array_type newnodes(2);
+    BI.set_field(field_);                           // the vector field
 
-    for (VMesh::Node::index_type idx=from; idx<to; ++idx)
+    index_type idx;
+    while (next_seed(idx, proc_num))
     {
       checkForInterruption();
-      seed_mesh_->get_point(BI.seed_, idx);
+      BI.seed_ = seeds_[idx];
 
-       // Is the seed point inside the field?
+      // Is the seed point inside the field?
       if (!field_->interpolate(test, BI.seed_))
         continue;
 
@@ -269,244 +525,72 @@ FieldHandle GenerateStreamLinesAlgoP::StreamLinesForCertainSeeds(VMesh::Node::in
         BI.integrate( method_ );
       }
 
-      double length = 0;
-      Point p1;
-
-      if (value_ == StreamlineLength)
-      {
-        node_iter = BI.nodes_.begin();
-        if (node_iter != BI.nodes_.end())
-        {
-          p1 = *node_iter;
-          ++node_iter;
-
-          while (node_iter != BI.nodes_.end())
-          {
-            length += Vector( *node_iter-p1 ).length();
-            p1 = *node_iter;
-            ++node_iter;
-          }
-        }
-      }
-
-      node_iter = BI.nodes_.begin();
-
-      if (node_iter != BI.nodes_.end())
-      {
-        p1 = *node_iter;
-        n1 = omesh->add_point(p1);
-
-	// Record the streamline point indexes. Used downstream.
-	//std::ostringstream str;
-	//str << "Streamline " << (unsigned int) idx << " Node Index";
-	//ofield->set_property( str.str(), (unsigned int) n1, false );
-
-        ofield->resize_values();
-
-        if (value_ == SeedValue) ofield->copy_value(seed_field_, idx, n1);
-        else if (value_ == SeedIndex) ofield->set_value(index_type(idx), n1);
-        else if (value_ == IntegrationIndex) ofield->set_value(abs(cc), n1);
-        else if (value_ == IntegrationStep) ofield->set_value(0, n1);
-        else if (value_ == DistanceFromSeed) ofield->set_value(0, n1);
-        else if (value_ == StreamlineLength) ofield->set_value(length, n1);
-
-        ++node_iter;
-        cc++;
-
-        while (node_iter != BI.nodes_.end())
-        {
-          n2 = omesh->add_point(*node_iter);
-          ofield->resize_fdata();
-
-          if (value_ == SeedValue) ofield->copy_value(seed_field_, idx, n2);
-          else if (value_ == SeedIndex) ofield->set_value(index_type(idx), n2);
-          else if (value_ == IntegrationIndex) ofield->set_value(abs(cc), n2);
-          else if (value_ == IntegrationStep)
-          {
-            length = Vector( *node_iter-p1 ).length();
-            ofield->set_value(length,n2);
-          }
-          else if (value_ == DistanceFromSeed)
-          {
-            length += Vector( *node_iter-p1 ).length();
-            ofield->set_value(length,n2);
-          }
-          else if (value_ == StreamlineLength)
-	        {
-	           ofield->set_value(length,n2);
-          }
-
-          newnodes[0] = n1;
-          newnodes[1] = n2;
-
-          omesh->add_elem(newnodes);
-          n1 = n2;
-          ++node_iter;
-
-          cc++;
-        }
-      }
-
-	  if(proc_num==0)
-	    algo_->update_progress_max(idx,to);
+      lines_[idx].nodes = BI.nodes_;
+      lines_[idx].first_index = cc;
     }
-
-    #ifdef NEEDS_ADDITIONAL_ALGO_OUTPUT
-    algo_->set_int("num_streamlines", num_seeds);
-    #endif
-
-    // Record the number of streamline. Used downstream.
-    //ofield->set_property( "Streamline Count", (unsigned int) num_seeds, false );
-   }
-
+  }
   catch (const Exception &e)
   {
-    algo_->error(std::string("Crashed with the following exception:\n")+e.message());
-    success_[proc_num] = false;
+    report_error(std::string("Crashed with the following exception:\n")+e.message());
   }
   catch (const std::string& a)
   {
-    algo_->error(a);
-    success_[proc_num] = false;
+    report_error(a);
   }
   catch (const char *a)
   {
-    algo_->error(a);
-    success_[proc_num] = false;
+    report_error(a);
   }
-
-  return out;
-}
-
-void GenerateStreamLinesAlgoP::parallel(int proc_num)
-{
- success_[proc_num] = true;
-
- for (int q=0; q<numprocessors_;q++)
-   if (success_[q] == false) return;
-
- const index_type start_gd = (global_dimension_ * proc_num)/numprocessors_+1;
- const index_type end_gd  = (global_dimension_ * (proc_num+1))/numprocessors_;
-
- outputs_[proc_num]=StreamLinesForCertainSeeds(start_gd, end_gd, proc_num);
 }
 
 bool GenerateStreamLinesAlgoP::run(FieldHandle input,
                               FieldHandle seeds,
                               FieldHandle& output,
-                              IntegrationMethod method)
+                              IntegrationMethod method,
+                              StreamLineCache* cache)
 {
-  seed_field_ = seeds->vfield();
-  seed_mesh_ = seeds->vmesh();
-  field_ = input->vfield();
-  mesh_ = input->vmesh();
-  ofield_ = output->vfield();
-  omesh_ = output->vmesh();
   tolerance_ = algo_->get(Parameters::StreamlineTolerance).toDouble();
   step_size_ = algo_->get(Parameters::StreamlineStepSize).toDouble();
-  max_steps_ = algo_->get(Parameters::StreamlineMaxSteps).toInt();
-  direction_ = convertDirectionOption(algo_->getOption(Parameters::StreamlineDirection));
-  value_ = convertValue(algo_->getOption(Parameters::StreamlineValue));
-  remove_colinear_pts_ = algo_->get(Parameters::RemoveColinearPoints).toBool();
   method_ = method;
-  input_=input;
-  global_dimension_=seed_mesh_->num_nodes();
-  if (global_dimension_<numprocessors_ || numprocessors_<1) numprocessors_=1;
-  if (numprocessors_>16) numprocessors_=16;  // request from Dan White to limit the number of threads
-  if (!algo_->get(Parameters::UseMultithreading).toBool())
-    numprocessors_ = 1;
-  success_.resize(numprocessors_,true);
-  outputs_.resize(numprocessors_, nullptr);
-
-  Parallel::RunTasks([this](int i) { parallel(i); }, numprocessors_);
-  for (size_t j=0; j<success_.size(); j++)
-  {
-    if (success_[j] == false) return false;
-    if (outputs_[j]  == nullptr) return false;
-  }
-  JoinFieldsAlgo algo;
-  algo.set(JoinFieldsAlgo::MergeNodes,false);
-  algo.runImpl(outputs_, output);
 
-  return true;
+  StreamLineSettings settings;
+  settings.method = method_;
+  settings.step_size = step_size_;
+  settings.tolerance = tolerance_;
+
+  return GenerateStreamLinesBase::run(input, seeds, output, cache, settings);
 }
 
 
 // Cell walk streamline code
 
-
-
-class GenerateStreamLinesAccAlgo {
-
+class GenerateStreamLinesAccAlgo : public GenerateStreamLinesBase
+{
   public:
-    GenerateStreamLinesAccAlgo() :
-      numprocessors_(Parallel::NumCores()), barrier_("FEMVolRHSBuilder Barrier", numprocessors_),
-      max_steps_(0), direction_(0), value_(SeedIndex), remove_colinear_pts_(false),
-      seed_field_(0), seed_mesh_(0)
-      {}
+    explicit GenerateStreamLinesAccAlgo(const AlgorithmBase* algo) :
+      GenerateStreamLinesBase(algo) {}
 
-    bool run(const AlgorithmBase* algo, FieldHandle input, FieldHandle seeds, FieldHandle& output);
+    bool run(FieldHandle input, FieldHandle seeds, FieldHandle& output, StreamLineCache* cache);
 
     void find_nodes(std::vector<Point>& v, Point seed, bool back);
-  private:
-    int numprocessors_;
-    Barrier barrier_;
-    int    max_steps_;
-    int    direction_;
-    StreamlineValue    value_;
-    bool   remove_colinear_pts_;
 
-    VField* seed_field_;
-    VMesh*  seed_mesh_;
-
-    VField* field_;
-    VMesh*  mesh_;
-
-    void parallel(int proc_num);
-    FieldHandle StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num);
-    std::vector<bool> success_;
-    FieldList outputs_;
-    FieldHandle input_;
-    VMesh::Node::index_type global_dimension_;
-    const AlgorithmBase* algo_;
+  protected:
+    virtual void parallel(int proc_num) override;
 };
 
 void GenerateStreamLinesAccAlgo::parallel(int proc_num)
 {
- success_[proc_num] = true;
- for (int q=0; q<numprocessors_;q++)
-   if (success_[q] == false) return;
- const index_type start_gd = (global_dimension_ * proc_num)/numprocessors_;
- const index_type end_gd  = (global_dimension_ * (proc_num+1))/numprocessors_;
- outputs_[proc_num]=StreamLinesForCertainSeeds(start_gd, end_gd, proc_num);
-}
-
-
-FieldHandle GenerateStreamLinesAccAlgo::StreamLinesForCertainSeeds(VMesh::Node::index_type from, VMesh::Node::index_type to, int proc_num)
-{
-  FieldInformation fi(input_);
-  fi.make_curvemesh();
-  fi.make_lineardata();
-  fi.make_linearmesh();
-  fi.make_double();
-  FieldHandle out;// = CreateField(fi);
   try
   {
-    out = CreateField(fi);
-    VField* ofield=out->vfield();
-    VMesh*  omesh=out->vmesh();
-    Point seed;
     VMesh::Elem::index_type elem;
     std::vector<Point> nodes;
     nodes.reserve(max_steps_);
-    std::vector<Point>::iterator node_iter;
-    VMesh::Node::index_type n1, n2;
-    VMesh::Node::array_type newnodes(2);
 
-    // Try to find the streamline for each seed point.
-    for(VMesh::Node::index_type idx=from; idx<to; ++idx)
+    index_type idx;
+    while (next_seed(idx, proc_num))
     {
-      seed_mesh_->get_center(seed, idx);
+      checkForInterruption();
+      const Point& seed = seeds_[idx];
 
       // Is the seed point inside the field?
       if (!(mesh_->locate(elem, seed)))
@@ -535,152 +619,33 @@ FieldHandle GenerateStreamLinesAccAlgo::StreamLinesForCertainSeeds(VMesh::Node::
         find_nodes(nodes, seed, false);
       }
 
-      double length = 0;
-      Point p1;
-
-      if (value_ == StreamlineLength)
-      {
-        node_iter = nodes.begin();
-        if (node_iter != nodes.end())
-        {
-          p1 = *node_iter;
-          ++node_iter;
-
-          while (node_iter != nodes.end())
-          {
-            length += Vector( *node_iter-p1 ).length();
-            p1 = *node_iter;
-            ++node_iter;
-          }
-        }
-      }
-
-      node_iter = nodes.begin();
-
-      if (node_iter != nodes.end())
-      {
-        p1 = *node_iter;
-        n1 = omesh->add_point(*node_iter);
-
-	// Record the streamline point indexes. Used downstream.
-	//std::ostringstream str;
-	//str << "Streamline " << (unsigned int) idx << " Node Index";
-	//ofield_->set_property( str.str(), (unsigned int) n1, false );
-
-        ofield->resize_values();
-
-        if (value_ == SeedValue) ofield->copy_value(field_, idx, n1);
-        else if (value_ == SeedIndex) ofield->set_value(static_cast<int>(idx), n1);
-        else if (value_ == IntegrationIndex) ofield->set_value(abs(cc), n1);
-        else if (value_ == IntegrationStep) ofield->set_value(0, n1);
-        else if (value_ == DistanceFromSeed) ofield->set_value(0, n1);
-        else if (value_ == StreamlineLength) ofield->set_value(length, n1);
-        ++node_iter;
-
-        cc++;
-
-        while (node_iter != nodes.end())
-        {
-          n2 = omesh->add_point(*node_iter);
-          ofield->resize_values();
-
-          if (value_ == SeedValue) ofield->copy_value(field_, idx, n2);
-          else if (value_ == SeedIndex) ofield->set_value(static_cast<int>(idx), n2);
-          else if (value_ == IntegrationIndex) ofield->set_value(abs(cc), n2);
-          else if (value_ == IntegrationStep)
-          {
-            length = Vector( *node_iter-p1 ).length();
-            ofield->set_value(length,n2);
-          }
-          else if (value_ == DistanceFromSeed)
-          {
-            length += Vector( *node_iter-p1 ).length();
-            ofield->set_value(length,n2);
-          }
-          else if (value_ == StreamlineLength)
-	       {
-	          ofield->set_value(length,n2);
-          }
-
-          newnodes[0] = n1;
-          newnodes[1] = n2;
-
-          omesh->add_elem(newnodes);
-
-          n1 = n2;
-          ++node_iter;
-
-          cc++;
-        }
-      }
-
-      if (proc_num==0)
-        algo_->update_progress_max(from, to);
+      lines_[idx].nodes = nodes;
+      lines_[idx].first_index = cc;
     }
-
-#ifdef NEED_ADDITIONAL_ALGO_OUTPUT
-    algo->set_int("num_streamlines", num_seeds);
-    #endif
-
-    // Record the number of streamline. Used downstream.
-    //ofield_->set_property( "Streamline Count", (unsigned int) num_seeds, false );
   }
-
   catch (const Exception &e)
   {
-    algo_->error(std::string("Crashed with the following exception:\n")+e.message());
-    success_[proc_num] = false;
+    report_error(std::string("Crashed with the following exception:\n")+e.message());
   }
   catch (const std::string& a)
   {
-    algo_->error(a);
-    success_[proc_num] = false;
+    report_error(a);
   }
   catch (const char *a)
   {
-    algo_->error(a);
-    success_[proc_num] = false;
+    report_error(a);
   }
-
-  return out;
 }
 
-
-bool GenerateStreamLinesAccAlgo::run(const AlgorithmBase* algo, FieldHandle input,
+bool GenerateStreamLinesAccAlgo::run(FieldHandle input,
 				FieldHandle seeds,
-				FieldHandle& output)
+				FieldHandle& output,
+				StreamLineCache* cache)
 {
-  seed_field_ = seeds->vfield();
-  seed_mesh_ = seeds->vmesh();
-  input_=input;
-  field_ = input->vfield();
-  mesh_ = input->vmesh();
-  algo_=algo;
-  max_steps_ = algo_->get(Parameters::StreamlineMaxSteps).toInt();
-  direction_ = convertDirectionOption(algo_->getOption(Parameters::StreamlineDirection));
-  value_ = convertValue(algo_->getOption(Parameters::StreamlineValue));
-  remove_colinear_pts_ = algo_->get(Parameters::RemoveColinearPoints).toBool();
-  global_dimension_=seed_mesh_->num_nodes();
-  if (global_dimension_<numprocessors_)
-    numprocessors_ = 1;
-  if (!algo_->get(Parameters::UseMultithreading).toBool())
-    numprocessors_ = 1;
-  if (numprocessors_ > 16)
-    numprocessors_ = 16;
-  success_.resize(numprocessors_,true);
-  outputs_.resize(numprocessors_, nullptr);
-  Parallel::RunTasks([this](int i) { parallel(i); }, numprocessors_);
-  for (size_t j=0; j<success_.size(); j++)
-  {
-    if (success_[j] == false) return false;
-    if (outputs_[j]  == nullptr) return false;
-  }
-  JoinFieldsAlgo JFalgo;
-  JFalgo.set(JoinFieldsAlgo::Tolerance,1e-8);
-  JFalgo.set(JoinFieldsAlgo::MergeNodes,false);
-  JFalgo.runImpl(outputs_, output);
+  StreamLineSettings settings;
+  settings.method = CellWalk;
 
-  return true;
+  return GenerateStreamLinesBase::run(input, seeds, output, cache, settings);
 }
 
 
@@ -841,8 +806,8 @@ bool GenerateStreamLinesAlgo::runImpl(FieldHandle input, FieldHandle seeds, Fiel
 
   if (method == 5)
   {
-    detail::GenerateStreamLinesAccAlgo algo;
-    success = algo.run(this,input,seeds,output);
+    detail::GenerateStreamLinesAccAlgo algo(this);
+    success = algo.run(input,seeds,output,cache_.get());
   }
   else
   {
@@ -864,7 +829,7 @@ bool GenerateStreamLinesAlgo::runImpl(FieldHandle input, FieldHandle seeds, Fiel
     }
 
     detail::GenerateStreamLinesAlgoP algo(this);
-    success = algo.run(input,seeds,output,method);
+    success = algo.run(input,seeds,output,method,cache_.get());
   }
 
   return (success);
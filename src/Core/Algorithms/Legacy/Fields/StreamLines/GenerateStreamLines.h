@@ -30,6 +30,7 @@
 #define CORE_ALGORITHMS_FIELDS_STREAMLINES_GENERATESTREAMLINES_H 1
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <boost/shared_ptr.hpp>
 #include <Core/Algorithms/Legacy/Fields/share.h>
 
 namespace SCIRun {
@@ -48,6 +49,8 @@ namespace SCIRun {
         ALGORITHM_PARAMETER_DECL(NumStreamlines);
         ALGORITHM_PARAMETER_DECL(UseMultithreading);
 
+        class StreamLineCache;
+
 class SCISHARE GenerateStreamLinesAlgo : public AlgorithmBase
 {
   public:
@@ -55,10 +58,16 @@ class SCISHARE GenerateStreamLinesAlgo : public AlgorithmBase
     bool runImpl(FieldHandle input, FieldHandle seeds, FieldHandle& output) const;
 
     virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+    /// Number of seeds traced by the last run; the others reused a cached line.
+    size_t integratedSeedCount() const;
 
     static const AlgorithmInputName VectorField;
     static const AlgorithmInputName Seeds;
     static const AlgorithmOutputName Streamlines;
+
+  private:
+    // Streamlines of the previous execution, reused for seeds that did not move
+    boost::shared_ptr<StreamLineCache> cache_;
 };
 
 }}}} // end namespace SCIRunAlgo
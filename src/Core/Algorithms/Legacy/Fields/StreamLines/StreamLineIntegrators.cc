@@ -35,6 +35,7 @@
 #include <Core/Algorithms/Legacy/Fields/StreamLines/StreamLineIntegrators.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 
 using namespace SCIRun;
@@ -42,6 +43,80 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms::Fields;
 
+StreamLineIntegrators::StreamLineIntegrators() :
+  tolerance2_(0.0), step_size_(0.0), max_steps_(0), vfield_(0),
+  vmesh_(0), walk_(NoWalk), elem_(-1)
+{
+}
+
+void
+StreamLineIntegrators::set_field(VField* vfield)
+{
+  vfield_ = vfield;
+  vmesh_ = vfield->vmesh();
+  elem_ = -1;
+  walk_ = NoWalk;
+
+  // Only for constant and linear data on linear volume elements, as the
+  // element test below relies on the local coordinates of those elements
+  if (vfield->basis_order() != 0 && vfield->basis_order() != 1) return;
+  if (!vmesh_->is_linearmesh() || !vmesh_->is_volume()) return;
+
+  if (vmesh_->is_tet_element()) walk_ = TetWalk;
+  else if (vmesh_->is_prism_element()) walk_ = PrismWalk;
+  else if (vmesh_->is_hex_element()) walk_ = HexWalk;
+}
+
+bool
+StreamLineIntegrators::inside_elem(const Point &p, VMesh::Elem::index_type elem)
+{
+  if (!vmesh_->get_coords(coords_, p, elem)) return (false);
+
+  // Same tolerance as the locate functions of the meshes
+  const double epsilon = 1e-7;
+  const double u = coords_[0], v = coords_[1], w = coords_[2];
+
+  switch (walk_)
+  {
+  case TetWalk:
+    return (u > -epsilon && v > -epsilon && w > -epsilon && u+v+w < 1.0+epsilon);
+  case PrismWalk:
+    return (u > -epsilon && v > -epsilon && u+v < 1.0+epsilon &&
+            w > -epsilon && w < 1.0+epsilon);
+  case HexWalk:
+    return (u > -epsilon && u < 1.0+epsilon && v > -epsilon && v < 1.0+epsilon &&
+            w > -epsilon && w < 1.0+epsilon);
+  default:
+    return (false);
+  }
+}
+
+bool
+StreamLineIntegrators::locate_from_last(const Point &p)
+{
+  // Integration steps are small compared to the elements, so the point is
+  // nearly always in the last element or in one of its face neighbors
+  if (elem_ >= 0)
+  {
+    if (inside_elem(p,elem_)) return (true);
+
+    vmesh_->get_neighbors(neighbors_,elem_);
+    for (size_t j=0; j<neighbors_.size(); j++)
+    {
+      if (inside_elem(p,neighbors_[j]))
+      {
+        elem_ = neighbors_[j];
+        return (true);
+      }
+    }
+  }
+
+  if (vmesh_->locate(elem_,coords_,p)) return (true);
+
+  elem_ = -1;
+  return (false);
+}
+
 /// interpolate using the generic linear interpolator
 bool
 StreamLineIntegrators::interpolate( const Point &p,
@@ -52,7 +127,24 @@ StreamLineIntegrators::interpolate( const Point &p,
   //  vfield_->interpolate(v, p);
   //  return (v.safe_normalize() > 0.0);
 
-  return vfield_->interpolate(v, p);
+  if (walk_ == NoWalk) return vfield_->interpolate(v, p);
+
+  if (!locate_from_last(p))
+  {
+    v = Vector(0.0,0.0,0.0);
+    return (false);
+  }
+
+  if (vfield_->basis_order() == 0)
+  {
+    vfield_->get_value(v,elem_);
+  }
+  else
+  {
+    vmesh_->get_interpolate_weights(coords_,elem_,ei_,1);
+    vfield_->get_weighted_value(v,&(ei_.node_index[0]),&(ei_.weights[0]),ei_.node_index.size());
+  }
+  return (true);
 }
 
 
@@ -262,6 +354,10 @@ StreamLineIntegrators::ComputeRKFTerms(Vector v[6],       // storage for terms
 void
 StreamLineIntegrators::integrate(IntegrationMethod method)
 {
+  // Start every line with a global locate, so the result does not depend
+  // on which line was integrated before
+  elem_ = -1;
+
   switch ( method ) 
   {
   case AdamsBashforth:
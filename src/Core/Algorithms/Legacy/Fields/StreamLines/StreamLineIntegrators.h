@@ -36,6 +36,7 @@
 #define CORE_ALGORITHMS_FIELDS_STREAMLINES_STREAMLINEINTEGRATORS_H 1
 
 #include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/GeometryPrimitives/Point.h>
 #include <Core/GeometryPrimitives/Vector.h>
 
@@ -68,6 +69,13 @@ namespace SCIRun {
         class SCISHARE StreamLineIntegrators
         {
         public:
+          StreamLineIntegrators();
+
+          // Set the vector field to integrate. For linear volume meshes the
+          // element containing the last point is remembered: it and its face
+          // neighbors are tested before a global locate is done.
+          void set_field(VField* vfield);
+
           void FindAdamsBashforth();
           void FindHeun();
           void FindRK4();
@@ -90,6 +98,18 @@ namespace SCIRun {
             double s);        // current step size
 
           bool interpolate(const Geometry::Point &p, Geometry::Vector &v);
+
+          bool locate_from_last(const Geometry::Point &p);
+          bool inside_elem(const Geometry::Point &p, VMesh::Elem::index_type elem);
+
+          enum WalkElement { NoWalk, TetWalk, PrismWalk, HexWalk };
+
+          VMesh*                  vmesh_;
+          WalkElement             walk_;
+          VMesh::Elem::index_type elem_;       // last containing element, -1 if unknown
+          VMesh::coords_type      coords_;     // local coordinates in elem_
+          VMesh::Elem::array_type neighbors_;
+          VMesh::ElemInterpolate  ei_;
         };
 
       }
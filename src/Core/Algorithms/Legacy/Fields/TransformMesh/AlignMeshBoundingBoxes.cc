@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/TransformMesh/AlignMeshBoundingBoxes.h>
+#include <Core/Algorithms/Legacy/Fields/TransformMesh/TransformMeshWithTransform.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/GeometryPrimitives/Transform.h>
@@ -88,35 +89,8 @@ AlignMeshBoundingBoxesAlgo::run(FieldHandle input, FieldHandle object, FieldHand
   
   output->vmesh()->transform(transform);
 
-  VField* field = output->vfield();
-  if (field->is_vector() || field->is_tensor())
-  {
-    if (rotate_data)
-    {
-      if (field->is_vector())
-      {
-        VMesh::size_type sz = field->num_values();
-        for (VMesh::index_type i=0; i < sz; i++)
-        {
-          Vector v;
-          field->get_value(v,i);
-          v = transform*v;
-          field->set_value(v,i);
-        }
-      }
-      if (field->is_tensor())
-      {
-        VMesh::size_type sz = field->num_values();
-        for (VMesh::index_type i=0; i < sz; i++)
-        {
-          Tensor v;
-          field->get_value(v,i);
-          v = transform*v*transform;
-          field->set_value(v,i);
-        }
-      }    
-    }
-  }
+  if (rotate_data)
+    TransformMeshWithTransformAlgo::transformFieldData(output->vfield(), transform);
 
   transform_matrix.reset(new DenseMatrix(transform));
   
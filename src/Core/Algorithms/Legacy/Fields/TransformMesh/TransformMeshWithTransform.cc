@@ -34,6 +34,8 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/GeometryPrimitives/Transform.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -41,6 +43,7 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Utility;
 using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
 
 TransformMeshWithTransformAlgo::TransformMeshWithTransformAlgo()
 {
@@ -81,38 +84,49 @@ bool TransformMeshWithTransformAlgo::run(FieldHandle input, DenseMatrixHandle tr
   
   vmesh->transform(transform);
   
-  if (vfield->is_vector() || vfield->is_tensor())
+  if (rotate_data)
+    transformFieldData(vfield, transform);
+
+  CopyProperties(*input, *output);
+
+  return (true);
+}
+
+namespace
+{
+  template <class T, class Op>
+  void transformValues(VField* field, Op op)
   {
-    if (rotate_data)
+    const VMesh::size_type size = field->num_values();
+    // Splitting only pays off once the per-thread ranges are large.
+    const int numTasks = static_cast<int>(std::max<VMesh::size_type>(1,
+      std::min<VMesh::size_type>(Parallel::NumCores(), size / 10000)));
+
+    auto task = [&](int i)
     {
-      if (vfield->is_vector())
+      const VMesh::index_type begin = size * i / numTasks;
+      const VMesh::index_type end = size * (i + 1) / numTasks;
+      T v;
+      for (VMesh::index_type j = begin; j < end; ++j)
       {
-        VMesh::size_type sz = vfield->num_values();
-        for (VMesh::index_type i=0; i < sz; i++)
-        {
-          Vector v;
-          vfield->get_value(v,i);
-          v = transform*v;
-          vfield->set_value(v,i);
-        }
+        field->get_value(v, j);
+        field->set_value(op(v), j);
       }
-      if (vfield->is_tensor())
-      {
-        VMesh::size_type sz = vfield->num_values();
-        for (VMesh::index_type i=0; i < sz; i++)
-        {
-          Tensor v;
-          vfield->get_value(v,i);
-          v = transform*v*transform;
-          vfield->set_value(v,i);
-        }
-      }    
-    }
+    };
+
+    if (numTasks == 1)
+      task(0);
+    else
+      Parallel::RunTasks(task, numTasks);
   }
-  
-  CopyProperties(*input, *output);
+}
 
-  return (true);
+void TransformMeshWithTransformAlgo::transformFieldData(VField* field, const Transform& transform)
+{
+  if (field->is_vector())
+    transformValues<Vector>(field, [&transform](const Vector& v) { return transform.project(v); });
+  if (field->is_tensor())
+    transformValues<Tensor>(field, [&transform](const Tensor& v) { return transform*v*transform; });
 }
 
 const AlgorithmInputName TransformMeshWithTransformAlgo::TransformMatrix("TransformMatrix");
@@ -31,6 +31,8 @@
 #define CORE_ALGORITHMS_FIELDS_TRANSFORMMESH_TRANSFORMMESHWITHTRANSFORM_H 1
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/GeometryPrimitives/GeomFwd.h>
 #include <Core/Algorithms/Legacy/Fields/share.h>
 
 namespace SCIRun {
@@ -48,6 +50,9 @@ namespace SCIRun {
 
           bool run(FieldHandle input, Core::Datatypes::DenseMatrixHandle transform, FieldHandle& output) const;
           virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+
+          /// Rotate vector and tensor values along with the mesh; other data types are left as is.
+          static void transformFieldData(VField* field, const Geometry::Transform& transform);
         };
 
       }
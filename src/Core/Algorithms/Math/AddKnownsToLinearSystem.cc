@@ -36,7 +36,7 @@ Last modification : 9/5/2014
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
-#include <Core/Datatypes/SparseRowMatrixFromMap.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 
 #include <Core/GeometryPrimitives/Point.h>
@@ -63,13 +63,14 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
   DenseColumnMatrixHandle& output_rhs) const
 {
 
-  SparseRowMatrixFromMap::Values additionalData;
-
-
   // Storing the number of columns in m and rows in n from the stiff matrix, m == n
   const unsigned int numCols = static_cast<unsigned int>(stiff->ncols());
   const unsigned int numRows = static_cast<unsigned int>(stiff->nrows());
 
+  // The original entries go in first so the constraint entries added below replace them.
+  SparseRowMatrixTripletBuilder additionalData(numCols, numRows, 1, SparseRowMatrixTripletBuilder::LAST_WINS);
+  additionalData.addMatrix(*stiff);
+
   // Checking if the rhs matrix is allocated and that the dimensions agree with the stiff matrix
   if (rhs)
   {
@@ -126,8 +127,7 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
         if (i!=p)
         {
           rhsColRef[i] += -it.value() * xCol_p;
-          additionalData[i][p] = 0.0;
-          additionalData[p][i] = 0.0;
+          additionalData.addSymmetric(i, p, 0.0);
         }
       }
       cnt++;
@@ -142,7 +142,7 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
   for (int i = 0; i < std::min(numRows, numCols); ++i)
   {
     if (IsFinite(xColRef[i]))
-      additionalData[i][i] = 1.0;
+      additionalData.add(i, i, 1.0);
   }
 
   // assigns value for right hand side vector
@@ -164,7 +164,7 @@ bool AddKnownsToLinearSystemAlgo::run(SparseRowMatrixHandle stiff,
   if (just_copying_inputs)
     remark("X vector does not contain any knowns! Copying inputs to outputs.");
 
-  output_stiff = SparseRowMatrixFromMap::appendToSparseMatrix(numCols, numRows, *stiff, additionalData);
+  output_stiff = additionalData.build();
   output_rhs = rhsCol;
 
   return true;
@@ -92,13 +92,14 @@ CollectSparseRowMatricesAlgorithm::concat_cols(MatrixHandle m1H, MatrixHandle m2
   const size_type newRows = m1H->nrows();
   const size_type newCols = m1H->ncols() + m2H->ncols();
 
-  SparseRowMatrixFromMap::Values shiftedValues;
   auto m1sparse = castMatrix::toSparse(m1H);
   auto m2sparse = castMatrix::toSparse(m2H);
 
-  copy_shifted_contents(m2sparse, shiftedValues, 0, m1sparse->ncols());
+  SparseRowMatrixTripletBuilder builder(newRows, newCols, 2);
+  builder.addMatrix(*m1sparse, 0, 0, 0);
+  builder.addMatrix(*m2sparse, 0, m1sparse->ncols(), 1);
 
-  return SparseRowMatrixFromMap::appendToSparseMatrix(newRows, newCols, *m1sparse, shiftedValues);
+  return builder.build();
 }
 
 MatrixHandle
@@ -109,13 +110,14 @@ CollectSparseRowMatricesAlgorithm::concat_rows(MatrixHandle m1H, MatrixHandle m2
   auto newRows = m1H->nrows() + m2H->nrows();
   auto newCols = m1H->ncols();
 
-  SparseRowMatrixFromMap::Values shiftedValues;
   auto m1sparse = castMatrix::toSparse(m1H);
   auto m2sparse = castMatrix::toSparse(m2H);
 
-  copy_shifted_contents(m2sparse, shiftedValues, m1sparse->nrows(), 0);
+  SparseRowMatrixTripletBuilder builder(newRows, newCols, 2);
+  builder.addMatrix(*m1sparse, 0, 0, 0);
+  builder.addMatrix(*m2sparse, m1sparse->nrows(), 0, 1);
 
-  return SparseRowMatrixFromMap::appendToSparseMatrix(newRows, newCols, *m1sparse, shiftedValues);
+  return builder.build();
 }
 
 void
@@ -124,20 +126,3 @@ CollectSparseRowMatricesAlgorithm::check_args(MatrixHandle m1H, MatrixHandle m2H
   if (!matrixIs::sparse(m1H) || !matrixIs::sparse(m2H))
     THROW_ALGORITHM_INPUT_ERROR("Both matrices to concatenate must be sparse.");
 }
-
-void
-CollectSparseRowMatricesAlgorithm::copy_shifted_contents(SparseRowMatrixHandle sparse, SparseRowMatrixFromMap::Values& shiftedValues,
-  size_t rowShift, size_t columnShift) const
-{
-  size_t count = 0;
-  size_t nextRow;
-  for (size_t r = 0; r < sparse->nrows(); ++r)
-  {
-    nextRow = sparse->get_rows()[r+1];
-    while (count < nextRow)
-    {
-      shiftedValues[r + rowShift][sparse->get_cols()[count] + columnShift] = sparse->valuePtr()[count];
-      count++;
-    }
-  }
-}
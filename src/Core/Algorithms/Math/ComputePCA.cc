@@ -26,10 +26,10 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Math/ComputePCA.h>
+#include <Core/Algorithms/Math/ComputeSVD.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
-#include <Eigen/SVD>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 
 using namespace SCIRun;
@@ -37,6 +37,14 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
 
+ComputePCAAlgo::ComputePCAAlgo()
+{
+    addOption(Parameters::SVDMethod, "Full", "Full|Randomized");
+    addParameter(Parameters::TruncationRank, 10);
+    addParameter(Parameters::PowerIterations, 2);
+    addParameter(Parameters::Oversampling, 10);
+}
+
 //Let's do some math.
 //Algorithm:
 void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, DenseMatrixHandle& PrinVals, DenseMatrixHandle& RightPrinMat) const{
@@ -55,16 +63,11 @@ void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, Den
         
         //After the data is centered, then we compute SVD on the centered matrix.
         //Centered Matrix = U*S*Vt, Vt = V transpose
-        Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(denseInputCentered, Eigen::ComputeFullU | Eigen::ComputeFullV);
-        
-        //U: Left principal matrix, nxn, orthogonal
-        LeftPrinMat = boost::make_shared<DenseMatrix>(svd_mat.matrixU());
-        
-        //S: Principal values nxm, diagonal
-        PrinVals = boost::make_shared<DenseMatrix>(svd_mat.singularValues());
-        
-        //V: Right singular mxm, orthognol
-        RightPrinMat = boost::make_shared<DenseMatrix>(svd_mat.matrixV());
+        //U: Left principal matrix, nxr; S: Principal values rx1; V: Right principal matrix, mxr.
+        //r = min(n,m) for the full decomposition, or the truncation rank for the randomized one.
+        ComputeSVDAlgo::decompose(boost::make_shared<DenseMatrix>(denseInputCentered), getOption(Parameters::SVDMethod),
+            get(Parameters::TruncationRank).toInt(), get(Parameters::PowerIterations).toInt(), get(Parameters::Oversampling).toInt(),
+            LeftPrinMat, PrinVals, RightPrinMat);
     }
     else
     {
@@ -80,15 +83,9 @@ DenseMatrix ComputePCAAlgo::centerData(MatrixHandle input_matrix)
     //Casts the matrix as dense.
     auto denseInput = castMatrix::toDense(input_matrix);
     
-    //Counts the number of rows in the input matrix.
-    auto rows = denseInput->rows();
-    
-    //Calulates the centering matrix (C).
-    // C = Identity(nxn) - 1/n * matrix of ones(nxn)
-    auto centerMatrix = Eigen::MatrixXd::Identity(rows,rows) - (1.0/rows)*Eigen::MatrixXd::Constant(rows,rows,1);
-    
-    //Multiplying the input matrix by the centering matrix.
-    auto denseInputCentered = centerMatrix * *denseInput;
+    //Subtracts the mean of each column, which is the same as multiplying by the
+    //centering matrix C = Identity(nxn) - 1/n * matrix of ones(nxn) without forming it.
+    DenseMatrix denseInputCentered = denseInput->rowwise() - denseInput->colwise().mean();
     
     return denseInputCentered;
 }
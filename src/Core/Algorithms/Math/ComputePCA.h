@@ -34,10 +34,12 @@ namespace SCIRun {
         namespace Algorithms {
             namespace Math {
                 
+                /// Uses the ComputeSVD parameters (SVDMethod, TruncationRank, PowerIterations, Oversampling);
+                /// outputs are thin factors of the centered data.
                 class SCISHARE ComputePCAAlgo : public AlgorithmBase
                 {
                 public:
-                    ComputePCAAlgo() {}
+                    ComputePCAAlgo();
                     
                     static AlgorithmOutputName LeftPrincipalMatrix;
                     static AlgorithmOutputName PrincipalValues;
@@ -30,40 +30,236 @@
 #include <Core/Algorithms/Math/ComputeSVD.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Thread/Parallel.h>
 #include <Eigen/SVD>
-
+#include <Eigen/QR>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <random>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Thread;
 
-void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat) const
+ALGORITHM_PARAMETER_DEF(Math, SVDMethod);
+ALGORITHM_PARAMETER_DEF(Math, TruncationRank);
+ALGORITHM_PARAMETER_DEF(Math, PowerIterations);
+ALGORITHM_PARAMETER_DEF(Math, Oversampling);
+
+ComputeSVDAlgo::ComputeSVDAlgo()
 {
-  if (input->nrows() == 0 || input->ncols() == 0){
-        
-    THROW_ALGORITHM_INPUT_ERROR("Input has a zero dimension.");
+  addOption(Parameters::SVDMethod, "Full", "Full|Randomized");
+  addParameter(Parameters::TruncationRank, 10);
+  addParameter(Parameters::PowerIterations, 2);
+  addParameter(Parameters::Oversampling, 10);
 }
-  if (matrixIs::dense(input))
+
+namespace
+{
+  typedef Eigen::MatrixXd Workspace;
+
+  // Rows are split into contiguous blocks of at least minRowsPerBlock; one block per core.
+  int blockCount(Eigen::Index rows, Eigen::Index minRowsPerBlock)
+  {
+    auto blocks = std::max<Eigen::Index>(1, rows / std::max<Eigen::Index>(1, minRowsPerBlock));
+    return static_cast<int>(std::min<Eigen::Index>(blocks, Parallel::NumCores()));
+  }
+
+  Eigen::Index blockBegin(Eigen::Index rows, int block, int blocks)
+  {
+    return rows * block / blocks;
+  }
+
+  template <class Task>
+  void runBlocks(int blocks, Task task)
+  {
+    if (blocks == 1)
+      task(0);
+    else
+      Parallel::RunTasks(task, blocks);
+  }
+
+  const Eigen::Index minProductRows = 256;
+
+  // Y = A * X, one row block of A per task.
+  template <class Mat>
+  Workspace multiply(const Mat& A, const Workspace& X)
+  {
+    Workspace Y(A.rows(), X.cols());
+    const int blocks = blockCount(A.rows(), minProductRows);
+    runBlocks(blocks, [&](int b)
+    {
+      auto begin = blockBegin(A.rows(), b, blocks);
+      auto size = blockBegin(A.rows(), b + 1, blocks) - begin;
+      Y.middleRows(begin, size).noalias() = A.middleRows(begin, size) * X;
+    });
+    return Y;
+  }
+
+  // Z = A^T * X, as a sum of per-row-block partial products.
+  template <class Mat>
+  Workspace multiplyTransposed(const Mat& A, const Workspace& X)
+  {
+    const int blocks = blockCount(A.rows(), minProductRows);
+    std::vector<Workspace> partial(blocks);
+    runBlocks(blocks, [&](int b)
+    {
+      auto begin = blockBegin(A.rows(), b, blocks);
+      auto size = blockBegin(A.rows(), b + 1, blocks) - begin;
+      partial[b].noalias() = A.middleRows(begin, size).transpose() * X.middleRows(begin, size);
+    });
+    for (int b = 1; b < blocks; ++b)
+      partial[0] += partial[b];
+    return partial[0];
+  }
+
+  // Thin QR of a tall matrix (rows >= cols). With more than one block each row block is factored
+  // independently, the stacked R factors are factored once more, and Q is assembled per block.
+  void tallSkinnyQR(const Workspace& A, Workspace& Q, Workspace* R)
+  {
+    const auto m = A.rows(), n = A.cols();
+    const int blocks = blockCount(m, std::max<Eigen::Index>(2 * n, minProductRows));
+    if (blocks == 1)
+    {
+      Eigen::HouseholderQR<Workspace> qr(A);
+      Q = qr.householderQ() * Workspace::Identity(m, n);
+      if (R)
+        *R = qr.matrixQR().topRows(n).triangularView<Eigen::Upper>();
+      return;
+    }
+
+    std::vector<Workspace> localQ(blocks);
+    Workspace stackedR(blocks * n, n);
+    Parallel::RunTasks([&](int b)
+    {
+      auto begin = blockBegin(m, b, blocks);
+      auto size = blockBegin(m, b + 1, blocks) - begin;
+      Eigen::HouseholderQR<Workspace> qr(A.middleRows(begin, size));
+      localQ[b] = qr.householderQ() * Workspace::Identity(size, n);
+      stackedR.middleRows(b * n, n) = qr.matrixQR().topRows(n).triangularView<Eigen::Upper>();
+    }, blocks);
+
+    Eigen::HouseholderQR<Workspace> top(stackedR);
+    Workspace topQ = top.householderQ() * Workspace::Identity(blocks * n, n);
+    if (R)
+      *R = top.matrixQR().topRows(n).triangularView<Eigen::Upper>();
+
+    Q.resize(m, n);
+    Parallel::RunTasks([&](int b)
+    {
+      auto begin = blockBegin(m, b, blocks);
+      auto size = blockBegin(m, b + 1, blocks) - begin;
+      Q.middleRows(begin, size).noalias() = localQ[b] * topQ.middleRows(b * n, n);
+    }, blocks);
+  }
+
+  void fullThinSVD(const Workspace& A, Workspace& U, Eigen::VectorXd& S, Workspace& V)
   {
-    auto denseInput = castMatrix::toDense(input);
+    if (A.rows() < A.cols())
+    {
+      fullThinSVD(A.transpose(), V, S, U);
+      return;
+    }
 
-    Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(*denseInput, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    if (blockCount(A.rows(), std::max<Eigen::Index>(2 * A.cols(), minProductRows)) == 1)
+    {
+      Eigen::BDCSVD<Workspace> svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+      U = svd.matrixU();
+      S = svd.singularValues();
+      V = svd.matrixV();
+      return;
+    }
 
-    LeftSingMat = boost::make_shared<DenseMatrix>(svd_mat.matrixU());
+    // A = Q R and R = U_R S V^T, so A = (Q U_R) S V^T with only an n x n SVD.
+    Workspace Q, R;
+    tallSkinnyQR(A, Q, &R);
+    Eigen::BDCSVD<Workspace> svd(R, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    U = multiply(Q, svd.matrixU());
+    S = svd.singularValues();
+    V = svd.matrixV();
+  }
+
+  template <class Mat>
+  void randomizedSVD(const Mat& A, Eigen::Index rank, int powerIterations, Eigen::Index oversampling,
+    Workspace& U, Eigen::VectorXd& S, Workspace& V)
+  {
+    const auto smallest = std::min<Eigen::Index>(A.rows(), A.cols());
+    const auto k = std::min(rank, smallest);
+    const auto samples = std::min(k + oversampling, smallest);
 
-    SingVals = boost::make_shared<DenseMatrix>(svd_mat.singularValues());
+    // Fixed seed, so that re-executing a network reproduces its outputs.
+    std::mt19937 generator(5489u);
+    std::normal_distribution<double> normal;
+    Workspace omega(A.cols(), samples);
+    for (Eigen::Index j = 0; j < omega.cols(); ++j)
+      for (Eigen::Index i = 0; i < omega.rows(); ++i)
+        omega(i, j) = normal(generator);
 
-    RightSingMat = boost::make_shared<DenseMatrix>(svd_mat.matrixV());
+    Workspace Q, W;
+    tallSkinnyQR(multiply(A, omega), Q, nullptr);
+    for (int i = 0; i < powerIterations; ++i)
+    {
+      tallSkinnyQR(multiplyTransposed(A, Q), W, nullptr);
+      tallSkinnyQR(multiply(A, W), Q, nullptr);
+    }
+
+    // B = Q^T A is small; factor its transpose, B^T = U_B S V_B^T, so A ~ (Q V_B) S U_B^T.
+    Workspace Bt = multiplyTransposed(A, Q);
+    Eigen::BDCSVD<Workspace> svd(Bt, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    U = Q * svd.matrixV().leftCols(k);
+    S = svd.singularValues().head(k);
+    V = svd.matrixU().leftCols(k);
+  }
+}
+
+void ComputeSVDAlgo::decompose(MatrixHandle input, const std::string& method, int rank, int powerIterations, int oversampling,
+  DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat)
+{
+  Workspace U, V;
+  Eigen::VectorXd S;
+
+  if (method == "Randomized")
+  {
+    if (rank < 1)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Truncation rank must be at least 1.");
+    auto iterations = std::max(powerIterations, 0);
+    auto extra = std::max(oversampling, 0);
+
+    if (matrixIs::dense(input))
+      randomizedSVD(*castMatrix::toDense(input), rank, iterations, extra, U, S, V);
+    else if (matrixIs::sparse(input))
+      randomizedSVD(*castMatrix::toSparse(input), rank, iterations, extra, U, S, V);
+    else
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Randomized SVD works for dense or sparse matrix input only.");
+  }
+  else if (matrixIs::dense(input))
+  {
+    fullThinSVD(Workspace(*castMatrix::toDense(input)), U, S, V);
   }
   else
   {
-    THROW_ALGORITHM_INPUT_ERROR("ComputeSVD works for dense matrix input only.");
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Full SVD works for dense matrix input only.");
   }
+
+  LeftSingMat = boost::make_shared<DenseMatrix>(U);
+  SingVals = boost::make_shared<DenseMatrix>(S);
+  RightSingMat = boost::make_shared<DenseMatrix>(V);
 }
 
+void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat) const
+{
+  if (input->nrows() == 0 || input->ncols() == 0)
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Input has a zero dimension.");
+  }
+
+  decompose(input, getOption(Parameters::SVDMethod), get(Parameters::TruncationRank).toInt(),
+    get(Parameters::PowerIterations).toInt(), get(Parameters::Oversampling).toInt(),
+    LeftSingMat, SingVals, RightSingMat);
+}
 
 AlgorithmOutput ComputeSVDAlgo::run(const AlgorithmInput& input) const
 {
@@ -34,17 +34,30 @@ namespace SCIRun {
 	namespace Core {
 		namespace Algorithms {
 			namespace Math {
-			
+
+			ALGORITHM_PARAMETER_DECL(SVDMethod);
+			ALGORITHM_PARAMETER_DECL(TruncationRank);
+			ALGORITHM_PARAMETER_DECL(PowerIterations);
+			ALGORITHM_PARAMETER_DECL(Oversampling);
+
+			/// Outputs are thin factors: U is m x r, S is r x 1 and V is n x r, where r = min(m, n)
+			/// for the Full method and r = min(TruncationRank, m, n) for the Randomized method.
 			class SCISHARE ComputeSVDAlgo : public AlgorithmBase
 			{
 				public:
-					ComputeSVDAlgo() {}
+					ComputeSVDAlgo();
 					
 					static AlgorithmOutputName LeftSingularMatrix;
 					static AlgorithmOutputName SingularValues;
 					static AlgorithmOutputName RightSingularMatrix;
 					void run(Datatypes::MatrixHandle input_matrix, Datatypes::DenseMatrixHandle& LeftSingMat, Datatypes::DenseMatrixHandle& SingVals, Datatypes::DenseMatrixHandle& RightSingMat) const;
 					virtual AlgorithmOutput run(const AlgorithmInput& input) const;
+
+					/// Decomposition shared with ComputePCA. "Full" runs a divide-and-conquer SVD, preceded by a
+					/// parallel tall-skinny QR when one dimension dominates; "Randomized" finds a rank-k range with
+					/// power iterations (Halko, Martinsson & Tropp 2011) and also accepts sparse input.
+					static void decompose(Datatypes::MatrixHandle input, const std::string& method, int rank, int powerIterations, int oversampling,
+						Datatypes::DenseMatrixHandle& LeftSingMat, Datatypes::DenseMatrixHandle& SingVals, Datatypes::DenseMatrixHandle& RightSingMat);
 			};
 		
 }}}}
\ No newline at end of file
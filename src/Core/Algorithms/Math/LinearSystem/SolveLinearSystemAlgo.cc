@@ -47,7 +47,7 @@ using namespace SCIRun::Core::Datatypes;
 SolveLinearSystemAlgo::SolveLinearSystemAlgo()
 {
   // For solver
-  addOption(Variables::Method,"cg","jacobi|cg|bicg|minres");
+  addOption(Variables::Method,"cg","jacobi|cg|bicg|minres|ldlt");
   addOption(Variables::Preconditioner,"Jacobi","None|Jacobi");
 
   addParameter(Variables::TargetError, 1e-5);
@@ -1147,6 +1147,19 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
 
   std::string method = getOption(Variables::Method);
 
+  if (method == "ldlt")
+  {
+    auto reuse = directSolver_.factorize(*A);
+    if (reuse == SparseLDLTSolver::NUMERIC)
+      remark("Reusing cached LDL^T factorization");
+    else if (reuse == SparseLDLTSolver::SYMBOLIC)
+      remark("Reusing cached LDL^T ordering for a matrix with the same sparsity pattern");
+    x = directSolver_.solve(*b);
+    update_progress(1);
+    return true;
+  }
+  directSolver_.clear();
+
   DenseColumnMatrixHandle conv;
   if (method == "cg")
   {
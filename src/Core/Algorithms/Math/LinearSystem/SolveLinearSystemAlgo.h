@@ -34,6 +34,7 @@
 #define CORE_ALGORITHMS_MATH_LINEARSYSTEM_SOLVELINEARSYSTEM_H
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Math/LinearSystem/SparseLDLTSolver.h>
 #include <Core/Datatypes/MatrixFwd.h>
 #include <Core/Algorithms/Math/share.h>
 
@@ -44,6 +45,8 @@ namespace Math {
 
 // Solve a linear system in parallel using a standard iterative method
 // Method solves A*x = b, with x0 being the initializer for the solution
+// Method "ldlt" is a direct solve instead; its factorization is cached on the
+// algorithm object, so re-solving the same matrix only does the substitutions.
 
 class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
 {
@@ -62,6 +65,9 @@ class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
              Datatypes::DenseColumnMatrixHandle& x) const;
 
     AlgorithmOutput run(const AlgorithmInput& input) const;
+
+  private:
+    mutable SparseLDLTSolver directSolver_;
 };
 
 
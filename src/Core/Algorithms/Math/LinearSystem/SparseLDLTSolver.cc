@@ -0,0 +1,133 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Math/LinearSystem/SparseLDLTSolver.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Eigen/SparseCholesky>
+#include <Eigen/OrderingMethods>
+
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Datatypes;
+
+class SparseLDLTSolver::Impl
+{
+public:
+  typedef SparseRowMatrix::EigenBase::StorageIndex StorageIndex;
+  typedef Eigen::SparseMatrix<double, Eigen::ColMajor, StorageIndex> ColumnMajor;
+  typedef Eigen::SimplicialLDLT<ColumnMajor, Eigen::Lower, Eigen::AMDOrdering<StorageIndex>> Factorization;
+
+  Factorization ldlt;
+  bool analyzed = false;
+  bool factorized = false;
+  SparseRowMatrix::id_type matrixId = -1;
+  // Pattern of the last analyzed matrix; for a symmetric matrix the row-major arrays are also its column-major ones.
+  std::vector<StorageIndex> outer, inner;
+
+  bool sameMatrix(const SparseRowMatrix& A) const
+  {
+    return factorized && A.id() == matrixId && A.nonZeros() == static_cast<Eigen::Index>(inner.size());
+  }
+
+  bool samePattern(const SparseRowMatrix& A) const
+  {
+    return analyzed
+      && A.rows() + 1 == static_cast<Eigen::Index>(outer.size())
+      && A.nonZeros() == static_cast<Eigen::Index>(inner.size())
+      && std::equal(outer.begin(), outer.end(), A.outerIndexPtr())
+      && std::equal(inner.begin(), inner.end(), A.innerIndexPtr());
+  }
+};
+
+SparseLDLTSolver::SparseLDLTSolver() : impl_(new Impl)
+{
+}
+
+SparseLDLTSolver::Reuse SparseLDLTSolver::factorize(const SparseRowMatrix& A)
+{
+  if (impl_->sameMatrix(A))
+    return NUMERIC;
+
+  if (A.rows() != A.cols())
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("LDL^T solver requires a square matrix");
+  if (!A.isCompressed())
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("LDL^T solver requires a compressed sparse matrix");
+
+  // Only the lower triangle is read, so an unsymmetric matrix would be solved silently wrong.
+  SparseRowMatrix::EigenBase asymmetry = A - SparseRowMatrix::EigenBase(A.transpose());
+  if (asymmetry.norm() > 1e-10 * A.norm())
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("LDL^T solver requires a symmetric matrix");
+
+  impl_->factorized = false;
+  Impl::ColumnMajor lhs(A);
+  auto reuse = NONE;
+  if (impl_->samePattern(A))
+  {
+    reuse = SYMBOLIC;
+  }
+  else
+  {
+    impl_->analyzed = false;
+    impl_->ldlt.analyzePattern(lhs);
+    if (impl_->ldlt.info() != Eigen::Success)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("LDL^T symbolic factorization failed");
+    impl_->outer.assign(A.outerIndexPtr(), A.outerIndexPtr() + A.rows() + 1);
+    impl_->inner.assign(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros());
+    impl_->analyzed = true;
+  }
+
+  impl_->ldlt.factorize(lhs);
+  if (impl_->ldlt.info() != Eigen::Success)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("LDL^T numeric factorization failed: matrix is singular");
+
+  impl_->matrixId = A.id();
+  impl_->factorized = true;
+  return reuse;
+}
+
+DenseColumnMatrixHandle SparseLDLTSolver::solve(const DenseColumnMatrix& b) const
+{
+  if (!impl_->factorized)
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("LDL^T solve called before factorization"));
+  if (b.nrows() + 1 != static_cast<size_t>(impl_->outer.size()))
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Matrix A and b do not have the same number of rows");
+
+  return boost::make_shared<DenseColumnMatrix>(impl_->ldlt.solve(b));
+}
+
+bool SparseLDLTSolver::factorized() const
+{
+  return impl_->factorized;
+}
+
+void SparseLDLTSolver::clear()
+{
+  impl_.reset(new Impl);
+}
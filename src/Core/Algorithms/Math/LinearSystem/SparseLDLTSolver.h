@@ -0,0 +1,71 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_MATH_LINEARSYSTEM_SPARSELDLTSOLVER_H
+#define CORE_ALGORITHMS_MATH_LINEARSYSTEM_SPARSELDLTSOLVER_H
+
+#include <Core/Datatypes/MatrixFwd.h>
+#include <boost/shared_ptr.hpp>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+// Direct solver for symmetric sparse systems: simplicial LDL^T with an AMD fill-reducing
+// ordering. The factorization is kept between calls, so a solver object that lives as long
+// as its module turns repeated solves with new right-hand sides into substitutions only.
+class SCISHARE SparseLDLTSolver
+{
+  public:
+    SparseLDLTSolver();
+
+    enum Reuse
+    {
+      NONE,       // ordering and numeric factorization computed
+      SYMBOLIC,   // same sparsity pattern as before: ordering and elimination tree reused
+      NUMERIC     // same matrix as before: factors reused
+    };
+
+    // Factorizes A unless the cached factors already belong to it. Throws if A is not square,
+    // not symmetric, or has a zero pivot.
+    Reuse factorize(const Datatypes::SparseRowMatrix& A);
+    Datatypes::DenseColumnMatrixHandle solve(const Datatypes::DenseColumnMatrix& b) const;
+
+    bool factorized() const;
+    void clear();
+
+  private:
+    class Impl;
+    boost::shared_ptr<Impl> impl_;
+};
+
+}}}}
+
+#endif
@@ -32,6 +32,7 @@
 #include <Core/Datatypes/MatrixComparison.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Core/Algorithms/Math/ComputePCA.h>
+#include <Core/Algorithms/Math/ComputeSVD.h>
 #include <Eigen/SVD>
 
 using namespace SCIRun::Core::Datatypes;
@@ -118,14 +119,14 @@ TEST(ComputePCAtest, checkOutputs)
     ASSERT_EQ(2,RightPrinMat_V->rows());
     
     //Columns
-    ASSERT_EQ(12,LeftPrinMat_U->cols());
+    ASSERT_EQ(2,LeftPrinMat_U->cols());
     ASSERT_EQ(1,PrinVals_S->cols());
     ASSERT_EQ(2,RightPrinMat_V->cols());
     
     
     
     //Eigen does not create a diagonal matrix when it computes SVD, it just has a column with the principal values, so we must put it into a diagonal matrix to be able to do some matrix multiplication later.
-    DenseMatrix sDiag = Eigen::MatrixXd::Constant(12,2,0);
+    DenseMatrix sDiag = Eigen::MatrixXd::Constant(2,2,0);
     sDiag.diagonal() = PrinVals_S->col(0);
     
     //Multiplying back together and comparing to the centered matrix. They should be equal to each other with some tolerance.
@@ -159,4 +160,26 @@ TEST(ComputePCAtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m2,LeftPrinMat_U,PrinVals_S,RightPrinMat_V));
     EXPECT_ANY_THROW(algo.run(m3,LeftPrinMat_U,PrinVals_S,RightPrinMat_V));
 
-}
\ No newline at end of file
+}
+
+//Keeping only the first principal component with the randomized method.
+TEST(ComputePCAtest, RandomizedFirstComponentMatchesFull)
+{
+    ComputePCAAlgo full;
+    DenseMatrixHandle U, S, V;
+    full.run(inputMatrix(), U, S, V);
+
+    ComputePCAAlgo randomized;
+    randomized.setOption(SCIRun::Core::Algorithms::Math::Parameters::SVDMethod, "Randomized");
+    randomized.set(SCIRun::Core::Algorithms::Math::Parameters::TruncationRank, 1);
+    DenseMatrixHandle Ur, Sr, Vr;
+    randomized.run(inputMatrix(), Ur, Sr, Vr);
+
+    ASSERT_EQ(12, Ur->rows());
+    ASSERT_EQ(1, Ur->cols());
+    ASSERT_EQ(1, Sr->rows());
+    ASSERT_EQ(2, Vr->rows());
+    ASSERT_EQ(1, Vr->cols());
+    EXPECT_NEAR((*S)(0,0), (*Sr)(0,0), 1e-10);
+    EXPECT_NEAR(std::abs((*V)(0,0)), std::abs((*Vr)(0,0)), 1e-10);
+}
@@ -33,8 +33,10 @@
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Core/Algorithms/Math/ComputeSVD.h>
 #include <Eigen/SVD>
+#include <Eigen/QR>
 
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Math;
 using namespace SCIRun::TestUtils;
 
@@ -84,12 +86,12 @@ TEST(ComputeSVDtest, checkOutputs)
     ASSERT_EQ(2,RightSingularMatrix_V->rows());
     
     //Columns
-    ASSERT_EQ(12,LeftSingularMatrix_U->cols());
+    ASSERT_EQ(2,LeftSingularMatrix_U->cols());
     ASSERT_EQ(1,SingularValues_S->cols());
     ASSERT_EQ(2,RightSingularMatrix_V->cols());
     
     //Eigen does not create a diagonal matrix when it computes SVD, it just has a column with the singular values, so we must put it into a diagonal matrix to be able to do some matrix multiplication later.
-    DenseMatrix sDiag = Eigen::MatrixXd::Constant(12,2,0);
+    DenseMatrix sDiag = Eigen::MatrixXd::Constant(2,2,0);
     sDiag.diagonal() = SingularValues_S->col(0);
     
     //Multiplying back together and comparing to the centered matrix. They should be equal to each other with some tolerance.
@@ -123,4 +125,169 @@ TEST(ComputeSVDtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m2,LeftSingularMatrix_U,SingularValues_S,RightSingularMatrix_V));
     EXPECT_ANY_THROW(algo.run(m3,LeftSingularMatrix_U,SingularValues_S,RightSingularMatrix_V));
     
-}
\ No newline at end of file
+}
+
+namespace
+{
+    //Deterministic m x n matrix of the given rank with singular values rank, rank-1, ..., 1,
+    //or decay^0, decay^1, ... when a decay factor is given.
+    DenseMatrixHandle lowRankMatrix(int rows, int cols, int rank, double decay = 0)
+    {
+        Eigen::MatrixXd left(rows, rank), right(cols, rank);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < rank; ++j)
+                left(i,j) = std::sin(0.37*(i+1)*(j+1)) + std::cos(0.11*i*(j+2));
+        for (int i = 0; i < cols; ++i)
+            for (int j = 0; j < rank; ++j)
+                right(i,j) = std::cos(0.23*(i+1)*(j+1)) - std::sin(0.05*i*(j+3));
+        Eigen::HouseholderQR<Eigen::MatrixXd> qrLeft(left), qrRight(right);
+        Eigen::MatrixXd U = qrLeft.householderQ() * Eigen::MatrixXd::Identity(rows, rank);
+        Eigen::MatrixXd V = qrRight.householderQ() * Eigen::MatrixXd::Identity(cols, rank);
+        Eigen::VectorXd s = Eigen::VectorXd::LinSpaced(rank, rank, 1);
+        if (decay > 0)
+            for (int i = 0; i < rank; ++i)
+                s(i) = std::pow(decay, i);
+        return boost::make_shared<DenseMatrix>(U * s.asDiagonal() * V.transpose());
+    }
+
+    double reconstructionError(const DenseMatrix& expected, const DenseMatrix& U, const DenseMatrix& S, const DenseMatrix& V)
+    {
+        Eigen::MatrixXd product = U * S.col(0).asDiagonal() * V.transpose();
+        return (expected - product).norm() / expected.norm();
+    }
+}
+
+//Full decomposition of a tall matrix, which goes through the parallel QR when more than one core is available.
+TEST(ComputeSVDtest, FullMatchesJacobiOnTallMatrix)
+{
+    ComputeSVDAlgo algo;
+    auto m = lowRankMatrix(3000, 20, 20);
+
+    DenseMatrixHandle U, S, V;
+    algo.run(m, U, S, V);
+
+    ASSERT_EQ(3000, U->rows());
+    ASSERT_EQ(20, U->cols());
+    ASSERT_EQ(20, S->rows());
+    ASSERT_EQ(20, V->rows());
+    ASSERT_EQ(20, V->cols());
+
+    Eigen::JacobiSVD<DenseMatrix::EigenBase> jacobi(*m);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_NEAR(jacobi.singularValues()(i), (*S)(i,0), 1e-9);
+    EXPECT_LT(reconstructionError(*m, *U, *S, *V), 1e-12);
+    EXPECT_TRUE((U->transpose() * *U).isIdentity(1e-10));
+}
+
+//A wide matrix gives thin factors as well.
+TEST(ComputeSVDtest, FullReturnsThinFactorsForWideMatrix)
+{
+    ComputeSVDAlgo algo;
+    DenseMatrixHandle m(boost::make_shared<DenseMatrix>(inputMatrix()->transpose()));
+
+    DenseMatrixHandle U, S, V;
+    algo.run(m, U, S, V);
+
+    EXPECT_EQ(2, U->rows());
+    EXPECT_EQ(2, U->cols());
+    EXPECT_EQ(12, V->rows());
+    EXPECT_EQ(2, V->cols());
+    EXPECT_LT(reconstructionError(*m, *U, *S, *V), 1e-12);
+}
+
+TEST(ComputeSVDtest, RandomizedRecoversLowRankMatrix)
+{
+    ComputeSVDAlgo algo;
+    algo.setOption(Parameters::SVDMethod, "Randomized");
+    algo.set(Parameters::TruncationRank, 5);
+    auto m = lowRankMatrix(400, 120, 5);
+
+    DenseMatrixHandle U, S, V;
+    algo.run(m, U, S, V);
+
+    ASSERT_EQ(400, U->rows());
+    ASSERT_EQ(5, U->cols());
+    ASSERT_EQ(5, S->rows());
+    ASSERT_EQ(120, V->rows());
+    ASSERT_EQ(5, V->cols());
+    for (int i = 0; i < 5; ++i)
+        EXPECT_NEAR(5 - i, (*S)(i,0), 1e-10);
+    EXPECT_LT(reconstructionError(*m, *U, *S, *V), 1e-10);
+}
+
+//Truncating a full-rank matrix with a decaying spectrum: the leading singular values match the full decomposition.
+TEST(ComputeSVDtest, RandomizedMatchesLeadingSingularValues)
+{
+    auto m = lowRankMatrix(600, 80, 80, 0.8);
+
+    ComputeSVDAlgo full;
+    DenseMatrixHandle U, S, V;
+    full.run(m, U, S, V);
+
+    ComputeSVDAlgo randomized;
+    randomized.setOption(Parameters::SVDMethod, "Randomized");
+    randomized.set(Parameters::TruncationRank, 8);
+    DenseMatrixHandle Ur, Sr, Vr;
+    randomized.run(m, Ur, Sr, Vr);
+
+    ASSERT_EQ(8, Sr->rows());
+    for (int i = 0; i < 8; ++i)
+        EXPECT_NEAR((*S)(i,0), (*Sr)(i,0), 1e-8);
+}
+
+TEST(ComputeSVDtest, RandomizedAcceptsSparseInput)
+{
+    ComputeSVDAlgo algo;
+    algo.setOption(Parameters::SVDMethod, "Randomized");
+    algo.set(Parameters::TruncationRank, 2);
+    auto sparse = MAKE_SPARSE_MATRIX_HANDLE((0,0,0,0)(5,8,0,0)(0,0,3,0)(0,6,0,0));
+
+    DenseMatrixHandle U, S, V;
+    algo.run(sparse, U, S, V);
+
+    Eigen::MatrixXd dense(*sparse);
+    Eigen::JacobiSVD<Eigen::MatrixXd> jacobi(dense);
+    EXPECT_NEAR(jacobi.singularValues()(0), (*S)(0,0), 1e-10);
+    EXPECT_NEAR(jacobi.singularValues()(1), (*S)(1,0), 1e-10);
+}
+
+TEST(ComputeSVDtest, FullThrowsForSparseInput)
+{
+    ComputeSVDAlgo algo;
+    auto sparse = MAKE_SPARSE_MATRIX_HANDLE((0,0,0,0)(5,8,0,0)(0,0,3,0)(0,6,0,0));
+    DenseMatrixHandle U, S, V;
+    EXPECT_ANY_THROW(algo.run(sparse, U, S, V));
+}
+
+//Runtime and accuracy of the original Jacobi path against the full and randomized methods.
+TEST(ComputeSVDtest, DISABLED_SVDTiming)
+{
+    auto m = lowRankMatrix(4000, 400, 400, 0.9);
+    const int rank = 20;
+
+    {
+        ScopedTimer t("JacobiSVD, full U and V");
+        Eigen::JacobiSVD<DenseMatrix::EigenBase> jacobi(*m, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    }
+
+    DenseMatrixHandle U, S, V;
+    {
+        ScopedTimer t("Full (TSQR + BDCSVD), thin factors");
+        ComputeSVDAlgo algo;
+        algo.run(m, U, S, V);
+    }
+    std::cout << "Full relative reconstruction error: " << reconstructionError(*m, *U, *S, *V) << std::endl;
+
+    DenseMatrixHandle Ur, Sr, Vr;
+    {
+        ScopedTimer t("Randomized, rank 20");
+        ComputeSVDAlgo algo;
+        algo.setOption(Parameters::SVDMethod, "Randomized");
+        algo.set(Parameters::TruncationRank, rank);
+        algo.run(m, Ur, Sr, Vr);
+    }
+    double worst = 0;
+    for (int i = 0; i < rank; ++i)
+        worst = std::max(worst, std::abs((*S)(i,0) - (*Sr)(i,0)) / (*S)(i,0));
+    std::cout << "Randomized worst relative singular value error: " << worst << std::endl;
+}
@@ -0,0 +1,160 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/Math/LinearSystem/SparseLDLTSolver.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // 5-point Laplacian on an n x n grid plus shift * I, symmetric positive definite.
+  SparseRowMatrixHandle laplacian(int n, double shift = 0)
+  {
+    std::vector<Eigen::Triplet<double>> entries;
+    auto index = [n](int i, int j) { return i * n + j; };
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+      {
+        entries.emplace_back(index(i, j), index(i, j), 4 + shift);
+        if (i > 0) entries.emplace_back(index(i, j), index(i - 1, j), -1);
+        if (i < n - 1) entries.emplace_back(index(i, j), index(i + 1, j), -1);
+        if (j > 0) entries.emplace_back(index(i, j), index(i, j - 1), -1);
+        if (j < n - 1) entries.emplace_back(index(i, j), index(i, j + 1), -1);
+      }
+    auto A = boost::make_shared<SparseRowMatrix>(n * n, n * n);
+    A->setFromTriplets(entries.begin(), entries.end());
+    A->makeCompressed();
+    return A;
+  }
+
+  DenseColumnMatrix rhs(int size, double phase)
+  {
+    DenseColumnMatrix b(size);
+    for (int i = 0; i < size; ++i)
+      b[i] = std::sin(0.1 * i + phase);
+    return b;
+  }
+
+  double residual(const SparseRowMatrix& A, const DenseColumnMatrix& x, const DenseColumnMatrix& b)
+  {
+    return (A * x - b).norm() / b.norm();
+  }
+}
+
+TEST(SparseLDLTSolverTests, SolvesSymmetricSystem)
+{
+  auto A = laplacian(20);
+  auto b = rhs(400, 0);
+
+  SparseLDLTSolver solver;
+  EXPECT_EQ(SparseLDLTSolver::NONE, solver.factorize(*A));
+  auto x = solver.solve(b);
+
+  ASSERT_EQ(400, x->nrows());
+  EXPECT_LT(residual(*A, *x, b), 1e-12);
+}
+
+TEST(SparseLDLTSolverTests, ReusesFactorizationForSameMatrix)
+{
+  auto A = laplacian(20);
+  SparseLDLTSolver solver;
+  solver.factorize(*A);
+
+  EXPECT_EQ(SparseLDLTSolver::NUMERIC, solver.factorize(*A));
+  auto b = rhs(400, 1.5);
+  EXPECT_LT(residual(*A, *solver.solve(b), b), 1e-12);
+}
+
+TEST(SparseLDLTSolverTests, ReusesOrderingForSamePattern)
+{
+  SparseLDLTSolver solver;
+  solver.factorize(*laplacian(20));
+
+  auto shifted = laplacian(20, 0.5);
+  EXPECT_EQ(SparseLDLTSolver::SYMBOLIC, solver.factorize(*shifted));
+  auto b = rhs(400, 0.3);
+  EXPECT_LT(residual(*shifted, *solver.solve(b), b), 1e-12);
+
+  EXPECT_EQ(SparseLDLTSolver::NONE, solver.factorize(*laplacian(15)));
+}
+
+TEST(SparseLDLTSolverTests, ThrowsForUnsymmetricMatrix)
+{
+  auto A = laplacian(5);
+  A->coeffRef(0, 1) = -2;
+  SparseLDLTSolver solver;
+  EXPECT_ANY_THROW(solver.factorize(*A));
+  EXPECT_FALSE(solver.factorized());
+}
+
+TEST(SparseLDLTSolverTests, ThrowsForSolveBeforeFactorize)
+{
+  SparseLDLTSolver solver;
+  EXPECT_ANY_THROW(solver.solve(rhs(4, 0)));
+}
+
+TEST(SparseLDLTSolverTests, SolveLinearSystemAlgoUsesCachedFactorization)
+{
+  auto A = laplacian(20);
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, "ldlt");
+  algo.setUpdaterFunc([](double) {});
+
+  for (double phase : { 0.0, 0.7, 2.1 })
+  {
+    auto b = boost::make_shared<DenseColumnMatrix>(rhs(400, phase));
+    DenseColumnMatrixHandle x;
+    ASSERT_TRUE(algo.run(A, b, DenseColumnMatrixHandle(), x));
+    EXPECT_LT(residual(*A, *x, *b), 1e-12);
+  }
+}
+
+TEST(SparseLDLTSolverTests, DISABLED_FactorizeVersusResolveTiming)
+{
+  auto A = laplacian(400);
+  auto b = rhs(A->nrows(), 0);
+  SparseLDLTSolver solver;
+  {
+    ScopedTimer t("LDL^T factorization, 160000 unknowns");
+    solver.factorize(*A);
+  }
+  {
+    ScopedTimer t("LDL^T solve with cached factorization");
+    solver.factorize(*A);
+    solver.solve(b);
+  }
+}
@@ -28,6 +28,8 @@
 
 #include <Core/Algorithms/Visualization/DataConversions.h>
 #include <Core/Algorithms/Visualization/RenderFieldState.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
 
 namespace SCIRun {
 
@@ -125,6 +127,31 @@ bool valToBuffer(const char &value, std::ostringstream &buffer)
   return true;
 }
 
+namespace
+{
+  template <class T>
+  void mapAllValues(VField* field, const Core::Datatypes::ColorMap& map, std::vector<Core::Datatypes::ColorMap::LookupIndex>& indices)
+  {
+    std::vector<T> values;
+    field->get_values(values);
+    indices.resize(values.size());
+    if (!values.empty())
+      map.valuesToLookupIndices(&values[0], values.size(), &indices[0]);
+  }
+}
+
+std::vector<Core::Datatypes::ColorMap::LookupIndex> colorMapIndices(VField* field, const Core::Datatypes::ColorMap& map)
+{
+  std::vector<Core::Datatypes::ColorMap::LookupIndex> indices;
+  if (field->is_scalar())
+    mapAllValues<double>(field, map, indices);
+  else if (field->is_vector())
+    mapAllValues<Vector>(field, map, indices);
+  else if (field->is_tensor())
+    mapAllValues<Tensor>(field, map, indices);
+  return indices;
+}
+
 RenderState::RenderState()
 {
   for (int i = 0; i < MAX_ACTION_FLAGS; ++i)
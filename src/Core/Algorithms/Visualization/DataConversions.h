@@ -30,6 +30,8 @@
 #define CORE_ALGORITHMS_VISUALIZATION_DATA_CONVERSIONS_H
 
 #include <Core/Datatypes/Color.h>
+#include <Core/Datatypes/ColorMap.h>
+#include <Core/Datatypes/Legacy/Field/FieldFwd.h>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 
@@ -107,6 +109,11 @@ SCISHARE bool valToBuffer(const unsigned char&, std::ostringstream&);
 template <>
 SCISHARE bool valToBuffer(const char&, std::ostringstream&);
 
+/// Maps every value of a field through the colormap in one batch. The result is indexed like the
+/// field values, so nodes shared by several faces or edges reuse the table index instead of
+/// re-evaluating the map. Empty for fields without scalar, vector or tensor data.
+SCISHARE std::vector<Core::Datatypes::ColorMap::LookupIndex> colorMapIndices(VField* field, const Core::Datatypes::ColorMap& map);
+
 }
 
 #endif
@@ -38,6 +38,7 @@
 #include <Dataflow/Engine/Scheduler/DesktopExecutionStrategyFactory.h>
 #include <Core/Command/GlobalCommandBuilderFromCommandLine.h>
 #include <Core/Logging/Log.h>
+#include <Core/Logging/Profiler.h>
 #include <Core/Logging/ApplicationHelper.h>
 #include <Core/IEPlugin/IEPluginInit.h>
 #include <Core/Utils/Exception.h>
@@ -99,6 +100,8 @@ void Application::shutdown()
 {
   if (!private_)
     GeneralLog::Instance().get()->info("Application shutdown called with null internals");
+  else
+    writeProfile();
   try
   {
     private_.reset();
@@ -113,6 +116,26 @@ void Application::shutdown()
   }
 }
 
+void Application::writeProfile() const
+{
+  if (!private_ || !private_->parameters_)
+    return;
+  auto file = private_->parameters_->developerParameters()->profileFile();
+  if (!file)
+    return;
+
+  auto& profiler = Profiler::Instance();
+  for (const auto& entry : profiler.summarize())
+  {
+    GeneralLog::Instance().get()->info("Profile: {} ran {} time(s), total {} s, max {} s",
+      entry.first, entry.second.count, entry.second.totalSeconds, entry.second.maxSeconds);
+  }
+  if (profiler.writeChromeTrace(*file))
+    GeneralLog::Instance().get()->info("Wrote profile trace to {}", file->string());
+  else
+    GeneralLog::Instance().get()->error("Could not write profile trace to {}", file->string());
+}
+
 static ApplicationHelper applicationHelper;
 
 std::string Application::applicationName() const
@@ -160,6 +183,9 @@ void Application::readCommandLine(int argc, const char* argv[])
     auto maxCoresOption = private_->parameters_->developerParameters()->maxCores();
     if (maxCoresOption)
       Thread::Parallel::SetMaximumCores(*maxCoresOption);
+
+    if (private_->parameters_->developerParameters()->profileFile())
+      Profiler::Instance().setEnabled(true);
       
     LogSettings::Instance().setVerbose(parameters()->verboseMode());
   }
@@ -236,14 +262,7 @@ NetworkEditorControllerHandle Application::controller()
 
   if (!private_->controller_)
   {
-    /// @todo: these all get configured
-    ModuleFactoryHandle moduleFactory(new HardCodedModuleFactory);
-    ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
-    ExecutionStrategyFactoryHandle exe(new DesktopExecutionStrategyFactory(parameters()->developerParameters()->threadMode()));
-    AlgorithmFactoryHandle algoFactory(new HardCodedAlgorithmFactory);
-    ReexecuteStrategyFactoryHandle reexFactory(new DynamicReexecutionStrategyFactory(parameters()->developerParameters()->reexecuteMode()));
-    auto eventCmdFactory(makeNetworkEventCommandFactory());
-    private_->controller_.reset(new NetworkEditorController(moduleFactory, sf, exe, algoFactory, reexFactory, private_->cmdFactory_, eventCmdFactory));
+    private_->controller_ = makeController();
 
     /// @todo: sloppy way to initialize this but similar to v4, oh well
     IEPluginManager::Initialize();
@@ -251,6 +270,21 @@ NetworkEditorControllerHandle Application::controller()
   return private_->controller_;
 }
 
+NetworkEditorControllerHandle Application::makeController() const
+{
+  ENSURE_NOT_NULL(private_, "Application internals are uninitialized!");
+  ENSURE_NOT_NULL(private_->cmdFactory_, "Application internals are uninitialized!");
+
+  /// @todo: these all get configured
+  ModuleFactoryHandle moduleFactory(new HardCodedModuleFactory);
+  ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
+  ExecutionStrategyFactoryHandle exe(new DesktopExecutionStrategyFactory(parameters()->developerParameters()->threadMode()));
+  AlgorithmFactoryHandle algoFactory(new HardCodedAlgorithmFactory);
+  ReexecuteStrategyFactoryHandle reexFactory(new DynamicReexecutionStrategyFactory(parameters()->developerParameters()->reexecuteMode()));
+  auto eventCmdFactory(makeNetworkEventCommandFactory());
+  return boost::make_shared<NetworkEditorController>(moduleFactory, sf, exe, algoFactory, reexFactory, private_->cmdFactory_, eventCmdFactory);
+}
+
 void Application::executeCommandLineRequests()
 {
   ENSURE_NOT_NULL(private_, "Application internals are uninitialized!");
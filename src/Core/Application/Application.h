@@ -69,6 +69,8 @@ public:
   void setCommandFactory(Commands::GlobalCommandFactoryHandle cmdFactory);
   CommandLine::ApplicationParametersHandle parameters() const;
   boost::shared_ptr<SCIRun::Dataflow::Engine::NetworkEditorController> controller();
+  /// A separate controller and network built from the same factories as controller(), e.g. for sweep lanes.
+  boost::shared_ptr<SCIRun::Dataflow::Engine::NetworkEditorController> makeController() const;
 
   void executeCommandLineRequests();
 
@@ -86,6 +88,8 @@ public:
   bool moduleNameExists(const std::string& name);
 
   void shutdown();
+  /// Writes the Chrome trace requested with --profile, if any.
+  void writeProfile() const;
 
   /// @todo: following will be useful later
 #if 0
@@ -91,6 +91,7 @@ namespace SCIRun
         SetupDataDirectory,
         DisableViewScenes,
         ExecuteCurrentNetwork,
+        RunParameterSweep,
         InteractiveMode,
         SetupQuitAfterExecute,
         QuitCommand
@@ -99,7 +99,12 @@ using namespace SCIRun::Core::Algorithms;
           load->set(Variables::Filename, mostRecentFileCode());
         q->enqueue(load);
 
-        if (params->executeNetwork())
+        if (params->developerParameters()->sweepFile())
+        {
+          // the sweep quits when its last row finishes
+          q->enqueue(cmdFactory_->create(GlobalCommands::RunParameterSweep));
+        }
+        else if (params->executeNetwork())
           q->enqueue(cmdFactory_->create(GlobalCommands::ExecuteCurrentNetwork));
         else if (params->executeNetworkAndQuit())
         {
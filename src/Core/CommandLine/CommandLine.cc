@@ -68,6 +68,8 @@ public:
       //("frameInitLimit", po::value<int>(), "ViewScene frame init limit--increase if renderer fails")
       ("guiExpandFactor", po::value<double>(), "Expansion factor for high resolution displays")
       ("max-cores", po::value<unsigned int>(), "Limit the number of cores used by multithreaded algorithms")
+      ("profile", po::value<std::string>(), "Record wall-clock timings of modules and parallel tasks; write them as a Chrome trace file on exit")
+      ("sweep", po::value<std::string>(), "Headless parameter sweep: execute the network once per row of a CSV table of module state overrides, header ModuleId::StateKey")
       ("list-modules", "print list of available modules")
       ;
 
@@ -117,9 +119,12 @@ public:
     const boost::optional<int>& frameInitLimit,
     const boost::optional<int>& regressionTimeout,
     const boost::optional<unsigned int>& maxCores,
-    const boost::optional<double>& guiExpandFactor
+    const boost::optional<double>& guiExpandFactor,
+    const boost::optional<boost::filesystem::path>& profileFile,
+    const boost::optional<boost::filesystem::path>& sweepFile
     ) : threadMode_(threadMode), reexecuteMode_(reexecuteMode), frameInitLimit_(frameInitLimit),
-    regressionTimeout_(regressionTimeout), maxCores_(maxCores), guiExpandFactor_(guiExpandFactor)
+    regressionTimeout_(regressionTimeout), maxCores_(maxCores), guiExpandFactor_(guiExpandFactor),
+    profileFile_(profileFile), sweepFile_(sweepFile)
   {}
   boost::optional<int> regressionTimeoutSeconds() const override
   {
@@ -145,11 +150,20 @@ public:
   {
     return guiExpandFactor_;
   }
+  boost::optional<boost::filesystem::path> profileFile() const override
+  {
+    return profileFile_;
+  }
+  boost::optional<boost::filesystem::path> sweepFile() const override
+  {
+    return sweepFile_;
+  }
 private:
   boost::optional<std::string> threadMode_, reexecuteMode_;
   boost::optional<int> frameInitLimit_, regressionTimeout_;
   boost::optional<unsigned int> maxCores_;
   boost::optional<double> guiExpandFactor_;
+  boost::optional<boost::filesystem::path> profileFile_, sweepFile_;
 };
 
 class ApplicationParametersImpl : public ApplicationParameters
@@ -325,6 +339,16 @@ ApplicationParametersHandle CommandLineParser::parse(int argc, const char* argv[
     {
       pythonScriptFile = boost::filesystem::path(parsed["Script"].as<std::string>());
     }
+    auto profileFile = boost::optional<boost::filesystem::path>();
+    if (parsed.count("profile") != 0 && !parsed["profile"].empty())
+    {
+      profileFile = boost::filesystem::path(parsed["profile"].as<std::string>());
+    }
+    auto sweepFile = boost::optional<boost::filesystem::path>();
+    if (parsed.count("sweep") != 0 && !parsed["sweep"].empty())
+    {
+      sweepFile = boost::filesystem::path(parsed["sweep"].as<std::string>());
+    }
     auto dataDirectory = boost::optional<boost::filesystem::path>();
     if (parsed.count("datadir") != 0 && !parsed["datadir"].empty() && !parsed["datadir"].defaulted())
     {
@@ -342,7 +366,9 @@ ApplicationParametersHandle CommandLineParser::parse(int argc, const char* argv[
         parseOptionalArg<int>(parsed, "frameInitLimit"),
         parseOptionalArg<int>(parsed, "regression"),
         parseOptionalArg<unsigned int>(parsed, "max-cores"),
-        parseOptionalArg<double>(parsed, "guiExpandFactor")
+        parseOptionalArg<double>(parsed, "guiExpandFactor"),
+        profileFile,
+        sweepFile
       ),
       ApplicationParametersImpl::Flags(
         parsed.count("help") != 0,
@@ -57,6 +57,11 @@ TEST(ScirunCommandLineSpecTest, CanReadBasicOptions)
     "  --guiExpandFactor arg   Expansion factor for high resolution displays\n"
     "  --max-cores arg         Limit the number of cores used by multithreaded \n"
     "                          algorithms\n"
+    "  --profile arg           Record wall-clock timings of modules and parallel \n"
+    "                          tasks; write them as a Chrome trace file on exit\n"
+    "  --sweep arg             Headless parameter sweep: execute the network once \n"
+    "                          per row of a CSV table of module state overrides, \n"
+    "                          header ModuleId::StateKey\n"
     "  --list-modules          print list of available modules\n";
 
   EXPECT_EQ(expectedHelp, parser.describe());
@@ -187,4 +192,27 @@ TEST(ScirunCommandLineSpecTest, CanReadBasicOptions)
     EXPECT_EQ("scr1.py", *aph->pythonScriptFile());
     EXPECT_TRUE(aph->quitAfterOneScriptedExecution());
   }
+
+  {
+    const char* argv[] = { "scirun.exe", "-x", "-E", "net.srn5", "--profile", "trace.json" };
+    int argc = sizeof(argv) / sizeof(char*);
+
+    auto aph = parser.parse(argc, argv);
+
+    ASSERT_TRUE(!!aph->developerParameters()->profileFile());
+    EXPECT_EQ("trace.json", *aph->developerParameters()->profileFile());
+    EXPECT_EQ("net.srn5", aph->inputFiles()[0]);
+  }
+
+  {
+    const char* argv[] = { "scirun.exe", "-x", "net.srn5", "--sweep", "rows.csv", "--max-cores", "8" };
+    int argc = sizeof(argv) / sizeof(char*);
+
+    auto aph = parser.parse(argc, argv);
+
+    ASSERT_TRUE(!!aph->developerParameters()->sweepFile());
+    EXPECT_EQ("rows.csv", *aph->developerParameters()->sweepFile());
+    EXPECT_EQ(8u, *aph->developerParameters()->maxCores());
+    EXPECT_EQ("net.srn5", aph->inputFiles()[0]);
+  }
 }
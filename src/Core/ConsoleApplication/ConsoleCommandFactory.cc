@@ -64,6 +64,8 @@ CommandHandle ConsoleGlobalCommandFactory::create(GlobalCommands type) const
     return boost::make_shared<ExecuteCurrentNetworkCommandConsole>();
   case GlobalCommands::SetupDataDirectory:
     return boost::make_shared<SetupDataDirectoryCommand>();
+  case GlobalCommands::RunParameterSweep:
+    return boost::make_shared<RunParameterSweepCommandConsole>();
   case GlobalCommands::InteractiveMode:
     return boost::make_shared<InteractiveModeCommandConsole>();
   case GlobalCommands::SetupQuitAfterExecute:
@@ -29,6 +29,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/ConsoleApplication/ConsoleCommands.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Dataflow/Engine/Controller/NetworkEditorController.h>
+#include <Dataflow/Engine/Controller/ParameterSweep.h>
 #include <Core/Application/Application.h>
 #include <Dataflow/Serialization/Network/XMLSerializer.h>
 #include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
@@ -36,6 +37,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Logging/ConsoleLogger.h>
 #include <Core/Python/PythonInterpreter.h>
 #include <boost/algorithm/string.hpp>
+#include <fstream>
 #include <Core/Application/Preferences/Preferences.h>
 
 using namespace SCIRun::Core;
@@ -121,6 +123,44 @@ bool ExecuteCurrentNetworkCommandConsole::execute()
   return interactive.execute();
 }
 
+bool RunParameterSweepCommandConsole::execute()
+{
+  auto sweepFile = Application::Instance().parameters()->developerParameters()->sweepFile();
+  if (!sweepFile)
+    return false;
+
+  int exitCode = 1;
+  std::ifstream in(sweepFile->string());
+  if (!in)
+  {
+    LOG_CONSOLE("Sweep table could not be read: " << sweepFile->string());
+  }
+  else
+  {
+    try
+    {
+      auto table = Dataflow::Engine::ParameterSweepTable::fromCsv(in);
+      LOG_CONSOLE("Running parameter sweep of " << table.rows().size() << " row(s)...");
+      Dataflow::Engine::ParameterSweep sweep(table, Application::Instance().controller()->saveNetwork(),
+        []() { return Application::Instance().makeController(); });
+      auto results = sweep.run();
+      auto failedRows = std::count_if(results.begin(), results.end(),
+        [](const Dataflow::Engine::ParameterSweepRowResult& r) { return r.errors != 0; });
+      LOG_CONSOLE("Parameter sweep done: " << failedRows << " of " << results.size() << " row(s) had errors.");
+      exitCode = failedRows == 0 ? 0 : 1;
+    }
+    catch (std::exception& e)
+    {
+      LOG_CONSOLE("Parameter sweep failed: " << e.what());
+    }
+  }
+
+  LOG_CONSOLE("Goodbye! Exit code: " << exitCode);
+  Application::Instance().writeProfile();
+  exit(exitCode);
+  return exitCode == 0;
+}
+
 QuitAfterExecuteCommandConsole::QuitAfterExecuteCommandConsole()
 {
   addParameter(Name("RunningPython"), false);
@@ -132,6 +172,7 @@ bool QuitAfterExecuteCommandConsole::execute()
   Application::Instance().controller()->connectNetworkExecutionFinished([](int code)
   {
     LOG_CONSOLE("Goodbye! Exit code: " << code);
+    Application::Instance().writeProfile();
     exit(code);
   });
   return true;
@@ -145,6 +186,7 @@ QuitCommandConsole::QuitCommandConsole()
 bool QuitCommandConsole::execute()
 {
   LOG_CONSOLE("Goodbye!");
+  Application::Instance().writeProfile();
   exit(0);
   return true;
 }
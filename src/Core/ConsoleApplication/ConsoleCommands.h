@@ -64,6 +64,13 @@ namespace Console {
     virtual bool execute() override;
   };
 
+  /// Runs the loaded network once per row of the --sweep table, then quits; the exit code is nonzero if any row had errors.
+  class SCISHARE RunParameterSweepCommandConsole : public Core::Commands::ConsoleCommand
+  {
+  public:
+    virtual bool execute() override;
+  };
+
   class SCISHARE QuitAfterExecuteCommandConsole : public Core::Commands::ConsoleCommand
   {
   public:
@@ -30,7 +30,7 @@
 #include <Core/Math/MiscMath.h>
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/Logging/Log.h>
-#include <iostream>
+#include <Core/Thread/Parallel.h>
 #include <boost/functional/factory.hpp>
 #include <boost/function.hpp>
 #include <boost/range/adaptors.hpp>
@@ -46,7 +46,18 @@ ColorMap::ColorMap(ColorMapStrategyHandle color, const std::string& name, const
   : color_(color), nameInfo_(name), resolution_(resolution), shift_(shift),
   invert_(invert), rescale_scale_(rescale_scale), rescale_shift_(rescale_shift)
 {
+  buildLookupTable();
+}
 
+void ColorMap::buildLookupTable()
+{
+  lookupTable_.clear();
+  if (!color_)
+    return;
+  // lookupIndex() yields 0..resolution inclusive: a value of exactly 1 quantizes to resolution.
+  lookupTable_.reserve(resolution_ + 1);
+  for (size_t i = 0; i <= resolution_; ++i)
+    lookupTable_.push_back(color_->getColorMapVal(transformedValueAt(static_cast<LookupIndex>(i))));
 }
 
 ColorMap* ColorMap::clone() const
@@ -137,36 +148,32 @@ StandardColorMapFactory::NameList StandardColorMapFactory::getList()
 }
 
 /**
- * @name getTransformedColor
- * @brief This method transforms the raw data into ColorMap space.
- * This includes the resolution, the gamma shift, and data rescaling (using data min/max)
- * @param v The input value from raw data that will be transformed (usually into [0,1] space).
- * @return The scalar double value transformed into ColorMap space from raw data.
+ * @name lookupIndex
+ * @brief Rescales, clamps, inverts and quantizes a raw data value to the resolution.
+ * @return Index in [0, resolution] into the lookup table.
  */
-double ColorMap::getTransformedValue(double f) const
+ColorMap::LookupIndex ColorMap::lookupIndex(double f) const
 {
-  /////////////////////////////////////////////////
-  //TODO: this seemingly useless code fixes a nasty crash bug on Windows. Don't delete it until a proper fix is implemented!
-  static bool x = true;
-  if (x)
-  {
-    std::cout << "";// this;// << " " << name_ << " " << resolution_ << " " << shift_ << " " << invert_ << std::endl;
-    x = false;
-  }
-  /////////////////////////////////////////////////
-
   const double rescaled01 = static_cast<double>((f + rescale_shift_) * rescale_scale_);
 
   double v = std::min(std::max(0., rescaled01), 1.);
-  double shift = shift_;
-  if (invert_) {
+  if (invert_)
     v = 1.f - v;
-    shift *= -1.;
-  }
   //apply the resolution
-  v = static_cast<double>((static_cast<int>(v *
-    static_cast<double>(resolution_)))) /
-    static_cast<double>(resolution_ - 1);
+  return static_cast<LookupIndex>(v * static_cast<double>(resolution_));
+}
+
+/**
+ * @name transformedValueAt
+ * @brief Applies the gamma shift to a quantized value.
+ * @return The value in ColorMap space [0,1] passed to the color strategy.
+ */
+double ColorMap::transformedValueAt(LookupIndex index) const
+{
+  double shift = shift_;
+  if (invert_)
+    shift *= -1.;
+  double v = static_cast<double>(index) / static_cast<double>(resolution_ - 1);
   // the shift is a gamma.
   double denom = std::tan(M_PI_2 * (0.5 - std::min(std::max(shift, -0.99), 0.99) * 0.5));
   // make sure we don't hit divide by zero
@@ -187,9 +194,8 @@ double ColorMap::getTransformedValue(double f) const
  */
 ColorRGB ColorMap::getColorMapVal(double v) const
 {
-  double f = getTransformedValue(v);
-  //now grab the RGB
-  auto colorWithoutAlpha = color_->getColorMapVal(f);
+  //the table already holds the strategy's color for every quantized value
+  auto colorWithoutAlpha = lookupTable_[lookupIndex(v)];
   //TODO:
   //return applyAlpha(f, colorWithoutAlpha);
   return colorWithoutAlpha;
@@ -220,14 +226,21 @@ ColorRGB ColorMap::valueToColor(double scalar) const {
  * @param The raw data value as a tensor.
  * @return The RGB value mapped from the tensor.
  */
-ColorRGB ColorMap::valueToColor(const Tensor &tensor) const {
+namespace
+{
+  double primaryEigenvalue(const Tensor& tensor)
+  {
     //TODO this is probably not implemented correctly.
     //return ColorRGB(getTransformedColor(fabs(tensor.xx())), getTransformedColor(fabs(tensor.yy())), getTransformedColor(fabs(tensor.zz())));
-  double eigen1, eigen2, eigen3;
-  Tensor ten = tensor;
-  ten.get_eigenvalues(eigen1, eigen2, eigen3);
-  double primaryEigen = std::max(std::max(eigen1, eigen2), eigen3);
-  return getColorMapVal(primaryEigen);
+    double eigen1, eigen2, eigen3;
+    Tensor ten = tensor;
+    ten.get_eigenvalues(eigen1, eigen2, eigen3);
+    return std::max(std::max(eigen1, eigen2), eigen3);
+  }
+}
+
+ColorRGB ColorMap::valueToColor(const Tensor &tensor) const {
+  return getColorMapVal(primaryEigenvalue(tensor));
 }
 /**
  * @name valueToColor
@@ -241,6 +254,109 @@ ColorRGB ColorMap::valueToColor(const Vector &vector) const {
   return getColorMapVal(vector.length());
 }
 
+namespace
+{
+  // Values are reduced to scalars in fixed-size chunks to keep the temporaries on the stack.
+  const size_t batchChunkSize = 1024;
+  // Eigen decomposition dominates tensor mapping; below this count threads cost more than they save.
+  const size_t parallelTensorThreshold = 16384;
+}
+
+void ColorMap::valuesToLookupIndices(const double* scalars, size_t count, LookupIndex* indices) const
+{
+  // Branch-free form of lookupIndex() so the compiler can vectorize the min/max rescaling.
+  // The comparisons are ordered like std::max/std::min so that NaN maps to 0 as well.
+  const double shift = rescale_shift_, scale = rescale_scale_;
+  const double resolution = static_cast<double>(resolution_);
+  const bool invert = invert_;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double v = (scalars[i] + shift) * scale;
+    v = 0. < v ? v : 0.;
+    v = v < 1. ? v : 1.;
+    v = invert ? 1. - v : v;
+    indices[i] = static_cast<LookupIndex>(v * resolution);
+  }
+}
+
+void ColorMap::valuesToLookupIndices(const Vector* vectors, size_t count, LookupIndex* indices) const
+{
+  double magnitudes[batchChunkSize];
+  for (size_t begin = 0; begin < count; begin += batchChunkSize)
+  {
+    auto n = std::min(batchChunkSize, count - begin);
+    for (size_t i = 0; i < n; ++i)
+      magnitudes[i] = vectors[begin + i].length();
+    valuesToLookupIndices(magnitudes, n, indices + begin);
+  }
+}
+
+void ColorMap::valuesToLookupIndices(const Tensor* tensors, size_t count, LookupIndex* indices) const
+{
+  auto mapRange = [=](size_t rangeBegin, size_t rangeEnd)
+  {
+    double eigenvalues[batchChunkSize];
+    for (size_t begin = rangeBegin; begin < rangeEnd; begin += batchChunkSize)
+    {
+      auto n = std::min(batchChunkSize, rangeEnd - begin);
+      for (size_t i = 0; i < n; ++i)
+        eigenvalues[i] = primaryEigenvalue(tensors[begin + i]);
+      valuesToLookupIndices(eigenvalues, n, indices + begin);
+    }
+  };
+
+  const size_t numProcs = SCIRun::Core::Thread::Parallel::NumCores();
+  if (count < parallelTensorThreshold || numProcs < 2)
+  {
+    mapRange(0, count);
+    return;
+  }
+
+  const size_t perThread = (count + numProcs - 1) / numProcs;
+  SCIRun::Core::Thread::Parallel::RunTasks([&](int proc)
+  {
+    auto begin = std::min(count, proc * perThread);
+    mapRange(begin, std::min(count, begin + perThread));
+  }, static_cast<int>(numProcs));
+}
+
+namespace
+{
+  template <class T>
+  void mapThroughLookupTable(const ColorMap& map, const T* values, size_t count, ColorRGB* colors)
+  {
+    ColorMap::LookupIndex indices[batchChunkSize];
+    for (size_t begin = 0; begin < count; begin += batchChunkSize)
+    {
+      auto n = std::min(batchChunkSize, count - begin);
+      map.valuesToLookupIndices(values + begin, n, indices);
+      for (size_t i = 0; i < n; ++i)
+        colors[begin + i] = map.lookupColor(indices[i]);
+    }
+  }
+}
+
+void ColorMap::valuesToColors(const double* scalars, size_t count, ColorRGB* colors) const
+{
+  mapThroughLookupTable(*this, scalars, count, colors);
+}
+
+void ColorMap::valuesToColors(const Vector* vectors, size_t count, ColorRGB* colors) const
+{
+  mapThroughLookupTable(*this, vectors, count, colors);
+}
+
+void ColorMap::valuesToColors(const Tensor* tensors, size_t count, ColorRGB* colors) const
+{
+  // resolve all eigenvalues first so the tensor path can use every core
+  std::vector<LookupIndex> indices(count);
+  if (count == 0)
+    return;
+  valuesToLookupIndices(tensors, count, &indices[0]);
+  for (size_t i = 0; i < count; ++i)
+    colors[i] = lookupTable_[indices[i]];
+}
+
 // This Rainbow takes into account scientific visualization recommendations.
 // It tones down the yellow/cyan values so they don't appear to
 // be "brighter" than the other colors. All colors "appear" to be the
@@ -29,6 +29,8 @@
 #ifndef CORE_DATATYPES_COLORMAP_H
 #define CORE_DATATYPES_COLORMAP_H
 
+#include <cstdint>
+#include <vector>
 #include <Core/Datatypes/Datatype.h>
 #include <boost/noncopyable.hpp>
 #include <Core/Datatypes/Color.h>
@@ -67,12 +69,37 @@ namespace Datatypes {
     ColorRGB valueToColor(const Core::Geometry::Tensor &tensor) const;
     ColorRGB valueToColor(const Core::Geometry::Vector &vector) const;
 
+    ///<< Batch versions of valueToColor: map count values into colors (RGBA).
+    /// Colors come from a table precomputed at construction with getColorMapResolution() + 1 entries,
+    /// so the results are identical to the per-value calls.
+    void valuesToColors(const double* scalars, size_t count, ColorRGB* colors) const;
+    void valuesToColors(const Core::Geometry::Vector* vectors, size_t count, ColorRGB* colors) const;
+    void valuesToColors(const Core::Geometry::Tensor* tensors, size_t count, ColorRGB* colors) const;
+    template <class T>
+    std::vector<ColorRGB> valuesToColors(const std::vector<T>& values) const
+    {
+      std::vector<ColorRGB> colors(values.size());
+      if (!values.empty())
+        valuesToColors(&values[0], values.size(), &colors[0]);
+      return colors;
+    }
+
+    ///<< Compact form of the batch API for callers that look colors up repeatedly (e.g. mesh nodes
+    /// shared by several faces): store table indices, then fetch with lookupColor.
+    typedef uint32_t LookupIndex;
+    void valuesToLookupIndices(const double* scalars, size_t count, LookupIndex* indices) const;
+    void valuesToLookupIndices(const Core::Geometry::Vector* vectors, size_t count, LookupIndex* indices) const;
+    void valuesToLookupIndices(const Core::Geometry::Tensor* tensors, size_t count, LookupIndex* indices) const;
+    const ColorRGB& lookupColor(LookupIndex index) const { return lookupTable_[index]; }
+
     virtual std::string dynamic_type_name() const override { return "ColorMap"; }
 
   private:
     ///<< Internal functions.
     Core::Datatypes::ColorRGB getColorMapVal(double v) const;
-    double getTransformedValue(double v) const;
+    LookupIndex lookupIndex(double v) const;
+    double transformedValueAt(LookupIndex index) const;
+    void buildLookupTable();
 
     ColorMapStrategyHandle color_;
     ///<< The colormap's name.
@@ -89,6 +116,8 @@ namespace Datatypes {
     double rescale_shift_;
 
     std::vector<double> alphaLookup_;
+    ///<< Strategy colors of every quantized value, indexed by lookupIndex().
+    std::vector<ColorRGB> lookupTable_;
   };
 
   class SCISHARE ColorMapStrategy
@@ -1549,14 +1549,9 @@ template <class Basis>
 void
 CurveMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
-  auto itr = points_.begin();
-  auto eitr = points_.end();
-  while (itr != eitr)
-  {
-    *itr = t.project(*itr);
-    ++itr;
-  }
-  
+  transform_points(points_.empty() ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
+
   /// If we have nodes on the edges they should be transformed in
   /// the same way
   size_type num_enodes = static_cast<size_type>(basis_.size_node_values());
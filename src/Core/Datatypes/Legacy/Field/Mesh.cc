@@ -40,6 +40,8 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/GeometryPrimitives/Transform.h>
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/GeometryPrimitives/BBox.h>
 #include <sci_debug.h>
 
 using namespace SCIRun;
@@ -589,3 +591,35 @@ SCIRun::CreateMesh(const std::string& type, size_type x)
   
   return (handle);
 }
+
+BBox
+SCIRun::transform_points(Point* points, size_type size, const Transform& t)
+{
+  // Below this size a single pass is faster than waking up the worker threads.
+  const size_type minPointsPerTask = 1 << 15;
+  const int numTasks = static_cast<int>(std::max<size_type>(1,
+    std::min<size_type>(Parallel::NumCores(), size / minPointsPerTask)));
+
+  std::vector<BBox> boxes(numTasks);
+  auto task = [&](int i)
+  {
+    const size_type begin = size * i / numTasks;
+    const size_type end = size * (i + 1) / numTasks;
+    BBox& box = boxes[i];
+    for (size_type j = begin; j < end; ++j)
+    {
+      points[j] = t.project(points[j]);
+      box.extend(points[j]);
+    }
+  };
+
+  if (numTasks == 1)
+    task(0);
+  else
+    Parallel::RunTasks(task, numTasks);
+
+  BBox bbox;
+  for (const auto& box : boxes)
+    bbox.extend(box);
+  return bbox;
+}
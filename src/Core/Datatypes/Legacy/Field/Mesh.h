@@ -176,6 +176,10 @@ SCISHARE MeshHandle CreateMesh(mesh_info_type mesh,size_type x,size_type y,size_
 SCISHARE MeshHandle CreateMesh(mesh_info_type mesh, const std::vector<size_type>& x);
 SCISHARE MeshHandle CreateMesh(mesh_info_type mesh, const std::vector<size_type>& x,const Core::Geometry::Point& min,const Core::Geometry::Point& max);
 
+/// Transform a contiguous array of mesh nodes in place, split over the available
+/// cores, and return the bounding box of the transformed nodes.
+SCISHARE Core::Geometry::BBox transform_points(Core::Geometry::Point* points, size_type size, const Core::Geometry::Transform& t);
+
 /// General case locate, search each elem.
 template <class INDEX, class MESH>
 bool elem_locate(INDEX &elem, MESH &msh, const Core::Geometry::Point &p)
@@ -1400,14 +1400,9 @@ PointCloudMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
-  while (itr != eitr)
-  {
-    *itr = t.project(*itr);
-    ++itr;
-  }
-  
+  transform_points(points_.empty() ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
+
   if (grid_) { grid_->transform(t); }
 
   synchronize_lock_.unlock();  
@@ -947,16 +947,8 @@ template <class Basis>
 void
 StructCurveMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
-  typename ScanlineMesh<Basis>::Node::iterator i, ie;
-  this->begin(i);
-  this->end(ie);
-
-  while (i != ie) 
-  {
-    points_[*i] = t.project(points_[*i]);
-
-    ++i;
-  }
+  transform_points(points_.empty() ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
 }
 
 
@@ -1186,17 +1186,8 @@ template <class Basis>
 void
 StructHexVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
-  typename LatVolMesh<Basis>::Node::iterator i, ie;
-  this->begin(i);
-  this->end(ie);
-
-  while (i != ie)
-  {
-    points_((*i).k_,(*i).j_,(*i).i_) =
-      t.project(points_((*i).k_,(*i).j_,(*i).i_));
-
-    ++i;
-  }
+  transform_points(points_.size() == 0 ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
 
   synchronize_lock_.lock();
   if (node_grid_) { node_grid_->transform(t); }
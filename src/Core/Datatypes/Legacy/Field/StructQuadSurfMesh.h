@@ -1124,15 +1124,8 @@ StructQuadSurfMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  typename ImageMesh<Basis>::Node::iterator i, ie;
-  this->begin(i);
-  this->end(ie);
-
-  while (i != ie) 
-  {
-    points_((*i).j_,(*i).i_) = t.project(points_((*i).j_,(*i).i_));
-    ++i;
-  }
+  transform_points(points_.size() == 0 ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
 
   if (node_grid_) { node_grid_->transform(t); }
   if (elem_grid_) { elem_grid_->transform(t); }
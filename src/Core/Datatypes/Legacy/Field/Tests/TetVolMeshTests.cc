@@ -32,6 +32,9 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/GeometryPrimitives/Transform.h>
+#include <Core/GeometryPrimitives/BBox.h>
 
 #include <gtest/gtest.h>
 
@@ -69,4 +72,123 @@ TEST(TetVolMeshTest, CheckMeshIteratorTetVolMesh)
   
 }
 
+TEST(TetVolMeshTest, TransformUpdatesNodesAndBoundingBox)
+{
+  FieldHandle tetmesh = CubeTetVolLinearBasis(NONE_E);
+  VMesh* mesh = tetmesh->vmesh();
+
+  std::vector<Point> before;
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    before.push_back(p);
+  }
+  BBox original = mesh->get_bounding_box();
+
+  Transform t;
+  t.load_identity();
+  t.pre_scale(Vector(2, 3, 4));
+  t.pre_translate(Vector(1, -1, 0.5));
+  mesh->transform(t);
+
+  for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    EXPECT_EQ(t.project(before[i]), p);
+  }
+  BBox transformed = mesh->get_bounding_box();
+  EXPECT_EQ(t.project(original.get_min()), transformed.get_min());
+  EXPECT_EQ(t.project(original.get_max()), transformed.get_max());
+}
+
+TEST(TetVolMeshTest, TransformPointsMatchesSerialProjection)
+{
+  const size_type size = 200000;
+  std::vector<Point> points(size), expected(size);
+  for (size_type i = 0; i < size; ++i)
+    points[i] = Point(i % 101, (i / 101) % 103, i * 1e-3);
+
+  Transform t;
+  t.load_identity();
+  t.pre_rotate(0.3, Vector(1, 1, 0));
+  t.pre_translate(Vector(5, 0, -2));
+
+  BBox serial;
+  for (size_type i = 0; i < size; ++i)
+  {
+    expected[i] = t.project(points[i]);
+    serial.extend(expected[i]);
+  }
+
+  BBox bbox = transform_points(&points[0], size, t);
+
+  for (size_type i = 0; i < size; ++i)
+    ASSERT_EQ(expected[i], points[i]);
+  EXPECT_EQ(serial.get_min(), bbox.get_min());
+  EXPECT_EQ(serial.get_max(), bbox.get_max());
+}
 
+TEST(TetVolMeshTest, BulkCentersAndConnectivityMatchPerElementAccess)
+{
+  FieldHandle tetmesh = CubeTetVolLinearBasis(DOUBLE_E);
+  VMesh* mesh = tetmesh->vmesh();
+
+  const VMesh::size_type numNodes = mesh->num_nodes();
+  const VMesh::size_type numElems = mesh->num_elems();
+  const VMesh::size_type n = mesh->num_nodes_per_elem();
+
+  std::vector<Point> nodeCenters(numNodes);
+  mesh->get_node_centers(&nodeCenters[0], VMesh::Node::index_type(0), VMesh::Node::size_type(numNodes));
+  for (VMesh::Node::index_type i = 0; i < numNodes; ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    EXPECT_EQ(p, nodeCenters[i]);
+  }
+
+  std::vector<Point> elemCenters(numElems - 1);
+  mesh->get_elem_centers(&elemCenters[0], VMesh::Elem::index_type(1), VMesh::Elem::size_type(numElems - 1));
+  for (VMesh::Elem::index_type i = 1; i < numElems; ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    EXPECT_EQ(p, elemCenters[i - 1]);
+  }
+
+  std::vector<VMesh::index_type> connectivity(numElems * n);
+  mesh->get_elem_nodes(&connectivity[0], VMesh::Elem::index_type(0), VMesh::Elem::size_type(numElems));
+  VMesh::Node::array_type nodes;
+  for (VMesh::Elem::index_type i = 0; i < numElems; ++i)
+  {
+    mesh->get_nodes(nodes, i);
+    for (VMesh::index_type k = 0; k < n; ++k)
+      EXPECT_EQ(nodes[k], connectivity[i * n + k]);
+  }
+}
+
+TEST(TetVolMeshTest, BulkAccessFallsBackOnStructuredMeshes)
+{
+  FieldHandle latvol = CreateEmptyLatVol(3, 3, 3);
+  VMesh* mesh = latvol->vmesh();
+
+  const VMesh::size_type numElems = mesh->num_elems();
+  const VMesh::size_type n = mesh->num_nodes_per_elem();
+
+  std::vector<Point> elemCenters(numElems);
+  mesh->get_elem_centers(&elemCenters[0], VMesh::Elem::index_type(0), VMesh::Elem::size_type(numElems));
+  std::vector<VMesh::index_type> connectivity(numElems * n);
+  mesh->get_elem_nodes(&connectivity[0], VMesh::Elem::index_type(0), VMesh::Elem::size_type(numElems));
+
+  VMesh::Node::array_type nodes;
+  for (VMesh::Elem::index_type i = 0; i < numElems; ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    EXPECT_EQ(p, elemCenters[i]);
+    mesh->get_nodes(nodes, i);
+    for (VMesh::index_type k = 0; k < n; ++k)
+      EXPECT_EQ(nodes[k], connectivity[i * n + k]);
+  }
+}
@@ -192,3 +192,31 @@ TEST(VFieldTest, TetVolMeshSetFieldValueTest2)
 }
 
 
+
+TEST(VFieldTest, TypedValuesPointerOnlyForMatchingType)
+{
+  FieldHandle field = CubeTetVolLinearBasis(DOUBLE_E);
+  VField *vfield = field->vfield();
+
+  std::vector<double> values(vfield->num_values());
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = 0.5 * i;
+  vfield->set_values(values);
+
+  double* data = vfield->get_values_pointer_as<double>();
+  ASSERT_TRUE(data != nullptr);
+  for (size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(values[i], data[i]);
+
+  data[1] = 42.0;
+  double v;
+  vfield->get_value(v, 1);
+  EXPECT_EQ(42.0, v);
+
+  EXPECT_TRUE(vfield->get_values_pointer_as<float>() == nullptr);
+  EXPECT_TRUE(vfield->get_values_pointer_as<int>() == nullptr);
+  EXPECT_TRUE(vfield->get_values_pointer_as<Core::Geometry::Vector>() == nullptr);
+
+  FieldHandle empty = CubeTetVolLinearBasis(NONE_E);
+  EXPECT_TRUE(empty->vfield()->get_values_pointer_as<double>() == nullptr);
+}
@@ -2869,27 +2869,12 @@ TetVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
-  std::vector<Core::Geometry::Point>::iterator itr = points_.begin();
-  std::vector<Core::Geometry::Point>::iterator eitr = points_.end();
-  while (itr != eitr)
-  {
-    *itr = t.project(*itr);
-    ++itr;
-  }
+  const Core::Geometry::BBox bbox = transform_points(points_.empty() ? nullptr : &points_[0],
+    static_cast<size_type>(points_.size()), t);
 
   if (bbox_.valid())
   {
-    bbox_.reset();
-
-    // Compute bounding box
-    typename Node::iterator ni, nie;
-    begin(ni);
-    end(nie);
-    while (ni != nie)
-    {
-      bbox_.extend(point(*ni));
-      ++ni;
-    }
+    bbox_ = bbox;
 
     // Compute epsilons associated with the bounding box
     epsilon_ = bbox_.diagonal().length()*1e-8;
@@ -34,6 +34,7 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/VFData.h>
 #include <Core/Datatypes/Legacy/Base/PropertyManager.h>
+#include <algorithm>
 
 
 #include <Core/Datatypes/Legacy/Field/share.h>
@@ -241,15 +242,26 @@ public:
   template<class T>  inline void set_value(const T& val, VMesh::ENode::index_type idx)
   { vfdata_->set_evalue(val,static_cast<VMesh::index_type>(idx)); }
 
-  /// Get/Set all values at once
+  /// Get/Set all values at once. If the field stores values of type T the
+  /// block is copied directly, otherwise each value is converted.
   template<class T> inline void set_values(const std::vector<T>& values)
-  { if (!values.empty()) vfdata_->set_values(&(values[0]),values.size(),0); }
+  { if (!values.empty()) set_values(&(values[0]),values.size(),0); }
   template<class T> inline void set_values(const T* data, size_type sz, index_type offset = 0)
-  { vfdata_->set_values(data,sz,offset); }
+  {
+    T* fdata = get_values_pointer_as<T>();
+    if (!fdata) { vfdata_->set_values(data,sz,offset); return; }
+    sz = std::min(sz,static_cast<size_type>(vfdata_->fdata_size()-offset));
+    if (sz > 0) std::copy(data,data+sz,fdata+offset);
+  }
   template<class T> inline void get_values(std::vector<T>& values) const
-  { values.resize(vfdata_->fdata_size()); if (values.size()) vfdata_->get_values(&(values[0]),values.size(),0); }
+  { values.resize(vfdata_->fdata_size()); if (values.size()) get_values(&(values[0]),values.size(),0); }
   template<class T> inline void get_values(T* data, size_type sz, index_type offset = 0) const
-  { vfdata_->get_values(data,sz,offset); }
+  {
+    const T* fdata = const_cast<VField*>(this)->get_values_pointer_as<T>();
+    if (!fdata) { vfdata_->get_values(data,sz,offset); return; }
+    sz = std::min(sz,static_cast<size_type>(vfdata_->fdata_size()-offset));
+    if (sz > 0) std::copy(fdata+offset,fdata+offset+sz,data);
+  }
 
   // Set/Get values per element array or node array
   template<class T> inline void set_values(const std::vector<T>& values, VMesh::Node::array_type nodes)
@@ -602,6 +614,11 @@ public:
   inline void* get_values_pointer()   { return (vfdata_->fdata_pointer()); }
   inline void* get_evalues_pointer()   { return (vfdata_->efdata_pointer()); }
 
+  /// Typed access to the contiguous value array. Returns null when the field
+  /// does not store values of type T; use get_values/set_values to convert.
+  template<class T> inline T* get_values_pointer_as()
+  { return ((!is_nodata() && is_type(static_cast<T*>(0))) ? static_cast<T*>(vfdata_->fdata_pointer()) : 0); }
+
   inline void* fdata_pointer()   { return (vfdata_->fdata_pointer()); }
   inline void* efdata_pointer()   { return (vfdata_->efdata_pointer()); }
 
@@ -468,6 +468,33 @@ VMesh::get_centers(Point*, const Elem::array_type&) const
   ASSERTFAIL("VMesh interface: get_centers(Point*,Elem::array_type) has not been implemented");
 }
 
+void
+VMesh::get_node_centers(Point* points, Node::index_type begin, Node::size_type count) const
+{
+  for (index_type j = 0; j < count; j++)
+    get_center(points[j], Node::index_type(begin + j));
+}
+
+void
+VMesh::get_elem_centers(Point* points, Elem::index_type begin, Elem::size_type count) const
+{
+  for (index_type j = 0; j < count; j++)
+    get_center(points[j], Elem::index_type(begin + j));
+}
+
+void
+VMesh::get_elem_nodes(index_type* nodes, Elem::index_type begin, Elem::size_type count) const
+{
+  Node::array_type elemNodes;
+  const size_type n = num_nodes_per_elem_;
+  for (index_type j = 0; j < count; j++)
+  {
+    get_nodes(elemNodes, Elem::index_type(begin + j));
+    for (index_type k = 0; k < n; k++)
+      nodes[j*n + k] = elemNodes[k];
+  }
+}
+
 double 
 VMesh::get_size(VMesh::Edge::index_type) const
 {
@@ -435,6 +435,16 @@ public:
     { points.resize(array.size()); get_centers(&(points[0]),array); }
 
 
+  /// Get the centers of a contiguous range [begin, begin+count) without
+  /// building an index array. Unstructured meshes copy straight from their
+  /// storage; the default falls back to get_center for each entry.
+  virtual void get_node_centers(Core::Geometry::Point* points, Node::index_type begin, Node::size_type count) const;
+  virtual void get_elem_centers(Core::Geometry::Point* points, Elem::index_type begin, Elem::size_type count) const;
+
+  /// Get the linear node indices of a contiguous range of elements, packed as
+  /// num_nodes_per_elem() entries per element.
+  virtual void get_elem_nodes(index_type* nodes, Elem::index_type begin, Elem::size_type count) const;
+
   inline void get_all_node_centers(points_type &points) const
     {
       Node::size_type sz = num_nodes();
@@ -64,6 +64,9 @@ public:
 
   virtual void get_centers(Core::Geometry::Point* points, const VMesh::Node::array_type& array) const;
   virtual void get_centers(Core::Geometry::Point* points, const VMesh::Elem::array_type& array) const;
+  virtual void get_node_centers(Core::Geometry::Point* points, VMesh::Node::index_type begin, VMesh::Node::size_type count) const;
+  virtual void get_elem_centers(Core::Geometry::Point* points, VMesh::Elem::index_type begin, VMesh::Elem::size_type count) const;
+  virtual void get_elem_nodes(VMesh::index_type* nodes, VMesh::Elem::index_type begin, VMesh::Elem::size_type count) const;
 
   virtual double get_size(VMesh::Edge::index_type i) const;
   virtual double get_size(VMesh::Face::index_type i) const;
@@ -690,10 +693,40 @@ VUnstructuredMesh<MESH>::get_centers(Core::Geometry::Point* points, const VMesh:
 {
   for (size_t j=0; j <array.size(); j++)
   {
-    this->mesh_->get_center(points[j],typename MESH::Node::index_type(array[j]));
+    this->mesh_->get_center(points[j],typename MESH::Elem::index_type(array[j]));
   }
 } 
 
+template <class MESH>
+void
+VUnstructuredMesh<MESH>::get_node_centers(Core::Geometry::Point* points, VMesh::Node::index_type begin, VMesh::Node::size_type count) const
+{
+  std::copy(this->mesh_->points_.begin() + begin, this->mesh_->points_.begin() + begin + count, points);
+}
+
+template <class MESH>
+void
+VUnstructuredMesh<MESH>::get_elem_centers(Core::Geometry::Point* points, VMesh::Elem::index_type begin, VMesh::Elem::size_type count) const
+{
+  for (VMesh::index_type j=0; j<count; j++)
+  {
+    this->mesh_->get_center(points[j],typename MESH::Elem::index_type(begin+j));
+  }
+}
+
+template <class MESH>
+void
+VUnstructuredMesh<MESH>::get_elem_nodes(VMesh::index_type* nodes, VMesh::Elem::index_type begin, VMesh::Elem::size_type count) const
+{
+  typename MESH::Node::array_type elemNodes;
+  const VMesh::size_type n = this->num_nodes_per_elem_;
+  for (VMesh::index_type j=0; j<count; j++)
+  {
+    this->mesh_->get_nodes_from_elem(elemNodes,typename MESH::Elem::index_type(begin+j));
+    for (VMesh::index_type k=0; k<n; k++) nodes[j*n+k] = elemNodes[k];
+  }
+}
+
 
 
 template <class MESH>
@@ -27,7 +27,7 @@
    */
 
 #include <Core/Datatypes/MatrixTypeConversions.h>
-#include <Core/Datatypes/SparseRowMatrixFromMap.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
 
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun;
@@ -112,12 +112,12 @@ SparseRowMatrixHandle convertMatrix::toSparse(const MatrixHandle& mh)
   auto col = castMatrix::toColumn(mh);
   if (col)
   {
-    SparseRowMatrixFromMap::Values data;
+    SparseRowMatrixTripletBuilder builder(col->nrows(), 1);
     for (auto i = 0; i<col->nrows(); i++)
       if (fabs((*col)(i, 0)) > zero_threshold)
-        data[i][0] = (*col)(i, 0);
+        builder.add(i, 0, (*col)(i, 0));
 
-    return SparseRowMatrixFromMap::make(col->nrows(), 1, data);
+    return builder.build();
   }
 
   auto dense = castMatrix::toDense(mh);
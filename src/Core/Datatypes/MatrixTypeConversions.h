@@ -35,6 +35,7 @@
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/SparseRowMatrixFromMap.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
 #include <boost/type_traits.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <Core/Datatypes/share.h>
@@ -154,14 +155,14 @@ namespace Core {
     template <typename T, template <typename> class MatrixType>
     static SharedPointer<SparseRowMatrixGeneric<T>> fromDenseToSparse(const MatrixType<T>& dense)
     {
-      typename SparseRowMatrixFromMapGeneric<T>::Values data;
+      SparseRowMatrixTripletBuilderGeneric<T> builder(dense.nrows(), dense.ncols());
       NonZero<T> nonZero;
       for (auto i = 0; i < dense.nrows(); i++)
         for (auto j = 0; j < dense.ncols(); j++)
           if (nonZero(dense(i, j)))
-            data[i][j] = dense(i, j);
+            builder.add(i, j, dense(i, j));
 
-      return SparseRowMatrixFromMapGeneric<T>::make(dense.nrows(), dense.ncols(), data);
+      return builder.build();
     }
 
     convertMatrix() = delete;
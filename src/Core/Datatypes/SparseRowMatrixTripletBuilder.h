@@ -0,0 +1,248 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_DATATYPES_SPARSEROWMATRIXTRIPLETBUILDER_H
+#define CORE_DATATYPES_SPARSEROWMATRIXTRIPLETBUILDER_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <boost/make_shared.hpp>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Utils/Exception.h>
+
+namespace SCIRun
+{
+  namespace Core
+  {
+    namespace Datatypes
+    {
+      /// Bulk sparse matrix construction from coordinate (row, column, value) entries.
+      /// Entries go into flat per-buffer arrays, so independent threads can each fill their
+      /// own buffer; build() bucket-sorts them by row in parallel, merges duplicates and
+      /// writes the compressed rows straight into the SparseRowMatrix storage.
+      template <typename T>
+      class SparseRowMatrixTripletBuilderGeneric
+      {
+      public:
+        enum DuplicatePolicy
+        {
+          SUM_DUPLICATES,  // finite-element assembly
+          LAST_WINS        // map assignment semantics: later buffers, then later entries, override
+        };
+
+        SparseRowMatrixTripletBuilderGeneric(size_type rows, size_type cols, size_t buffers = 1, DuplicatePolicy policy = SUM_DUPLICATES) :
+          rows_(rows), cols_(cols), policy_(policy), buffers_(std::max<size_t>(buffers, 1))
+        {
+          if (rows < 0 || cols < 0)
+            THROW_INVALID_ARGUMENT("Sparse matrix dimensions must be non-negative");
+        }
+
+        size_t numBuffers() const { return buffers_.size(); }
+
+        void reserve(size_t entriesPerBuffer)
+        {
+          for (auto& b : buffers_)
+            b.reserve(entriesPerBuffer);
+        }
+
+        void add(index_type row, index_type col, T value, size_t buffer = 0)
+        {
+          if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+            THROW_OUT_OF_RANGE("Sparse matrix entry index out of range");
+          buffers_[buffer].push_back(Entry{ row, col, value });
+        }
+
+        /// Adds (row, col) and (col, row); a diagonal entry is added once.
+        void addSymmetric(index_type row, index_type col, T value, size_t buffer = 0)
+        {
+          add(row, col, value, buffer);
+          if (row != col)
+            add(col, row, value, buffer);
+        }
+
+        /// Adds every stored entry of a matrix, shifted by the given offsets.
+        void addMatrix(const SparseRowMatrixGeneric<T>& matrix, index_type rowOffset = 0, index_type colOffset = 0, size_t buffer = 0)
+        {
+          if (matrix.nrows() + rowOffset > rows_ || matrix.ncols() + colOffset > cols_)
+            THROW_OUT_OF_RANGE("Sparse matrix block does not fit at the given offset");
+          auto& entries = buffers_[buffer];
+          entries.reserve(entries.size() + matrix.nonZeros());
+          for (index_type k = 0; k < matrix.outerSize(); ++k)
+            for (typename SparseRowMatrixGeneric<T>::InnerIterator it(matrix, k); it; ++it)
+              entries.push_back(Entry{ it.row() + rowOffset, it.col() + colOffset, it.value() });
+        }
+
+        size_t pendingEntries() const
+        {
+          size_t total = 0;
+          for (const auto& b : buffers_)
+            total += b.size();
+          return total;
+        }
+
+        SharedPointer<SparseRowMatrixGeneric<T>> build() const
+        {
+          using Thread::Parallel;
+
+          std::vector<size_t> bufferStart(buffers_.size() + 1, 0);
+          for (size_t b = 0; b < buffers_.size(); ++b)
+            bufferStart[b + 1] = bufferStart[b] + buffers_[b].size();
+          const size_t total = bufferStart.back();
+
+          auto mat = boost::make_shared<SparseRowMatrixGeneric<T>>(rows_, cols_);
+          if (total == 0)
+            return mat;
+
+          const int tasks = static_cast<int>(std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), total / minEntriesPerTask)));
+          auto run = [tasks](const std::function<void(int)>& task)
+          {
+            if (tasks == 1)
+              task(0);
+            else
+              Parallel::RunTasks(task, tasks);
+          };
+          // Task t handles global entries [total*t/tasks, total*(t+1)/tasks), across buffer boundaries.
+          auto forEachEntry = [&](int t, const std::function<void(size_t, const Entry&)>& f)
+          {
+            const size_t begin = total * t / tasks, end = total * (t + 1) / tasks;
+            auto b = std::upper_bound(bufferStart.begin(), bufferStart.end(), begin) - bufferStart.begin() - 1;
+            for (size_t i = begin; i < end; ++b)
+            {
+              const auto& entries = buffers_[b];
+              const size_t stop = std::min(end, bufferStart[b + 1]);
+              for (; i < stop; ++i)
+                f(i, entries[i - bufferStart[b]]);
+            }
+          };
+
+          // Bucket the entries by row, tagging each with its global order for LAST_WINS.
+          std::unique_ptr<std::atomic<size_t>[]> cursor(new std::atomic<size_t>[rows_ + 1]);
+          for (index_type r = 0; r <= rows_; ++r)
+            cursor[r].store(0, std::memory_order_relaxed);
+          run([&](int t) { forEachEntry(t, [&](size_t, const Entry& e) { cursor[e.row + 1].fetch_add(1, std::memory_order_relaxed); }); });
+
+          std::vector<size_t> rowStart(rows_ + 1, 0);
+          for (index_type r = 0; r < rows_; ++r)
+          {
+            rowStart[r + 1] = rowStart[r] + cursor[r + 1].load(std::memory_order_relaxed);
+            cursor[r].store(rowStart[r], std::memory_order_relaxed);
+          }
+
+          std::vector<Bucketed> bucketed(total);
+          run([&](int t)
+          {
+            forEachEntry(t, [&](size_t order, const Entry& e)
+            {
+              bucketed[cursor[e.row].fetch_add(1, std::memory_order_relaxed)] = Bucketed{ e.col, order, e.value };
+            });
+          });
+          cursor.reset();
+
+          // Sort each row by (column, order) and merge duplicates in place; row blocks are balanced by entry count.
+          std::vector<index_type> rowBlock(tasks + 1, rows_);
+          rowBlock[0] = 0;
+          for (int t = 1; t < tasks; ++t)
+            rowBlock[t] = std::upper_bound(rowStart.begin(), rowStart.end(), total * t / tasks) - rowStart.begin() - 1;
+          std::vector<size_t> rowCount(rows_, 0);
+          const auto policy = policy_;
+          run([&](int t)
+          {
+            for (index_type r = rowBlock[t]; r < rowBlock[t + 1]; ++r)
+            {
+              auto first = bucketed.begin() + rowStart[r], last = bucketed.begin() + rowStart[r + 1];
+              std::sort(first, last, [](const Bucketed& a, const Bucketed& b) { return a.col < b.col || (a.col == b.col && a.order < b.order); });
+              auto out = first;
+              for (auto in = first; in != last; ++in)
+              {
+                if (out != first && (out - 1)->col == in->col)
+                {
+                  if (policy == SUM_DUPLICATES)
+                    (out - 1)->value += in->value;
+                  else
+                    (out - 1)->value = in->value;
+                }
+                else
+                  *out++ = *in;
+              }
+              rowCount[r] = out - first;
+            }
+          });
+
+          index_type* outer = mat->outerIndexPtr();
+          outer[0] = 0;
+          for (index_type r = 0; r < rows_; ++r)
+            outer[r + 1] = outer[r] + rowCount[r];
+          mat->resizeNonZeros(outer[rows_]);
+          index_type* inner = mat->innerIndexPtr();
+          T* values = mat->valuePtr();
+          run([&](int t)
+          {
+            for (index_type r = rowBlock[t]; r < rowBlock[t + 1]; ++r)
+            {
+              const auto* in = &bucketed[rowStart[r]];
+              for (index_type k = outer[r]; k < outer[r + 1]; ++k, ++in)
+              {
+                inner[k] = in->col;
+                values[k] = in->value;
+              }
+            }
+          });
+          return mat;
+        }
+
+      private:
+        struct Entry
+        {
+          index_type row, col;
+          T value;
+        };
+        struct Bucketed
+        {
+          index_type col;
+          size_t order;
+          T value;
+        };
+        static const size_t minEntriesPerTask = 1 << 16;
+
+        index_type rows_, cols_;
+        DuplicatePolicy policy_;
+        std::vector<std::vector<Entry>> buffers_;
+      };
+
+      using SparseRowMatrixTripletBuilder = SparseRowMatrixTripletBuilderGeneric<double>;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/ColorMap.h>
+#include <Core/Math/MiscMath.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <random>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // Per-value transform as originally written, evaluated without the lookup table.
+  ColorRGB referenceColor(const ColorMap& map, double f)
+  {
+    const double rescaled01 = (f + map.getColorMapRescaleShift()) * map.getColorMapRescaleScale();
+    double v = std::min(std::max(0., rescaled01), 1.);
+    double shift = map.getColorMapShift();
+    if (map.getColorMapInvert())
+    {
+      v = 1. - v;
+      shift *= -1.;
+    }
+    auto resolution = map.getColorMapResolution();
+    v = static_cast<double>(static_cast<int>(v * static_cast<double>(resolution))) / static_cast<double>(resolution - 1);
+    double denom = std::tan(M_PI_2 * (0.5 - std::min(std::max(shift, -0.99), 0.99) * 0.5));
+    if (std::isnan(denom)) denom = 0.f;
+    denom = std::max(denom, 0.001);
+    v = std::pow(v, (1. / denom));
+    return map.getColorStrategy()->getColorMapVal(std::min(std::max(0., v), 1.));
+  }
+
+  std::vector<double> randomScalars(size_t n)
+  {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1.5, 1.5);
+    std::vector<double> values(n);
+    for (auto& v : values)
+      v = dist(gen);
+    // exact boundaries of the default [-1,1] data range
+    values[0] = -1;
+    values[1] = 1;
+    values[2] = 0;
+    return values;
+  }
+}
+
+TEST(ColorMapTests, LookupTableMatchesDirectEvaluation)
+{
+  auto values = randomScalars(2000);
+  for (const auto& name : StandardColorMapFactory::getList())
+  {
+    for (auto resolution : { 2, 17, 256 })
+    {
+      for (auto shift : { -0.5, 0.0, 0.3 })
+      {
+        for (auto invert : { false, true })
+        {
+          auto map = StandardColorMapFactory::create(name, resolution, shift, invert);
+          for (auto v : values)
+            ASSERT_EQ(referenceColor(*map, v), map->valueToColor(v)) << name << " " << resolution << " " << shift << " " << invert << " " << v;
+        }
+      }
+    }
+  }
+}
+
+TEST(ColorMapTests, BatchScalarsMatchSingleValues)
+{
+  auto values = randomScalars(5000);
+  values.push_back(std::numeric_limits<double>::quiet_NaN());
+  auto map = StandardColorMapFactory::create("Blackbody", 64, 0.2, true, 0.25, 3.0);
+  auto colors = map->valuesToColors(values);
+  ASSERT_EQ(values.size(), colors.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(map->valueToColor(values[i]), colors[i]) << i;
+}
+
+TEST(ColorMapTests, BatchVectorsMatchSingleValues)
+{
+  auto scalars = randomScalars(3000);
+  std::vector<Vector> values;
+  for (size_t i = 0; i + 2 < scalars.size(); i += 3)
+    values.emplace_back(scalars[i], scalars[i + 1], scalars[i + 2]);
+  auto map = StandardColorMapFactory::create("Rainbow", 256, 0, false, 0.5, 0);
+  auto colors = map->valuesToColors(values);
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(map->valueToColor(values[i]), colors[i]) << i;
+}
+
+TEST(ColorMapTests, BatchTensorsMatchSingleValues)
+{
+  auto scalars = randomScalars(60000);
+  std::vector<Tensor> values;
+  for (size_t i = 0; i + 5 < scalars.size(); i += 6)
+    values.emplace_back(scalars[i], scalars[i + 1], scalars[i + 2], scalars[i + 3], scalars[i + 4], scalars[i + 5]);
+  auto map = StandardColorMapFactory::create("Darkhue");
+  auto colors = map->valuesToColors(values);
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(map->valueToColor(values[i]), colors[i]) << i;
+}
+
+TEST(ColorMapTests, DISABLED_BatchScalarTiming)
+{
+  const size_t n = 10000000;
+  auto values = randomScalars(n);
+  auto map = StandardColorMapFactory::create("Rainbow");
+  std::vector<ColorRGB> single(n), batch(n);
+  {
+    ScopedTimer t("per-value valueToColor");
+    for (size_t i = 0; i < n; ++i)
+      single[i] = map->valueToColor(values[i]);
+  }
+  {
+    ScopedTimer t("batch valuesToColors");
+    map->valuesToColors(&values[0], n, &batch[0]);
+  }
+  EXPECT_EQ(single, batch);
+}
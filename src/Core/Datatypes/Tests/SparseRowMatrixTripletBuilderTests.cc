@@ -0,0 +1,188 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <Core/Datatypes/SparseRowMatrixFromMap.h>
+#include <Core/Datatypes/SparseRowMatrixTripletBuilder.h>
+#include <Core/Utils/Exception.h>
+#include <boost/timer.hpp>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::TestUtils;
+
+TEST(SparseRowMatrixTripletBuilderTest, SumsDuplicatesAndLeavesEmptyRows)
+{
+  SparseRowMatrixTripletBuilder builder(3, 4);
+
+  builder.add(2, 1, 2);
+  builder.add(0, 3, 1);
+  builder.add(0, 0, 1);
+  builder.add(2, 1, 5);
+
+  auto sparse = builder.build();
+
+  EXPECT_EQ(3, sparse->nrows());
+  EXPECT_EQ(4, sparse->ncols());
+  EXPECT_EQ(3, sparse->nonZeros());
+
+  DenseMatrix expected = MAKE_DENSE_MATRIX(
+    (1,0,0,1)
+    (0,0,0,0)
+    (0,7,0,0));
+
+  EXPECT_MATRIX_EQ(*makeDense(*sparse), expected);
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, LastWinsMatchesMapAssignment)
+{
+  SparseRowMatrixTripletBuilder builder(3, 3, 2, SparseRowMatrixTripletBuilder::LAST_WINS);
+  SparseRowMatrixFromMap::Values data;
+
+  builder.add(1, 1, 4, 0);   data[1][1] = 4;
+  builder.add(0, 2, 3, 0);   data[0][2] = 3;
+  builder.add(1, 1, 0, 0);   data[1][1] = 0;
+  builder.add(0, 2, -1, 1);  data[0][2] = -1;
+
+  auto sparse = builder.build();
+  auto fromMap = SparseRowMatrixFromMap::make(3, 3, data);
+
+  EXPECT_EQ(fromMap->nonZeros(), sparse->nonZeros());
+  EXPECT_MATRIX_EQ(*makeDense(*fromMap), *makeDense(*sparse));
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, SymmetricEntries)
+{
+  SparseRowMatrixTripletBuilder builder(3, 3);
+
+  builder.addSymmetric(0, 0, 1);
+  builder.addSymmetric(2, 1, 2);
+  builder.addSymmetric(0, 2, 3);
+
+  DenseMatrix expected = MAKE_DENSE_MATRIX(
+    (1,0,3)
+    (0,0,2)
+    (3,2,0));
+
+  EXPECT_MATRIX_EQ(*makeDense(*builder.build()), expected);
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, AddMatrixWithOffsets)
+{
+  SparseRowMatrixTripletBuilder blockBuilder(2, 2);
+  blockBuilder.add(0, 1, 5);
+  blockBuilder.add(1, 0, 6);
+  auto block = blockBuilder.build();
+
+  SparseRowMatrixTripletBuilder builder(3, 4);
+  builder.addMatrix(*block);
+  builder.addMatrix(*block, 1, 2);
+
+  DenseMatrix expected = MAKE_DENSE_MATRIX(
+    (0,5,0,0)
+    (6,0,0,5)
+    (0,0,6,0));
+
+  EXPECT_MATRIX_EQ(*makeDense(*builder.build()), expected);
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, ThrowsOnOutOfRangeEntries)
+{
+  SparseRowMatrixTripletBuilder builder(3, 3);
+
+  EXPECT_THROW(builder.add(3, 0, 1), Core::OutOfRangeException);
+  EXPECT_THROW(builder.add(0, -1, 1), Core::OutOfRangeException);
+
+  SparseRowMatrixTripletBuilder block(2, 2);
+  block.add(1, 1, 1);
+  EXPECT_THROW(builder.addMatrix(*block.build(), 2, 0), Core::OutOfRangeException);
+}
+
+namespace
+{
+  // Deterministic stand-in for an assembly loop: a banded matrix where every entry is hit several times.
+  template <class AddFunc>
+  void assembleBanded(int size, int band, int repeats, AddFunc add)
+  {
+    for (int rep = 0; rep < repeats; ++rep)
+      for (int r = 0; r < size; ++r)
+        for (int c = std::max(0, r - band); c <= std::min(size - 1, r + band); ++c)
+          add(r, c, 1.0 + (r * 31 + c * 17 + rep) % 7);
+  }
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, BufferedLargeBuildMatchesEigen)
+{
+  const int size = 20000, band = 3, repeats = 3, buffers = 4;
+  SparseRowMatrixTripletBuilder builder(size, size, buffers);
+  std::vector<Eigen::Triplet<double>> triplets;
+  int next = 0;
+  assembleBanded(size, band, repeats, [&](int r, int c, double v)
+  {
+    builder.add(r, c, v, next++ % buffers);
+    triplets.emplace_back(r, c, v);
+  });
+
+  SparseRowMatrix expected(size, size);
+  expected.setFromTriplets(triplets.begin(), triplets.end());
+  auto sparse = builder.build();
+
+  ASSERT_EQ(expected.nonZeros(), sparse->nonZeros());
+  for (int k = 0; k <= size; ++k)
+    ASSERT_EQ(expected.outerIndexPtr()[k], sparse->outerIndexPtr()[k]);
+  for (int k = 0; k < expected.nonZeros(); ++k)
+  {
+    ASSERT_EQ(expected.innerIndexPtr()[k], sparse->innerIndexPtr()[k]);
+    ASSERT_EQ(expected.valuePtr()[k], sparse->valuePtr()[k]);
+  }
+}
+
+TEST(SparseRowMatrixTripletBuilderTest, DISABLED_TimingVersusMap)
+{
+  const int size = 300000, band = 5, repeats = 2;
+
+  boost::timer t;
+  SparseRowMatrixFromMap::Values data;
+  assembleBanded(size, band, repeats, [&](int r, int c, double v) { data[r][c] += v; });
+  auto fromMap = SparseRowMatrixFromMap::make(size, size, data);
+  std::cout << "map-of-maps: " << t.elapsed() << " s" << std::endl;
+
+  t.restart();
+  SparseRowMatrixTripletBuilder builder(size, size);
+  builder.reserve(size * (2 * band + 1) * repeats);
+  assembleBanded(size, band, repeats, [&](int r, int c, double v) { builder.add(r, c, v); });
+  auto sparse = builder.build();
+  std::cout << "triplet builder: " << t.elapsed() << " s" << std::endl;
+
+  EXPECT_EQ(fromMap->nonZeros(), sparse->nonZeros());
+}
@@ -0,0 +1,300 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Logging/Profiler.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+using namespace SCIRun::Core::Logging;
+
+CORE_SINGLETON_IMPLEMENTATION(Profiler)
+
+namespace SCIRun
+{
+  namespace Core
+  {
+    namespace Logging
+    {
+      class ProfileBuffer
+      {
+      public:
+        explicit ProfileBuffer(size_t capacity) : ring_(capacity) {}
+
+        void push(ProfileEvent&& event)
+        {
+          std::lock_guard<std::mutex> lock(lock_);
+          if (ring_.empty())
+            return;
+          ring_[next_] = std::move(event);
+          next_ = (next_ + 1) % ring_.size();
+          size_ = std::min(size_ + 1, ring_.size());
+        }
+
+        void appendTo(std::vector<ProfileEvent>& out) const
+        {
+          std::lock_guard<std::mutex> lock(lock_);
+          auto first = (next_ + ring_.size() - size_) % std::max<size_t>(ring_.size(), 1);
+          for (size_t i = 0; i < size_; ++i)
+            out.push_back(ring_[(first + i) % ring_.size()]);
+        }
+
+        void reset(size_t capacity)
+        {
+          std::lock_guard<std::mutex> lock(lock_);
+          ring_.assign(capacity, ProfileEvent());
+          next_ = size_ = 0;
+        }
+
+        void clear()
+        {
+          std::lock_guard<std::mutex> lock(lock_);
+          next_ = size_ = 0;
+        }
+
+      private:
+        mutable std::mutex lock_;
+        std::vector<ProfileEvent> ring_;
+        size_t next_{ 0 }, size_{ 0 };
+      };
+
+      // Hands a buffer back to the profiler's free list when its thread exits, so short-lived
+      // worker threads (Parallel::RunTasks creates a fresh group per call) reuse buffers.
+      class ThreadBufferLease
+      {
+      public:
+        ~ThreadBufferLease()
+        {
+          if (owner && buffer)
+            owner->releaseBuffer(buffer);
+        }
+        Profiler* owner{ nullptr };
+        ProfileBuffer* buffer{ nullptr };
+        unsigned int threadIndex{ 0 };
+        bool hasIndex{ false };
+        unsigned int depth{ 0 };
+      };
+    }
+  }
+}
+
+namespace
+{
+  thread_local ThreadBufferLease threadLease;
+
+  void writeJsonString(std::ostream& out, const std::string& str)
+  {
+    out << '"';
+    for (auto c : str)
+    {
+      switch (c)
+      {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+        else
+          out << c;
+      }
+    }
+    out << '"';
+  }
+}
+
+Profiler::Profiler() : capacity_(1 << 14), origin_(Clock::now())
+{
+}
+
+Profiler::~Profiler()
+{
+  std::lock_guard<std::mutex> lock(buffersLock_);
+  for (auto buffer : buffers_)
+    delete buffer;
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+  enabled_.store(enabled);
+}
+
+void Profiler::setBufferCapacity(size_t eventsPerThread)
+{
+  std::lock_guard<std::mutex> lock(buffersLock_);
+  capacity_ = eventsPerThread;
+  for (auto buffer : buffers_)
+    buffer->reset(eventsPerThread);
+}
+
+size_t Profiler::bufferCapacity() const
+{
+  return capacity_;
+}
+
+unsigned int& Profiler::threadDepth()
+{
+  return threadLease.depth;
+}
+
+ProfileBuffer* Profiler::threadBuffer()
+{
+  if (threadLease.buffer && threadLease.owner == this)
+    return threadLease.buffer;
+
+  std::lock_guard<std::mutex> lock(buffersLock_);
+  ProfileBuffer* buffer;
+  if (!freeBuffers_.empty())
+  {
+    buffer = freeBuffers_.back();
+    freeBuffers_.pop_back();
+  }
+  else
+  {
+    buffer = new ProfileBuffer(capacity_);
+    buffers_.push_back(buffer);
+  }
+  threadLease.owner = this;
+  threadLease.buffer = buffer;
+  return buffer;
+}
+
+void Profiler::releaseBuffer(ProfileBuffer* buffer)
+{
+  std::lock_guard<std::mutex> lock(buffersLock_);
+  freeBuffers_.push_back(buffer);
+}
+
+void Profiler::record(const std::string& name, const char* category, Clock::time_point start, Clock::time_point end)
+{
+  if (!threadLease.hasIndex)
+  {
+    threadLease.threadIndex = nextThreadIndex_++;
+    threadLease.hasIndex = true;
+  }
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  threadBuffer()->push({ name, category,
+    duration_cast<microseconds>(start - origin_).count(),
+    duration_cast<microseconds>(end - start).count(),
+    threadLease.threadIndex, threadLease.depth });
+}
+
+std::vector<ProfileEvent> Profiler::events() const
+{
+  std::vector<ProfileEvent> all;
+  {
+    std::lock_guard<std::mutex> lock(buffersLock_);
+    for (auto buffer : buffers_)
+      buffer->appendTo(all);
+  }
+  std::stable_sort(all.begin(), all.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+  {
+    // enclosing scopes first when timestamps tie at microsecond resolution
+    if (a.startMicroseconds != b.startMicroseconds)
+      return a.startMicroseconds < b.startMicroseconds;
+    return a.depth < b.depth;
+  });
+  return all;
+}
+
+std::map<std::string, ProfileSummary> Profiler::summarize() const
+{
+  std::map<std::string, ProfileSummary> summary;
+  for (const auto& event : events())
+  {
+    auto& entry = summary[event.name];
+    auto seconds = event.durationMicroseconds * 1e-6;
+    entry.count++;
+    entry.totalSeconds += seconds;
+    entry.maxSeconds = std::max(entry.maxSeconds, seconds);
+  }
+  return summary;
+}
+
+void Profiler::clear()
+{
+  std::lock_guard<std::mutex> lock(buffersLock_);
+  for (auto buffer : buffers_)
+    buffer->clear();
+}
+
+void Profiler::writeChromeTrace(std::ostream& out) const
+{
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& event : events())
+  {
+    if (!first)
+      out << ",";
+    first = false;
+    out << "\n{\"name\":";
+    writeJsonString(out, event.name);
+    out << ",\"cat\":";
+    writeJsonString(out, event.category ? event.category : "");
+    out << ",\"ph\":\"X\",\"ts\":" << event.startMicroseconds
+      << ",\"dur\":" << event.durationMicroseconds
+      << ",\"pid\":1,\"tid\":" << event.threadIndex
+      << ",\"args\":{\"depth\":" << event.depth << "}}";
+  }
+  out << "\n]}\n";
+}
+
+bool Profiler::writeChromeTrace(const boost::filesystem::path& file) const
+{
+  std::ofstream out(file.string());
+  if (!out)
+    return false;
+  writeChromeTrace(out);
+  return static_cast<bool>(out);
+}
+
+ScopedProfileEvent::ScopedProfileEvent(const std::string& name, const char* category) :
+  active_(Profiler::Instance().enabled()), category_(category)
+{
+  if (active_)
+  {
+    name_ = name;
+    ++Profiler::threadDepth();
+    start_ = Profiler::Clock::now();
+  }
+}
+
+ScopedProfileEvent::~ScopedProfileEvent()
+{
+  if (active_)
+  {
+    auto end = Profiler::Clock::now();
+    auto& depth = Profiler::threadDepth();
+    --depth;
+    Profiler::Instance().record(name_, category_, start_, end);
+  }
+}
@@ -0,0 +1,132 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_LOGGING_PROFILER_H
+#define CORE_LOGGING_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <Core/Utils/Singleton.h>
+#include <Core/Logging/share.h>
+
+namespace SCIRun
+{
+  namespace Core
+  {
+    namespace Logging
+    {
+      /// One completed wall-clock interval. Categories are expected to be string literals.
+      struct SCISHARE ProfileEvent
+      {
+        std::string name;
+        const char* category;
+        long long startMicroseconds;
+        long long durationMicroseconds;
+        unsigned int threadIndex;
+        unsigned int depth;
+      };
+
+      struct SCISHARE ProfileSummary
+      {
+        size_t count{ 0 };
+        double totalSeconds{ 0 };
+        double maxSeconds{ 0 };
+      };
+
+      class ProfileBuffer;
+
+      /// @class Profiler
+      /// @brief Low-overhead wall-clock instrumentation for modules, algorithm phases and parallel tasks.
+      /// @details Each thread records into its own fixed-size ring buffer, so recording only takes
+      /// an uncontended lock. When disabled, a ScopedProfileEvent costs one atomic load.
+      /// Collected events can be exported in the Chrome trace-event format (chrome://tracing, Perfetto).
+      class SCISHARE Profiler final
+      {
+        CORE_SINGLETON(Profiler)
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        Profiler();
+        ~Profiler();
+
+        void setEnabled(bool enabled);
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        /// Capacity of each per-thread ring buffer; once full, the oldest events are overwritten.
+        void setBufferCapacity(size_t eventsPerThread);
+        size_t bufferCapacity() const;
+
+        void record(const std::string& name, const char* category, Clock::time_point start, Clock::time_point end);
+
+        /// Snapshot of all buffered events, ordered by start time.
+        std::vector<ProfileEvent> events() const;
+        std::map<std::string, ProfileSummary> summarize() const;
+        void clear();
+
+        void writeChromeTrace(std::ostream& out) const;
+        bool writeChromeTrace(const boost::filesystem::path& file) const;
+
+        // used by ScopedProfileEvent to track nesting depth
+        static unsigned int& threadDepth();
+      private:
+        ProfileBuffer* threadBuffer();
+        void releaseBuffer(ProfileBuffer* buffer);
+        friend class ThreadBufferLease;
+
+        std::atomic<bool> enabled_{ false };
+        std::atomic<size_t> capacity_;
+        Clock::time_point origin_;
+        mutable std::mutex buffersLock_;
+        std::vector<ProfileBuffer*> buffers_, freeBuffers_;
+        std::atomic<unsigned int> nextThreadIndex_{ 0 };
+      };
+
+      /// Records the lifetime of the enclosing scope when the profiler is enabled.
+      class SCISHARE ScopedProfileEvent : boost::noncopyable
+      {
+      public:
+        ScopedProfileEvent(const std::string& name, const char* category);
+        ~ScopedProfileEvent();
+      private:
+        bool active_;
+        std::string name_;
+        const char* category_;
+        Profiler::Clock::time_point start_;
+      };
+    }
+  }
+}
+
+#endif
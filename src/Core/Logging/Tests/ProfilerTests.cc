@@ -0,0 +1,118 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Logging/Profiler.h>
+#include <boost/thread/thread.hpp>
+#include <sstream>
+
+using namespace SCIRun::Core::Logging;
+
+class ProfilerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Profiler::Instance().clear();
+    Profiler::Instance().setEnabled(true);
+  }
+  void TearDown() override
+  {
+    Profiler::Instance().setEnabled(false);
+    Profiler::Instance().clear();
+  }
+};
+
+TEST_F(ProfilerTests, DisabledProfilerRecordsNothing)
+{
+  Profiler::Instance().setEnabled(false);
+  {
+    ScopedProfileEvent e("ignored", "test");
+  }
+  EXPECT_TRUE(Profiler::Instance().events().empty());
+}
+
+TEST_F(ProfilerTests, RecordsNestedScopesWithDepth)
+{
+  {
+    ScopedProfileEvent outer("outer", "module");
+    {
+      ScopedProfileEvent inner("inner", "algorithm");
+      boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+    }
+  }
+  auto events = Profiler::Instance().events();
+  ASSERT_EQ(2, events.size());
+  EXPECT_EQ("outer", events[0].name);
+  EXPECT_EQ(0, events[0].depth);
+  EXPECT_EQ("inner", events[1].name);
+  EXPECT_EQ(1, events[1].depth);
+  EXPECT_GE(events[0].durationMicroseconds, events[1].durationMicroseconds);
+  EXPECT_GE(events[1].durationMicroseconds, 4000);
+}
+
+TEST_F(ProfilerTests, RingBufferKeepsMostRecentEvents)
+{
+  Profiler::Instance().setBufferCapacity(4);
+  for (int i = 0; i < 10; ++i)
+  {
+    ScopedProfileEvent e("event" + std::to_string(i), "test");
+  }
+  auto events = Profiler::Instance().events();
+  Profiler::Instance().setBufferCapacity(1 << 14);
+  ASSERT_EQ(4, events.size());
+  EXPECT_EQ("event6", events[0].name);
+  EXPECT_EQ("event9", events[3].name);
+}
+
+TEST_F(ProfilerTests, CollectsEventsFromManyThreads)
+{
+  boost::thread_group threads;
+  for (int i = 0; i < 4; ++i)
+    threads.create_thread([i]() { ScopedProfileEvent e("task " + std::to_string(i), "task"); });
+  threads.join_all();
+
+  auto summary = Profiler::Instance().summarize();
+  EXPECT_EQ(4, summary.size());
+  for (const auto& entry : summary)
+    EXPECT_EQ(1, entry.second.count);
+}
+
+TEST_F(ProfilerTests, ExportsChromeTraceJson)
+{
+  {
+    ScopedProfileEvent e("Module \"quoted\"", "module");
+  }
+  std::ostringstream out;
+  Profiler::Instance().writeChromeTrace(out);
+  auto json = out.str();
+  EXPECT_NE(std::string::npos, json.find("\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Module \\\"quoted\\\"\""));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"cat\":\"module\""));
+}
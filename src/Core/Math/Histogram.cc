@@ -30,6 +30,7 @@
 #include <boost/algorithm/minmax_element.hpp>
 #include <Core/Math/Histogram.h>
 #include <Core/Math/MiscMath.h>
+#include <Core/Math/Statistics.h>
 
 using namespace SCIRun::Core::Math;
 
@@ -55,9 +56,6 @@ Histogram::Histogram( const double* data, size_t size )
   this->compute( data, size );
 }
 
-// For char and short data we do a single pass over the data to speed up the computation. The
-// first pass is used to generate the histogram. In the next step we use this data to compute
-// min and max
 bool Histogram::compute( const double* data, size_t size )
 {
   this->min_ = Nan();
@@ -70,53 +68,32 @@ bool Histogram::compute( const double* data, size_t size )
 
   try
   {
-    this->min_ = std::numeric_limits<double>::max();
-    this->max_ = std::numeric_limits<double>::min();
-
-    for ( size_t j = 0 ; j < size ; j++ )
-    {
-      double val = data[ j ];
-      if ( ! IsFinite( val ) ) continue;
-      if ( val < this->min_ ) this->min_ = val;
-      if ( val > this->max_ ) this->max_ = val;
-    }
+    const auto stats = computeStatistics( data, size );
     
-    if ( this->min_ > this->max_ )
+    if ( stats.count() == 0 )
     {
-      // Most likely all the data is NaN
-      this->min_ = Nan();
-      this->max_ = Nan();
-      this->bin_start_ = Nan();
-      this->bin_size_ = Nan();
-      this->histogram_.resize( 0 );
+      // All the data is NaN
       return false;   
     }
+
+    this->min_ = stats.min();
+    this->max_ = stats.max();
       
+    size_t hist_size = 1;
     if ( this->min_ == this->max_ )
     {
       this->bin_size_  = 1.0;
-      this->bin_start_ = this->min_ - ( this->bin_size_ * 0.5 );
-      this->histogram_.resize( 1, 0 );
     }
     else
     {
-      size_t hist_size = 0x100;
-      this->histogram_.resize( hist_size, 0 );
+      hist_size = 0x100;
       this->bin_size_ = ( this->max_ - this->min_ ) / static_cast<double>( hist_size - 1 );
-      this->bin_start_ = this->min_ - ( this->bin_size_ * 0.5 );  
     }
+    this->bin_start_ = this->min_ - ( this->bin_size_ * 0.5 );  
 
-    double inv_bin_size = 1.0 / bin_size_;
-
-    for ( size_t j = 1 ; j < size ; j++ )
-    {
-      double val = data[ j ];
-      if ( IsFinite( val ) )
-      {
-        size_t idx = static_cast<size_t>( ( val - this->min_ ) * inv_bin_size );
-        this->histogram_[ idx ]++;
-      }   
-    }
+    // Bins are centered on min_ + j * bin_size_, so the histogram covers half a bin beyond either end.
+    this->histogram_ = computeHistogram( data, size, this->bin_start_,
+      this->bin_start_ + hist_size * this->bin_size_, hist_size );
     
     auto min_max = boost::minmax_element( this->histogram_.begin(), this->histogram_.end() );
     this->min_bin_ = (*min_max.first);
@@ -0,0 +1,211 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Math/Statistics.h>
+#include <Core/Math/MiscMath.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+using namespace SCIRun::Core::Math;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  double Nan()
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  // Below this many values per thread the reductions run serially.
+  const size_t minValuesPerTask = 1 << 15;
+
+  int taskCount(size_t size)
+  {
+    return static_cast<int>(std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), size / minValuesPerTask)));
+  }
+
+  // Run task(i, begin, end) over numTasks contiguous chunks of [0, size).
+  void forEachChunk(size_t size, int numTasks, const std::function<void(int, size_t, size_t)>& task)
+  {
+    auto chunk = [&](int i) { task(i, size * i / numTasks, size * (i + 1) / numTasks); };
+    if (numTasks == 1)
+      chunk(0);
+    else
+      Parallel::RunTasks(chunk, numTasks);
+  }
+}
+
+RunningStatistics::RunningStatistics() :
+  count_(0), mean_(0), m2_(0),
+  min_(std::numeric_limits<double>::max()), max_(std::numeric_limits<double>::lowest())
+{
+}
+
+void RunningStatistics::add(double value)
+{
+  ++count_;
+  const double delta = value - mean_;
+  mean_ += delta / count_;
+  m2_ += delta * (value - mean_);
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+void RunningStatistics::merge(const RunningStatistics& other)
+{
+  if (other.count_ == 0)
+    return;
+  if (count_ == 0)
+  {
+    *this = other;
+    return;
+  }
+  const double n = static_cast<double>(count_ + other.count_);
+  const double delta = other.mean_ - mean_;
+  mean_ += delta * other.count_ / n;
+  m2_ += other.m2_ + delta * delta * (static_cast<double>(count_) * other.count_ / n);
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+double RunningStatistics::sum() const
+{
+  return mean_ * count_;
+}
+
+double RunningStatistics::mean() const
+{
+  return count_ > 0 ? mean_ : Nan();
+}
+
+double RunningStatistics::variance() const
+{
+  return count_ > 1 ? m2_ / (count_ - 1) : Nan();
+}
+
+double RunningStatistics::populationVariance() const
+{
+  return count_ > 0 ? m2_ / count_ : Nan();
+}
+
+double RunningStatistics::stddev() const
+{
+  return std::sqrt(variance());
+}
+
+double RunningStatistics::min() const
+{
+  return count_ > 0 ? min_ : Nan();
+}
+
+double RunningStatistics::max() const
+{
+  return count_ > 0 ? max_ : Nan();
+}
+
+RunningStatistics SCIRun::Core::Math::computeStatistics(const double* data, size_t size)
+{
+  const int numTasks = taskCount(size);
+  std::vector<RunningStatistics> partial(numTasks);
+  forEachChunk(size, numTasks, [&](int i, size_t begin, size_t end)
+  {
+    for (size_t j = begin; j < end; ++j)
+      if (IsFinite(data[j]))
+        partial[i].add(data[j]);
+  });
+
+  RunningStatistics stats;
+  for (const auto& p : partial)
+    stats.merge(p);
+  return stats;
+}
+
+std::vector<RunningStatistics> SCIRun::Core::Math::computeGroupedStatistics(const double* data, const int* groups, size_t size, size_t numGroups)
+{
+  const int numTasks = taskCount(size);
+  std::vector<std::vector<RunningStatistics>> partial(numTasks, std::vector<RunningStatistics>(numGroups));
+  forEachChunk(size, numTasks, [&](int i, size_t begin, size_t end)
+  {
+    auto& stats = partial[i];
+    for (size_t j = begin; j < end; ++j)
+    {
+      const int group = groups[j];
+      if (group >= 0 && static_cast<size_t>(group) < numGroups && IsFinite(data[j]))
+        stats[group].add(data[j]);
+    }
+  });
+
+  std::vector<RunningStatistics> result(numGroups);
+  for (const auto& p : partial)
+    for (size_t g = 0; g < numGroups; ++g)
+      result[g].merge(p[g]);
+  return result;
+}
+
+double SCIRun::Core::Math::computeQuantile(const double* data, size_t size, double fraction)
+{
+  std::vector<double> values;
+  values.reserve(size);
+  std::copy_if(data, data + size, std::back_inserter(values), [](double v) { return IsFinite(v); });
+  if (values.empty())
+    return Nan();
+
+  fraction = std::min(1.0, std::max(0.0, fraction));
+  auto nth = values.begin() + static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), nth, values.end());
+  return *nth;
+}
+
+std::vector<size_t> SCIRun::Core::Math::computeHistogram(const double* data, size_t size, double min, double max, size_t numBins)
+{
+  std::vector<size_t> bins(numBins, 0);
+  if (numBins == 0 || !(max > min))
+    return bins;
+
+  const double scale = numBins / (max - min);
+  const int numTasks = taskCount(size);
+  std::vector<std::vector<size_t>> partial(numTasks, std::vector<size_t>(numBins, 0));
+  forEachChunk(size, numTasks, [&](int i, size_t begin, size_t end)
+  {
+    auto& counts = partial[i];
+    for (size_t j = begin; j < end; ++j)
+    {
+      const double v = data[j];
+      if (v >= min && v <= max)
+        counts[std::min(numBins - 1, static_cast<size_t>((v - min) * scale))]++;
+    }
+  });
+
+  for (const auto& p : partial)
+    for (size_t b = 0; b < numBins; ++b)
+      bins[b] += p[b];
+  return bins;
+}
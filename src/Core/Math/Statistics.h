@@ -0,0 +1,89 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_MATH_STATISTICS_H
+#define CORE_MATH_STATISTICS_H
+
+#include <vector>
+#include <cstddef>
+#include <Core/Math/share.h>
+
+namespace SCIRun
+{
+  namespace Core
+  {
+    namespace Math
+    {
+      /// Single-pass count, mean, variance, min and max (Welford's update). Partial results from
+      /// separate chunks of data are combined with merge(), which is how the parallel
+      /// reductions below work.
+      class SCISHARE RunningStatistics
+      {
+      public:
+        RunningStatistics();
+
+        void add(double value);
+        void merge(const RunningStatistics& other);
+
+        size_t count() const { return count_; }
+        double sum() const;
+        double mean() const;
+        /// Sample variance (n-1 denominator); NaN for fewer than two values.
+        double variance() const;
+        double populationVariance() const;
+        double stddev() const;
+        double min() const;
+        double max() const;
+
+      private:
+        size_t count_;
+        double mean_;
+        double m2_;
+        double min_;
+        double max_;
+      };
+
+      /// Statistics of all finite values in data, computed in parallel for large inputs.
+      SCISHARE RunningStatistics computeStatistics(const double* data, size_t size);
+
+      /// Statistics per group: groups[i] is the group index of data[i] in [0, numGroups);
+      /// entries with a negative group are skipped.
+      SCISHARE std::vector<RunningStatistics> computeGroupedStatistics(const double* data, const int* groups, size_t size, size_t numGroups);
+
+      /// Exact quantile of the finite values (fraction in [0,1], 0.5 is the median) by selection
+      /// on a copy of the data, instead of a full sort. NaN if there are no finite values.
+      SCISHARE double computeQuantile(const double* data, size_t size, double fraction);
+
+      /// Counts of finite values in numBins equal-width bins covering [min, max]; values outside
+      /// the range are not counted.
+      SCISHARE std::vector<size_t> computeHistogram(const double* data, size_t size, double min, double max, size_t numBins);
+    }
+  }
+}
+
+#endif
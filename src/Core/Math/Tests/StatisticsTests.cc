@@ -0,0 +1,163 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Math/Statistics.h>
+#include <Core/Math/Histogram.h>
+#include <Core/Math/MiscMath.h>
+#include <cmath>
+#include <numeric>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Math;
+
+namespace
+{
+  std::vector<double> sampleData(size_t size)
+  {
+    std::vector<double> data(size);
+    for (size_t i = 0; i < size; ++i)
+      data[i] = 1000.0 + std::sin(0.37 * i) * 50.0 + (i % 13);
+    return data;
+  }
+}
+
+TEST(StatisticsTests, MomentsMatchTwoPassComputation)
+{
+  auto data = sampleData(300000);
+
+  const double mean = std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+  double ss = 0;
+  for (auto v : data)
+    ss += (v - mean) * (v - mean);
+
+  auto stats = computeStatistics(&data[0], data.size());
+  EXPECT_EQ(data.size(), stats.count());
+  EXPECT_NEAR(mean, stats.mean(), 1e-9);
+  EXPECT_NEAR(ss / (data.size() - 1), stats.variance(), 1e-6);
+  EXPECT_EQ(*std::min_element(data.begin(), data.end()), stats.min());
+  EXPECT_EQ(*std::max_element(data.begin(), data.end()), stats.max());
+}
+
+TEST(StatisticsTests, MergeEqualsSequentialAdd)
+{
+  auto data = sampleData(1001);
+  RunningStatistics all, first, second;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    all.add(data[i]);
+    (i < 400 ? first : second).add(data[i]);
+  }
+  first.merge(second);
+
+  EXPECT_EQ(all.count(), first.count());
+  EXPECT_NEAR(all.mean(), first.mean(), 1e-10);
+  EXPECT_NEAR(all.variance(), first.variance(), 1e-8);
+  EXPECT_EQ(all.min(), first.min());
+  EXPECT_EQ(all.max(), first.max());
+}
+
+TEST(StatisticsTests, SkipsNonFiniteValues)
+{
+  std::vector<double> data = { 1, std::numeric_limits<double>::quiet_NaN(), 3, std::numeric_limits<double>::infinity() };
+  auto stats = computeStatistics(&data[0], data.size());
+  EXPECT_EQ(2u, stats.count());
+  EXPECT_EQ(2, stats.mean());
+  EXPECT_EQ(3, computeQuantile(&data[0], data.size(), 0.5));
+}
+
+TEST(StatisticsTests, EmptyAndSingleValue)
+{
+  RunningStatistics stats;
+  EXPECT_TRUE(IsNan(stats.mean()));
+  EXPECT_TRUE(IsNan(stats.min()));
+  stats.add(4);
+  EXPECT_EQ(4, stats.mean());
+  EXPECT_TRUE(IsNan(stats.variance()));
+  EXPECT_EQ(0, stats.populationVariance());
+}
+
+TEST(StatisticsTests, QuantileSelectsOrderStatistic)
+{
+  std::vector<double> data = { 5, 1, 4, 2, 3 };
+  EXPECT_EQ(3, computeQuantile(&data[0], data.size(), 0.5));
+  EXPECT_EQ(1, computeQuantile(&data[0], data.size(), 0));
+  EXPECT_EQ(5, computeQuantile(&data[0], data.size(), 1));
+  // input is left untouched
+  EXPECT_EQ(5, data[0]);
+}
+
+TEST(StatisticsTests, GroupedStatistics)
+{
+  const size_t size = 200000;
+  auto data = sampleData(size);
+  std::vector<int> groups(size);
+  for (size_t i = 0; i < size; ++i)
+    groups[i] = static_cast<int>(i % 4) - 1;
+
+  auto stats = computeGroupedStatistics(&data[0], &groups[0], size, 3);
+  ASSERT_EQ(3u, stats.size());
+  for (int g = 0; g < 3; ++g)
+  {
+    RunningStatistics expected;
+    for (size_t i = 0; i < size; ++i)
+      if (groups[i] == g)
+        expected.add(data[i]);
+    EXPECT_EQ(expected.count(), stats[g].count());
+    EXPECT_NEAR(expected.mean(), stats[g].mean(), 1e-9);
+    EXPECT_NEAR(expected.variance(), stats[g].variance(), 1e-6);
+    EXPECT_EQ(expected.min(), stats[g].min());
+    EXPECT_EQ(expected.max(), stats[g].max());
+  }
+}
+
+TEST(StatisticsTests, HistogramCountsEveryValueInRange)
+{
+  auto data = sampleData(100000);
+  auto bins = computeHistogram(&data[0], data.size(), 950, 1050, 100);
+  ASSERT_EQ(100u, bins.size());
+  size_t inRange = std::count_if(data.begin(), data.end(), [](double v) { return v >= 950 && v <= 1050; });
+  EXPECT_EQ(inRange, std::accumulate(bins.begin(), bins.end(), size_t(0)));
+
+  std::vector<double> edges = { 0, 0.5, 1, 2 };
+  auto small = computeHistogram(&edges[0], edges.size(), 0, 1, 2);
+  EXPECT_EQ(1u, small[0]);
+  EXPECT_EQ(2u, small[1]);
+}
+
+TEST(StatisticsTests, HistogramClassBinsAllValues)
+{
+  std::vector<double> data = { -2, 0, 1, 1, 6 };
+  Histogram h(&data[0], data.size());
+  ASSERT_TRUE(h.is_valid());
+  EXPECT_EQ(-2, h.get_min());
+  EXPECT_EQ(6, h.get_max());
+  EXPECT_EQ(data.size(), std::accumulate(h.get_bins().begin(), h.get_bins().end(), size_t(0)));
+  EXPECT_EQ(1u, h.get_bins().front());
+  EXPECT_EQ(1u, h.get_bins().back());
+}
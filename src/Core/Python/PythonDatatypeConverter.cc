@@ -41,6 +41,10 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Matlab/matlabarray.h>
 #include <Core/Matlab/matlabconverter.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <cstring>
+#include <type_traits>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Python;
@@ -88,6 +92,258 @@ namespace
     list.append(values);
     return list;
   }
+
+  template <typename T> struct BufferFormat;
+  template <> struct BufferFormat<char> { static const char code = 'b'; };
+  template <> struct BufferFormat<unsigned char> { static const char code = 'B'; };
+  template <> struct BufferFormat<short> { static const char code = 'h'; };
+  template <> struct BufferFormat<unsigned short> { static const char code = 'H'; };
+  template <> struct BufferFormat<int> { static const char code = 'i'; };
+  template <> struct BufferFormat<unsigned int> { static const char code = 'I'; };
+  template <> struct BufferFormat<long> { static const char code = 'l'; };
+  template <> struct BufferFormat<unsigned long> { static const char code = 'L'; };
+  template <> struct BufferFormat<long long> { static const char code = 'q'; };
+  template <> struct BufferFormat<unsigned long long> { static const char code = 'Q'; };
+  template <> struct BufferFormat<float> { static const char code = 'f'; };
+  template <> struct BufferFormat<double> { static const char code = 'd'; };
+
+  /// Python object exporting a read-only, C-contiguous view of memory owned by a SCIRun datatype.
+  /// The owner handle is held until the last consumer (memoryview, numpy array) releases the buffer.
+  struct DatatypeBufferObject
+  {
+    PyObject_HEAD
+    boost::shared_ptr<const void>* owner;
+    const void* data;
+    Py_ssize_t itemsize;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    char format[2];
+  };
+
+  void datatypeBufferDealloc(PyObject* self)
+  {
+    delete reinterpret_cast<DatatypeBufferObject*>(self)->owner;
+    PyObject_Del(self);
+  }
+
+  int datatypeBufferGet(PyObject* self, Py_buffer* view, int flags)
+  {
+    auto buffer = reinterpret_cast<DatatypeBufferObject*>(self);
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE)
+    {
+      view->obj = nullptr;
+      PyErr_SetString(PyExc_BufferError, "SCIRun datatype buffers are read-only; copy the array before modifying it.");
+      return -1;
+    }
+
+    Py_ssize_t count = 1;
+    for (int i = 0; i < buffer->ndim; ++i)
+      count *= buffer->shape[i];
+
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = const_cast<void*>(buffer->data);
+    view->len = count * buffer->itemsize;
+    view->readonly = 1;
+    view->itemsize = buffer->itemsize;
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? buffer->format : nullptr;
+    view->ndim = buffer->ndim;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? buffer->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? buffer->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+  }
+
+  PyTypeObject* datatypeBufferType()
+  {
+    static PyBufferProcs bufferProcs = { datatypeBufferGet, nullptr };
+    static PyTypeObject type = { PyVarObject_HEAD_INIT(nullptr, 0) };
+    if (!type.tp_name)
+    {
+      type.tp_name = "SCIRun.DatatypeBuffer";
+      type.tp_basicsize = sizeof(DatatypeBufferObject);
+      type.tp_dealloc = datatypeBufferDealloc;
+      type.tp_as_buffer = &bufferProcs;
+      type.tp_flags = Py_TPFLAGS_DEFAULT;
+      type.tp_doc = "Read-only view of SCIRun datatype memory";
+      if (PyType_Ready(&type) < 0)
+        boost::python::throw_error_already_set();
+    }
+    return &type;
+  }
+
+  /// Wraps rows x cols (cols == 0 for 1-D) elements at data in a memoryview without copying.
+  template <typename T>
+  boost::python::object toPythonArray(const boost::shared_ptr<const void>& owner, const T* data, Py_ssize_t rows, Py_ssize_t cols = 0)
+  {
+    auto buffer = PyObject_New(DatatypeBufferObject, datatypeBufferType());
+    if (!buffer)
+      boost::python::throw_error_already_set();
+    buffer->owner = new boost::shared_ptr<const void>(owner);
+    buffer->data = data;
+    buffer->itemsize = sizeof(T);
+    buffer->ndim = cols > 0 ? 2 : 1;
+    buffer->shape[0] = rows;
+    buffer->shape[1] = cols;
+    buffer->strides[0] = cols > 0 ? cols * sizeof(T) : sizeof(T);
+    buffer->strides[1] = sizeof(T);
+    buffer->format[0] = BufferFormat<T>::code;
+    buffer->format[1] = '\0';
+
+    boost::python::handle<> exporter(reinterpret_cast<PyObject*>(buffer));
+    return boost::python::object(boost::python::handle<>(PyMemoryView_FromObject(exporter.get())));
+  }
+
+  /// RAII access to the buffer of an arbitrary Python object (numpy array, memoryview, array.array).
+  class PythonBufferView
+  {
+  public:
+    explicit PythonBufferView(const boost::python::object& object) : valid_(false)
+    {
+      auto ptr = object.ptr();
+      if (!ptr || PyBytes_Check(ptr) || PyByteArray_Check(ptr) || PyUnicode_Check(ptr) || !PyObject_CheckBuffer(ptr))
+        return;
+      if (0 != PyObject_GetBuffer(ptr, &view_, PyBUF_RECORDS_RO))
+      {
+        PyErr_Clear();
+        return;
+      }
+      valid_ = (1 == view_.ndim || 2 == view_.ndim) && 0 != formatCode();
+    }
+    ~PythonBufferView()
+    {
+      if (view_.obj)
+        PyBuffer_Release(&view_);
+    }
+    PythonBufferView(const PythonBufferView&) = delete;
+    PythonBufferView& operator=(const PythonBufferView&) = delete;
+
+    bool valid() const { return valid_; }
+    Py_ssize_t rows() const { return view_.shape[0]; }
+    Py_ssize_t cols() const { return 2 == view_.ndim ? view_.shape[1] : 1; }
+    Py_ssize_t size() const { return rows() * cols(); }
+
+    /// Native-order single element format character, or 0 if unsupported.
+    char formatCode() const
+    {
+      const char* f = view_.format ? view_.format : "B";
+      const bool nativeOrder = '@' == *f || '=' == *f
+        || ('<' == *f && isLittleEndian()) || (('>' == *f || '!' == *f) && !isLittleEndian());
+      if (nativeOrder)
+        ++f;
+      if (f[0] == '\0' || f[1] != '\0')
+        return 0;
+      switch (f[0])
+      {
+      case 'b': case 'B': case 'h': case 'H': case 'i': case 'I':
+      case 'l': case 'L': case 'q': case 'Q': case 'f': case 'd':
+        return f[0];
+      default:
+        return 0;
+      }
+    }
+
+    /// Converts all elements in row-major order into out, which must hold size() elements.
+    template <typename Out>
+    void copyTo(Out* out) const
+    {
+      switch (formatCode())
+      {
+      case 'b': copyAs<signed char>(out); break;
+      case 'B': copyAs<unsigned char>(out); break;
+      case 'h': copyAs<short>(out); break;
+      case 'H': copyAs<unsigned short>(out); break;
+      case 'i': copyAs<int>(out); break;
+      case 'I': copyAs<unsigned int>(out); break;
+      case 'l': copyAs<long>(out); break;
+      case 'L': copyAs<unsigned long>(out); break;
+      case 'q': copyAs<long long>(out); break;
+      case 'Q': copyAs<unsigned long long>(out); break;
+      case 'f': copyAs<float>(out); break;
+      case 'd': copyAs<double>(out); break;
+      default: throw std::invalid_argument("Unsupported Python buffer element format.");
+      }
+    }
+
+  private:
+    static bool isLittleEndian()
+    {
+      const unsigned short probe = 1;
+      return 1 == *reinterpret_cast<const unsigned char*>(&probe);
+    }
+
+    template <typename In, typename Out>
+    void copyAs(Out* out) const
+    {
+      const auto rowStride = view_.strides[0];
+      const auto colStride = 2 == view_.ndim ? view_.strides[1] : 0;
+      const auto nrows = rows(), ncols = cols();
+      const char* base = static_cast<const char*>(view_.buf);
+
+      if (std::is_same<In, Out>::value && PyBuffer_IsContiguous(&view_, 'C'))
+      {
+        std::memcpy(out, base, size() * sizeof(Out));
+        return;
+      }
+      for (Py_ssize_t i = 0; i < nrows; ++i)
+      {
+        const char* row = base + i * rowStride;
+        for (Py_ssize_t j = 0; j < ncols; ++j)
+        {
+          In value;
+          std::memcpy(&value, row + j * colStride, sizeof(In));
+          *out++ = static_cast<Out>(value);
+        }
+      }
+    }
+
+    Py_buffer view_ = {};
+    bool valid_;
+  };
+
+  template <typename T>
+  std::vector<T> toVectorFromPython(const boost::python::object& object)
+  {
+    PythonBufferView buffer(object);
+    if (buffer.valid())
+    {
+      std::vector<T> values(buffer.size());
+      buffer.copyTo(values.data());
+      return values;
+    }
+    return to_std_vector<T>(object);
+  }
+
+  template <typename T>
+  boost::python::object toPythonArray(const boost::shared_ptr<const void>& owner, VField* vfield)
+  {
+    auto data = static_cast<const T*>(vfield->fdata_pointer());
+    return toPythonArray(owner, data, vfield->num_values());
+  }
+
+  boost::python::object fieldValuesToPythonArray(const boost::shared_ptr<const void>& owner, VField* vfield)
+  {
+    if (vfield->is_vector())
+      return toPythonArray(owner, reinterpret_cast<const double*>(vfield->fdata_pointer()), vfield->num_values(), 3);
+    if (!vfield->is_scalar())
+      return {};
+
+    if (vfield->is_double()) return toPythonArray<double>(owner, vfield);
+    if (vfield->is_float()) return toPythonArray<float>(owner, vfield);
+    if (vfield->is_int()) return toPythonArray<int>(owner, vfield);
+    if (vfield->is_unsigned_int()) return toPythonArray<unsigned int>(owner, vfield);
+    if (vfield->is_char()) return toPythonArray<char>(owner, vfield);
+    if (vfield->is_unsigned_char()) return toPythonArray<unsigned char>(owner, vfield);
+    if (vfield->is_short()) return toPythonArray<short>(owner, vfield);
+    if (vfield->is_unsigned_short()) return toPythonArray<unsigned short>(owner, vfield);
+    if (vfield->is_long()) return toPythonArray<long>(owner, vfield);
+    if (vfield->is_unsigned_long()) return toPythonArray<unsigned long>(owner, vfield);
+    if (vfield->is_longlong()) return toPythonArray<long long>(owner, vfield);
+    if (vfield->is_unsigned_longlong()) return toPythonArray<unsigned long long>(owner, vfield);
+    return {};
+  }
 }
 
 boost::python::dict SCIRun::Core::Python::convertFieldToPython(FieldHandle field)
@@ -155,6 +411,66 @@ boost::python::object SCIRun::Core::Python::convertMatrixToPython(SparseRowMatri
   return {};
 }
 
+boost::python::object SCIRun::Core::Python::convertMatrixToPythonArray(DenseMatrixHandle matrix)
+{
+  if (!matrix)
+    return {};
+  return toPythonArray(matrix, matrix->data(), matrix->nrows(), matrix->ncols());
+}
+
+boost::python::dict SCIRun::Core::Python::convertMatrixToPythonArrays(SparseRowMatrixHandle matrix)
+{
+  boost::python::dict arrays;
+  if (!matrix)
+    return arrays;
+
+  SparseRowMatrixHandle compressed = matrix;
+  if (!matrix->isCompressed())
+  {
+    compressed = boost::make_shared<SparseRowMatrix>(*matrix);
+    compressed->makeCompressed();
+  }
+
+  arrays["shape"] = boost::python::make_tuple(compressed->nrows(), compressed->ncols());
+  arrays["indptr"] = toPythonArray(compressed, compressed->outerIndexPtr(), compressed->outerSize() + 1);
+  arrays["indices"] = toPythonArray(compressed, compressed->innerIndexPtr(), compressed->nonZeros());
+  arrays["data"] = toPythonArray(compressed, compressed->valuePtr(), compressed->nonZeros());
+  return arrays;
+}
+
+boost::python::dict SCIRun::Core::Python::convertFieldToPythonArrays(FieldHandle field)
+{
+  static_assert(sizeof(Geometry::Point) == 3 * sizeof(double), "Point layout must be three packed doubles");
+  static_assert(sizeof(Geometry::Vector) == 3 * sizeof(double), "Vector layout must be three packed doubles");
+
+  boost::python::dict arrays;
+  if (!field)
+    return arrays;
+
+  auto vmesh = field->vmesh();
+  auto vfield = field->vfield();
+
+  if (vmesh->is_irregularmesh())
+  {
+    auto points = vmesh->get_points_pointer();
+    if (points)
+      arrays["node"] = toPythonArray(field, reinterpret_cast<const double*>(points), vmesh->num_nodes(), 3);
+  }
+  if (vmesh->is_unstructuredmesh() && !vmesh->is_pointcloudmesh())
+  {
+    auto elems = vmesh->get_elems_pointer();
+    if (elems)
+      arrays["elem"] = toPythonArray(field, elems, vmesh->num_elems(), vmesh->num_nodes_per_elem());
+  }
+  if (vfield->num_values() > 0)
+  {
+    auto values = fieldValuesToPythonArray(field, vfield);
+    if (!values.is_none())
+      arrays["data"] = values;
+  }
+  return arrays;
+}
+
 boost::python::object SCIRun::Core::Python::convertStringToPython(StringHandle str)
 {
   if (str)
@@ -167,6 +483,9 @@ boost::python::object SCIRun::Core::Python::convertStringToPython(StringHandle s
 
 bool DenseMatrixExtractor::check() const
 {
+  if (PythonBufferView(object_).valid())
+    return true;
+
   boost::python::extract<boost::python::list> e(object_);
   if (!e.check())
     return false;
@@ -184,6 +503,16 @@ bool DenseMatrixExtractor::check() const
 DatatypeHandle DenseMatrixExtractor::operator()() const
 {
   DenseMatrixHandle dense;
+  {
+    PythonBufferView buffer(object_);
+    if (buffer.valid())
+    {
+      dense.reset(new DenseMatrix(buffer.rows(), buffer.cols()));
+      buffer.copyTo(dense->data());
+      return dense;
+    }
+  }
+
   boost::python::extract<boost::python::list> e(object_);
   if (e.check())
   {
@@ -227,12 +556,56 @@ DatatypeHandle DenseMatrixExtractor::operator()() const
 
 bool SparseRowMatrixExtractor::check() const
 {
-  return false;
+  boost::python::extract<boost::python::dict> e(object_);
+  if (!e.check())
+    return false;
+
+  auto dict = e();
+  for (const auto& key : { "shape", "indptr", "indices", "data" })
+  {
+    if (!dict.has_key(key))
+      return false;
+  }
+  return true;
 }
 
 DatatypeHandle SparseRowMatrixExtractor::operator()() const
 {
-  return nullptr;
+  boost::python::dict dict = boost::python::extract<boost::python::dict>(object_);
+  const int rows = boost::python::extract<int>(dict["shape"][0]);
+  const int cols = boost::python::extract<int>(dict["shape"][1]);
+  auto indptr = toVectorFromPython<index_type>(dict["indptr"]);
+  auto indices = toVectorFromPython<index_type>(dict["indices"]);
+  auto data = toVectorFromPython<double>(dict["data"]);
+
+  if (indptr.size() != static_cast<size_t>(rows) + 1 || indices.size() != data.size()
+    || indptr.front() != 0 || indptr.back() != static_cast<index_type>(data.size()))
+    throw std::invalid_argument("Attempted to convert into sparse matrix but CSR arrays are inconsistent.");
+
+  bool sortedRows = true;
+  for (int i = 0; i < rows; ++i)
+  {
+    if (indptr[i] > indptr[i + 1])
+      throw std::invalid_argument("Attempted to convert into sparse matrix but row pointer array is not monotonic.");
+    for (auto j = indptr[i]; j < indptr[i + 1]; ++j)
+    {
+      if (indices[j] < 0 || indices[j] >= cols)
+        throw std::invalid_argument("Attempted to convert into sparse matrix but a column index is out of bounds.");
+      if (j > indptr[i] && indices[j] <= indices[j - 1])
+        sortedRows = false;
+    }
+  }
+
+  // Unsorted or duplicate column entries need Eigen's triplet path to be summed and ordered.
+  if (!sortedRows)
+    return boost::make_shared<SparseRowMatrix>(rows, cols, indptr.data(), indices.data(), data.data(), data.size());
+
+  auto sparse = boost::make_shared<SparseRowMatrix>(rows, cols);
+  sparse->resizeNonZeros(data.size());
+  std::copy(indptr.begin(), indptr.end(), sparse->outerIndexPtr());
+  std::copy(indices.begin(), indices.end(), sparse->innerIndexPtr());
+  std::copy(data.begin(), data.end(), sparse->valuePtr());
+  return sparse;
 }
 
 bool FieldExtractor::check() const
@@ -388,13 +761,13 @@ Variable SCIRun::Core::Python::convertPythonObjectToVariable(const boost::python
       return makeDatatypeVariable(e);
     }
   }
-  //{
-  //  detail::SparseRowMatrixExtractor e(object);
-  //  if (e.check())
-  //  {
-  //    return makeDatatypeVariable(e);
-  //  }
-  //}
+  {
+    SparseRowMatrixExtractor e(object);
+    if (e.check())
+    {
+      return makeDatatypeVariable(e);
+    }
+  }
   //{
   //  detail::DenseColumnMatrixExtractor e(object);
   //  if (e.check())
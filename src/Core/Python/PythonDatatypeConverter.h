@@ -92,6 +92,15 @@ namespace SCIRun
       SCISHARE boost::python::object convertMatrixToPython(Datatypes::SparseRowMatrixHandle matrix);
       SCISHARE boost::python::object convertStringToPython(Datatypes::StringHandle str);
 
+      /// Zero-copy conversions: the returned objects implement the Python buffer protocol, so
+      /// numpy.asarray() or memoryview() wrap the SCIRun storage directly. The buffers are read-only
+      /// and keep the underlying datatype alive for as long as Python holds a reference.
+      SCISHARE boost::python::object convertMatrixToPythonArray(Datatypes::DenseMatrixHandle matrix);
+      /// Returns a dict with "shape", "indptr", "indices" and "data" entries (CSR layout, as scipy.sparse.csr_matrix expects).
+      SCISHARE boost::python::dict convertMatrixToPythonArrays(Datatypes::SparseRowMatrixHandle matrix);
+      /// Returns a dict with "node" (n x 3), "elem" (m x nodes-per-elem) and "data" arrays, where the field stores them contiguously.
+      SCISHARE boost::python::dict convertFieldToPythonArrays(FieldHandle field);
+
       SCISHARE Algorithms::Variable convertPythonObjectToVariable(const boost::python::object& object);
       SCISHARE boost::python::object convertVariableToPythonObject(const Algorithms::Variable& object);
 
@@ -107,6 +116,7 @@ namespace SCIRun
         const boost::python::object& object_;
       };
 
+      /// Accepts a list of lists, or any object exporting a 1-D/2-D numeric buffer (numpy arrays, memoryviews).
       class SCISHARE DenseMatrixExtractor : public DatatypePythonExtractor
       {
       public:
@@ -116,6 +126,7 @@ namespace SCIRun
         virtual std::string label() const override { return "dense matrix"; }
       };
 
+      /// Accepts a dict of CSR arrays, as produced by convertMatrixToPythonArrays.
       class SCISHARE SparseRowMatrixExtractor : public DatatypePythonExtractor
       {
       public:
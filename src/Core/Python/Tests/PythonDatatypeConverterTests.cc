@@ -0,0 +1,201 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+   */
+
+#include <Python.h>
+#include <boost/python.hpp>
+
+#include <gtest/gtest.h>
+#include <Core/Python/PythonDatatypeConverter.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Python;
+using namespace SCIRun::TestUtils;
+
+class PythonArrayConversionTests : public testing::Test
+{
+protected:
+  virtual void SetUp() override
+  {
+    Py_Initialize();
+  }
+
+  static const void* bufferAddress(const boost::python::object& array)
+  {
+    Py_buffer view;
+    if (0 != PyObject_GetBuffer(array.ptr(), &view, PyBUF_RECORDS_RO))
+    {
+      PyErr_Clear();
+      return nullptr;
+    }
+    auto address = view.buf;
+    PyBuffer_Release(&view);
+    return address;
+  }
+
+  static DenseMatrixHandle matrixOfSize(int rows, int cols)
+  {
+    auto m = boost::make_shared<DenseMatrix>(rows, cols);
+    for (int i = 0; i < rows; ++i)
+      for (int j = 0; j < cols; ++j)
+        (*m)(i, j) = i * cols + j + 0.5;
+    return m;
+  }
+};
+
+TEST_F(PythonArrayConversionTests, DenseMatrixArraySharesMemory)
+{
+  auto m = matrixOfSize(3, 2);
+  auto array = convertMatrixToPythonArray(m);
+
+  EXPECT_EQ(m->data(), bufferAddress(array));
+  EXPECT_TRUE(boost::python::extract<bool>(array.attr("readonly"))());
+  EXPECT_EQ(3, boost::python::extract<int>(array.attr("shape")[0])());
+  EXPECT_EQ(2, boost::python::extract<int>(array.attr("shape")[1])());
+  EXPECT_EQ("d", std::string(boost::python::extract<std::string>(array.attr("format"))));
+}
+
+TEST_F(PythonArrayConversionTests, ArrayKeepsMatrixAlive)
+{
+  auto m = matrixOfSize(4, 4);
+  auto expected = *m;
+  auto array = convertMatrixToPythonArray(m);
+  m.reset();
+
+  DenseMatrixExtractor e(array);
+  ASSERT_TRUE(e.check());
+  auto actual = boost::dynamic_pointer_cast<DenseMatrix>(e());
+  ASSERT_TRUE(actual != nullptr);
+  EXPECT_MATRIX_EQ(expected, *actual);
+}
+
+TEST_F(PythonArrayConversionTests, DenseMatrixExtractorConvertsOtherBufferTypes)
+{
+  auto ints = boost::python::import("array").attr("array")("i", toPythonList(std::vector<int>{ 3, 1, 4 }));
+  DenseMatrixExtractor e(ints);
+  ASSERT_TRUE(e.check());
+  auto actual = boost::dynamic_pointer_cast<DenseMatrix>(e());
+  ASSERT_TRUE(actual != nullptr);
+  ASSERT_EQ(3, actual->nrows());
+  ASSERT_EQ(1, actual->ncols());
+  EXPECT_EQ(3.0, (*actual)(0, 0));
+  EXPECT_EQ(1.0, (*actual)(1, 0));
+  EXPECT_EQ(4.0, (*actual)(2, 0));
+}
+
+TEST_F(PythonArrayConversionTests, DenseMatrixExtractorRejectsBytes)
+{
+  boost::python::object bytes(boost::python::handle<>(PyBytes_FromString("abc")));
+  EXPECT_FALSE(DenseMatrixExtractor(bytes).check());
+}
+
+TEST_F(PythonArrayConversionTests, SparseMatrixRoundTripThroughCSRArrays)
+{
+  auto sparse = MAKE_SPARSE_MATRIX_HANDLE(
+    (1, 0, 0)
+    (0, 2, 3)
+    (4, 0, 5));
+  auto arrays = convertMatrixToPythonArrays(sparse);
+  EXPECT_EQ(sparse->valuePtr(), bufferAddress(arrays["data"]));
+  EXPECT_EQ(sparse->outerIndexPtr(), bufferAddress(arrays["indptr"]));
+
+  SparseRowMatrixExtractor e(arrays);
+  ASSERT_TRUE(e.check());
+  auto actual = boost::dynamic_pointer_cast<SparseRowMatrix>(e());
+  ASSERT_TRUE(actual != nullptr);
+  EXPECT_EQ(5, actual->nonZeros());
+  EXPECT_MATRIX_EQ(*convertMatrix::toDense(sparse), *convertMatrix::toDense(actual));
+}
+
+TEST_F(PythonArrayConversionTests, SparseMatrixExtractorRejectsBadColumns)
+{
+  boost::python::dict arrays;
+  arrays["shape"] = boost::python::make_tuple(1, 2);
+  arrays["indptr"] = toPythonList(std::vector<int>{ 0, 1 });
+  arrays["indices"] = toPythonList(std::vector<int>{ 7 });
+  arrays["data"] = toPythonList(std::vector<double>{ 1.0 });
+
+  SparseRowMatrixExtractor e(arrays);
+  ASSERT_TRUE(e.check());
+  EXPECT_THROW(e(), std::invalid_argument);
+}
+
+TEST_F(PythonArrayConversionTests, FieldArraysExposeNodesElementsAndData)
+{
+  auto field = TetrahedronTetVolLinearBasis(DOUBLE_E);
+  auto arrays = convertFieldToPythonArrays(field);
+
+  auto node = arrays["node"];
+  EXPECT_EQ(4, boost::python::extract<int>(node.attr("shape")[0])());
+  EXPECT_EQ(3, boost::python::extract<int>(node.attr("shape")[1])());
+  EXPECT_EQ(field->vmesh()->get_points_pointer(), bufferAddress(node));
+
+  auto elem = arrays["elem"];
+  EXPECT_EQ(1, boost::python::extract<int>(elem.attr("shape")[0])());
+  EXPECT_EQ(4, boost::python::extract<int>(elem.attr("shape")[1])());
+
+  auto data = arrays["data"];
+  EXPECT_EQ(4, boost::python::extract<int>(data.attr("shape")[0])());
+  EXPECT_EQ(field->vfield()->fdata_pointer(), bufferAddress(data));
+}
+
+/// Conversion timing comparison between the list-of-lists and buffer paths. Run manually.
+TEST_F(PythonArrayConversionTests, DISABLED_ConversionTimingListsVersusArrays)
+{
+  auto m = matrixOfSize(100000, 100);
+
+  boost::python::object list, array;
+  {
+    ScopedTimer t("dense 100000x100 to python list of lists");
+    list = convertMatrixToPython(m);
+  }
+  {
+    ScopedTimer t("dense 100000x100 to python buffer");
+    array = convertMatrixToPythonArray(m);
+  }
+  {
+    ScopedTimer t("python list of lists to dense 100000x100");
+    DenseMatrixExtractor e(list);
+    ASSERT_TRUE(e.check());
+    e();
+  }
+  {
+    ScopedTimer t("python buffer to dense 100000x100");
+    DenseMatrixExtractor e(array);
+    ASSERT_TRUE(e.check());
+    e();
+  }
+}
@@ -28,6 +28,7 @@
 
 #include <Core/Thread/Parallel.h>
 #include <Core/Logging/Log.h>
+#include <Core/Logging/Profiler.h>
 #include <boost/thread/thread.hpp>
 #include <vector>
 
@@ -37,10 +38,20 @@ using namespace SCIRun::Core::Logging;
 void Parallel::RunTasks(IndexedTask task, int numProcs)
 {
   boost::thread_group threads;
+  const bool profiling = Profiler::Instance().enabled();
 
   for (int i = 0; i < capByUserCoreCount(numProcs); ++i)
   {
-    threads.create_thread(boost::bind(task, i));
+    if (profiling)
+    {
+      threads.create_thread([task, i]()
+      {
+        ScopedProfileEvent profile("Parallel task " + std::to_string(i), "task");
+        task(i);
+      });
+    }
+    else
+      threads.create_thread(boost::bind(task, i));
   }
 
   try
@@ -73,6 +84,16 @@ void Parallel::SetMaximumCores(unsigned int max)
   maximumCoresSetByUser_ = max;
 }
 
+Parallel::ScopedCoreLimit::ScopedCoreLimit(unsigned int max) : previous_(maximumCoresSetByUser_)
+{
+  maximumCoresSetByUser_ = std::max(1u, std::min(max, previous_));
+}
+
+Parallel::ScopedCoreLimit::~ScopedCoreLimit()
+{
+  maximumCoresSetByUser_ = previous_;
+}
+
 unsigned int Parallel::capByUserCoreCount(unsigned int numProcs)
 {
   return std::min(numProcs, maximumCoresSetByUser_);
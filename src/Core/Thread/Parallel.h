@@ -46,6 +46,17 @@ namespace Thread
     static void RunTasks(IndexedTask task, int numProcs);
     static unsigned int NumCores();
     static void SetMaximumCores(unsigned int max);
+
+    /// Lowers the core cap while several independent jobs each run their own parallel
+    /// algorithms, e.g. sweep lanes; the previous cap is restored on destruction.
+    class SCISHARE ScopedCoreLimit : boost::noncopyable
+    {
+    public:
+      explicit ScopedCoreLimit(unsigned int max);
+      ~ScopedCoreLimit();
+    private:
+      unsigned int previous_;
+    };
   private:
     static unsigned int maximumCoresSetByUser_;
     static unsigned int capByUserCoreCount(unsigned int numProcs);
@@ -0,0 +1,334 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Dataflow/Engine/Controller/ParameterSweep.h>
+#include <Dataflow/Engine/Controller/NetworkEditorController.h>
+#include <Dataflow/Engine/Scheduler/BoostGraphSerialScheduler.h>
+#include <Dataflow/Network/NetworkInterface.h>
+#include <Dataflow/Network/ModuleInterface.h>
+#include <Dataflow/Network/ModuleStateInterface.h>
+#include <Dataflow/Network/ConnectionId.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Logging/Log.h>
+#include <Core/Logging/Profiler.h>
+#include <Core/Utils/Exception.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+#include <boost/make_shared.hpp>
+#include <chrono>
+#include <istream>
+#include <map>
+#include <queue>
+
+using namespace SCIRun::Dataflow::Engine;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
+
+ParameterSweepTable::ParameterSweepTable(const std::vector<ParameterSweepColumn>& columns, const std::vector<Row>& rows)
+  : columns_(columns), rows_(rows)
+{
+  for (size_t i = 0; i < rows_.size(); ++i)
+  {
+    if (rows_[i].size() != columns_.size())
+      THROW_INVALID_ARGUMENT("Sweep row " + std::to_string(i) + " has " + std::to_string(rows_[i].size())
+        + " values, expected " + std::to_string(columns_.size()));
+  }
+}
+
+namespace
+{
+  std::vector<std::string> splitCsvLine(const std::string& line)
+  {
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of(","));
+    for (auto& field : fields)
+      boost::trim(field);
+    return fields;
+  }
+
+  ParameterSweepColumn parseColumn(const std::string& header)
+  {
+    auto separator = header.rfind("::");
+    if (separator == std::string::npos || separator == 0 || separator + 2 == header.size())
+      THROW_INVALID_ARGUMENT("Sweep column must be named ModuleId::StateKey: " + header);
+    return { ModuleId(header.substr(0, separator)), header.substr(separator + 2) };
+  }
+}
+
+ParameterSweepTable ParameterSweepTable::fromCsv(std::istream& in)
+{
+  std::vector<ParameterSweepColumn> columns;
+  std::vector<Row> rows;
+  bool haveHeader = false;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    boost::trim(line);
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    auto fields = splitCsvLine(line);
+    if (!haveHeader)
+    {
+      for (const auto& field : fields)
+        columns.push_back(parseColumn(field));
+      haveHeader = true;
+    }
+    else
+      rows.push_back(fields);
+  }
+  if (!haveHeader)
+    THROW_INVALID_ARGUMENT("Sweep table has no header line");
+  return ParameterSweepTable(columns, rows);
+}
+
+namespace
+{
+  class SweepValueConverter : public boost::static_visitor<Variable::Value>
+  {
+  public:
+    explicit SweepValueConverter(const std::string& text) : text_(text) {}
+
+    Variable::Value operator()(int) const
+    {
+      return convert<int>();
+    }
+    Variable::Value operator()(double) const
+    {
+      return convert<double>();
+    }
+    Variable::Value operator()(const std::string&) const
+    {
+      return text_;
+    }
+    Variable::Value operator()(bool) const
+    {
+      auto lower = boost::algorithm::to_lower_copy(text_);
+      if (lower == "1" || lower == "true" || lower == "yes" || lower == "on")
+        return true;
+      if (lower == "0" || lower == "false" || lower == "no" || lower == "off")
+        return false;
+      THROW_INVALID_ARGUMENT("Sweep value is not a boolean: " + text_);
+    }
+    Variable::Value operator()(const AlgoOption& option) const
+    {
+      if (!option.options_.empty() && option.options_.find(text_) == option.options_.end())
+        THROW_INVALID_ARGUMENT("Sweep value is not one of the allowed options: " + text_);
+      return AlgoOption(text_, option.options_);
+    }
+    Variable::Value operator()(const Variable::List&) const
+    {
+      THROW_INVALID_ARGUMENT("List-valued state cannot be swept");
+    }
+  private:
+    template <typename T>
+    Variable::Value convert() const
+    {
+      try
+      {
+        return boost::lexical_cast<T>(text_);
+      }
+      catch (boost::bad_lexical_cast&)
+      {
+        THROW_INVALID_ARGUMENT("Sweep value has the wrong type: " + text_);
+      }
+    }
+    const std::string& text_;
+  };
+}
+
+Variable::Value SCIRun::Dataflow::Engine::convertSweepValue(const Variable::Value& current, const std::string& text)
+{
+  return boost::apply_visitor(SweepValueConverter(text), current);
+}
+
+std::set<ModuleId> SCIRun::Dataflow::Engine::downstreamModules(const std::vector<ConnectionDescription>& connections,
+  const std::set<ModuleId>& roots)
+{
+  std::multimap<ModuleId, ModuleId> outgoing;
+  for (const auto& cd : connections)
+    outgoing.insert(std::make_pair(cd.out_.moduleId_, cd.in_.moduleId_));
+
+  std::set<ModuleId> reached(roots);
+  std::queue<ModuleId> toVisit;
+  for (const auto& root : roots)
+    toVisit.push(root);
+
+  while (!toVisit.empty())
+  {
+    auto range = outgoing.equal_range(toVisit.front());
+    toVisit.pop();
+    for (auto edge = range.first; edge != range.second; ++edge)
+    {
+      if (reached.insert(edge->second).second)
+        toVisit.push(edge->second);
+    }
+  }
+  return reached;
+}
+
+namespace
+{
+  class SweepLane
+  {
+  public:
+    SweepLane(NetworkEditorControllerHandle controller, const ParameterSweepTable& table)
+      : controller_(controller), network_(controller->getNetwork()), table_(table), executedOnce_(false)
+    {
+      order_ = BoostGraphSerialScheduler().schedule(*network_);
+      for (const auto& column : table_.columns())
+      {
+        auto module = network_->lookupModule(column.moduleId);
+        if (!module)
+          THROW_INVALID_ARGUMENT("Sweep column refers to a module not in the network: " + column.moduleId.id_);
+        if (!module->get_state()->containsKey(Name(column.stateKey)))
+          THROW_INVALID_ARGUMENT("Sweep column refers to an unknown state key: " + column.moduleId.id_ + "::" + column.stateKey);
+        modules_.push_back(module);
+      }
+    }
+
+    void run(size_t begin, size_t end, std::vector<ParameterSweepRowResult>& results)
+    {
+      for (size_t row = begin; row < end; ++row)
+        results[row] = runRow(row);
+    }
+
+  private:
+    ParameterSweepRowResult runRow(size_t row)
+    {
+      ScopedProfileEvent profile("Sweep row " + std::to_string(row), "sweep");
+      auto start = std::chrono::steady_clock::now();
+      ParameterSweepRowResult result { row, 0, 0, 0.0 };
+      auto errorsBefore = network_->errorCode();
+      try
+      {
+        auto toExecute = downstreamModules(network_->connections(), applyOverrides(row));
+        for (const auto& id : order_)
+        {
+          if (executedOnce_ && toExecute.find(id) == toExecute.end())
+            continue;
+          auto executable = network_->lookupExecutable(id);
+          if (executable)
+          {
+            executable->executeWithSignals();
+            ++result.modulesExecuted;
+          }
+        }
+        executedOnce_ = true;
+      }
+      catch (std::exception& e)
+      {
+        GeneralLog::Instance().get()->error("Sweep row {} failed: {}", row, e.what());
+        ++result.errors;
+      }
+      result.errors += network_->errorCode() - errorsBefore;
+      result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      return result;
+    }
+
+    std::set<ModuleId> applyOverrides(size_t row)
+    {
+      std::set<ModuleId> changed;
+      const auto& values = table_.rows()[row];
+      for (size_t col = 0; col < modules_.size(); ++col)
+      {
+        auto state = modules_[col]->get_state();
+        Name key(table_.columns()[col].stateKey);
+        auto current = state->getValue(key).value();
+        auto value = convertSweepValue(current, values[col]);
+        if (!(value == current))
+        {
+          state->setValue(key, value);
+          changed.insert(modules_[col]->get_id());
+        }
+      }
+      return changed;
+    }
+
+    NetworkEditorControllerHandle controller_;
+    NetworkHandle network_;
+    const ParameterSweepTable& table_;
+    ModuleExecutionOrder order_;
+    std::vector<ModuleHandle> modules_;
+    bool executedOnce_;
+  };
+}
+
+ParameterSweep::ParameterSweep(const ParameterSweepTable& table, NetworkFileHandle network, ControllerMaker makeController)
+  : table_(table), network_(network), makeController_(makeController), maximumLanes_(0)
+{
+  ENSURE_NOT_NULL(network_, "Sweep network file");
+}
+
+std::vector<ParameterSweepRowResult> ParameterSweep::run()
+{
+  const auto rowCount = table_.rows().size();
+  std::vector<ParameterSweepRowResult> results(rowCount);
+  if (rowCount == 0)
+    return results;
+
+  const auto cores = std::max(1u, Parallel::NumCores());
+  auto laneCount = static_cast<unsigned int>(std::min<size_t>(rowCount, cores));
+  if (maximumLanes_ > 0)
+    laneCount = std::min(laneCount, maximumLanes_);
+
+  // networks are loaded one at a time; loading is not thread-safe
+  std::vector<boost::shared_ptr<SweepLane>> lanes;
+  for (unsigned int i = 0; i < laneCount; ++i)
+  {
+    auto controller = makeController_();
+    controller->loadNetwork(network_);
+    lanes.push_back(boost::make_shared<SweepLane>(controller, table_));
+  }
+
+  GeneralLog::Instance().get()->info("Running {} sweep row(s) on {} lane(s) of {} core(s)", rowCount, laneCount, cores);
+  {
+    // algorithms inside each lane split whatever cores the lanes leave over
+    Parallel::ScopedCoreLimit coreLimit(std::max(1u, cores / laneCount));
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < laneCount; ++i)
+    {
+      auto begin = rowCount * i / laneCount;
+      auto end = rowCount * (i + 1) / laneCount;
+      auto lane = lanes[i];
+      threads.create_thread([lane, begin, end, &results]() { lane->run(begin, end, results); });
+    }
+    threads.join_all();
+  }
+
+  for (const auto& result : results)
+  {
+    GeneralLog::Instance().get()->info("Sweep row {}: executed {} module(s) with {} error(s) in {} s",
+      result.row, result.modulesExecuted, result.errors, result.seconds);
+  }
+  return results;
+}
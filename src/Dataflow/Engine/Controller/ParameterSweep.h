@@ -0,0 +1,113 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ENGINE_NETWORK_PARAMETERSWEEP_H
+#define ENGINE_NETWORK_PARAMETERSWEEP_H
+
+#include <set>
+#include <vector>
+#include <iosfwd>
+#include <boost/function.hpp>
+#include <Dataflow/Network/NetworkFwd.h>
+#include <Dataflow/Network/ModuleDescription.h>
+#include <Core/Algorithms/Base/Variable.h>
+#include <Dataflow/Engine/Controller/share.h>
+
+namespace SCIRun {
+namespace Dataflow {
+namespace Engine {
+
+  class NetworkEditorController;
+
+  /// One sweep column: the state key of a module to override.
+  struct SCISHARE ParameterSweepColumn
+  {
+    Networks::ModuleId moduleId;
+    std::string stateKey;
+  };
+
+  /// @brief Table of module state overrides, one network execution per row.
+  ///
+  /// The CSV header names the overridden values as ModuleId::StateKey (e.g. CreateLatVol:0::XSize);
+  /// each following line holds the values for one execution. Blank lines and lines starting with # are skipped.
+  class SCISHARE ParameterSweepTable
+  {
+  public:
+    typedef std::vector<std::string> Row;
+
+    ParameterSweepTable(const std::vector<ParameterSweepColumn>& columns, const std::vector<Row>& rows);
+    static ParameterSweepTable fromCsv(std::istream& in);
+
+    const std::vector<ParameterSweepColumn>& columns() const { return columns_; }
+    const std::vector<Row>& rows() const { return rows_; }
+  private:
+    std::vector<ParameterSweepColumn> columns_;
+    std::vector<Row> rows_;
+  };
+
+  /// Converts sweep table text to the type of the state value it replaces.
+  SCISHARE Core::Algorithms::Variable::Value convertSweepValue(const Core::Algorithms::Variable::Value& current, const std::string& text);
+
+  /// The given modules plus every module reachable from them through connections.
+  SCISHARE std::set<Networks::ModuleId> downstreamModules(const std::vector<Networks::ConnectionDescription>& connections,
+    const std::set<Networks::ModuleId>& roots);
+
+  struct SCISHARE ParameterSweepRowResult
+  {
+    size_t row;
+    size_t modulesExecuted;
+    int errors;
+    double seconds;
+  };
+
+  /// @brief Executes a loaded network once per sweep table row, without the GUI.
+  ///
+  /// Rows are split into contiguous blocks, one per lane. Each lane owns a copy of the network, so lanes run
+  /// concurrently; within a lane, only the modules whose overrides changed since the previous row and the
+  /// modules downstream of them are re-executed. The lane count and the cores left to each lane's parallel
+  /// algorithms together stay within Parallel::NumCores(), which --max-cores caps.
+  class SCISHARE ParameterSweep
+  {
+  public:
+    typedef boost::function<boost::shared_ptr<NetworkEditorController>()> ControllerMaker;
+
+    ParameterSweep(const ParameterSweepTable& table, Networks::NetworkFileHandle network, ControllerMaker makeController);
+    /// Lanes are limited to this many even when more cores are available. Zero means no limit.
+    void setMaximumLanes(unsigned int lanes) { maximumLanes_ = lanes; }
+    std::vector<ParameterSweepRowResult> run();
+  private:
+    ParameterSweepTable table_;
+    Networks::NetworkFileHandle network_;
+    ControllerMaker makeController_;
+    unsigned int maximumLanes_;
+  };
+
+}}}
+
+#endif
@@ -46,6 +46,13 @@ namespace Engine {
     virtual ~ProvenanceItem() {}
     virtual Memento memento() const = 0;
     virtual std::string name() const = 0;
+
+    /// Storage hooks used by ProvenanceManager to bound history memory. Items may replace their
+    /// full memento by a difference against the next newer item; by default they keep it whole.
+    virtual void storeRelativeTo(const Handle& newer) {}
+    virtual size_t storageSize() const { return 0; }
+    /// The item whose memento this one is stored against, kept alive for as long as this one is.
+    virtual Handle storedRelativeTo() const { return Handle(); }
   };
 
 }
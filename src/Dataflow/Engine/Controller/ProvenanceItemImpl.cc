@@ -30,18 +30,60 @@
 #include <string>
 #include <sstream>
 #include <Dataflow/Engine/Controller/ProvenanceItemImpl.h>
+#include <boost/make_shared.hpp>
 
 using namespace SCIRun;
 using namespace SCIRun::Dataflow::Engine;
 using namespace SCIRun::Dataflow::Networks;
 
-ProvenanceItemBase::ProvenanceItemBase(NetworkFileHandle state) : state_(state)
+ProvenanceItemBase::ProvenanceItemBase(NetworkFileHandle state) : state_(state),
+  storageSize_(state ? estimatedMemorySize(*state) : 0)
 {
 }
 
 NetworkFileHandle ProvenanceItemBase::memento() const
 {
-  return state_;
+  if (state_ || !delta_)
+    return state_;
+
+  std::vector<const ProvenanceItemBase*> chain { this };
+  while (!chain.back()->state_ && chain.back()->newer_)
+    chain.push_back(chain.back()->newer_.get());
+
+  auto checkpoint = chain.back()->state_;
+  if (!checkpoint)
+    return nullptr;
+  auto state = boost::make_shared<NetworkFile>(*checkpoint);
+  for (auto item = chain.rbegin() + 1; item != chain.rend(); ++item)
+    applyNetworkFileDelta(*state, *(*item)->delta_);
+  return state;
+}
+
+void ProvenanceItemBase::storeRelativeTo(const Handle& newer)
+{
+  auto newerItem = boost::dynamic_pointer_cast<ProvenanceItemBase>(newer);
+  if (!newerItem || newerItem.get() == this || newerItem == newer_)
+    return;
+
+  auto mine = memento();
+  auto theirs = newerItem->memento();
+  if (!mine || !theirs)
+    return;
+
+  delta_ = boost::make_shared<NetworkFileDelta>(diffNetworkFiles(*theirs, *mine));
+  newer_ = newerItem;
+  state_.reset();
+  storageSize_ = estimatedMemorySize(*delta_);
+}
+
+size_t ProvenanceItemBase::storageSize() const
+{
+  return storageSize_;
+}
+
+ProvenanceItemBase::Handle ProvenanceItemBase::storedRelativeTo() const
+{
+  return newer_;
 }
 
 ModuleAddedProvenanceItem::ModuleAddedProvenanceItem(const std::string& moduleName, NetworkFileHandle state)
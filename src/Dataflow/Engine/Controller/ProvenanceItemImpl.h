@@ -33,19 +33,31 @@
 #include <Dataflow/Network/ModuleDescription.h>
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Network/ConnectionId.h>
+#include <Dataflow/Serialization/Network/NetworkFileDelta.h>
 #include <Dataflow/Engine/Controller/share.h>
 
 namespace SCIRun {
 namespace Dataflow {
 namespace Engine {
   
+  /// Holds either a full network snapshot or a reverse delta: the structural difference that
+  /// turns the next newer item's state back into this one. Snapshots are rebuilt by walking
+  /// towards the nearest newer item that still holds a full snapshot (a checkpoint).
   class SCISHARE ProvenanceItemBase : public ProvenanceItem<Networks::NetworkFileHandle>
   {
   public:
     explicit ProvenanceItemBase(Networks::NetworkFileHandle state);
-    virtual Networks::NetworkFileHandle memento() const;
+    virtual Networks::NetworkFileHandle memento() const override;
+    virtual void storeRelativeTo(const Handle& newer) override;
+    virtual size_t storageSize() const override;
+    virtual Handle storedRelativeTo() const override;
+    bool isCheckpoint() const { return state_ != nullptr; }
   protected:
     Networks::NetworkFileHandle state_;
+  private:
+    boost::shared_ptr<ProvenanceItemBase> newer_;
+    boost::shared_ptr<Networks::NetworkFileDelta> delta_;
+    size_t storageSize_;
   };
 
   class SCISHARE ModuleAddedProvenanceItem : public ProvenanceItemBase
@@ -31,6 +31,8 @@
 #define ENGINE_NETWORK_PROVENANCEMANAGER_H
 
 #include <stack>
+#include <set>
+#include <algorithm>
 #include <boost/noncopyable.hpp>
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Engine/Controller/NetworkEditorController.h>
@@ -64,25 +66,45 @@ namespace Engine {
     size_t undoSize() const;
     size_t redoSize() const;
 
+    /// Every checkpointInterval-th item keeps a full memento; the items in between may store
+    /// differences, so restoring a state replays at most this many of them. The differences are
+    /// computed in one pass when the next checkpoint is added, not on every edit.
+    void setCheckpointInterval(size_t interval);
+    /// Oldest undo items are discarded once the estimated history size exceeds this many bytes. Zero means no limit.
+    void setMemoryLimit(size_t bytes);
+    /// Size of every item still held, including the floor and items only kept alive as the base of another item's difference.
+    size_t storageSize() const;
+
     const IOType* networkIO() const;
 
   private:
     ItemHandle undo(bool restore);
     ItemHandle redo(bool restore);
+    void storeIntervalRelative();
+    void enforceMemoryLimit();
+    void restoreFloor();
     IOType* networkIO_;
-    Stack undo_, redo_;
+    List undo_, redo_;
     boost::optional<Memento> initialState_;
+    /// Newest item dropped by the memory limit; its state is where undo stops. It is only
+    /// rebuilt when undo gets there.
+    ItemHandle floor_;
+    /// Items dropped from the front of the undo list, so positions stay absolute.
+    size_t dropped_;
+    size_t checkpointInterval_;
+    size_t memoryLimit_;
   };
 
 
 
   template <class Memento>
-  ProvenanceManager<Memento>::ProvenanceManager(IOType* networkIO) : networkIO_(networkIO) {}
+  ProvenanceManager<Memento>::ProvenanceManager(IOType* networkIO) : networkIO_(networkIO), dropped_(0), checkpointInterval_(10), memoryLimit_(0) {}
 
   template <class Memento>
   void ProvenanceManager<Memento>::setInitialState(const Memento& initialState)
   {
     initialState_ = initialState;
+    floor_.reset();
   }
 
   template <class Memento>
@@ -97,18 +119,100 @@ namespace Engine {
     return redo_.size();
   }
 
+  template <class Memento>
+  void ProvenanceManager<Memento>::setCheckpointInterval(size_t interval)
+  {
+    checkpointInterval_ = std::max<size_t>(interval, 1);
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::setMemoryLimit(size_t bytes)
+  {
+    memoryLimit_ = bytes;
+    enforceMemoryLimit();
+  }
+
+  template <class Memento>
+  size_t ProvenanceManager<Memento>::storageSize() const
+  {
+    // An item keeps the one it is stored against alive, even after redo is cleared or the
+    // item is dropped, so count everything reachable from the three roots once.
+    std::set<const Item*> counted;
+    size_t total = 0;
+    auto countFrom = [&counted, &total](ItemHandle item)
+    {
+      for (; item && counted.insert(item.get()).second; item = item->storedRelativeTo())
+        total += item->storageSize();
+    };
+    for (const auto& item : undo_)
+      countFrom(item);
+    for (const auto& item : redo_)
+      countFrom(item);
+    countFrom(floor_);
+    return total;
+  }
+
   template <class Memento>
   void ProvenanceManager<Memento>::addItem(typename ProvenanceManager<Memento>::ItemHandle item)
   {
-    undo_.push(item);
-    Stack().swap(redo_);
+    undo_.push_back(item);
+    List().swap(redo_);
+    // The position of the new item in the whole history decides whether it is a checkpoint, so
+    // dropping old items does not shift the checkpoints.
+    if ((dropped_ + undo_.size() - 1) % checkpointInterval_ == 0)
+      storeIntervalRelative();
+    enforceMemoryLimit();
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::storeIntervalRelative()
+  {
+    // The newest item just became a checkpoint. The items since the previous one, the floor
+    // among them if it is still held, are stored against their successors, oldest first so
+    // that each successor still has its full memento when it is diffed.
+    const auto newest = undo_.size() - 1;
+    const auto count = std::min(checkpointInterval_ - 1, dropped_ + newest);
+    for (auto back = count; back > 0; --back)
+    {
+      if (back <= newest)
+        undo_[newest - back]->storeRelativeTo(undo_[newest - back + 1]);
+      else if (back == newest + 1 && floor_)
+        floor_->storeRelativeTo(undo_.front());
+    }
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::enforceMemoryLimit()
+  {
+    if (0 == memoryLimit_)
+      return;
+
+    while (undo_.size() > 1 && storageSize() > memoryLimit_)
+    {
+      // The dropped item's state becomes the floor that undo can return to, replacing the
+      // previous floor. Its delta chain runs through the items that are kept.
+      floor_ = undo_.front();
+      undo_.pop_front();
+      ++dropped_;
+    }
   }
 
   template <class Memento>
   void ProvenanceManager<Memento>::clearAll()
   {
-    Stack().swap(undo_);
-    Stack().swap(redo_);
+    List().swap(undo_);
+    List().swap(redo_);
+    floor_.reset();
+    dropped_ = 0;
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::restoreFloor()
+  {
+    if (floor_)
+      networkIO_->loadNetwork(floor_->memento());
+    else if (initialState_)
+      networkIO_->loadNetwork(initialState_.get());
   }
 
   template <class Memento>
@@ -122,18 +226,18 @@ namespace Engine {
   {
     if (!undo_.empty())
     {
-      auto undone = undo_.top();
-      undo_.pop();
-      redo_.push(undone);
+      auto undone = undo_.back();
+      undo_.pop_back();
+      redo_.push_back(undone);
 
       //clear and load previous memento
       if (restore)
       {
         networkIO_->clear();
         if (!undo_.empty())
-          networkIO_->loadNetwork(undo_.top()->memento());
-        else if (initialState_)
-          networkIO_->loadNetwork(initialState_.get());
+          networkIO_->loadNetwork(undo_.back()->memento());
+        else
+          restoreFloor();
       }
       
       return undone;
@@ -152,9 +256,9 @@ namespace Engine {
   {
     if (!redo_.empty())
     {
-      auto redone = redo_.top();
-      redo_.pop();
-      undo_.push(redone);
+      auto redone = redo_.back();
+      redo_.pop_back();
+      undo_.push_back(redone);
 
       //clear and load redone memento
       if (restore)
@@ -175,8 +279,7 @@ namespace Engine {
     while (0 != undoSize())
       undone.push_back(undo(false));
     networkIO_->clear();
-    if (initialState_)
-      networkIO_->loadNetwork(initialState_.get());
+    restoreFloor();
     return undone;
   }
 
@@ -187,7 +290,7 @@ namespace Engine {
     while (0 != redoSize())
       redone.push_back(redo(false));
     networkIO_->clear();
-    networkIO_->loadNetwork(undo_.top()->memento());
+    networkIO_->loadNetwork(undo_.back()->memento());
     return redone;
   }
 
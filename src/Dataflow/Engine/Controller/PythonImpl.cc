@@ -89,7 +89,7 @@ namespace
   class PyDatatypeDenseMatrix : public PyDatatype
   {
   public:
-    explicit PyDatatypeDenseMatrix(DenseMatrixHandle underlying) : underlying_(underlying), pyMat_(convertMatrixToPython(underlying))
+    explicit PyDatatypeDenseMatrix(DenseMatrixHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -100,18 +100,25 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return pyMat_;
+      if (!pyMat_)
+        pyMat_ = convertMatrixToPython(underlying_);
+      return *pyMat_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertMatrixToPythonArray(underlying_);
     }
 
   private:
     DenseMatrixHandle underlying_;
-    boost::python::list pyMat_;
+    mutable boost::optional<boost::python::list> pyMat_;
   };
 
   class PyDatatypeSparseRowMatrix : public PyDatatype
   {
   public:
-    explicit PyDatatypeSparseRowMatrix(SparseRowMatrixHandle underlying) : underlying_(underlying), pyMat_(convertMatrixToPython(underlying))
+    explicit PyDatatypeSparseRowMatrix(SparseRowMatrixHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -122,18 +129,25 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return pyMat_;
+      if (!pyMat_)
+        pyMat_ = convertMatrixToPython(underlying_);
+      return *pyMat_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertMatrixToPythonArrays(underlying_);
     }
 
   private:
     SparseRowMatrixHandle underlying_;
-    boost::python::list pyMat_;
+    mutable boost::optional<boost::python::object> pyMat_;
   };
 
   class PyDatatypeField : public PyDatatype
   {
   public:
-    explicit PyDatatypeField(FieldHandle underlying) : underlying_(underlying), matlabStructure_(convertFieldToPython(underlying))
+    explicit PyDatatypeField(FieldHandle underlying) : underlying_(underlying)
     {
     }
 
@@ -144,12 +158,19 @@ namespace
 
     virtual boost::python::object value() const override
     {
-      return matlabStructure_;
+      if (!matlabStructure_)
+        matlabStructure_ = convertFieldToPython(underlying_);
+      return *matlabStructure_;
+    }
+
+    virtual boost::python::object array() const override
+    {
+      return convertFieldToPythonArrays(underlying_);
     }
 
   private:
     FieldHandle underlying_;
-    boost::python::dict matlabStructure_;
+    mutable boost::optional<boost::python::dict> matlabStructure_;
   };
 
   class PyDatatypeFactory
@@ -0,0 +1,284 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <Dataflow/Engine/Controller/ParameterSweep.h>
+#include <Dataflow/Engine/Controller/NetworkEditorController.h>
+#include <Dataflow/Network/ConnectionId.h>
+#include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
+#include <Dataflow/Network/Tests/MockNetwork.h>
+#include <Dataflow/Network/Tests/MockModule.h>
+#include <Dataflow/State/SimpleMapModuleState.h>
+#include <Core/Utils/Exception.h>
+#include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+using namespace SCIRun;
+using namespace SCIRun::Dataflow::Engine;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Dataflow::Networks::Mocks;
+using namespace SCIRun::Dataflow::State;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::Invoke;
+
+TEST(ParameterSweepTableTests, ReadsHeaderAndRows)
+{
+  std::istringstream csv(
+    "# resolution study\n"
+    "CreateLatVol:0::XSize, CreateLatVol:0::YSize, WriteField:2::Filename\n"
+    "\n"
+    "8,8,out8.fld\n"
+    "16, 16, out16.fld\n");
+
+  auto table = ParameterSweepTable::fromCsv(csv);
+
+  ASSERT_EQ(3, table.columns().size());
+  EXPECT_EQ(ModuleId("CreateLatVol:0"), table.columns()[0].moduleId);
+  EXPECT_EQ("YSize", table.columns()[1].stateKey);
+  EXPECT_EQ(ModuleId("WriteField:2"), table.columns()[2].moduleId);
+  EXPECT_EQ("Filename", table.columns()[2].stateKey);
+
+  ASSERT_EQ(2, table.rows().size());
+  EXPECT_EQ("8", table.rows()[0][0]);
+  EXPECT_EQ("out16.fld", table.rows()[1][2]);
+}
+
+TEST(ParameterSweepTableTests, RejectsMalformedTables)
+{
+  {
+    std::istringstream csv("CreateLatVol:0 XSize\n1\n");
+    EXPECT_THROW(ParameterSweepTable::fromCsv(csv), Core::InvalidArgumentException);
+  }
+  {
+    std::istringstream csv("CreateLatVol:0::XSize,CreateLatVol:0::YSize\n1,2\n3\n");
+    EXPECT_THROW(ParameterSweepTable::fromCsv(csv), Core::InvalidArgumentException);
+  }
+  {
+    std::istringstream csv("# nothing here\n");
+    EXPECT_THROW(ParameterSweepTable::fromCsv(csv), Core::InvalidArgumentException);
+  }
+}
+
+TEST(ParameterSweepTableTests, ConvertsValuesToCurrentStateType)
+{
+  EXPECT_EQ(12, boost::get<int>(convertSweepValue(3, "12")));
+  EXPECT_EQ(0.25, boost::get<double>(convertSweepValue(1.0, "0.25")));
+  EXPECT_EQ("a.fld", boost::get<std::string>(convertSweepValue(std::string("b.fld"), "a.fld")));
+  EXPECT_TRUE(boost::get<bool>(convertSweepValue(false, "TRUE")));
+  EXPECT_FALSE(boost::get<bool>(convertSweepValue(true, "0")));
+
+  AlgoOption method("Linear", { "Linear", "Cubic" });
+  auto cubic = boost::get<AlgoOption>(convertSweepValue(method, "Cubic"));
+  EXPECT_EQ("Cubic", cubic.option_);
+  EXPECT_EQ(method.options_, cubic.options_);
+
+  EXPECT_THROW(convertSweepValue(3, "twelve"), Core::InvalidArgumentException);
+  EXPECT_THROW(convertSweepValue(true, "maybe"), Core::InvalidArgumentException);
+  EXPECT_THROW(convertSweepValue(method, "Quintic"), Core::InvalidArgumentException);
+  EXPECT_THROW(convertSweepValue(Variable::List(), "1"), Core::InvalidArgumentException);
+}
+
+TEST(ParameterSweepTableTests, DownstreamModulesFollowConnections)
+{
+  auto connect = [](const std::string& from, const std::string& to)
+  {
+    return ConnectionDescription(OutgoingConnectionDescription(ModuleId(from), PortId(0, "out")),
+      IncomingConnectionDescription(ModuleId(to), PortId(0, "in")));
+  };
+  // a -> b -> d, a -> c, e -> d
+  std::vector<ConnectionDescription> connections {
+    connect("A:0", "B:0"), connect("B:0", "D:0"), connect("A:0", "C:0"), connect("E:0", "D:0") };
+
+  std::set<ModuleId> fromB { ModuleId("B:0") };
+  EXPECT_EQ((std::set<ModuleId> { ModuleId("B:0"), ModuleId("D:0") }), downstreamModules(connections, fromB));
+
+  std::set<ModuleId> fromA { ModuleId("A:0") };
+  EXPECT_EQ(4, downstreamModules(connections, fromA).size());
+
+  std::set<ModuleId> fromD { ModuleId("D:0") };
+  EXPECT_EQ(fromD, downstreamModules(connections, fromD));
+
+  EXPECT_TRUE(downstreamModules(connections, {}).empty());
+}
+
+namespace
+{
+  ConnectionDescription connectModules(const std::string& from, const std::string& to)
+  {
+    return ConnectionDescription(OutgoingConnectionDescription(ModuleId(from), PortId(0, "out")),
+      IncomingConnectionDescription(ModuleId(to), PortId(0, "in")));
+  }
+
+  // Keeps the network it was built with instead of loading the sweep's network file.
+  class PrebuiltNetworkController : public NetworkEditorController
+  {
+  public:
+    explicit PrebuiltNetworkController(NetworkHandle network) : NetworkEditorController(network, ExecutionStrategyFactoryHandle()) {}
+    void loadNetwork(const NetworkFileHandle&) override {}
+  };
+
+  struct ExecutionRecord
+  {
+    int lane;
+    std::string module;
+    int sweptValue;
+  };
+
+  // One lane's network, Upstream:0 -> Swept:0 -> Downstream:0, where Swept:0::Value is the swept parameter.
+  // Every execution records the swept value the lane's own module state holds at that moment.
+  class SweepLaneNetwork
+  {
+  public:
+    SweepLaneNetwork(int lane, std::vector<ExecutionRecord>& log, boost::mutex& logLock)
+      : network_(boost::make_shared<NiceMock<MockNetwork>>()), sweptState_(boost::make_shared<SimpleMapModuleState>())
+    {
+      sweptState_->setValue(Name("Value"), 0);
+      for (const auto& name : { "Upstream:0", "Swept:0", "Downstream:0" })
+      {
+        auto module = boost::make_shared<NiceMock<MockModule>>();
+        ModuleId id(name);
+        auto state = sweptState_;
+        ON_CALL(*module, get_id()).WillByDefault(Return(id));
+        ON_CALL(*module, get_state()).WillByDefault(Return(state));
+        ON_CALL(*module, executeWithSignals()).WillByDefault(Invoke([lane, name, state, &log, &logLock]()
+        {
+          boost::mutex::scoped_lock lock(logLock);
+          log.push_back({ lane, name, state->getValue(Name("Value")).toInt() });
+          return true;
+        }));
+        ON_CALL(*network_, lookupModule(id)).WillByDefault(Return(module));
+        ON_CALL(*network_, lookupExecutable(id)).WillByDefault(Return(module.get()));
+        modules_.push_back(module);
+      }
+      ON_CALL(*network_, nmodules()).WillByDefault(Return(modules_.size()));
+      for (size_t i = 0; i < modules_.size(); ++i)
+        ON_CALL(*network_, module(i)).WillByDefault(Return(modules_[i]));
+      ON_CALL(*network_, connections()).WillByDefault(Return(NetworkInterface::ConnectionDescriptionList {
+        connectModules("Upstream:0", "Swept:0"), connectModules("Swept:0", "Downstream:0") }));
+    }
+
+    NetworkHandle network() const { return network_; }
+  private:
+    boost::shared_ptr<NiceMock<MockNetwork>> network_;
+    ModuleStateHandle sweptState_;
+    std::vector<ModuleHandle> modules_;
+  };
+
+  class ParameterSweepExecutionTests : public ::testing::Test
+  {
+  protected:
+    std::vector<ParameterSweepRowResult> runSweep(unsigned int maximumLanes)
+    {
+      ParameterSweepTable table({ { ModuleId("Swept:0"), "Value" } }, { { "10" }, { "20" }, { "30" } });
+      ParameterSweep sweep(table, boost::make_shared<NetworkFile>(), [this]()
+      {
+        lanes_.push_back(boost::make_shared<SweepLaneNetwork>(static_cast<int>(lanes_.size()), log_, logLock_));
+        return boost::make_shared<PrebuiltNetworkController>(lanes_.back()->network());
+      });
+      sweep.setMaximumLanes(maximumLanes);
+      return sweep.run();
+    }
+
+    std::map<std::string, int> executionCounts() const
+    {
+      std::map<std::string, int> counts;
+      for (const auto& record : log_)
+        ++counts[record.module];
+      return counts;
+    }
+
+    std::vector<boost::shared_ptr<SweepLaneNetwork>> lanes_;
+    std::vector<ExecutionRecord> log_;
+    boost::mutex logLock_;
+  };
+}
+
+TEST_F(ParameterSweepExecutionTests, UpstreamRunsOnceAndDownstreamRunsPerRow)
+{
+  auto results = runSweep(1);
+
+  ASSERT_EQ(1, lanes_.size());
+  ASSERT_EQ(3, results.size());
+  EXPECT_EQ(3, results[0].modulesExecuted);
+  EXPECT_EQ(2, results[1].modulesExecuted);
+  EXPECT_EQ(2, results[2].modulesExecuted);
+  for (const auto& result : results)
+    EXPECT_EQ(0, result.errors);
+
+  auto counts = executionCounts();
+  EXPECT_EQ(1, counts["Upstream:0"]);
+  EXPECT_EQ(3, counts["Swept:0"]);
+  EXPECT_EQ(3, counts["Downstream:0"]);
+
+  std::vector<int> downstreamValues;
+  for (const auto& record : log_)
+  {
+    if (record.module == "Downstream:0")
+      downstreamValues.push_back(record.sweptValue);
+  }
+  EXPECT_EQ((std::vector<int> { 10, 20, 30 }), downstreamValues);
+}
+
+TEST_F(ParameterSweepExecutionTests, EachLaneSeesItsRowValues)
+{
+  auto results = runSweep(3);
+
+  const auto laneCount = lanes_.size();
+  ASSERT_GE(laneCount, 1u);
+  ASSERT_LE(laneCount, 3u);
+  ASSERT_EQ(3, results.size());
+
+  // rows are split into contiguous blocks, so each lane's downstream module must see exactly its rows' values, in order
+  const std::vector<int> rowValues { 10, 20, 30 };
+  for (size_t lane = 0; lane < laneCount; ++lane)
+  {
+    std::vector<int> expected(rowValues.begin() + 3 * lane / laneCount, rowValues.begin() + 3 * (lane + 1) / laneCount);
+    std::vector<int> seen;
+    int upstreamRuns = 0;
+    for (const auto& record : log_)
+    {
+      if (record.lane != static_cast<int>(lane))
+        continue;
+      if (record.module == "Downstream:0")
+        seen.push_back(record.sweptValue);
+      else if (record.module == "Upstream:0")
+        ++upstreamRuns;
+    }
+    EXPECT_EQ(expected, seen) << "lane " << lane;
+    EXPECT_EQ(1, upstreamRuns) << "lane " << lane;
+  }
+  EXPECT_EQ(3, executionCounts()["Downstream:0"]);
+}
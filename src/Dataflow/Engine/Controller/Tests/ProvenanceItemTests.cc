@@ -34,6 +34,7 @@
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Engine/Controller/ProvenanceItemFactory.h>
 #include <Dataflow/Engine/Controller/ProvenanceItemImpl.h>
+#include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Dataflow::Engine;
@@ -73,4 +74,61 @@ TEST_F(ProvenanceItemTests, CanCreateRemoveModule)
   ModuleRemovedProvenanceItem item((ModuleId(id)), NetworkFileHandle());
 
   EXPECT_EQ("Module Removed: " + id, item.name());
-}
\ No newline at end of file
+}
+namespace
+{
+  NetworkFileHandle networkWithModules(int count, double x = 0)
+  {
+    auto file = boost::make_shared<NetworkFile>();
+    for (int i = 0; i < count; ++i)
+    {
+      auto id = "CreateMatrix:" + std::to_string(i);
+      file->network.modules[id] = ModuleWithState(ModuleLookupInfoXML());
+      file->modulePositions.modulePositions[id] = std::make_pair(x + i, 0.0);
+    }
+    return file;
+  }
+}
+
+TEST_F(ProvenanceItemTests, RelativeItemsRebuildTheirSnapshot)
+{
+  auto moved = networkWithModules(2);
+  moved->modulePositions.modulePositions["CreateMatrix:0"].first = 5;
+
+  ProvenanceItem<NetworkFileHandle>::Handle first(boost::make_shared<ModuleAddedProvenanceItem>("CreateMatrix", networkWithModules(1)));
+  ProvenanceItem<NetworkFileHandle>::Handle second(boost::make_shared<ModuleAddedProvenanceItem>("CreateMatrix", networkWithModules(2)));
+  ProvenanceItem<NetworkFileHandle>::Handle third(boost::make_shared<ModuleMovedProvenanceItem>(ModuleId("CreateMatrix:0"), 5, 0, moved));
+
+  first->storeRelativeTo(second);
+  second->storeRelativeTo(third);
+
+  EXPECT_FALSE(boost::dynamic_pointer_cast<ProvenanceItemBase>(first)->isCheckpoint());
+  EXPECT_FALSE(boost::dynamic_pointer_cast<ProvenanceItemBase>(second)->isCheckpoint());
+  EXPECT_TRUE(boost::dynamic_pointer_cast<ProvenanceItemBase>(third)->isCheckpoint());
+
+  auto rebuiltFirst = first->memento();
+  ASSERT_TRUE(rebuiltFirst != nullptr);
+  EXPECT_EQ(1, rebuiltFirst->network.modules.size());
+  EXPECT_EQ(0.0, rebuiltFirst->modulePositions.modulePositions["CreateMatrix:0"].first);
+
+  auto rebuiltSecond = second->memento();
+  ASSERT_TRUE(rebuiltSecond != nullptr);
+  EXPECT_EQ(2, rebuiltSecond->network.modules.size());
+  EXPECT_EQ(0.0, rebuiltSecond->modulePositions.modulePositions["CreateMatrix:0"].first);
+  EXPECT_EQ(1.0, rebuiltSecond->modulePositions.modulePositions["CreateMatrix:1"].first);
+}
+
+TEST_F(ProvenanceItemTests, MoveDeltaIsMuchSmallerThanSnapshot)
+{
+  auto before = networkWithModules(100);
+  auto after = boost::make_shared<NetworkFile>(*before);
+  after->modulePositions.modulePositions["CreateMatrix:7"].second = 42;
+
+  ProvenanceItem<NetworkFileHandle>::Handle older(boost::make_shared<ModuleAddedProvenanceItem>("CreateMatrix", before));
+  ProvenanceItem<NetworkFileHandle>::Handle newer(boost::make_shared<ModuleMovedProvenanceItem>(ModuleId("CreateMatrix:7"), 7, 42, after));
+
+  auto snapshotSize = older->storageSize();
+  older->storeRelativeTo(newer);
+  EXPECT_LT(10 * older->storageSize(), snapshotSize);
+  EXPECT_EQ(0.0, older->memento()->modulePositions.modulePositions["CreateMatrix:7"].second);
+}
@@ -268,4 +268,186 @@ TEST_F(ProvenanceManagerTests, LoadFileSetsInitialState)
   EXPECT_CALL(*controller_, clear()).Times(1);
   EXPECT_CALL(*controller_, loadNetwork("initial")).Times(1);
   manager.undo();
-}
\ No newline at end of file
+}
+namespace
+{
+  class SizedProvenanceItem : public ProvenanceItem<std::string>
+  {
+  public:
+    SizedProvenanceItem(const std::string& name, size_t size) : name_(name), size_(size), mementoCalls_(0) {}
+    virtual std::string name() const override { return name_; }
+    virtual std::string memento() const override { ++mementoCalls_; return name_; }
+    virtual void storeRelativeTo(const Handle& newer) override { newer_ = newer; }
+    virtual size_t storageSize() const override { return relative() ? size_ / 10 : size_; }
+    virtual Handle storedRelativeTo() const override { return newer_; }
+    bool relative() const { return newer_ != nullptr; }
+    int mementoCalls() const { return mementoCalls_; }
+  private:
+    std::string name_;
+    size_t size_;
+    Handle newer_;
+    mutable int mementoCalls_;
+  };
+}
+
+TEST_F(ProvenanceManagerTests, KeepsPeriodicCheckpoints)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(3);
+
+  std::vector<boost::shared_ptr<SizedProvenanceItem>> items;
+  for (int i = 0; i < 7; ++i)
+  {
+    items.push_back(boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100));
+    manager.addItem(items.back());
+  }
+
+  EXPECT_FALSE(items[0]->relative());
+  EXPECT_TRUE(items[1]->relative());
+  EXPECT_TRUE(items[2]->relative());
+  EXPECT_FALSE(items[3]->relative());
+  EXPECT_TRUE(items[4]->relative());
+  EXPECT_TRUE(items[5]->relative());
+  EXPECT_FALSE(items[6]->relative());
+  EXPECT_EQ(100 + 10 + 10 + 100 + 10 + 10 + 100, manager.storageSize());
+}
+
+TEST_F(ProvenanceManagerTests, MemoryLimitDropsOldestItems)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(1);
+  manager.setMemoryLimit(350);
+
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("1", 100));
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("2", 100));
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("3", 100));
+  EXPECT_EQ(3, manager.undoSize());
+  // the dropped item kept as the floor still counts, so a second one has to go
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("4", 100));
+  EXPECT_EQ(2, manager.undoSize());
+  EXPECT_EQ(300, manager.storageSize());
+
+  manager.undo();
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("2")).Times(1);
+  auto undone = manager.undo();
+  EXPECT_EQ("3", undone->name());
+  EXPECT_EQ(0, manager.undoSize());
+}
+
+TEST_F(ProvenanceManagerTests, CheckpointsStayPeriodicUnderMemoryLimit)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(3);
+  manager.setMemoryLimit(250);
+
+  std::vector<boost::shared_ptr<SizedProvenanceItem>> items;
+  for (int i = 0; i < 10; ++i)
+  {
+    items.push_back(boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100));
+    manager.addItem(items.back());
+    EXPECT_LE(manager.storageSize(), 250);
+  }
+
+  // items after the last checkpoint keep their full memento until the next one arrives
+  for (int i = 0; i < 9; ++i)
+    EXPECT_EQ(i % 3 != 0, items[i]->relative()) << "item " << i;
+}
+
+TEST_F(ProvenanceManagerTests, DroppedItemIsOnlyRebuiltWhenUndoReachesIt)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(1);
+  manager.setMemoryLimit(150);
+
+  std::vector<boost::shared_ptr<SizedProvenanceItem>> items;
+  for (int i = 1; i <= 3; ++i)
+  {
+    items.push_back(boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100));
+    manager.addItem(items.back());
+  }
+  EXPECT_EQ(1, manager.undoSize());
+  EXPECT_EQ(0, items[0]->mementoCalls());
+  EXPECT_EQ(0, items[1]->mementoCalls());
+
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("2")).Times(1);
+  manager.undo();
+  EXPECT_EQ(0, items[0]->mementoCalls());
+  EXPECT_EQ(1, items[1]->mementoCalls());
+}
+
+TEST_F(ProvenanceManagerTests, DifferencesAreStoredWhenTheNextCheckpointArrives)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(3);
+
+  std::vector<boost::shared_ptr<SizedProvenanceItem>> items;
+  for (int i = 0; i < 3; ++i)
+  {
+    items.push_back(boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100));
+    manager.addItem(items.back());
+  }
+  EXPECT_FALSE(items[1]->relative());
+  EXPECT_FALSE(items[2]->relative());
+  EXPECT_EQ(300, manager.storageSize());
+
+  items.push_back(boost::make_shared<SizedProvenanceItem>("3", 100));
+  manager.addItem(items.back());
+  EXPECT_EQ(items[2], items[1]->storedRelativeTo());
+  EXPECT_EQ(items[3], items[2]->storedRelativeTo());
+  EXPECT_EQ(100 + 10 + 10 + 100, manager.storageSize());
+}
+
+TEST_F(ProvenanceManagerTests, StorageSizeCountsItemsKeptAliveByDifferences)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(3);
+
+  for (int i = 0; i < 4; ++i)
+    manager.addItem(boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100));
+  manager.undo();
+  manager.undo();
+
+  // 1 is stored against 2, which is stored against 3: clearing redo does not free them
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("X", 100));
+  EXPECT_EQ(2 + 1, manager.undoSize());
+  EXPECT_EQ(0, manager.redoSize());
+  EXPECT_EQ(100 + 10 + 100 + 10 + 100, manager.storageSize());
+
+  // the next checkpoint stores 1 against X instead, releasing the old branch
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("Y", 100));
+  EXPECT_EQ(100 + 10 + 10 + 100, manager.storageSize());
+}
+
+TEST_F(ProvenanceManagerTests, FloorOutlivesTrimmedItems)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+  manager.setCheckpointInterval(1);
+
+  std::vector<boost::weak_ptr<SizedProvenanceItem>> items;
+  for (int i = 0; i < 4; ++i)
+  {
+    auto item = boost::make_shared<SizedProvenanceItem>(std::to_string(i), 100);
+    items.push_back(item);
+    manager.addItem(item);
+  }
+  manager.setMemoryLimit(250);
+
+  // 0 and 1 are gone; 2 stays alive as the floor and is counted
+  EXPECT_EQ(1, manager.undoSize());
+  EXPECT_TRUE(items[0].expired());
+  EXPECT_TRUE(items[1].expired());
+  EXPECT_FALSE(items[2].expired());
+  EXPECT_EQ(200, manager.storageSize());
+
+  manager.undo();
+  manager.addItem(boost::make_shared<SizedProvenanceItem>("4", 100));
+  EXPECT_TRUE(items[3].expired());
+  EXPECT_FALSE(items[2].expired());
+  EXPECT_EQ(200, manager.storageSize());
+
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("2")).Times(1);
+  manager.undo();
+}
@@ -428,6 +428,15 @@ boost::python::object NetworkEditorPythonAPI::scirun_get_module_input_value(cons
   return {};
 }
 
+boost::python::object NetworkEditorPythonAPI::scirun_get_module_input_array(const std::string& moduleId, const std::string& portName)
+{
+  auto pyData = scirun_get_module_input_object(moduleId, portName);
+  Guard g(pythonLock_.get());
+  if (pyData)
+    return pyData->array();
+  return {};
+}
+
 boost::python::object SimplePythonAPI::scirun_module_ids()
 {
   auto mods = NetworkEditorPythonAPI::modules();
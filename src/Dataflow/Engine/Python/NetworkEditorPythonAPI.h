@@ -68,6 +68,7 @@ namespace SCIRun {
     //these work on all platforms
     static boost::python::object scirun_get_module_input_value_index(const std::string& moduleId, int portIndex);
     static boost::python::object scirun_get_module_input_value(const std::string& moduleId, const std::string& portName);
+    static boost::python::object scirun_get_module_input_array(const std::string& moduleId, const std::string& portName);
 
     static std::string executeAll();
     static std::string saveNetwork(const std::string& filename);
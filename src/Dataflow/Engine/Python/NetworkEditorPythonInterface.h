@@ -76,6 +76,8 @@ namespace SCIRun
     virtual ~PyDatatype() {}
     virtual std::string type() const = 0;
     virtual boost::python::object value() const = 0;
+    /// Zero-copy buffer view(s) of the underlying data, for use with numpy.asarray. None if not supported.
+    virtual boost::python::object array() const { return {}; }
   };
 
   class SCISHARE PyPort : public boost::enable_shared_from_this<PyPort>
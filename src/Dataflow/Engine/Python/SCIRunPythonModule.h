@@ -67,6 +67,7 @@ BOOST_PYTHON_MODULE(SCIRunPythonAPI)
   boost::python::class_<PyDatatype, boost::shared_ptr<PyDatatype>, boost::noncopyable>("SCIRun::PyDatatype", boost::python::no_init)
     .add_property("type", &PyDatatype::type)
     .add_property("value", &PyDatatype::value)
+    .add_property("array", &PyDatatype::array)
   ;
 
   //////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +95,7 @@ BOOST_PYTHON_MODULE(SCIRunPythonAPI)
   boost::python::def("scirun_get_module_input_value", &NetworkEditorPythonAPI::scirun_get_module_input_value);
   boost::python::def("scirun_get_module_input_object_by_index", &NetworkEditorPythonAPI::scirun_get_module_input_object_index);
   boost::python::def("scirun_get_module_input_value_by_index", &NetworkEditorPythonAPI::scirun_get_module_input_value_index);
+  boost::python::def("scirun_get_module_input_array", &NetworkEditorPythonAPI::scirun_get_module_input_array);
 
   boost::python::def("scirun_save_network", &NetworkEditorPythonAPI::saveNetwork);
   boost::python::def("scirun_load_network", &NetworkEditorPythonAPI::loadNetwork);
@@ -40,26 +40,8 @@ BoostGraphParallelScheduler::BoostGraphParallelScheduler(const ModuleFilter& fil
 ParallelModuleExecutionOrder BoostGraphParallelScheduler::schedule(const NetworkInterface& network) const
 {
   NetworkGraphAnalyzer graphAnalyzer(network, filter_, true);
-  const DirectedGraph& g = graphAnalyzer.graph();
+  const auto& time = graphAnalyzer.executionLevels();
 
-  // Parallel compilation ordering
-  std::vector<int> time(graphAnalyzer.moduleCount(), 0);
-  for (auto i = graphAnalyzer.topologicalBegin(); i != graphAnalyzer.topologicalEnd(); ++i) 
-  {    
-    // Walk through the in_edges an calculate the maximum time.
-    if (in_degree (*i, g) > 0) 
-    {
-      DirectedGraph::in_edge_iterator j, j_end;
-      int maxdist = 0;
-      // Through the order from topological sort, we are sure that every 
-      // time we are using here is already initialized.
-      for (boost::tie(j, j_end) = in_edges(*i, g); j != j_end; ++j)
-        maxdist = std::max(time[source(*j, g)], maxdist);
-
-      time[*i] = maxdist + 1;
-    }
-  }
-  
   ParallelModuleExecutionOrder::ModulesByGroup map;
 
   std::transform(
@@ -31,19 +31,110 @@
 #include <Dataflow/Network/ConnectionId.h>
 #include <Dataflow/Engine/Scheduler/BoostGraphParallelScheduler.h>
 #include <Core/Logging/Log.h>
+#include <Core/Thread/Mutex.h>
 
 #include <boost/utility.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/copy.hpp>
 #include <boost/graph/connected_components.hpp>
 #include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
 
 using namespace SCIRun::Dataflow::Engine;
 using namespace SCIRun::Dataflow::Engine::NetworkGraph;
 using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Core;
+
+namespace
+{
+  // Analyses keyed by topology stamp. A handful of entries covers the distinct filters
+  // (execute all, execute selected, single module) that are scheduled against one network state.
+  class SnapshotCache
+  {
+  public:
+    SnapshotCache() : mutex_("networkGraphSnapshots") {}
+
+    SnapshotHandle find(size_t stamp, const std::vector<ModuleId>& modules)
+    {
+      Thread::Guard g(mutex_.get());
+      for (auto i = entries_.begin(); i != entries_.end(); ++i)
+      {
+        if (i->first == stamp && i->second->modules == modules)
+        {
+          entries_.splice(entries_.begin(), entries_, i);
+          return entries_.front().second;
+        }
+      }
+      return SnapshotHandle();
+    }
+
+    void insert(size_t stamp, SnapshotHandle snapshot)
+    {
+      Thread::Guard g(mutex_.get());
+      entries_.emplace_front(stamp, snapshot);
+      if (entries_.size() > maxEntries)
+        entries_.pop_back();
+    }
+
+  private:
+    static const size_t maxEntries = 8;
+    Thread::Mutex mutex_;
+    std::list<std::pair<size_t, SnapshotHandle>> entries_;
+  };
+
+  SnapshotCache& snapshotCache()
+  {
+    static SnapshotCache cache;
+    return cache;
+  }
+
+  SnapshotHandle buildSnapshot(const NetworkInterface& network, std::vector<ModuleId>&& modules)
+  {
+    auto snapshot = boost::make_shared<Snapshot>();
+    snapshot->modules = std::move(modules);
+
+    int vertex = 0;
+    for (const auto& id : snapshot->modules)
+      snapshot->moduleIdLookup.left.insert(std::make_pair(id, vertex++));
+
+    const auto& lookup = snapshot->moduleIdLookup.left;
+    for (const ConnectionDescription& cd : network.connections())
+    {
+      auto out = lookup.find(cd.out_.moduleId_);
+      auto in = lookup.find(cd.in_.moduleId_);
+      if (out != lookup.end() && in != lookup.end())
+        snapshot->edges.push_back(std::make_pair(out->second, in->second));
+    }
+
+    const int moduleCount = static_cast<int>(snapshot->modules.size());
+    snapshot->graph = DirectedGraph(snapshot->edges.begin(), snapshot->edges.end(), moduleCount);
+
+    try
+    {
+      boost::topological_sort(snapshot->graph, std::front_inserter(snapshot->order));
+    }
+    catch (std::invalid_argument& e)
+    {
+      snapshot->order.clear();
+      snapshot->cycleError = e.what();
+      return snapshot;
+    }
+
+    // Topological order guarantees every upstream level is final before it is read.
+    const auto& g = snapshot->graph;
+    snapshot->levels.assign(moduleCount, 0);
+    for (auto v : snapshot->order)
+    {
+      DirectedGraph::in_edge_iterator j, j_end;
+      for (boost::tie(j, j_end) = in_edges(v, g); j != j_end; ++j)
+        snapshot->levels[v] = std::max(snapshot->levels[v], snapshot->levels[source(*j, g)] + 1);
+    }
+    return snapshot;
+  }
+}
 
 NetworkGraphAnalyzer::NetworkGraphAnalyzer(const NetworkInterface& network, const ModuleFilter& moduleFilter, bool precompute)
-  : network_(network), moduleFilter_(moduleFilter), moduleCount_(0)
+  : network_(network), moduleFilter_(moduleFilter)
 {
   if (precompute)
   {
@@ -53,81 +144,82 @@ NetworkGraphAnalyzer::NetworkGraphAnalyzer(const NetworkInterface& network, cons
 
 const ModuleId& NetworkGraphAnalyzer::moduleAt(int vertex) const
 {
-  return moduleIdLookup_.right.at(vertex);
+  return snapshot_->moduleIdLookup.right.at(vertex);
 }
 
 ExecutionOrderIterator NetworkGraphAnalyzer::topologicalBegin()
 {
-  return order_.begin();
+  return snapshot_->order.begin();
 }
 
 ExecutionOrderIterator NetworkGraphAnalyzer::topologicalEnd()
 {
-  return order_.end();
+  return snapshot_->order.end();
 }
 
 const DirectedGraph& NetworkGraphAnalyzer::graph()
 {
-  return graph_;
+  return snapshot_->graph;
 }
 
 int NetworkGraphAnalyzer::moduleCount() const
 {
-  return moduleCount_;
+  return snapshot_ ? static_cast<int>(snapshot_->modules.size()) : 0;
 }
 
-EdgeVector NetworkGraphAnalyzer::constructEdgeListFromNetwork()
+const ExecutionLevels& NetworkGraphAnalyzer::executionLevels()
 {
-  moduleCount_ = 0;
-  moduleIdLookup_.clear();
+  return snapshot_->levels;
+}
 
-  for (int i = 0; i < network_.nmodules(); ++i)
+void NetworkGraphAnalyzer::loadSnapshot()
+{
+  std::vector<ModuleId> modules;
+  modules.reserve(network_.nmodules());
+  for (size_t i = 0; i < network_.nmodules(); ++i)
   {
     auto module = network_.module(i);
     if (moduleFilter_(module))
-    {
-      moduleIdLookup_.left.insert(std::make_pair(module->get_id(), moduleCount_));
-      moduleCount_++;
-    }
+      modules.push_back(module->get_id());
   }
 
-  std::vector<Edge> edges;
-
-  for (const ConnectionDescription& cd : network_.connections())
+  // The module list is part of the key: filters may depend on module state, not only on topology.
+  const auto stamp = network_.topologyStamp();
+  if (stamp != 0)
   {
-    if (moduleIdLookup_.left.find(cd.out_.moduleId_) != moduleIdLookup_.left.end()
-      && moduleIdLookup_.left.find(cd.in_.moduleId_) != moduleIdLookup_.left.end())
-    {
-      edges.push_back(std::make_pair(moduleIdLookup_.left.at(cd.out_.moduleId_), moduleIdLookup_.left.at(cd.in_.moduleId_)));
-    }
+    snapshot_ = snapshotCache().find(stamp, modules);
+    if (snapshot_)
+      return;
   }
 
-  return edges;
+  snapshot_ = buildSnapshot(network_, std::move(modules));
+  if (stamp != 0)
+    snapshotCache().insert(stamp, snapshot_);
 }
 
-void NetworkGraphAnalyzer::computeExecutionOrder()
+EdgeVector NetworkGraphAnalyzer::constructEdgeListFromNetwork()
 {
-  auto edges = constructEdgeListFromNetwork();
+  loadSnapshot();
+  return snapshot_->edges;
+}
 
-  graph_ = DirectedGraph(edges.begin(), edges.end(), moduleCount_);
+void NetworkGraphAnalyzer::computeExecutionOrder()
+{
+  loadSnapshot();
 
-  try
-  {
-    boost::topological_sort(graph_, std::front_inserter(order_));
-  }
-  catch (std::invalid_argument& e)
-  {
-    BOOST_THROW_EXCEPTION(NetworkHasCyclesException() << SCIRun::Core::ErrorMessage(e.what()));
-  }
+  if (!snapshot_->cycleError.empty())
+    BOOST_THROW_EXCEPTION(NetworkHasCyclesException() << SCIRun::Core::ErrorMessage(snapshot_->cycleError));
 }
 
 ComponentMap NetworkGraphAnalyzer::connectedComponents()
 {
-  auto edges = constructEdgeListFromNetwork();
-  UndirectedGraph undirected(edges.begin(), edges.end(), moduleCount_);
+  loadSnapshot();
+  const auto& edges = snapshot_->edges;
+  UndirectedGraph undirected(edges.begin(), edges.end(), moduleCount());
 
   std::vector<int> component(boost::num_vertices(undirected));
-  boost::connected_components(undirected, &component[0]);
+  if (!component.empty())
+    boost::connected_components(undirected, &component[0]);
 
   ComponentMap componentMap;
   for (size_t i = 0; i < component.size(); ++i)
@@ -32,6 +32,7 @@
 #include <boost/noncopyable.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/bimap.hpp>
+#include <boost/shared_ptr.hpp>
 #include <Dataflow/Network/ModuleDescription.h>
 #include <Dataflow/Engine/Scheduler/SchedulerInterfaces.h>
 #include <Dataflow/Engine/Scheduler/share.h>
@@ -50,6 +51,21 @@ namespace Engine {
     typedef std::list<Vertex> ExecutionOrder;
     typedef ExecutionOrder::const_iterator ExecutionOrderIterator;
     typedef std::map<std::string, int> ComponentMap;
+    typedef std::vector<int> ExecutionLevels;
+
+    /// Immutable analysis of one filtered view of a network. Snapshots are shared between analyzers
+    /// and reused until the network's topology stamp changes, so repeated scheduling is O(modules).
+    struct Snapshot
+    {
+      std::vector<Networks::ModuleId> modules;
+      boost::bimap<Networks::ModuleId, int> moduleIdLookup;
+      EdgeVector edges;
+      DirectedGraph graph;
+      ExecutionOrder order;
+      ExecutionLevels levels;
+      std::string cycleError;
+    };
+    typedef boost::shared_ptr<const Snapshot> SnapshotHandle;
   }
 
   class SCISHARE NetworkGraphAnalyzer : boost::noncopyable
@@ -66,15 +82,15 @@ namespace Engine {
     const NetworkGraph::DirectedGraph& graph();
     int moduleCount() const;
     NetworkGraph::ComponentMap connectedComponents();
+    /// Longest upstream path length per vertex; modules with equal level can execute concurrently.
+    const NetworkGraph::ExecutionLevels& executionLevels();
 
   private:
+    void loadSnapshot();
+
     const Networks::NetworkInterface& network_;
     Networks::ModuleFilter moduleFilter_;
-
-    boost::bimap<Networks::ModuleId, int> moduleIdLookup_;
-    NetworkGraph::ExecutionOrder order_;
-    NetworkGraph::DirectedGraph graph_;
-    int moduleCount_;
+    NetworkGraph::SnapshotHandle snapshot_;
   };
 
 }}}
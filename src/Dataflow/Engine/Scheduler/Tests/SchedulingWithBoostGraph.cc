@@ -362,6 +362,42 @@ TEST_F(SchedulingWithBoostGraph, ParallelNetworkOrderWithSomeModulesDone)
   EXPECT_EQ(expected, ostr.str());
 }
 
+TEST_F(SchedulingWithBoostGraph, RepeatedScheduleFollowsTopologyChanges)
+{
+  setupBasicNetwork();
+
+  BoostGraphParallelScheduler scheduler(ExecuteAllModules::Instance());
+  std::ostringstream first, second;
+  first << scheduler.schedule(matrixMathNetwork);
+  second << scheduler.schedule(matrixMathNetwork);
+  EXPECT_EQ(first.str(), second.str());
+
+  ModuleHandle create2 = addModuleToNetwork(matrixMathNetwork, "CreateMatrix");
+  ModuleHandle report2 = addModuleToNetwork(matrixMathNetwork, "ReportMatrixInfo");
+  matrixMathNetwork.connect(ConnectionOutputPort(create2, 0), ConnectionInputPort(report2, 0));
+
+  std::ostringstream afterConnect;
+  afterConnect << scheduler.schedule(matrixMathNetwork);
+
+  std::string expected =
+    "0 CreateMatrix:0\n"
+    "0 CreateMatrix:1\n"
+    "0 CreateMatrix:9\n"
+    "1 EvaluateLinearAlgebraUnary:2\n"
+    "1 EvaluateLinearAlgebraUnary:3\n"
+    "1 EvaluateLinearAlgebraUnary:4\n"
+    "1 ReportMatrixInfo:10\n"
+    "2 EvaluateLinearAlgebraBinary:5\n"
+    "3 EvaluateLinearAlgebraBinary:6\n"
+    "4 ReportMatrixInfo:7\n"
+    "4 ReportMatrixInfo:8\n";
+  EXPECT_EQ(expected, afterConnect.str());
+
+  BoostGraphSerialScheduler serial;
+  auto serialOrder = serial.schedule(matrixMathNetwork);
+  EXPECT_EQ(11, std::distance(serialOrder.begin(), serialOrder.end()));
+}
+
 TEST_F(SchedulingWithBoostGraph, ParallelNetworkOrderExecutedFromAModuleInADisjointSubnetwork)
 {
   setupBasicNetwork();
@@ -31,8 +31,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/bind.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/timer.hpp>
 #include <atomic>
+#include <chrono>
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Dataflow/Network/PortManager.h>
@@ -47,6 +47,7 @@
 #include <Dataflow/Network/ModuleBuilder.h>
 #include <Core/Logging/ConsoleLogger.h>
 #include <Core/Logging/Log.h>
+#include <Core/Logging/Profiler.h>
 #include <Core/Thread/Mutex.h>
 #include <Core/Thread/Interruptible.h>
 
@@ -370,7 +371,8 @@ bool Module::executeWithSignals() NOEXCEPT
   }
 #endif
   impl_->executeBegins_(get_id());
-  boost::timer executionTimer;
+  // wall time: CPU time over-reports multithreaded modules and misses time spent waiting
+  auto executionStart = std::chrono::steady_clock::now();
   {
     auto isoString = boost::posix_time::to_simple_string(boost::posix_time::microsec_clock::universal_time());
     impl_->metadata_.setMetadata("Last execution timestamp", isoString);
@@ -386,6 +388,7 @@ bool Module::executeWithSignals() NOEXCEPT
 
   try
   {
+    ScopedProfileEvent profile(get_id().id_, "module");
     if (!executionDisabled())
       execute();
     returnCode = true;
@@ -431,7 +434,7 @@ bool Module::executeWithSignals() NOEXCEPT
   }
   impl_->threadStopped_ = threadStopValue;
 
-  auto executionTime = executionTimer.elapsed();
+  auto executionTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - executionStart).count();
   {
     std::ostringstream ostr;
     ostr << executionTime;
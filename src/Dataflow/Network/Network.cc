@@ -34,6 +34,7 @@
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 #include <boost/thread.hpp>
+#include <atomic>
 #include <Dataflow/Network/Network.h>
 #include <Dataflow/Network/Connection.h>
 #include <Dataflow/Network/Module.h>
@@ -44,8 +45,14 @@
 using namespace SCIRun::Dataflow::Networks;
 using namespace SCIRun::Core::Algorithms;
 
+namespace
+{
+  // Stamps are unique across all networks, so a cache keyed on the stamp alone never confuses two networks.
+  std::atomic<size_t> nextTopologyStamp(0);
+}
+
 Network::Network(ModuleFactoryHandle moduleFactory, ModuleStateFactoryHandle stateFactory, AlgorithmFactoryHandle algoFactory, ReexecuteStrategyFactoryHandle reexFactory)
-  : moduleFactory_(moduleFactory), stateFactory_(stateFactory), errorCode_(0)
+  : moduleFactory_(moduleFactory), stateFactory_(stateFactory), errorCode_(0), topologyStamp_(++nextTopologyStamp)
 {
   moduleFactory_->setStateFactory(stateFactory_);
   moduleFactory_->setAlgorithmFactory(algoFactory);
@@ -62,23 +69,57 @@ ModuleHandle Network::add_module(const ModuleLookupInfo& info)
   modules_.push_back(module);
   if (module)
   {
+    moduleIndex_[module->get_id().id_] = module;
     module->connectErrorListener(boost::bind(&NetworkInterface::incrementErrorCode, this, _1));
   }
+  topologyChanged();
   return module;
 }
 
 bool Network::remove_module(const ModuleId& id)
 {
-  Modules::iterator loc = std::find_if(modules_.begin(), modules_.end(), boost::lambda::bind(&ModuleInterface::get_id, *boost::lambda::_1) == id);
+  auto indexed = moduleIndex_.find(id.id_);
+  if (indexed == moduleIndex_.end())
+    return false;
+
+  auto loc = std::find(modules_.begin(), modules_.end(), indexed->second);
+  moduleIndex_.erase(indexed);
   if (loc != modules_.end())
   {
     // Inform the module that it is about to be erased from the network...
     modules_.erase(loc);
+    topologyChanged();
     return true;
   }
   return false;
 }
 
+void Network::setModuleId(const ModuleHandle& module, const ModuleId& id)
+{
+  ENSURE_NOT_NULL(module, "cannot rename null module");
+
+  auto oldId = module->get_id().id_;
+  module->set_id(id.id_);
+
+  auto indexed = moduleIndex_.find(oldId);
+  if (indexed != moduleIndex_.end() && indexed->second == module)
+  {
+    moduleIndex_.erase(indexed);
+    moduleIndex_[id.id_] = module;
+    topologyChanged();
+  }
+}
+
+void Network::topologyChanged()
+{
+  topologyStamp_ = ++nextTopologyStamp;
+}
+
+size_t Network::topologyStamp() const
+{
+  return topologyStamp_;
+}
+
 ConnectionId Network::connect(const ConnectionOutputPort& out, const ConnectionInputPort& in)
 {
   ModuleHandle outputModule = out.first;
@@ -116,6 +157,7 @@ ConnectionId Network::connect(const ConnectionOutputPort& out, const ConnectionI
       ConnectionHandle conn(boost::make_shared<Connection>(outputModule->getOutputPort(outputPortId), inputModule->getInputPort(inputPortId), id));
 
       connections_[id] = conn;
+      topologyChanged();
 
       return id;
     }
@@ -135,6 +177,7 @@ bool Network::disconnect(const ConnectionId& id)
   if (loc != connections_.end())
   {
     connections_.erase(loc);
+    topologyChanged();
     return true;
   }
   return false;
@@ -160,8 +203,11 @@ ModuleHandle Network::module(size_t i) const
 
 ModuleHandle Network::lookupModule(const ModuleId& id) const
 {
-  Modules::const_iterator i = std::find_if(modules_.begin(), modules_.end(), boost::lambda::bind(&ModuleInterface::get_id, *boost::lambda::_1) == id);
-  return i == modules_.end() ? nullptr : *i;
+  auto i = moduleIndex_.find(id.id_);
+  // An entry is stale if the module was renamed behind the network's back; treat it as absent.
+  if (i == moduleIndex_.end() || !(i->second->get_id() == id))
+    return nullptr;
+  return i->second;
 }
 
 ExecutableObject* Network::lookupExecutable(const ModuleId& id) const
@@ -252,6 +298,8 @@ void Network::clear()
 {
   connections_.clear();
   modules_.clear();
+  moduleIndex_.clear();
+  topologyChanged();
 }
 
 bool Network::containsViewScene() const
@@ -32,6 +32,7 @@
 #define DATAFLOW_NETWORK_NETWORK_H
 
 #include <boost/noncopyable.hpp>
+#include <unordered_map>
 #include <Core/Algorithms/Base/AlgorithmFwd.h>
 #include <Dataflow/Network/NetworkInterface.h>
 #include <Dataflow/Network/ConnectionId.h>
@@ -47,6 +48,7 @@ namespace Networks {
   public:
     using Connections = std::map<ConnectionId, ConnectionHandle, OrderedByConnectionId>;
     using Modules = std::vector<ModuleHandle>;
+    using ModuleIndex = std::unordered_map<std::string, ModuleHandle>;
 
     Network(ModuleFactoryHandle moduleFactory, ModuleStateFactoryHandle stateFactory, Core::Algorithms::AlgorithmFactoryHandle algoFactory, ReexecuteStrategyFactoryHandle reexFactory);
     ~Network();
@@ -57,11 +59,13 @@ namespace Networks {
     ModuleHandle module(size_t i) const override;
     ExecutableObject* lookupExecutable(const ModuleId& id) const override;
     ModuleHandle lookupModule(const ModuleId& id) const override;
+    void setModuleId(const ModuleHandle& module, const ModuleId& id) override;
     ConnectionId connect(const ConnectionOutputPort&, const ConnectionInputPort&) override;
     bool disconnect(const ConnectionId&) override;
     size_t nconnections() const override;
     void disable_connection(const ConnectionId&) override;
     ConnectionDescriptionList connections() const override;
+    size_t topologyStamp() const override;
     int errorCode() const override;
     void incrementErrorCode(const ModuleId& moduleId) override;
     bool containsViewScene() const override;
@@ -74,10 +78,14 @@ namespace Networks {
     void interruptModuleRequest(const ModuleId& id) override;
     void clear() override;
   private:
+    void topologyChanged();
+
     ModuleFactoryHandle moduleFactory_;
     ModuleStateFactoryHandle stateFactory_;
     Connections connections_;
     Modules modules_;
+    ModuleIndex moduleIndex_;
+    size_t topologyStamp_;
     int errorCode_;
     NetworkGlobalSettings settings_;
     mutable ModuleInterruptedSignal interruptModule_;
@@ -83,12 +83,17 @@ namespace Networks {
     virtual size_t nmodules() const = 0;
     virtual ModuleHandle module(size_t i) const = 0;
     virtual ModuleHandle lookupModule(const ModuleId& id) const = 0;
+    /// Renames a module already in the network, keeping the id lookup index consistent.
+    virtual void setModuleId(const ModuleHandle& module, const ModuleId& id) = 0;
 
     virtual ConnectionId connect(const ConnectionOutputPort&, const ConnectionInputPort&) = 0;
     virtual bool disconnect(const ConnectionId&) = 0;
     virtual size_t nconnections() const = 0;
     virtual void disable_connection(const ConnectionId&) = 0;
     virtual ConnectionDescriptionList connections() const = 0;
+    /// Process-unique stamp that changes whenever modules or connections are added, removed or renamed.
+    /// Zero means the implementation does not track changes, so derived data must not be cached.
+    virtual size_t topologyStamp() const = 0;
     virtual void incrementErrorCode(const ModuleId& moduleId) = 0;
     virtual NetworkGlobalSettings& settings() = 0;
     virtual void setModuleExecutionState(ModuleExecutionState::Value state, ModuleFilter filter) = 0;
@@ -48,6 +48,7 @@ namespace SCIRun {
           MOCK_CONST_METHOD0(nmodules, size_t());
           MOCK_CONST_METHOD1(module, ModuleHandle(size_t));
           MOCK_CONST_METHOD1(lookupModule, ModuleHandle(const ModuleId&));
+          MOCK_METHOD2(setModuleId, void(const ModuleHandle&, const ModuleId&));
           MOCK_CONST_METHOD1(lookupExecutable, ExecutableObject*(const ModuleId&));
           MOCK_METHOD2(connect, ConnectionId(const ConnectionOutputPort&, const ConnectionInputPort&));
           MOCK_METHOD1(disconnect, bool(const ConnectionId&));
@@ -55,6 +56,7 @@ namespace SCIRun {
           MOCK_METHOD1(disable_connection, void(const ConnectionId&));
           MOCK_CONST_METHOD0(toString, std::string());
           MOCK_CONST_METHOD0(connections, ConnectionDescriptionList());
+          MOCK_CONST_METHOD0(topologyStamp, size_t());
           MOCK_CONST_METHOD0(errorCode, int());
           MOCK_METHOD1(incrementErrorCode, void(const ModuleId&));
           MOCK_METHOD0(settings, NetworkGlobalSettings&());
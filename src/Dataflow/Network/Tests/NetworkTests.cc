@@ -44,6 +44,7 @@ using namespace SCIRun::Core::Algorithms;
 using namespace boost::assign;
 using ::testing::DefaultValue;
 using ::testing::NiceMock;
+using ::testing::Return;
 
 
 class NetworkTests : public ::testing::Test
@@ -143,6 +144,74 @@ TEST_F(NetworkTests, CannotMakeSameConnectionTwice)
   EXPECT_EQ("module:1_p#o1:0#_@to@_module:2_p#i2:0#", connId.id_);
 }
 
+TEST_F(NetworkTests, LookupModuleByIdAfterRemovalAndRename)
+{
+  Network network(moduleFactory_, sf_, af_, reex_);
+
+  ModuleLookupInfo mli;
+  mli.module_name_ = "Module1";
+  ModuleHandle m1 = network.add_module(mli);
+  ModuleHandle m2 = network.add_module(mli);
+  ModuleHandle m3 = network.add_module(mli);
+
+  EXPECT_EQ(m1, network.lookupModule(m1->get_id()));
+  EXPECT_EQ(m2, network.lookupModule(m2->get_id()));
+  EXPECT_EQ(m3, network.lookupModule(m3->get_id()));
+  EXPECT_FALSE(network.lookupModule(ModuleId("NotThere:42")));
+
+  auto removedId = m2->get_id();
+  EXPECT_TRUE(network.remove_module(removedId));
+  EXPECT_FALSE(network.lookupModule(removedId));
+  EXPECT_FALSE(network.remove_module(removedId));
+  EXPECT_EQ(m3, network.module(1));
+  EXPECT_EQ(m3, network.lookupModule(m3->get_id()));
+
+  auto mock = boost::dynamic_pointer_cast<MockModule>(m1);
+  ASSERT_TRUE(mock != nullptr);
+  auto oldId = m1->get_id();
+  ModuleId newId("Renamed:7");
+  ON_CALL(*mock, set_id(newId.id_)).WillByDefault(::testing::InvokeWithoutArgs([&]() { ON_CALL(*mock, get_id()).WillByDefault(Return(newId)); }));
+
+  network.setModuleId(m1, newId);
+  EXPECT_FALSE(network.lookupModule(oldId));
+  EXPECT_EQ(m1, network.lookupModule(newId));
+  EXPECT_TRUE(network.remove_module(newId));
+  EXPECT_EQ(1, network.nmodules());
+}
+
+TEST_F(NetworkTests, TopologyStampChangesOnlyWhenGraphChanges)
+{
+  Network network(moduleFactory_, sf_, af_, reex_);
+  Network other(moduleFactory_, sf_, af_, reex_);
+  EXPECT_NE(0, network.topologyStamp());
+  EXPECT_NE(network.topologyStamp(), other.topologyStamp());
+
+  ModuleLookupInfo mli;
+  mli.module_name_ = "Module1";
+  auto stamp = network.topologyStamp();
+  ModuleHandle m1 = network.add_module(mli);
+  ModuleHandle m2 = network.add_module(mli);
+  EXPECT_NE(stamp, network.topologyStamp());
+
+  stamp = network.topologyStamp();
+  ConnectionId connId = network.connect(ConnectionOutputPort(m1, 0), ConnectionInputPort(m2, 1));
+  EXPECT_NE(stamp, network.topologyStamp());
+
+  stamp = network.topologyStamp();
+  network.lookupModule(m1->get_id());
+  network.connections();
+  network.connect(ConnectionOutputPort(m1, 0), ConnectionInputPort(m2, 1));
+  EXPECT_EQ(stamp, network.topologyStamp());
+
+  EXPECT_TRUE(network.disconnect(connId));
+  EXPECT_NE(stamp, network.topologyStamp());
+
+  stamp = network.topologyStamp();
+  network.clear();
+  EXPECT_NE(stamp, network.topologyStamp());
+  EXPECT_FALSE(network.lookupModule(m1->get_id()));
+}
+
 /// @todo: this verification pushed up to higher layer.
 TEST_F(NetworkTests, DISABLED_ConnectionsMustHaveMatchingPortTypes)
 {
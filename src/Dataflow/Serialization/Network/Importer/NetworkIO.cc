@@ -152,15 +152,8 @@ const std::string &y)
 
   const std::string cmodule = checkForModuleRename(moduleNameOrig);
 
-  std::vector<int> existingIdsWithThisModuleName;
-  boost::copy(moduleIdMap_
-    | boost::adaptors::map_values
-    | boost::adaptors::filtered([&](const ModuleId& mid) { return mid.name_ == cmodule; })
-    | boost::adaptors::transformed([&](const ModuleId& mid) { return mid.idNumber_; }),
-    std::back_inserter(existingIdsWithThisModuleName));
-  int nextId = 0;
-  if (!existingIdsWithThisModuleName.empty())
-    nextId = *std::max_element(existingIdsWithThisModuleName.begin(), existingIdsWithThisModuleName.end()) + 1;
+  // Ids per module name are handed out in increasing order, so the next free one is a counter lookup.
+  int nextId = nextModuleIdNumber_[cmodule]++;
   moduleIdMap_[mod_id] = ModuleId(cmodule, nextId);
 
   ModuleLookupInfoXML& mod = xmlData_->network.modules[moduleIdMap_[mod_id]].module;
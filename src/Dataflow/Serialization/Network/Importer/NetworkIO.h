@@ -36,6 +36,7 @@
 #include <Core/Algorithms/Base/Variable.h>
 #include <libxml/xmlreader.h>
 #include <map>
+#include <unordered_map>
 #include <stack>
 
 #include <Dataflow/Serialization/Network/Importer/share.h>
@@ -171,6 +172,7 @@ namespace Networks {
     std::ostringstream& simpleLog_;
     const Networks::ModuleFactory& modFactory_;
     std::map<std::string, ModuleId> moduleIdMap_;
+    std::unordered_map<std::string, int> nextModuleIdNumber_;
     std::map<std::string, std::string> connectionIdMap_;
     static const std::map<std::string, std::string> moduleRenameMap_;
     static NameLookup nameLookup_;
@@ -0,0 +1,267 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Dataflow/Serialization/Network/NetworkFileDelta.h>
+#include <algorithm>
+#include <functional>
+
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Dataflow::State;
+using namespace SCIRun::Core::Algorithms;
+
+namespace
+{
+  bool sameState(const SimpleMapModuleStateXML& lhs, const SimpleMapModuleStateXML& rhs)
+  {
+    auto keys = lhs.getKeys();
+    if (keys != rhs.getKeys())
+      return false;
+    for (const auto& key : keys)
+    {
+      if (lhs.getValue(key) != rhs.getValue(key))
+        return false;
+    }
+    return true;
+  }
+
+  bool sameModule(const ModuleWithState& lhs, const ModuleWithState& rhs)
+  {
+    return lhs.module == rhs.module && sameState(lhs.state, rhs.state);
+  }
+
+  bool sameNotes(const NotesMapXML& lhs, const NotesMapXML& rhs)
+  {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+      [](const NotesMapXML::value_type& l, const NotesMapXML::value_type& r)
+      {
+        return l.first == r.first && l.second.noteHTML == r.second.noteHTML && l.second.noteText == r.second.noteText
+          && l.second.position == r.second.position && l.second.fontSize == r.second.fontSize;
+      });
+  }
+
+  bool sameTags(const ModuleTags& lhs, const ModuleTags& rhs)
+  {
+    return lhs.tags == rhs.tags && lhs.labels == rhs.labels && lhs.showTagGroupsOnLoad == rhs.showTagGroupsOnLoad;
+  }
+
+  bool sameDisabled(const DisabledComponents& lhs, const DisabledComponents& rhs)
+  {
+    return lhs.disabledModules == rhs.disabledModules && lhs.disabledConnections == rhs.disabledConnections;
+  }
+
+  template <class Map, class Equal>
+  void diffMaps(const Map& from, const Map& to, Map& changed, std::vector<std::string>& removed, Equal equal)
+  {
+    for (const auto& entry : to)
+    {
+      auto old = from.find(entry.first);
+      if (old == from.end() || !equal(old->second, entry.second))
+        changed.insert(entry);
+    }
+    for (const auto& entry : from)
+    {
+      if (to.find(entry.first) == to.end())
+        removed.push_back(entry.first);
+    }
+  }
+
+  template <class Map>
+  void applyMapDiff(Map& target, const Map& changed, const std::vector<std::string>& removed)
+  {
+    for (const auto& key : removed)
+      target.erase(key);
+    for (const auto& entry : changed)
+      target[entry.first] = entry.second;
+  }
+
+  template <class T, class Equal = std::equal_to<T>>
+  void setIfChanged(boost::optional<T>& slot, const T& from, const T& to, Equal equal = Equal())
+  {
+    if (!equal(from, to))
+      slot = to;
+  }
+
+  size_t sizeOf(const std::string& str)
+  {
+    return sizeof(std::string) + str.capacity();
+  }
+
+  class VariableSizeVisitor : public boost::static_visitor<size_t>
+  {
+  public:
+    size_t operator()(const std::string& str) const { return str.capacity(); }
+    size_t operator()(const AlgoOption& opt) const
+    {
+      size_t size = opt.option_.capacity();
+      for (const auto& o : opt.options_)
+        size += sizeOf(o);
+      return size;
+    }
+    size_t operator()(const Variable::List& list) const
+    {
+      size_t size = 0;
+      for (const auto& v : list)
+        size += sizeof(Variable) + v.name().name().capacity() + boost::apply_visitor(*this, v.value());
+      return size;
+    }
+    template <typename T>
+    size_t operator()(const T&) const { return 0; }
+  };
+
+  size_t sizeOf(const ModuleWithState& mod)
+  {
+    size_t size = sizeof(ModuleWithState) + mod.module.module_name_.capacity()
+      + mod.module.category_name_.capacity() + mod.module.package_name_.capacity();
+    for (const auto& key : mod.state.getKeys())
+    {
+      auto value = mod.state.getValue(key);
+      size += sizeof(Variable) + key.name().capacity() + boost::apply_visitor(VariableSizeVisitor(), value.value());
+    }
+    return size;
+  }
+
+  size_t sizeOf(const ConnectionsXML& connections)
+  {
+    size_t size = 0;
+    for (const auto& c : connections)
+    {
+      size += sizeof(ConnectionDescriptionXML) + c.out_.moduleId_.id_.capacity() + c.in_.moduleId_.id_.capacity()
+        + c.out_.portId_.name.capacity() + c.in_.portId_.name.capacity();
+    }
+    return size;
+  }
+
+  size_t sizeOf(const NotesMapXML& notes)
+  {
+    size_t size = 0;
+    for (const auto& note : notes)
+      size += sizeOf(note.first) + sizeof(NoteXML) + note.second.noteHTML.capacity() + note.second.noteText.capacity();
+    return size;
+  }
+
+  size_t sizeOf(const std::vector<std::string>& strings)
+  {
+    size_t size = 0;
+    for (const auto& s : strings)
+      size += sizeOf(s);
+    return size;
+  }
+
+  size_t sizeOf(const ModuleTags& tags)
+  {
+    size_t size = tags.tags.size() * (sizeof(std::string) + sizeof(int));
+    for (const auto& label : tags.labels)
+      size += sizeof(int) + sizeOf(label.second);
+    return size;
+  }
+
+  size_t sizeOf(const DisabledComponents& disabled)
+  {
+    return sizeOf(disabled.disabledModules) + sizeOf(disabled.disabledConnections);
+  }
+
+  size_t sizeOf(const SubnetworkMap& subnets)
+  {
+    size_t size = 0;
+    for (const auto& subnet : subnets)
+      size += sizeOf(subnet.first) + sizeOf(subnet.second);
+    return size;
+  }
+
+  // Rough per-node overhead of the std::map containers used throughout NetworkFile.
+  const size_t mapNodeOverhead = 4 * sizeof(void*);
+
+  template <class T>
+  size_t sizeOf(const boost::optional<T>& opt)
+  {
+    return opt ? sizeOf(*opt) : 0;
+  }
+}
+
+bool NetworkFileDelta::empty() const
+{
+  return modulesChanged.empty() && modulesRemoved.empty() && positionsChanged.empty() && positionsRemoved.empty()
+    && !connections && !moduleNotes && !connectionNotes && !moduleTags && !disabledComponents && !subnetworks;
+}
+
+NetworkFileDelta SCIRun::Dataflow::Networks::diffNetworkFiles(const NetworkFile& from, const NetworkFile& to)
+{
+  NetworkFileDelta delta;
+  diffMaps(from.network.modules, to.network.modules, delta.modulesChanged, delta.modulesRemoved, sameModule);
+  diffMaps(from.modulePositions.modulePositions, to.modulePositions.modulePositions, delta.positionsChanged, delta.positionsRemoved,
+    std::equal_to<ModulePositions::Data::mapped_type>());
+  setIfChanged(delta.connections, from.network.connections, to.network.connections);
+  setIfChanged(delta.moduleNotes, from.moduleNotes.notes, to.moduleNotes.notes, sameNotes);
+  setIfChanged(delta.connectionNotes, from.connectionNotes.notes, to.connectionNotes.notes, sameNotes);
+  setIfChanged(delta.moduleTags, from.moduleTags, to.moduleTags, sameTags);
+  setIfChanged(delta.disabledComponents, from.disabledComponents, to.disabledComponents, sameDisabled);
+  setIfChanged(delta.subnetworks, from.subnetworks.subnets, to.subnetworks.subnets);
+  return delta;
+}
+
+void SCIRun::Dataflow::Networks::applyNetworkFileDelta(NetworkFile& file, const NetworkFileDelta& delta)
+{
+  applyMapDiff(file.network.modules, delta.modulesChanged, delta.modulesRemoved);
+  applyMapDiff(file.modulePositions.modulePositions, delta.positionsChanged, delta.positionsRemoved);
+  if (delta.connections)
+    file.network.connections = *delta.connections;
+  if (delta.moduleNotes)
+    file.moduleNotes.notes = *delta.moduleNotes;
+  if (delta.connectionNotes)
+    file.connectionNotes.notes = *delta.connectionNotes;
+  if (delta.moduleTags)
+    file.moduleTags = *delta.moduleTags;
+  if (delta.disabledComponents)
+    file.disabledComponents = *delta.disabledComponents;
+  if (delta.subnetworks)
+    file.subnetworks.subnets = *delta.subnetworks;
+}
+
+size_t SCIRun::Dataflow::Networks::estimatedMemorySize(const NetworkFile& file)
+{
+  size_t size = sizeof(NetworkFile);
+  for (const auto& mod : file.network.modules)
+    size += mapNodeOverhead + sizeOf(mod.first) + sizeOf(mod.second);
+  size += file.modulePositions.modulePositions.size() * (mapNodeOverhead + sizeof(std::string) + 2 * sizeof(double));
+  size += sizeOf(file.network.connections);
+  size += sizeOf(file.moduleNotes.notes) + sizeOf(file.connectionNotes.notes);
+  size += sizeOf(file.moduleTags) + sizeOf(file.disabledComponents) + sizeOf(file.subnetworks.subnets);
+  return size;
+}
+
+size_t SCIRun::Dataflow::Networks::estimatedMemorySize(const NetworkFileDelta& delta)
+{
+  size_t size = sizeof(NetworkFileDelta);
+  for (const auto& mod : delta.modulesChanged)
+    size += mapNodeOverhead + sizeOf(mod.first) + sizeOf(mod.second);
+  size += sizeOf(delta.modulesRemoved) + sizeOf(delta.positionsRemoved);
+  size += delta.positionsChanged.size() * (mapNodeOverhead + sizeof(std::string) + 2 * sizeof(double));
+  size += sizeOf(delta.connections) + sizeOf(delta.moduleNotes) + sizeOf(delta.connectionNotes);
+  size += sizeOf(delta.moduleTags) + sizeOf(delta.disabledComponents) + sizeOf(delta.subnetworks);
+  return size;
+}
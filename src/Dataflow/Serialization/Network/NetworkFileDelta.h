@@ -0,0 +1,70 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_SERIALIZATION_NETWORK_NETWORK_FILE_DELTA_H
+#define CORE_SERIALIZATION_NETWORK_NETWORK_FILE_DELTA_H
+
+#include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
+#include <boost/optional.hpp>
+#include <Dataflow/Serialization/Network/share.h>
+
+namespace SCIRun {
+namespace Dataflow {
+namespace Networks {
+
+  /// Structural difference between two NetworkFile snapshots. Modules and positions are diffed
+  /// per id; the smaller id-keyed sections (connections, notes, tags, ...) are stored whole, and only
+  /// when they changed.
+  struct SCISHARE NetworkFileDelta
+  {
+    ModuleMapXML modulesChanged;
+    std::vector<std::string> modulesRemoved;
+    ModulePositions::Data positionsChanged;
+    std::vector<std::string> positionsRemoved;
+    boost::optional<ConnectionsXML> connections;
+    boost::optional<NotesMapXML> moduleNotes;
+    boost::optional<NotesMapXML> connectionNotes;
+    boost::optional<ModuleTags> moduleTags;
+    boost::optional<DisabledComponents> disabledComponents;
+    boost::optional<SubnetworkMap> subnetworks;
+
+    bool empty() const;
+  };
+
+  /// Returns the delta that turns from into to.
+  SCISHARE NetworkFileDelta diffNetworkFiles(const NetworkFile& from, const NetworkFile& to);
+  /// Applies delta to file in place, so a chain of deltas can be replayed on one working copy.
+  SCISHARE void applyNetworkFileDelta(NetworkFile& file, const NetworkFileDelta& delta);
+
+  /// Approximate heap footprint in bytes, used to enforce provenance memory limits.
+  SCISHARE size_t estimatedMemorySize(const NetworkFile& file);
+  SCISHARE size_t estimatedMemorySize(const NetworkFileDelta& delta);
+
+}}}
+
+#endif
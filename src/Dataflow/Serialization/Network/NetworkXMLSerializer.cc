@@ -84,7 +84,7 @@ NetworkHandle NetworkXMLConverter::from_xml_data(const NetworkXML& data)
       try
       {
         auto module = controller_->addModule(modPair.second.module);
-        module->set_id(modPair.first);
+        network->setModuleId(module, ModuleId(modPair.first));
         ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
         module->set_state(state);
       }
@@ -136,7 +136,7 @@ NetworkXMLConverter::NetworkAppendInfo NetworkXMLConverter::appendXmlData(const
 
       //std::cout << "setting module id to " << newId << std::endl;
       info.moduleIdMapping[modPair.first] = newId;
-      module->set_id(newId);
+      network->setModuleId(module, newId);
       ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
       module->set_state(state);
     }
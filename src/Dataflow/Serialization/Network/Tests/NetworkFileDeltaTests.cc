@@ -0,0 +1,101 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Dataflow/Serialization/Network/NetworkFileDelta.h>
+#include <Dataflow/Network/ConnectionId.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Dataflow::State;
+using namespace SCIRun::Core::Algorithms;
+
+namespace
+{
+  NetworkFile twoModuleNetwork()
+  {
+    NetworkFile file;
+    SimpleMapModuleStateXML state;
+    state.setValue(Name("Rows"), 3);
+    file.network.modules["CreateMatrix:1"] = ModuleWithState(ModuleLookupInfoXML(), state);
+    file.network.modules["ReportMatrixInfo:2"] = ModuleWithState(ModuleLookupInfoXML());
+    file.modulePositions.modulePositions["CreateMatrix:1"] = std::make_pair(0.0, 0.0);
+    file.modulePositions.modulePositions["ReportMatrixInfo:2"] = std::make_pair(0.0, 100.0);
+    return file;
+  }
+}
+
+TEST(NetworkFileDeltaTests, IdenticalFilesGiveEmptyDelta)
+{
+  auto file = twoModuleNetwork();
+  EXPECT_TRUE(diffNetworkFiles(file, file).empty());
+}
+
+TEST(NetworkFileDeltaTests, DeltaOnlyHoldsChangedModules)
+{
+  auto from = twoModuleNetwork();
+  auto to = from;
+  to.network.modules["CreateMatrix:1"].state.setValue(Name("Rows"), 4);
+  to.network.modules.erase("ReportMatrixInfo:2");
+  to.modulePositions.modulePositions.erase("ReportMatrixInfo:2");
+
+  auto delta = diffNetworkFiles(from, to);
+  EXPECT_EQ(1, delta.modulesChanged.size());
+  EXPECT_EQ(1, delta.modulesChanged.count("CreateMatrix:1"));
+  EXPECT_EQ(std::vector<std::string>{ "ReportMatrixInfo:2" }, delta.modulesRemoved);
+  EXPECT_EQ(std::vector<std::string>{ "ReportMatrixInfo:2" }, delta.positionsRemoved);
+  EXPECT_TRUE(delta.positionsChanged.empty());
+  EXPECT_FALSE(delta.connections);
+  EXPECT_FALSE(delta.moduleNotes);
+}
+
+TEST(NetworkFileDeltaTests, ApplyingDeltaReproducesTarget)
+{
+  auto from = twoModuleNetwork();
+  auto to = from;
+  ConnectionDescriptionXML conn;
+  conn.out_.moduleId_ = ModuleId("CreateMatrix:1");
+  conn.in_.moduleId_ = ModuleId("ReportMatrixInfo:2");
+  conn.out_.portId_ = PortId(0, "EnteredMatrix");
+  conn.in_.portId_ = PortId(0, "InputMatrix");
+  to.network.connections.push_back(conn);
+  to.modulePositions.modulePositions["CreateMatrix:1"].first = 50;
+  to.moduleNotes.notes["CreateMatrix:1"] = NoteXML("<b>note</b>", 1, "note");
+
+  auto delta = diffNetworkFiles(from, to);
+  auto result = from;
+  applyNetworkFileDelta(result, delta);
+  EXPECT_TRUE(diffNetworkFiles(result, to).empty());
+  EXPECT_EQ(1, result.network.connections.size());
+  EXPECT_EQ(50.0, result.modulePositions.modulePositions["CreateMatrix:1"].first);
+  EXPECT_EQ("note", result.moduleNotes.notes["CreateMatrix:1"].noteText);
+
+  auto reverse = diffNetworkFiles(to, from);
+  applyNetworkFileDelta(result, reverse);
+  EXPECT_TRUE(diffNetworkFiles(result, from).empty());
+}
@@ -108,6 +108,15 @@ GLuint VBOMan::addInMemoryVBO(void* vboData, size_t vboDataSize,
   return glid;
 }
 
+void VBOMan::removeInMemoryVBO(GLuint glid)
+{
+  auto iter = mVBOData.find(glid);
+  if (iter != mVBOData.end())
+    mVBOData.erase(iter);
+
+  GL(glDeleteBuffers(1, &glid));
+}
+
 //------------------------------------------------------------------------------
 // GARBAGE COLLECTION
 //------------------------------------------------------------------------------
@@ -57,14 +57,15 @@ public:
 
   /// Sets up this class 'ShaderVBOAttribs' such that it attributes can be
   /// applied before rendering.
-  void setup(GLuint vboID, GLuint shaderID, const StaticVBOMan& vboMan)
+  void setup(GLuint vboID, GLuint shaderID, const StaticVBOMan& vboMan, bool partial = false)
   {
-    setup(vboID, shaderID, *(vboMan.instance_));
+    setup(vboID, shaderID, *(vboMan.instance_), partial);
   }
 
   /// Sets up this class 'ShaderVBOAttribs' such that it attributes can be
-  /// applied before rendering.
-  void setup(GLuint vboID, GLuint shaderID, const VBOMan& vboMan)
+  /// applied before rendering. Set \p partial when the VBO only holds some
+  /// of the shader's attributes and another VBO holds the rest.
+  void setup(GLuint vboID, GLuint shaderID, const VBOMan& vboMan, bool partial = false)
   {
     /// NOTE: If this statement proves to be a performance problem (because
     ///       we are looking up the shader's attributes using OpenGL), then
@@ -78,7 +79,7 @@ public:
     std::vector<spire::ShaderAttribute> vboAttribs =
         vboMan.getVBOAttributes(vboID);
 
-    if (vboAttribs.size() < attribs.size())
+    if (!partial && vboAttribs.size() < attribs.size())
     {
       std::cerr << "ren::RenderSimpleGeom: Unable to satisfy shader! Not enough attributes." << std::endl;
     }
@@ -31,12 +31,7 @@ void VarBuffer::clear()
 void VarBuffer::writeBytes(const char* bytes, size_t numBytes)
 {
   RENDERER_LOG("VarBuffer writeBytes (bytes {}, numBytes {})", bytes, numBytes);
-  // Resize the buffer if necessary.
-  while (mSerializer->getOffset() + numBytes > mBufferSize)
-  {
-    resize();
-  }
-
+  reserve(numBytes);
   mSerializer->writeBytes(bytes, numBytes);
 }
 
@@ -47,21 +42,28 @@ void VarBuffer::writeNullTermString(const char* str)
 
   size_t stringLength = std::strlen(str);
 
-  // Resize the buffer if necessary.
-  while (mSerializer->getOffset() + stringLength + 1 > mBufferSize)
-  {
-    resize();
-  }
-
+  reserve(stringLength + 1);
   mSerializer->writeNullTermString(str);
 }
 
-void VarBuffer::resize()
+void VarBuffer::reserve(size_t numBytes)
 {
-  mBufferSize *= 2;
-  mBuffer.resize(mBufferSize);
+  const size_t required = mSerializer->getOffset() + numBytes;
+  if (required <= static_cast<size_t>(mBufferSize))
+    return;
+
+  size_t newSize = mBufferSize > 0 ? static_cast<size_t>(mBufferSize) : 1024;
+  while (newSize < required)
+    newSize *= 2;
+  reallocate(newSize);
+}
+
+void VarBuffer::reallocate(size_t newSize)
+{
+  RENDERER_LOG("VarBuffer resize (oldSize {}, newSize {})", mBufferSize, newSize);
 
-  RENDERER_LOG("VarBuffer resize (oldSize {}, newSize {})", mBufferSize/2, mBufferSize);
+  mBufferSize = static_cast<int>(newSize);
+  mBuffer.resize(mBufferSize);
 
   // Record offset before we destroy and recreate the serializer.
   size_t bufferOffset = mSerializer->getOffset();
@@ -3,7 +3,9 @@
 
 #include <es-log/trace-log.h>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <vector>
 #include <bserialize/BSerialize.hpp>
 #include <spire/scishare.h>
@@ -34,12 +36,35 @@ public:
   template <typename T>
   void write(const T& val)
   {
-    // Attempt to write the value to BSerialize. If a runtime exception is
-    // caught, then we need to resize the buffer.
-    while (mSerializer->write(val) == false)
-    {
-      resize();
-    }
+    reserve(serializedSize(val));
+    mSerializer->write(val);
+  }
+
+  /// Makes room for at least \p numBytes past the current write position.
+  /// The buffer grows once to the required size instead of doubling on every
+  /// failed write.
+  void reserve(size_t numBytes);
+
+  /// Writes \p count values starting at \p vals with a single bounds check.
+  template <typename T>
+  void writeSpan(const T* vals, size_t count)
+  {
+    if (count > 0)
+      writeBytes(reinterpret_cast<const char*>(vals), count * sizeof(T));
+  }
+
+  /// Appends room for \p count values of type T and returns a pointer to the
+  /// start of that range. The caller fills the range directly; disjoint parts
+  /// of it may be filled from different threads. The pointer stays valid
+  /// until the next write that grows the buffer.
+  template <typename T>
+  T* allocate(size_t count)
+  {
+    const size_t numBytes = count * sizeof(T);
+    reserve(numBytes);
+    const size_t offset = mSerializer->getOffset();
+    mSerializer->setOffset(offset + numBytes);
+    return reinterpret_cast<T*>(getBuffer() + offset);
   }
 
   /// Clears all data currently written to the var buffer.
@@ -57,7 +82,16 @@ public:
 
 private:
 
-  void resize();
+  void reallocate(size_t newSize);
+
+  /// Bytes BSerialize writes for a value; strings carry a length prefix and
+  /// a null terminator.
+  template <typename T>
+  static size_t serializedSize(const T&) {return sizeof(T);}
+  static size_t serializedSize(const char* str)
+  {return sizeof(int32_t) + (str ? std::strlen(str) : 0) + 1;}
+  static size_t serializedSize(const std::string& str)
+  {return sizeof(int32_t) + str.size() + 1;}
 
   static bool serializeFloat(char* msg, int msgLen, int* offset_out, float in);
 
@@ -82,7 +82,7 @@ namespace SCIRun {
           bool        normalize;
         };
 
-        SpireVBO() : numElements(0), onGPU(false) {}
+        SpireVBO() : numElements(0), onGPU(false), version(0) {}
         SpireVBO(const std::string& vboName, const std::vector<AttributeData> attribs,
           std::shared_ptr<spire::VarBuffer> vboData,
           int64_t numVBOElements, const Core::Geometry::BBox& bbox, bool placeOnGPU) :
@@ -91,7 +91,8 @@ namespace SCIRun {
           data(vboData),
           numElements(numVBOElements),
           boundingBox(bbox),
-          onGPU(placeOnGPU)
+          onGPU(placeOnGPU),
+          version(0)
         {}
 
         std::string                           name;
@@ -100,6 +101,9 @@ namespace SCIRun {
         int64_t                               numElements;
         Core::Geometry::BBox                  boundingBox;
         bool                                  onGPU;
+        /// Bumped by the producer whenever the contents under this name change.
+        /// The renderer keeps an uploaded buffer while name, data and version match.
+        uint64_t                              version;
       };
 
       struct SpireIBO
@@ -177,6 +181,7 @@ namespace SCIRun {
 
         std::string   passName;
         std::string   vboName;
+        std::string   colorVboName; ///< Optional second VBO holding only the color attributes.
         std::string   iboName;
         std::string   programName;
         RenderState   renderState;
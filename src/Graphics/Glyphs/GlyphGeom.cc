@@ -29,6 +29,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Graphics/Glyphs/GlyphGeom.h>
 #include <Core/Math/MiscMath.h>
 #include <Core/GeometryPrimitives/Transform.h>
+#include <Core/Thread/Parallel.h>
 
 using namespace SCIRun;
 using namespace Graphics;
@@ -157,31 +158,50 @@ void GlyphGeom::buildObject(GeometryHandle geom, const std::string& uniqueNodeID
 
   //write to the IBO/VBOs
 
-  for (auto a : indices_)
-    iboBuffer->write(a);
+  iboBuffer->writeSpan(indices_.data(), indices_.size());
 
-  for (size_t i = 0; i < points_.size(); i++)
+  const bool writeNormals = normals_.size() == points_.size();
+  const bool writeColors = colorScheme == ColorScheme::COLOR_MAP || colorScheme == ColorScheme::COLOR_IN_SITU;
+  const size_t stride = 3 + (writeNormals ? 3 : 0) + (writeColors ? 4 : 0);
+  float* vbo = vboBuffer->allocate<float>(points_.size() * stride);
+
+  // Every vertex owns a fixed slice of the VBO, so the slices are filled
+  // in parallel for large glyph sets.
+  const size_t numPoints = points_.size();
+  const int numProcs = numPoints > 65536 ? static_cast<int>(Core::Thread::Parallel::NumCores()) : 1;
+  auto fill = [&](int proc)
   {
-    // Write first point on line
-    vboBuffer->write(static_cast<float>(points_.at(i).x()));
-    vboBuffer->write(static_cast<float>(points_.at(i).y()));
-    vboBuffer->write(static_cast<float>(points_.at(i).z()));
-    // Write normal
-    if (normals_.size() == points_.size())
+    const size_t start = proc * numPoints / numProcs;
+    const size_t end = (proc + 1) * numPoints / numProcs;
+    float* out = vbo + start * stride;
+    for (size_t i = start; i < end; i++)
     {
-      vboBuffer->write(static_cast<float>(normals_.at(i).x()));
-      vboBuffer->write(static_cast<float>(normals_.at(i).y()));
-      vboBuffer->write(static_cast<float>(normals_.at(i).z()));
+      const Vector& p = points_[i];
+      *out++ = static_cast<float>(p.x());
+      *out++ = static_cast<float>(p.y());
+      *out++ = static_cast<float>(p.z());
+      if (writeNormals)
+      {
+        const Vector& n = normals_[i];
+        *out++ = static_cast<float>(n.x());
+        *out++ = static_cast<float>(n.y());
+        *out++ = static_cast<float>(n.z());
+      }
+      if (writeColors)
+      {
+        const ColorRGB& c = colors_[i];
+        *out++ = static_cast<float>(c.r());
+        *out++ = static_cast<float>(c.g());
+        *out++ = static_cast<float>(c.b());
+        *out++ = static_cast<float>(c.a());
+      } // no color writing otherwise
     }
-    if (colorScheme == ColorScheme::COLOR_MAP || colorScheme == ColorScheme::COLOR_IN_SITU)
-    {
-      vboBuffer->write(static_cast<float>(colors_.at(i).r()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).g()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).b()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).a()));
-      //vboBuffer->write(static_cast<float>(1.f));
-    } // no color writing otherwise
-  }
+  };
+
+  if (numProcs > 1)
+    Core::Thread::Parallel::RunTasks(fill, numProcs);
+  else
+    fill(0);
 
   // If true, then the VBO will be placed on the GPU. We don't want to place
   // VBOs on the GPU when we are generating rendering lists.
@@ -64,6 +64,8 @@ CommandHandle GuiGlobalCommandFactory::create(GlobalCommands type) const
     return boost::make_shared<ExecuteCurrentNetworkCommandGui>();
   case GlobalCommands::DisableViewScenes:
     return boost::make_shared<DisableViewScenesCommandGui>();
+  case GlobalCommands::RunParameterSweep:
+    return boost::make_shared<RunParameterSweepCommandConsole>();
   case GlobalCommands::InteractiveMode:
     return boost::make_shared<InteractiveModeCommandConsole>();
   case GlobalCommands::SetupQuitAfterExecute:
@@ -83,15 +83,6 @@ public:
     QListWidgetItem(QString::fromStdString(info->name()), parent),
     info_(info)
   {
-    auto xml = info_->memento();
-    if (xml)
-    {
-      std::ostringstream ostr;
-      XMLSerializer::save_xml(*xml, ostr, "networkFile");
-      xmlText_ = QString::fromStdString(ostr.str());
-    }
-    else
-      xmlText_ = "<Unknown state for this item>";
   }
   void setAsUndo()
   {
@@ -107,8 +98,21 @@ public:
     setFont(f);
     setBackgroundColor(Qt::lightGray);
   }
+  // Serialized on demand: items may only hold a delta, and most are never displayed.
   QString xmlText() const
   {
+    if (xmlText_.isEmpty())
+    {
+      auto xml = info_->memento();
+      if (xml)
+      {
+        std::ostringstream ostr;
+        XMLSerializer::save_xml(*xml, ostr, "networkFile");
+        xmlText_ = QString::fromStdString(ostr.str());
+      }
+      else
+        xmlText_ = "<Unknown state for this item>";
+    }
     return xmlText_;
   }
   std::string name() const
@@ -117,7 +121,7 @@ public:
   }
 private:
   ProvenanceItemHandle info_;
-  QString xmlText_;
+  mutable QString xmlText_;
 };
 
 void ProvenanceWindow::addProvenanceItem(ProvenanceItemHandle item)
@@ -202,7 +206,7 @@ void ProvenanceWindow::undo()
       auto undone = provenanceManager_->undo();
       Q_EMIT modifyingNetwork(false);
       Q_EMIT networkModified();
-      if (undone->name() != provenanceItem->name())
+      if (!undone || undone->name() != provenanceItem->name())
         std::cout << "Inconsistency in provenance items. TODO: emit logical error here." << std::endl;
     }
 
@@ -230,7 +234,7 @@ void ProvenanceWindow::redo()
       auto redone = provenanceManager_->redo();
       Q_EMIT modifyingNetwork(false);
       Q_EMIT networkModified();
-      if (redone->name() != provenanceItem->name())
+      if (!redone || redone->name() != provenanceItem->name())
         std::cout << "Inconsistency in provenance items. TODO: emit logical error here." << std::endl;
     }
 
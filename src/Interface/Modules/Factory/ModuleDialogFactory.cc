@@ -44,6 +44,8 @@
 #include <Interface/Modules/Math/ReportColumnMatrixMisfitDialog.h>
 #include <Interface/Modules/Math/SelectSubMatrixDialog.h>
 #include <Interface/Modules/Math/ConvertMatrixTypeDialog.h>
+#include <Interface/Modules/Math/ComputeSVDDialog.h>
+#include <Interface/Modules/Math/ComputePCADialog.h>
 #include <Interface/Modules/Math/GetMatrixSliceDialog.h>
 #include <Interface/Modules/Math/BuildNoiseColumnMatrixDialog.h>
 #include <Interface/Modules/Math/CollectMatricesDialog.h>
@@ -161,6 +163,8 @@ void ModuleDialogFactory::addDialogsToMakerMap1()
     ADD_MODULE_DIALOG(GetFieldsFromBundle, GetFieldsFromBundleDialog)
     ADD_MODULE_DIALOG(SplitFieldByDomain, SplitFieldByDomainDialog)
     ADD_MODULE_DIALOG(ConvertMatrixType, ConvertMatrixTypeDialog)
+    ADD_MODULE_DIALOG(ComputeSVD, ComputeSVDDialog)
+    ADD_MODULE_DIALOG(ComputePCA, ComputePCADialog)
     ADD_MODULE_DIALOG(MapFieldDataFromNodeToElem, MapFieldDataFromNodeToElemDialog)
     ADD_MODULE_DIALOG(ResampleRegularMesh, ResampleRegularMeshDialog)
     ADD_MODULE_DIALOG(FairMesh, FairMeshDialog)
@@ -53,6 +53,7 @@ namespace SCIRun {
         solverNameLookup_.insert(StringPair("BiConjugate Gradient (SCI)", "bicg"));
         solverNameLookup_.insert(StringPair("Jacobi (SCI)", "jacobi"));
         solverNameLookup_.insert(StringPair("MINRES (SCI)", "minres"));
+        solverNameLookup_.insert(StringPair("LDL^T direct, cached factorization (SCI)", "ldlt"));
       }
       GuiStringTranslationMap solverNameLookup_;
     };
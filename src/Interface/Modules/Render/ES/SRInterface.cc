@@ -795,6 +795,7 @@ namespace SCIRun {
         if (std::shared_ptr<ren::IBOMan> iboMan = im.lock())
         {
           DEBUG_LOG_LINE_INFO
+          bool replacingObject = false;
           if (foundObject != mSRObjects.end())
           {
             DEBUG_LOG_LINE_INFO
@@ -811,19 +812,40 @@ namespace SCIRun {
               "old entities from the system.");
             mCore.renormalize(true);
 
-            RENDERER_LOG("Run a garbage collection cycle for the VBOs and IBOs. We will likely"
-              " be using similar VBO and IBO names.");
-            vboMan->runGCCycle(mCore);
-            iboMan->runGCCycle(mCore);
-
-            RENDERER_LOG("Remove the object from the entity system.");
+            RENDERER_LOG("Remove the object from the entity system. Its VBOs and IBOs are"
+              " collected once the new passes hold the ones they still use.");
             mSRObjects.erase(foundObject);
+            replacingObject = true;
           }
 
+          // Buffers keep their GL object when the same data, at the same
+          // version, was last uploaded under their name and is still on the
+          // GPU. Otherwise older buffers of that name are dropped, so that
+          // the passes below find the new one.
+          auto isUploaded = [](const std::map<std::string, UploadedBuffer>& uploaded,
+            const std::string& name, const std::shared_ptr<spire::VarBuffer>& data,
+            uint64_t version, GLuint glid)
+          {
+            auto it = uploaded.find(name);
+            return glid != 0 && it != uploaded.end() && it->second.glid == glid
+              && it->second.version == version && it->second.data.lock() == data;
+          };
+          auto recordUpload = [](std::map<std::string, UploadedBuffer>& uploaded,
+            const std::string& name, const std::shared_ptr<spire::VarBuffer>& data,
+            uint64_t version, GLuint glid)
+          {
+            UploadedBuffer& upload = uploaded[name];
+            upload.data = data;
+            upload.version = version;
+            upload.glid = glid;
+          };
+
           DEBUG_LOG_LINE_INFO
           RENDERER_LOG("Add vertex buffer objects.");
           std::vector<char*> vbo_buffer;
           std::vector<size_t> stride_vbo;
+          std::vector<std::string> vbo_names;
+          std::set<std::string> keptVBOs;
 
           int nameIndex = 0;
           for (auto it = obj->mVBOs.cbegin(); it != obj->mVBOs.cend(); ++it, ++nameIndex)
@@ -832,16 +854,29 @@ namespace SCIRun {
 
             if (vbo.onGPU)
             {
-              RENDERER_LOG("Generate vector of attributes to pass into the entity system: {}, {}", nameIndex, vbo.name);
-              std::vector<std::tuple<std::string, size_t, bool>> attributeData;
-              for (const auto& attribData : vbo.attributes)
+              if (isUploaded(mUploadedVBOs, vbo.name, vbo.data, vbo.version, vboMan->hasVBO(vbo.name)))
               {
-                attributeData.push_back(std::make_tuple(attribData.name, attribData.sizeInBytes, attribData.normalize));
+                RENDERER_LOG("Keep vertex buffer {}, its data did not change.", vbo.name);
+                keptVBOs.insert(vbo.name);
               }
+              else
+              {
+                while (GLuint stale = vboMan->hasVBO(vbo.name))
+                  vboMan->removeInMemoryVBO(stale);
 
-              vboMan->addInMemoryVBO(vbo.data->getBuffer(), vbo.data->getBufferSize(), attributeData, vbo.name);
+                RENDERER_LOG("Generate vector of attributes to pass into the entity system: {}, {}", nameIndex, vbo.name);
+                std::vector<std::tuple<std::string, size_t, bool>> attributeData;
+                for (const auto& attribData : vbo.attributes)
+                {
+                  attributeData.push_back(std::make_tuple(attribData.name, attribData.sizeInBytes, attribData.normalize));
+                }
+
+                GLuint glid = vboMan->addInMemoryVBO(vbo.data->getBuffer(), vbo.data->getBufferSize(), attributeData, vbo.name);
+                recordUpload(mUploadedVBOs, vbo.name, vbo.data, vbo.version, glid);
+              }
             }
 
+            vbo_names.push_back(vbo.name);
             vbo_buffer.push_back(reinterpret_cast<char*>(vbo.data->getBuffer()));
             size_t stride = 0;
             for (auto a : vbo.attributes)
@@ -857,6 +892,37 @@ namespace SCIRun {
           for (auto it = obj->mIBOs.cbegin(); it != obj->mIBOs.cend(); ++it, ++nameIndex)
           {
             const auto& ibo = *it;
+            bool listsSort = mRenderSortType == RenderState::TransparencySortType::LISTS_SORT;
+
+            // Positions for sorting come from the VBO of the pass that draws
+            // this IBO. A separate color VBO shifts the VBO list, so the
+            // position of the IBO in its list is only the fallback.
+            size_t vboIndex = nameIndex;
+            auto drawingPass = std::find_if(obj->mPasses.begin(), obj->mPasses.end(),
+              [&ibo](const SpireSubPass& pass) { return pass.iboName == ibo.name; });
+            if (drawingPass != obj->mPasses.end())
+            {
+              auto vboName = std::find(vbo_names.begin(), vbo_names.end(), drawingPass->vboName);
+              if (vboName != vbo_names.end())
+                vboIndex = vboName - vbo_names.begin();
+            }
+
+            // Sorted orders depend on the positions as well, so they are only
+            // kept together with their VBO.
+            if (isUploaded(mUploadedIBOs, ibo.name, ibo.data, 0, iboMan->hasIBO(ibo.name))
+              && (!listsSort || (vboIndex < vbo_names.size() && keptVBOs.count(vbo_names[vboIndex])
+                && iboMan->hasIBO(ibo.name + "NegZ"))))
+            {
+              RENDERER_LOG("Keep index buffer {}, its data did not change.", ibo.name);
+              continue;
+            }
+
+            for (const char* suffix : { "", "X", "Y", "Z", "NegX", "NegY", "NegZ" })
+            {
+              while (GLuint stale = iboMan->hasIBO(ibo.name + suffix))
+                iboMan->removeInMemoryIBO(stale);
+            }
+
             GLenum primType = GL_UNSIGNED_SHORT;
             switch (ibo.indexSize)
             {
@@ -896,7 +962,7 @@ namespace SCIRun {
               break;
             }
 
-            if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
+            if (listsSort)
             {
               RENDERER_LOG("Create sorted lists of Buffers for transparency in each direction of the axis.");
               uint32_t* ibo_buffer = reinterpret_cast<uint32_t*>(ibo.data->getBuffer());
@@ -910,9 +976,10 @@ namespace SCIRun {
                 if (i == 0)
                 {
                   int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
-                  iboMan->addInMemoryIBO(ibo.data->getBuffer(),
+                  GLuint glid = iboMan->addInMemoryIBO(ibo.data->getBuffer(),
                     ibo.data->getBufferSize(), primitive, primType,
                     numPrimitives, ibo.name);
+                  recordUpload(mUploadedIBOs, ibo.name, ibo.data, 0, glid);
                 }
                 if (i == 1)
                 {
@@ -948,13 +1015,13 @@ namespace SCIRun {
                 {
                   for (size_t j = 0; j < num_triangles; j++)
                   {
-                    float* vertex1 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3]));
+                    float* vertex1 = reinterpret_cast<float*>(vbo_buffer[vboIndex] + stride_vbo[vboIndex] * (ibo_buffer[j * 3]));
                     Point node1(vertex1[0], vertex1[1], vertex1[2]);
 
-                    float* vertex2 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3 + 1]));
+                    float* vertex2 = reinterpret_cast<float*>(vbo_buffer[vboIndex] + stride_vbo[vboIndex] * (ibo_buffer[j * 3 + 1]));
                     Point node2(vertex2[0], vertex2[1], vertex2[2]);
 
-                    float* vertex3 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3 + 2]));
+                    float* vertex3 = reinterpret_cast<float*>(vbo_buffer[vboIndex] + stride_vbo[vboIndex] * (ibo_buffer[j * 3 + 2]));
                     Point node3(vertex3[0], vertex3[1], vertex3[2]);
 
                     rel_depth[j].mDepth = Dot(dir, node1) + Dot(dir, node2) + Dot(dir, node3);
@@ -984,7 +1051,8 @@ namespace SCIRun {
             else
             {
               int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
-              iboMan->addInMemoryIBO(ibo.data->getBuffer(), ibo.data->getBufferSize(), primitive, primType, numPrimitives, ibo.name);
+              GLuint glid = iboMan->addInMemoryIBO(ibo.data->getBuffer(), ibo.data->getBufferSize(), primitive, primType, numPrimitives, ibo.name);
+              recordUpload(mUploadedIBOs, ibo.name, ibo.data, 0, glid);
             }
           }
 
@@ -1004,6 +1072,8 @@ namespace SCIRun {
               if (pass.renderType == RenderType::RENDER_VBO_IBO)
               {
                 addVBOToEntity(entityID, pass.vboName);
+                if (!pass.colorVboName.empty())
+                  addVBOToEntity(entityID, pass.colorVboName);
                 if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
                 {
                   for (int i = 0; i <= 6; ++i)
@@ -1138,6 +1208,29 @@ namespace SCIRun {
               mCore.addComponent(entityID, pass);
             }
 
+            if (replacingObject)
+            {
+              RENDERER_LOG("Run a garbage collection cycle for the VBOs and IBOs the new passes no longer use.");
+              mCore.renormalize(true);
+              vboMan->runGCCycle(mCore);
+              iboMan->runGCCycle(mCore);
+
+              for (auto upload = mUploadedVBOs.begin(); upload != mUploadedVBOs.end();)
+              {
+                if (vboMan->hasVBO(upload->first) != upload->second.glid)
+                  upload = mUploadedVBOs.erase(upload);
+                else
+                  ++upload;
+              }
+              for (auto upload = mUploadedIBOs.begin(); upload != mUploadedIBOs.end();)
+              {
+                if (iboMan->hasIBO(upload->first) != upload->second.glid)
+                  upload = mUploadedIBOs.erase(upload);
+                else
+                  ++upload;
+              }
+            }
+
             RENDERER_LOG("Recalculate scene bounding box. Should only be done when an object is added.");
             mSceneBBox.reset();
             for (auto it = mSRObjects.begin(); it != mSRObjects.end(); ++it)
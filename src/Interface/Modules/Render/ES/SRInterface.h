@@ -30,6 +30,7 @@
 #define INTERFACE_MODULES_RENDER_SPIRESCIRUN_SRINTERFACE_H
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <Interface/Modules/Render/GLContext.h>
 #include <Interface/Modules/Render/ES/Core.h>
@@ -236,6 +237,17 @@ namespace SCIRun {
         }
       };
 
+      // Data last uploaded under a VBO or IBO name. An object that replaces
+      // itself keeps the buffers that did not change since then.
+      struct UploadedBuffer
+      {
+        UploadedBuffer() : version(0), glid(0) {}
+
+        std::weak_ptr<spire::VarBuffer> data;
+        uint64_t                        version;
+        GLuint                          glid;
+      };
+
       class SRObject
       {
       public:
@@ -363,6 +375,8 @@ namespace SCIRun {
       int axesFailCount_;
       std::shared_ptr<Gui::GLContext>   mContext;         ///< Context to use for rendering.
       std::vector<SRObject>             mSRObjects;       ///< All SCIRun objects.
+      std::map<std::string, UploadedBuffer> mUploadedVBOs; ///< VBO data on the GPU, by name.
+      std::map<std::string, UploadedBuffer> mUploadedIBOs; ///< IBO data on the GPU, by name.
       Core::Geometry::BBox              mSceneBBox;       ///< Scene's AABB. Recomputed per-frame.
 
 
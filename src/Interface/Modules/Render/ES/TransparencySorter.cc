@@ -0,0 +1,444 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Interface/Modules/Render/ES/TransparencySorter.h>
+#include <Core/Thread/Parallel.h>
+#include <boost/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+namespace SCIRun {
+namespace Render {
+
+namespace
+{
+  // below this many items per thread, spawning threads costs more than it saves
+  const size_t minItemsPerTask = 1 << 16;
+
+  size_t taskCount(size_t n)
+  {
+    size_t cores = std::max(1u, Parallel::NumCores());
+    return std::max<size_t>(1, std::min(cores, n / minItemsPerTask));
+  }
+
+  /// Runs func(task, begin, end) over tasks contiguous ranges of [0, n).
+  void forEachRange(size_t n, size_t tasks, const std::function<void(size_t, size_t, size_t)>& func)
+  {
+    auto range = [n, tasks, &func](int task)
+    {
+      func(task, n * task / tasks, n * (task + 1) / tasks);
+    };
+    if (tasks == 1)
+      range(0);
+    else
+      Parallel::RunTasks(range, static_cast<int>(tasks));
+  }
+
+  // flips float bits so unsigned integer order matches float order
+  inline uint32_t sortableKey(float f)
+  {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+  }
+}
+
+void radixSortByKey(const std::vector<float>& keys, std::vector<uint32_t>& order)
+{
+  const size_t n = keys.size();
+  const size_t tasks = taskCount(n);
+  const size_t radix = 256;
+
+  std::vector<uint32_t> bits(n), bitsOut(n), index(n), indexOut(n);
+  forEachRange(n, tasks, [&](size_t, size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      bits[i] = sortableKey(keys[i]);
+      index[i] = static_cast<uint32_t>(i);
+    }
+  });
+
+  std::vector<size_t> offsets(tasks * radix);
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    forEachRange(n, tasks, [&](size_t task, size_t begin, size_t end)
+    {
+      size_t* count = &offsets[task * radix];
+      for (size_t i = begin; i < end; ++i)
+        ++count[(bits[i] >> shift) & 0xff];
+    });
+
+    // every key shares this digit: the pass would not move anything
+    bool trivial = false;
+    for (size_t digit = 0; digit < radix && !trivial; ++digit)
+    {
+      size_t total = 0;
+      for (size_t task = 0; task < tasks; ++task)
+        total += offsets[task * radix + digit];
+      trivial = total == n;
+    }
+    if (trivial)
+      continue;
+
+    // exclusive prefix sum, digit-major then task, keeps the sort stable
+    size_t sum = 0;
+    for (size_t digit = 0; digit < radix; ++digit)
+    {
+      for (size_t task = 0; task < tasks; ++task)
+      {
+        size_t count = offsets[task * radix + digit];
+        offsets[task * radix + digit] = sum;
+        sum += count;
+      }
+    }
+
+    forEachRange(n, tasks, [&](size_t task, size_t begin, size_t end)
+    {
+      size_t* next = &offsets[task * radix];
+      for (size_t i = begin; i < end; ++i)
+      {
+        size_t to = next[(bits[i] >> shift) & 0xff]++;
+        bitsOut[to] = bits[i];
+        indexOut[to] = index[i];
+      }
+    });
+    bits.swap(bitsOut);
+    index.swap(indexOut);
+  }
+
+  order.swap(index);
+}
+
+std::vector<float> TransparencySorter::triangleCentroids(const SortableTriangles& triangles)
+{
+  std::vector<float> centroids(triangles.numTriangles * 3);
+  forEachRange(triangles.numTriangles, taskCount(triangles.numTriangles), [&](size_t, size_t begin, size_t end)
+  {
+    for (size_t j = begin; j < end; ++j)
+    {
+      float sum[3] = { 0.0f, 0.0f, 0.0f };
+      for (int corner = 0; corner < 3; ++corner)
+      {
+        auto vertex = reinterpret_cast<const float*>(triangles.vertices
+          + triangles.vertexStride * triangles.indices[j * 3 + corner]);
+        sum[0] += vertex[0];
+        sum[1] += vertex[1];
+        sum[2] += vertex[2];
+      }
+      std::copy(sum, sum + 3, &centroids[j * 3]);
+    }
+  });
+  return centroids;
+}
+
+TransparencySorter::IndexBufferHandle TransparencySorter::sortTriangles(const SortableTriangles& triangles,
+  const std::vector<float>& centroids, const Vector& dir)
+{
+  const size_t n = triangles.numTriangles;
+  const size_t tasks = taskCount(n);
+  const float dx = static_cast<float>(dir.x());
+  const float dy = static_cast<float>(dir.y());
+  const float dz = static_cast<float>(dir.z());
+
+  std::vector<float> depths(n);
+  forEachRange(n, tasks, [&](size_t, size_t begin, size_t end)
+  {
+    for (size_t j = begin; j < end; ++j)
+      depths[j] = dx * centroids[j * 3] + dy * centroids[j * 3 + 1] + dz * centroids[j * 3 + 2];
+  });
+
+  std::vector<uint32_t> order;
+  radixSortByKey(depths, order);
+
+  auto sorted = std::make_shared<IndexBuffer>(n * 3);
+  forEachRange(n, tasks, [&](size_t, size_t begin, size_t end)
+  {
+    uint32_t* out = sorted->data();
+    for (size_t j = begin; j < end; ++j)
+      std::copy(triangles.indices + order[j] * 3, triangles.indices + order[j] * 3 + 3, out + j * 3);
+  });
+  return sorted;
+}
+
+struct TransparencySorter::SortJob
+{
+  uint32_t cell = 0;
+  std::atomic<bool> done { false };
+  IndexBufferHandle result;
+  std::shared_ptr<const std::vector<float>> centroids;
+  boost::thread thread;
+};
+
+TransparencySorter::TransparencySorter(int cellsPerFaceEdge, size_t ordersPerObject) :
+  cellsPerFaceEdge_(std::max(1, cellsPerFaceEdge)),
+  ordersPerObject_(std::max<size_t>(1, ordersPerObject))
+{
+}
+
+TransparencySorter::~TransparencySorter()
+{
+  for (auto& object : objects_)
+  {
+    if (object.second.job && object.second.job->thread.joinable())
+      object.second.job->thread.join();
+  }
+}
+
+bool TransparencySorter::setTriangles(const std::string& name, const SortableTriangles& triangles)
+{
+  auto existing = objects_.find(name);
+  if (existing != objects_.end())
+  {
+    const auto& current = existing->second.triangles;
+    if (current.vertices == triangles.vertices && current.indices == triangles.indices
+      && current.vertexStride == triangles.vertexStride && current.numTriangles == triangles.numTriangles)
+      return false;
+  }
+
+  auto& object = objects_[name];
+  if (object.job)
+  {
+    // the job holds its own reference to the old buffers
+    object.job->thread.detach();
+  }
+  object = SortedObject();
+  object.triangles = triangles;
+  return true;
+}
+
+TransparencySorter::IndexBufferHandle TransparencySorter::request(const std::string& name, const Vector& dir)
+{
+  auto it = objects_.find(name);
+  if (it == objects_.end() || it->second.triangles.numTriangles == 0)
+    return nullptr;
+
+  auto& object = it->second;
+  collect(object);
+
+  const auto cell = directionCell(dir);
+  for (auto order = object.orders.begin(); order != object.orders.end(); ++order)
+  {
+    if (order->first == cell)
+    {
+      object.orders.splice(object.orders.begin(), object.orders, order);
+      object.lastReturned = order->second;
+      return object.lastReturned;
+    }
+  }
+
+  if (!object.job)
+  {
+    auto job = std::make_shared<SortJob>();
+    job->cell = cell;
+    auto triangles = object.triangles;
+    auto centroids = object.centroids;
+    auto direction = cellDirection(cell);
+    job->thread = boost::thread([job, triangles, centroids, direction]()
+    {
+      try
+      {
+        job->centroids = centroids ? centroids
+          : std::make_shared<const std::vector<float>>(triangleCentroids(triangles));
+        job->result = sortTriangles(triangles, *job->centroids, direction);
+      }
+      catch (std::bad_alloc&)
+      {
+        job->result.reset();
+      }
+      job->done = true;
+    });
+    object.job = job;
+  }
+  return object.lastReturned;
+}
+
+void TransparencySorter::wait(const std::string& name)
+{
+  auto it = objects_.find(name);
+  if (it == objects_.end() || !it->second.job)
+    return;
+  if (it->second.job->thread.joinable())
+    it->second.job->thread.join();
+  collect(it->second);
+}
+
+void TransparencySorter::retainOnly(const std::vector<std::string>& keep)
+{
+  for (auto it = objects_.begin(); it != objects_.end();)
+  {
+    if (std::find(keep.begin(), keep.end(), it->first) == keep.end())
+    {
+      if (it->second.job)
+        it->second.job->thread.detach();
+      it = objects_.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+void TransparencySorter::collect(SortedObject& object)
+{
+  if (!object.job || !object.job->done)
+    return;
+  if (object.job->thread.joinable())
+    object.job->thread.join();
+  if (object.job->result)
+  {
+    object.centroids = object.job->centroids;
+    cache(object, object.job->cell, object.job->result);
+  }
+  object.job.reset();
+}
+
+void TransparencySorter::cache(SortedObject& object, uint32_t cell, IndexBufferHandle order)
+{
+  object.orders.emplace_front(cell, order);
+  if (object.orders.size() > ordersPerObject_)
+    object.orders.pop_back();
+}
+
+uint32_t TransparencySorter::directionCell(const Vector& dir) const
+{
+  const double ax = std::fabs(dir.x()), ay = std::fabs(dir.y()), az = std::fabs(dir.z());
+  int face;
+  double u, v;
+  if (ax >= ay && ax >= az)
+  {
+    if (ax == 0.0)
+      return 0;
+    face = dir.x() >= 0.0 ? 0 : 1;
+    u = dir.y() / ax;
+    v = dir.z() / ax;
+  }
+  else if (ay >= az)
+  {
+    face = dir.y() >= 0.0 ? 2 : 3;
+    u = dir.x() / ay;
+    v = dir.z() / ay;
+  }
+  else
+  {
+    face = dir.z() >= 0.0 ? 4 : 5;
+    u = dir.x() / az;
+    v = dir.y() / az;
+  }
+
+  const int n = cellsPerFaceEdge_;
+  auto quantize = [n](double t) { return std::min(n - 1, std::max(0, static_cast<int>((t + 1.0) * 0.5 * n))); };
+  return static_cast<uint32_t>((face * n + quantize(u)) * n + quantize(v));
+}
+
+Vector TransparencySorter::cellDirection(uint32_t cell) const
+{
+  const int n = cellsPerFaceEdge_;
+  const int face = static_cast<int>(cell) / (n * n);
+  const double u = (((cell / n) % n) + 0.5) / n * 2.0 - 1.0;
+  const double v = ((cell % n) + 0.5) / n * 2.0 - 1.0;
+  const double major = (face % 2 == 0) ? 1.0 : -1.0;
+
+  Vector dir;
+  switch (face / 2)
+  {
+  case 0:
+    dir = Vector(major, u, v);
+    break;
+  case 1:
+    dir = Vector(u, major, v);
+    break;
+  default:
+    dir = Vector(u, v, major);
+    break;
+  }
+  dir.safe_normalize();
+  return dir;
+}
+
+unsigned SortedIndexBuffers::upload(IndexBufferStore& store, const std::string& name,
+  const TransparencySorter::IndexBufferHandle& order)
+{
+  auto& uploaded = uploaded_[name];
+  if (uploaded.id != 0 && store.find(assetName(name)) != uploaded.id)
+    uploaded = Uploaded();
+
+  if (order != uploaded.order)
+  {
+    if (uploaded.id != 0 && uploaded.order->size() == order->size())
+      store.update(uploaded.id, *order);
+    else
+    {
+      if (uploaded.id != 0)
+        store.remove(uploaded.id);
+      uploaded.id = store.add(assetName(name), *order);
+    }
+    uploaded.order = order;
+  }
+  return uploaded.id;
+}
+
+void SortedIndexBuffers::remove(IndexBufferStore& store, const std::string& name)
+{
+  auto it = uploaded_.find(name);
+  if (it == uploaded_.end())
+    return;
+  release(store, it->first, it->second);
+  uploaded_.erase(it);
+}
+
+void SortedIndexBuffers::retainOnly(IndexBufferStore& store, const std::vector<std::string>& keep)
+{
+  for (auto it = uploaded_.begin(); it != uploaded_.end();)
+  {
+    if (std::find(keep.begin(), keep.end(), it->first) == keep.end())
+    {
+      release(store, it->first, it->second);
+      it = uploaded_.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+void SortedIndexBuffers::release(IndexBufferStore& store, const std::string& name, const Uploaded& uploaded)
+{
+  // a buffer the store already collected may have had its id reused
+  if (uploaded.id != 0 && store.find(assetName(name)) == uploaded.id)
+    store.remove(uploaded.id);
+}
+
+} // namespace Render
+} // namespace SCIRun
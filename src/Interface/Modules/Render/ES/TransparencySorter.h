@@ -0,0 +1,181 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef INTERFACE_MODULES_RENDER_ES_TRANSPARENCYSORTER_H
+#define INTERFACE_MODULES_RENDER_ES_TRANSPARENCYSORTER_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Core/GeometryPrimitives/Vector.h>
+#include <Interface/Modules/Render/share.h>
+
+namespace SCIRun {
+namespace Render {
+
+/// Stable ascending sort of the indices 0..keys.size()-1 by their float key.
+/// Four 8-bit LSD radix passes; histogram and scatter work is split across
+/// Parallel::NumCores() threads for large inputs.
+SCISHARE void radixSortByKey(const std::vector<float>& keys, std::vector<uint32_t>& order);
+
+/// Triangles to depth sort: positions are the first three floats of each
+/// vertex, indices are uint32_t triples. The owner keeps both buffers alive
+/// while background sorts read them.
+struct SCISHARE SortableTriangles
+{
+  std::shared_ptr<const void> owner;
+  const char*     vertices = nullptr;
+  size_t          vertexStride = 0;
+  const uint32_t* indices = nullptr;
+  size_t          numTriangles = 0;
+};
+
+/// CPU-side depth sorting for transparent geometry.
+///
+/// View directions are quantized to cells on the faces of a cube, and each
+/// object keeps the sorted index buffers of its most recently used cells.
+/// Sorting runs on a background thread while the caller keeps drawing the
+/// order it already has, so rotating large transparent surfaces does not
+/// stall the render thread.
+class SCISHARE TransparencySorter
+{
+public:
+  typedef std::vector<uint32_t>             IndexBuffer;
+  typedef std::shared_ptr<const IndexBuffer> IndexBufferHandle;
+
+  /// \param cellsPerFaceEdge Direction cells along each cube face edge.
+  /// \param ordersPerObject  Sorted orders cached for each object.
+  explicit TransparencySorter(int cellsPerFaceEdge = 16, size_t ordersPerObject = 16);
+  ~TransparencySorter();
+
+  TransparencySorter(const TransparencySorter&) = delete;
+  TransparencySorter& operator=(const TransparencySorter&) = delete;
+
+  /// Registers an object's triangles; cheap when the buffers are unchanged.
+  /// Returns true, and drops the object's cached orders, when they differ
+  /// from the buffers previously registered under the same name.
+  bool setTriangles(const std::string& name, const SortableTriangles& triangles);
+
+  /// Returns the order for dir's direction cell if it is cached. Otherwise a
+  /// background sort for that cell is started (unless one is running) and
+  /// the most recently returned order is handed back, which is null until
+  /// the object's first sort finishes.
+  IndexBufferHandle request(const std::string& name, const Core::Geometry::Vector& dir);
+
+  /// Blocks until the object's background sort, if any, has finished.
+  void wait(const std::string& name);
+
+  /// Drops the objects whose names are not in keep.
+  void retainOnly(const std::vector<std::string>& keep);
+
+  uint32_t directionCell(const Core::Geometry::Vector& dir) const;
+  Core::Geometry::Vector cellDirection(uint32_t cell) const;
+
+  /// Synchronous sort along dir; used by the background jobs.
+  static IndexBufferHandle sortTriangles(const SortableTriangles& triangles,
+    const std::vector<float>& centroids, const Core::Geometry::Vector& dir);
+  /// Per-triangle sum of the three vertex positions, packed xyz.
+  static std::vector<float> triangleCentroids(const SortableTriangles& triangles);
+
+private:
+  struct SortJob;
+  struct SortedObject
+  {
+    SortableTriangles triangles;
+    std::shared_ptr<const std::vector<float>> centroids;
+    std::list<std::pair<uint32_t, IndexBufferHandle>> orders;
+    IndexBufferHandle lastReturned;
+    std::shared_ptr<SortJob> job;
+  };
+
+  void collect(SortedObject& object);
+  void cache(SortedObject& object, uint32_t cell, IndexBufferHandle order);
+
+  int cellsPerFaceEdge_;
+  size_t ordersPerObject_;
+  std::map<std::string, SortedObject> objects_;
+};
+
+/// Where SortedIndexBuffers keeps its index buffers. The renderer implements
+/// it on top of the IBO manager.
+class SCISHARE IndexBufferStore
+{
+public:
+  virtual ~IndexBufferStore() {}
+  /// Creates a buffer holding order under assetName and returns its id.
+  virtual unsigned add(const std::string& assetName, const TransparencySorter::IndexBuffer& order) = 0;
+  /// Overwrites a buffer with an order of the same size.
+  virtual void update(unsigned id, const TransparencySorter::IndexBuffer& order) = 0;
+  virtual void remove(unsigned id) = 0;
+  /// Returns the id of the buffer stored under assetName, 0 if there is none.
+  virtual unsigned find(const std::string& assetName) const = 0;
+};
+
+/// The sorted order currently uploaded for each transparent object.
+///
+/// The store can delete buffers on its own (the IBO garbage collector only
+/// keeps buffers referenced by IBO components), so a buffer is checked
+/// against the store before it is reused and uploaded again when it is gone.
+class SCISHARE SortedIndexBuffers
+{
+public:
+  /// Returns the id of a buffer holding order for name, uploading order if
+  /// it differs from the last one or the buffer was lost.
+  unsigned upload(IndexBufferStore& store, const std::string& name,
+    const TransparencySorter::IndexBufferHandle& order);
+
+  /// Deletes the buffer uploaded for name.
+  void remove(IndexBufferStore& store, const std::string& name);
+
+  /// Deletes the buffers of the objects whose names are not in keep.
+  void retainOnly(IndexBufferStore& store, const std::vector<std::string>& keep);
+
+  size_t size() const { return uploaded_.size(); }
+
+  static std::string assetName(const std::string& name) { return name + "trans"; }
+
+private:
+  struct Uploaded
+  {
+    TransparencySorter::IndexBufferHandle order;
+    unsigned id = 0;
+  };
+
+  static void release(IndexBufferStore& store, const std::string& name, const Uploaded& uploaded);
+
+  std::map<std::string, Uploaded> uploaded_;
+};
+
+} // namespace Render
+} // namespace SCIRun
+
+#endif
@@ -17,6 +17,9 @@ struct RenderBasicGeom
   // -- Data --
   static const int MaxNumAttributes = 5;
   ren::ShaderVBOAttribs<MaxNumAttributes> attribs;
+  /// Attributes of the second VBO, for passes that keep their colors in a
+  /// buffer of their own. Left unset otherwise.
+  ren::ShaderVBOAttribs<MaxNumAttributes> colorAttribs;
 
   // -- Functions --
   RenderBasicGeom() {}
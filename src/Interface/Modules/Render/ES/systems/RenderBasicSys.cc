@@ -157,7 +157,14 @@ public:
       // 2) It is more correct than issuing a modify call. The data is used
       //    directly below to render geometry.
       const_cast<RenderBasicGeom&>(geom.front()).attribs.setup(
-          vbo.front().glid, shader.front().glid, vboMan.front());
+          vbo.front().glid, shader.front().glid, vboMan.front(), vbo.size() > 1);
+      // Passes with a separate color VBO carry it as their second VBO
+      // component. Stable renormalization keeps it after the geometry VBO.
+      if (vbo.size() > 1)
+      {
+        const_cast<RenderBasicGeom&>(geom.front()).colorAttribs.setup(
+          vbo[1].glid, shader.front().glid, vboMan.front(), true);
+      }
 
       /// \todo Optimize by pulling uniforms only once.
       if (commonUniforms.size() > 0)
@@ -250,6 +257,12 @@ public:
     }
 
     geom.front().attribs.bind();
+    if (vbo.size() > 1)
+    {
+      // Attribute pointers refer to the buffer bound when they are set.
+      GL(glBindBuffer(GL_ARRAY_BUFFER, vbo[1].glid));
+      geom.front().colorAttribs.bind();
+    }
 
     if (rlist.size() > 0)
     {
@@ -385,6 +398,8 @@ public:
     }
 
     geom.front().attribs.unbind();
+    if (vbo.size() > 1)
+      geom.front().colorAttribs.unbind();
 
     // Reapply the default state here -- only do this if static state is
     // present.
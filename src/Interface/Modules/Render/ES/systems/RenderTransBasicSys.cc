@@ -26,6 +26,8 @@
  DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <map>
 #include <glm/glm.hpp>
 #include <gl-platform/GLPlatform.hpp>
 #include <entity-system/GenericSystem.hpp>
@@ -58,6 +60,7 @@
 #include "../comp/StaticClippingPlanes.h"
 #include "../comp/LightingUniforms.h"
 #include "../comp/ClippingPlaneUniforms.h"
+#include "../TransparencySorter.h"
 
 namespace es = spire;
 namespace shaders = spire;
@@ -114,102 +117,97 @@ public:
   }
 
 private:
-  class SortedObject
+  // Keeps the sorted orders in the IBO manager, drawn with the primitive
+  // setup of the object's own IBO.
+  class IBOManStore : public IndexBufferStore
   {
   public:
-    std::string mName;
-    GLuint mSortedID;
-    Core::Geometry::Vector prevDir = Core::Geometry::Vector(0.0);
-
-    SortedObject() :
-      mSortedID(0)
-    {}
-
-    SortedObject(const std::string& name, GLuint ID, Core::Geometry::Vector& dir) :
-      mName(name),
-      mSortedID(ID),
-      prevDir(dir)
-    {}
-  };
-
-  std::vector<SortedObject> sortedObjects;
-
-  class DepthIndex {
-  public:
-    size_t mIndex;
-    double mDepth;
-
-    DepthIndex() :
-      mIndex(0),
-      mDepth(0.0)
-    {}
+    explicit IBOManStore(ren::IBOMan& man, GLenum primMode = 0, GLenum primType = 0) :
+      man_(man), primMode_(primMode), primType_(primType) {}
 
-    DepthIndex(size_t index, double depth) :
-      mIndex(index),
-      mDepth(depth)
-    {}
+    unsigned add(const std::string& assetName, const TransparencySorter::IndexBuffer& order) override
+    {
+      return man_.addInMemoryIBO(const_cast<uint32_t*>(order.data()), order.size() * sizeof(uint32_t),
+        primMode_, primType_, static_cast<GLsizei>(order.size()), assetName);
+    }
 
-    bool operator<(const DepthIndex& di) const
+    void update(unsigned id, const TransparencySorter::IndexBuffer& order) override
     {
-      return this->mDepth < di.mDepth;
+      GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id));
+      GL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0,
+        static_cast<GLsizeiptr>(order.size() * sizeof(uint32_t)), order.data()));
     }
-  };
 
-  GLuint sortObjects(const Core::Geometry::Vector& dir,
-    const spire::ComponentGroup<ren::IBO>& ibo,
-    const spire::ComponentGroup<SpireSubPass>& pass,
-    const spire::ComponentGroup<ren::StaticIBOMan>& iboMan)
-  {
-    char* vbo_buffer = reinterpret_cast<char*>(pass.front().vbo.data->getBuffer());
-    uint32_t* ibo_buffer = reinterpret_cast<uint32_t*>(pass.front().ibo.data->getBuffer());
-    size_t num_triangles = pass.front().ibo.data->getBufferSize() / (sizeof(uint32_t) * 3);
+    void remove(unsigned id) override { man_.removeInMemoryIBO(id); }
+    unsigned find(const std::string& assetName) const override { return man_.hasIBO(assetName); }
 
-    size_t stride_vbo = 0;
-    for (auto a : pass.front().vbo.attributes)
-      stride_vbo += a.sizeInBytes;
+  private:
+    ren::IBOMan& man_;
+    GLenum primMode_, primType_;
+  };
 
-    std::vector<DepthIndex> rel_depth(num_triangles);
+  TransparencySorter sorter_;
+  SortedIndexBuffers uploadedOrders_;
+  std::map<std::string, Core::Geometry::Vector> updateSortDirections_;
+  // Objects that requested a sorted order during the current frame.
+  std::vector<std::string> liveObjects_;
 
+  void preWalkComponents(spire::ESCoreBase&) override
+  {
+    liveObjects_.clear();
+  }
 
-    for (size_t j = 0; j < num_triangles; j++)
+  // Objects that were not drawn sorted this frame have been removed or
+  // renamed; drop their cached orders and index buffers.
+  void postWalkComponents(spire::ESCoreBase& core) override
+  {
+    sorter_.retainOnly(liveObjects_);
+    for (auto it = updateSortDirections_.begin(); it != updateSortDirections_.end();)
     {
-      float* vertex1 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3]));
-      Core::Geometry::Point node1(vertex1[0], vertex1[1], vertex1[2]);
-
-      float* vertex2 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3 + 1]));
-      Core::Geometry::Point node2(vertex2[0], vertex2[1], vertex2[2]);
-
-      float* vertex3 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3 + 2]));
-      Core::Geometry::Point node3(vertex3[0], vertex3[1], vertex3[2]);
-
-      rel_depth[j].mDepth = Core::Geometry::Dot(dir, node1) + Core::Geometry::Dot(dir, node2) + Core::Geometry::Dot(dir, node3);
-      rel_depth[j].mIndex = j;
+      if (std::find(liveObjects_.begin(), liveObjects_.end(), it->first) == liveObjects_.end())
+        it = updateSortDirections_.erase(it);
+      else
+        ++it;
     }
 
-    std::sort(rel_depth.begin(), rel_depth.end());
-
-    // setup index buffers
-    int numPrimitives = pass.front().ibo.data->getBufferSize() / pass.front().ibo.indexSize;
-
-    std::vector<char> sorted_buffer(pass.front().ibo.data->getBufferSize());
-    char* ibuffer = reinterpret_cast<char*>(pass.front().ibo.data->getBuffer());
-    char* sbuffer = !sorted_buffer.empty() ? reinterpret_cast<char*>(&sorted_buffer[0]) : 0;
-    GLuint result = ibo.front().glid;
-    if (sbuffer && num_triangles > 0)
+    auto iboMan = core.getStaticComponent<ren::StaticIBOMan>();
+    if (iboMan && iboMan->instance_)
     {
-      size_t tri_size = pass.front().ibo.data->getBufferSize() / num_triangles;
-
-      for (size_t j = 0; j < num_triangles; j++)
-      {
-        memcpy(sbuffer + j * tri_size, ibuffer + rel_depth[j].mIndex * tri_size, tri_size);
-      }
-
-      std::string transIBOName = pass.front().ibo.name + "trans";
-      result = iboMan.front().instance_->addInMemoryIBO(sbuffer, pass.front().ibo.data->getBufferSize(), ibo.front().primMode, ibo.front().primType,
-        numPrimitives, transIBOName);
+      IBOManStore store(*iboMan->instance_);
+      uploadedOrders_.retainOnly(store, liveObjects_);
     }
+  }
 
-    return result;
+  // Depth sorting runs in the background; until the order for dir is ready
+  // the last uploaded order is drawn, or the unsorted buffer before that.
+  GLuint sortedIBO(const Core::Geometry::Vector& dir,
+    const spire::ComponentGroup<ren::IBO>& ibo,
+    const spire::ComponentGroup<SpireSubPass>& pass,
+    const spire::ComponentGroup<ren::StaticIBOMan>& iboMan)
+  {
+    const SpireSubPass& subpass = pass.front();
+    if (subpass.ibo.indexSize != sizeof(uint32_t))
+      return ibo.front().glid;
+
+    SortableTriangles triangles;
+    triangles.owner = std::make_shared<std::pair<std::shared_ptr<spire::VarBuffer>, std::shared_ptr<spire::VarBuffer>>>(
+      subpass.vbo.data, subpass.ibo.data);
+    triangles.vertices = reinterpret_cast<const char*>(subpass.vbo.data->getBuffer());
+    triangles.indices = reinterpret_cast<const uint32_t*>(subpass.ibo.data->getBuffer());
+    triangles.numTriangles = subpass.ibo.data->getBufferSize() / (sizeof(uint32_t) * 3);
+    for (const auto& a : subpass.vbo.attributes)
+      triangles.vertexStride += a.sizeInBytes;
+
+    const std::string& name = subpass.ibo.name;
+    liveObjects_.push_back(name);
+    IBOManStore store(*iboMan.front().instance_, ibo.front().primMode, ibo.front().primType);
+    if (sorter_.setTriangles(name, triangles))
+      uploadedOrders_.remove(store, name);
+
+    auto order = sorter_.request(name, dir);
+    if (!order)
+      return ibo.front().glid;
+    return uploadedOrders_.upload(store, name, order);
   }
 
   void groupExecute(
@@ -271,39 +269,20 @@ private:
       {
         case RenderState::TransparencySortType::CONTINUOUS_SORT:
         {
-          iboID = sortObjects(dir, ibo, pass, iboMan);
+          iboID = sortedIBO(dir, ibo, pass, iboMan);
           break;
         }
         case RenderState::TransparencySortType::UPDATE_SORT:
         {
-          unsigned int index = 0;
-          bool indexed = false;
-          for (int i = 0; i < sortedObjects.size(); ++i)
-          {
-            if (sortedObjects[i].mName == pass.front().ibo.name)
-            {
-              indexed = true;
-              index = i;
-            }
-          }
-          if (!indexed)
-          {
-            index = sortedObjects.size();
-            sortedObjects.push_back(SortedObject(pass.front().ibo.name, 0, dir));
-          }
-
-          Core::Geometry::Vector diff = sortedObjects[index].prevDir - dir;
-          double distance = sqrtf(Dot(diff, diff));
-          if (distance >= 1.23 || sortedObjects[index].mSortedID == 0)
-          {
-            if (sortedObjects[index].mSortedID != 0)
-            {
-              iboMan.front().instance_->removeInMemoryIBO(sortedObjects[index].mSortedID);
-            }
-            sortedObjects[index].prevDir = dir;
-            sortedObjects[index].mSortedID = sortObjects(dir, ibo, pass, iboMan);
-          }
-          iboID = sortedObjects[index].mSortedID;
+          // only resort after a large change in view direction
+          auto sortDir = updateSortDirections_.find(pass.front().ibo.name);
+          if (sortDir == updateSortDirections_.end())
+            sortDir = updateSortDirections_.insert(std::make_pair(pass.front().ibo.name, dir)).first;
+
+          Core::Geometry::Vector diff = sortDir->second - dir;
+          if (sqrt(Dot(diff, diff)) >= 1.23)
+            sortDir->second = dir;
+          iboID = sortedIBO(sortDir->second, ibo, pass, iboMan);
           break;
         }
         case RenderState::TransparencySortType::LISTS_SORT:
@@ -367,7 +346,14 @@ private:
       // 2) It is more correct than issuing a modify call. The data is used
       //    directly below to render geometry.
       const_cast<RenderBasicGeom&>(geom.front()).attribs.setup(
-        vbo.front().glid, shader.front().glid, vboMan.front());
+        vbo.front().glid, shader.front().glid, vboMan.front(), vbo.size() > 1);
+      // Passes with a separate color VBO carry it as their second VBO
+      // component. Stable renormalization keeps it after the geometry VBO.
+      if (vbo.size() > 1)
+      {
+        const_cast<RenderBasicGeom&>(geom.front()).colorAttribs.setup(
+        vbo[1].glid, shader.front().glid, vboMan.front(), true);
+      }
 
       /// \todo Optimize by pulling uniforms only once.
       if (commonUniforms.size() > 0)
@@ -452,6 +438,12 @@ private:
     }
 
     geom.front().attribs.bind();
+    if (vbo.size() > 1)
+    {
+      // Attribute pointers refer to the buffer bound when they are set.
+      GL(glBindBuffer(GL_ARRAY_BUFFER, vbo[1].glid));
+      geom.front().colorAttribs.bind();
+    }
 
     // Disable zwrite if we are rendering a transparent object.
     //if (srstate.front().state.get(RenderState::USE_TRANSPARENCY))
@@ -579,14 +571,6 @@ private:
     }
 
 
-    if (!drawLines)
-    {
-      if (pass.front().renderState.mSortType == RenderState::TransparencySortType::CONTINUOUS_SORT)
-      {
-        iboMan.front().instance_->removeInMemoryIBO(iboID);
-      }
-    }
-
     if (depthMask)
     {
       GL(glDepthMask(GL_TRUE));
@@ -608,6 +592,8 @@ private:
     }
 
     geom.front().attribs.unbind();
+    if (vbo.size() > 1)
+      geom.front().colorAttribs.unbind();
 
     // Reapply the default state here -- only do this if static state is
     // present.
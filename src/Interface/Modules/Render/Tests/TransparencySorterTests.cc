@@ -0,0 +1,311 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <Interface/Modules/Render/ES/TransparencySorter.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+
+using namespace SCIRun::Render;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  std::vector<float> randomKeys(size_t n)
+  {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    std::vector<float> keys(n);
+    for (auto& k : keys)
+      k = dist(rng);
+    return keys;
+  }
+
+  std::vector<uint32_t> referenceOrder(const std::vector<float>& keys)
+  {
+    std::vector<uint32_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    return order;
+  }
+
+  // A grid of small triangles scattered through the unit cube.
+  struct TriangleSoup
+  {
+    explicit TriangleSoup(size_t numTriangles)
+    {
+      std::mt19937 rng(5);
+      std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+      for (size_t i = 0; i < numTriangles * 3; ++i)
+      {
+        for (int c = 0; c < 3; ++c)
+          vertices.push_back(dist(rng));
+        vertices.push_back(1.0f); // non-position attribute
+        indices.push_back(static_cast<uint32_t>(i));
+      }
+      triangles.vertices = reinterpret_cast<const char*>(vertices.data());
+      triangles.vertexStride = 4 * sizeof(float);
+      triangles.indices = indices.data();
+      triangles.numTriangles = numTriangles;
+    }
+
+    float depth(size_t triangle, const Vector& dir) const
+    {
+      float d = 0.0f;
+      for (int corner = 0; corner < 3; ++corner)
+      {
+        const float* v = &vertices[4 * indices[triangle * 3 + corner]];
+        d += static_cast<float>(dir.x()) * v[0] + static_cast<float>(dir.y()) * v[1] + static_cast<float>(dir.z()) * v[2];
+      }
+      return d;
+    }
+
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    SortableTriangles triangles;
+  };
+
+  // Hands out the lowest free id like glGenBuffers, and can drop every
+  // buffer like the IBO garbage collector does for ones without an IBO component.
+  class FakeIndexBufferStore : public IndexBufferStore
+  {
+  public:
+    unsigned add(const std::string& assetName, const TransparencySorter::IndexBuffer& order) override
+    {
+      unsigned id = 1;
+      while (buffers.count(id))
+        ++id;
+      buffers[id] = std::make_pair(assetName, order);
+      return id;
+    }
+    void update(unsigned id, const TransparencySorter::IndexBuffer& order) override
+    {
+      ASSERT_EQ(1u, buffers.count(id));
+      ++updates;
+      buffers[id].second = order;
+    }
+    void remove(unsigned id) override
+    {
+      ASSERT_EQ(1u, buffers.erase(id));
+    }
+    unsigned find(const std::string& assetName) const override
+    {
+      for (const auto& buffer : buffers)
+        if (buffer.second.first == assetName)
+          return buffer.first;
+      return 0;
+    }
+    void collectGarbage() { buffers.clear(); }
+
+    std::map<unsigned, std::pair<std::string, TransparencySorter::IndexBuffer>> buffers;
+    int updates = 0;
+  };
+
+  TransparencySorter::IndexBufferHandle indexBuffer(std::initializer_list<uint32_t> indices)
+  {
+    return std::make_shared<const TransparencySorter::IndexBuffer>(indices);
+  }
+}
+
+TEST(TransparencySorterTests, RadixSortMatchesStableSort)
+{
+  for (size_t n : { size_t(0), size_t(1), size_t(1000), size_t(300000) })
+  {
+    auto keys = randomKeys(n);
+    // duplicates, signed zeros and a constant high byte exercise stability and the skipped passes
+    for (size_t i = 0; i + 1 < n; i += 7)
+      keys[i + 1] = keys[i];
+    if (n > 2)
+    {
+      keys[0] = -0.0f;
+      keys[2] = 0.0f;
+    }
+    std::vector<uint32_t> order;
+    radixSortByKey(keys, order);
+    ASSERT_EQ(n, order.size());
+    for (size_t i = 1; i < n; ++i)
+      ASSERT_LE(keys[order[i - 1]], keys[order[i]]) << i;
+    if (n < 1000)
+      EXPECT_EQ(referenceOrder(keys), order);
+  }
+}
+
+TEST(TransparencySorterTests, DirectionCellsRoundTrip)
+{
+  TransparencySorter sorter(8);
+  for (uint32_t cell = 0; cell < 6 * 8 * 8; ++cell)
+    EXPECT_EQ(cell, sorter.directionCell(sorter.cellDirection(cell)));
+
+  // small rotations stay in the same cell
+  EXPECT_EQ(sorter.directionCell(Vector(0.01, 0.01, 1)), sorter.directionCell(Vector(0.012, 0.011, 1)));
+  EXPECT_NE(sorter.directionCell(Vector(0, 0, 1)), sorter.directionCell(Vector(0, 0, -1)));
+}
+
+TEST(TransparencySorterTests, SortedTrianglesAreOrderedByDepth)
+{
+  TriangleSoup soup(5000);
+  Vector dir(0.3, -0.5, 0.8);
+  auto centroids = TransparencySorter::triangleCentroids(soup.triangles);
+  auto sorted = TransparencySorter::sortTriangles(soup.triangles, centroids, dir);
+
+  ASSERT_EQ(soup.indices.size(), sorted->size());
+  std::vector<uint32_t> copy(*sorted);
+  std::sort(copy.begin(), copy.end());
+  EXPECT_EQ(soup.indices, copy);
+
+  float previous = -1e30f;
+  for (size_t j = 0; j < soup.triangles.numTriangles; ++j)
+  {
+    // triangles keep their corners together
+    ASSERT_EQ(0u, (*sorted)[j * 3] % 3);
+    ASSERT_EQ((*sorted)[j * 3] + 1, (*sorted)[j * 3 + 1]);
+    float depth = soup.depth((*sorted)[j * 3] / 3, dir);
+    ASSERT_GE(depth, previous - 1e-4f);
+    previous = depth;
+  }
+}
+
+TEST(TransparencySorterTests, RequestsSortInBackgroundAndCacheByDirection)
+{
+  TriangleSoup soup(20000);
+  TransparencySorter sorter;
+  EXPECT_TRUE(sorter.setTriangles("soup", soup.triangles));
+  EXPECT_FALSE(sorter.setTriangles("soup", soup.triangles));
+
+  Vector dir(0, 0, 1);
+  auto first = sorter.request("soup", dir);
+  sorter.wait("soup");
+  auto order = sorter.request("soup", dir);
+  ASSERT_TRUE(order != nullptr);
+  if (first)
+    EXPECT_EQ(first, order);
+
+  // a small rotation reuses the cached order
+  EXPECT_EQ(order, sorter.request("soup", Vector(0.001, 0.002, 1)));
+
+  // a new direction keeps returning the old order until its sort finishes
+  Vector opposite(0, 0, -1);
+  auto stale = sorter.request("soup", opposite);
+  sorter.wait("soup");
+  auto reversed = sorter.request("soup", opposite);
+  ASSERT_TRUE(reversed != nullptr);
+  EXPECT_TRUE(stale == order || stale == reversed);
+  EXPECT_NE(order, reversed);
+  EXPECT_EQ(order, sorter.request("soup", dir));
+
+  EXPECT_TRUE(sorter.request("unknown", dir) == nullptr);
+  sorter.retainOnly({});
+  EXPECT_TRUE(sorter.request("soup", dir) == nullptr);
+}
+
+TEST(TransparencySorterTests, OrdersLostToGarbageCollectionAreUploadedAgain)
+{
+  FakeIndexBufferStore store;
+  SortedIndexBuffers uploaded;
+  auto front = indexBuffer({ 0, 1, 2, 3, 4, 5 });
+  auto back = indexBuffer({ 3, 4, 5, 0, 1, 2 });
+
+  auto first = uploaded.upload(store, "soup", front);
+  EXPECT_EQ(first, uploaded.upload(store, "soup", front));
+  EXPECT_EQ(first, uploaded.upload(store, "soup", back));
+  EXPECT_EQ(1, store.updates);
+  EXPECT_EQ(*back, store.buffers[first].second);
+
+  // a GC cycle between two sorted frames, after which the id goes to someone else
+  store.collectGarbage();
+  auto other = store.add("other", { 7, 8, 9 });
+  EXPECT_EQ(first, other);
+
+  auto second = uploaded.upload(store, "soup", front);
+  EXPECT_NE(other, second);
+  EXPECT_EQ(1, store.updates);
+  EXPECT_EQ(*front, store.buffers[second].second);
+  EXPECT_EQ(TransparencySorter::IndexBuffer({ 7, 8, 9 }), store.buffers[other].second);
+
+  // the same order is uploaded again when its buffer was collected
+  store.collectGarbage();
+  auto third = uploaded.upload(store, "soup", front);
+  ASSERT_EQ(1u, store.buffers.count(third));
+  EXPECT_EQ(SortedIndexBuffers::assetName("soup"), store.buffers[third].first);
+
+  // removing a collected buffer leaves the new owner of its id alone
+  store.collectGarbage();
+  other = store.add("other", { 7, 8, 9 });
+  uploaded.remove(store, "soup");
+  EXPECT_EQ(1u, store.buffers.count(other));
+  EXPECT_EQ(0u, uploaded.size());
+}
+
+TEST(TransparencySorterTests, RetainOnlyDeletesBuffersOfRemovedObjects)
+{
+  FakeIndexBufferStore store;
+  SortedIndexBuffers uploaded;
+  auto order = indexBuffer({ 0, 1, 2 });
+  auto kept = uploaded.upload(store, "kept", order);
+  uploaded.upload(store, "removed", order);
+  ASSERT_EQ(2u, store.buffers.size());
+
+  uploaded.retainOnly(store, { "kept" });
+  EXPECT_EQ(1u, uploaded.size());
+  ASSERT_EQ(1u, store.buffers.size());
+  EXPECT_EQ(1u, store.buffers.count(kept));
+}
+
+TEST(TransparencySorterTests, DISABLED_DepthSortTiming)
+{
+  const size_t n = 3000000;
+  TriangleSoup soup(n);
+  Vector dir(0.3, -0.5, 0.8);
+  auto centroids = TransparencySorter::triangleCentroids(soup.triangles);
+  std::vector<float> depths(n);
+  for (size_t j = 0; j < n; ++j)
+    depths[j] = soup.depth(j, dir);
+
+  std::vector<uint32_t> reference(n);
+  {
+    ScopedTimer t("std::sort of triangle depths");
+    std::iota(reference.begin(), reference.end(), 0);
+    std::sort(reference.begin(), reference.end(), [&depths](uint32_t a, uint32_t b) { return depths[a] < depths[b]; });
+  }
+  std::vector<uint32_t> order;
+  {
+    ScopedTimer t("radixSortByKey of triangle depths");
+    radixSortByKey(depths, order);
+  }
+  {
+    ScopedTimer t("sortTriangles (depths, sort and index gather)");
+    TransparencySorter::sortTriangles(soup.triangles, centroids, dir);
+  }
+  for (size_t i = 1; i < n; ++i)
+    ASSERT_LE(depths[order[i - 1]], depths[order[i]]);
+}
@@ -0,0 +1,120 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <var-buffer/VarBuffer.hpp>
+#include <bserialize/BSerialize.hpp>
+#include <numeric>
+
+using namespace spire;
+
+TEST(VarBufferTests, WriteGrowsFromZeroSize)
+{
+  VarBuffer buffer(0);
+  EXPECT_EQ(0, buffer.getAllocatedSize());
+
+  for (uint32_t i = 0; i < 1000; ++i)
+    buffer.write(i);
+  EXPECT_EQ(1000 * sizeof(uint32_t), buffer.getBufferSize());
+  EXPECT_GE(static_cast<size_t>(buffer.getAllocatedSize()), buffer.getBufferSize());
+
+  auto values = reinterpret_cast<const uint32_t*>(buffer.getBuffer());
+  for (uint32_t i = 0; i < 1000; ++i)
+    ASSERT_EQ(i, values[i]);
+}
+
+TEST(VarBufferTests, WriteStringGrowsPastCapacity)
+{
+  VarBuffer buffer(8);
+  const std::string text(100, 'x');
+  buffer.write(text);
+  buffer.write(7.5f);
+
+  BSerialize reader(buffer.getBuffer(), buffer.getBufferSize());
+  EXPECT_EQ(text, reader.read<std::string>());
+  EXPECT_EQ(7.5f, reader.read<float>());
+}
+
+TEST(VarBufferTests, ReserveGrowsOnceToRequiredSize)
+{
+  VarBuffer buffer(16);
+  buffer.write(1.0f);
+
+  buffer.reserve(8);
+  EXPECT_EQ(16, buffer.getAllocatedSize());
+
+  buffer.reserve(5000);
+  EXPECT_GE(buffer.getAllocatedSize(), 5004);
+  EXPECT_EQ(sizeof(float), buffer.getBufferSize());
+  EXPECT_EQ(1.0f, *reinterpret_cast<const float*>(buffer.getBuffer()));
+
+  VarBuffer empty(0);
+  empty.reserve(3);
+  EXPECT_GE(empty.getAllocatedSize(), 3);
+}
+
+TEST(VarBufferTests, WriteSpanAppendsPastCapacity)
+{
+  std::vector<float> values(3000);
+  std::iota(values.begin(), values.end(), 0.0f);
+
+  for (uint32_t initialSize : { 0u, 64u })
+  {
+    VarBuffer buffer(initialSize);
+    buffer.write(-1.0f);
+    buffer.writeSpan(values.data(), values.size());
+    buffer.writeSpan(values.data(), 0);
+
+    ASSERT_EQ((values.size() + 1) * sizeof(float), buffer.getBufferSize());
+    auto written = reinterpret_cast<const float*>(buffer.getBuffer());
+    EXPECT_EQ(-1.0f, written[0]);
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), written + 1));
+  }
+}
+
+TEST(VarBufferTests, AllocateReturnsRangeAfterWritePosition)
+{
+  for (uint32_t initialSize : { 0u, 32u })
+  {
+    VarBuffer buffer(initialSize);
+    buffer.write(uint32_t(42));
+
+    auto range = buffer.allocate<uint32_t>(2000);
+    ASSERT_EQ(2001 * sizeof(uint32_t), buffer.getBufferSize());
+    EXPECT_EQ(reinterpret_cast<uint32_t*>(buffer.getBuffer()) + 1, range);
+    for (uint32_t i = 0; i < 2000; ++i)
+      range[i] = i * 3;
+    buffer.write(uint32_t(7));
+
+    auto values = reinterpret_cast<const uint32_t*>(buffer.getBuffer());
+    EXPECT_EQ(42u, values[0]);
+    for (uint32_t i = 0; i < 2000; ++i)
+      ASSERT_EQ(i * 3, values[i + 1]);
+    EXPECT_EQ(7u, values[2001]);
+  }
+}
@@ -39,7 +39,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun;
 
 
-ComputeSVD::ComputeSVD() : Module(ModuleLookupInfo("ComputeSVD", "Math", "SCIRun"),false)
+ComputeSVD::ComputeSVD() : Module(ModuleLookupInfo("ComputeSVD", "Math", "SCIRun"))
 {
 	INITIALIZE_PORT(InputMatrix);
 	INITIALIZE_PORT(LeftSingularMatrix);
@@ -47,12 +47,25 @@ ComputeSVD::ComputeSVD() : Module(ModuleLookupInfo("ComputeSVD", "Math", "SCIRun
 	INITIALIZE_PORT(RightSingularMatrix);
 }
 
+void ComputeSVD::setStateDefaults()
+{
+	setStateStringFromAlgoOption(Parameters::SVDMethod);
+	setStateIntFromAlgo(Parameters::TruncationRank);
+	setStateIntFromAlgo(Parameters::PowerIterations);
+	setStateIntFromAlgo(Parameters::Oversampling);
+}
+
 void ComputeSVD::execute()
 {
 	auto input_matrix = getRequiredInput(InputMatrix);
 
 	if(needToExecute())
 	{
+		setAlgoOptionFromState(Parameters::SVDMethod);
+		setAlgoIntFromState(Parameters::TruncationRank);
+		setAlgoIntFromState(Parameters::PowerIterations);
+		setAlgoIntFromState(Parameters::Oversampling);
+
 		auto output = algo().run(withInputData((InputMatrix,input_matrix)));
 
 		sendOutputFromAlgorithm(LeftSingularMatrix, output);
@@ -23,6 +23,7 @@
 
 #include <Modules/Math/ComputePCA.h>
 #include <Core/Algorithms/Math/ComputePCA.h>
+#include <Core/Algorithms/Math/ComputeSVD.h>
 #include <Core/Datatypes/DenseMatrix.h>
 
 using namespace SCIRun::Modules::Math;
@@ -33,7 +34,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun;
 
 
-ComputePCA::ComputePCA() : Module(ModuleLookupInfo("ComputePCA", "Math", "SCIRun"),false)
+ComputePCA::ComputePCA() : Module(ModuleLookupInfo("ComputePCA", "Math", "SCIRun"))
 {
     INITIALIZE_PORT(InputMatrix);
     INITIALIZE_PORT(LeftPrincipalMatrix);
@@ -41,12 +42,25 @@ ComputePCA::ComputePCA() : Module(ModuleLookupInfo("ComputePCA", "Math", "SCIRun
     INITIALIZE_PORT(RightPrincipalMatrix);
 }
 
+void ComputePCA::setStateDefaults()
+{
+    setStateStringFromAlgoOption(Parameters::SVDMethod);
+    setStateIntFromAlgo(Parameters::TruncationRank);
+    setStateIntFromAlgo(Parameters::PowerIterations);
+    setStateIntFromAlgo(Parameters::Oversampling);
+}
+
 void ComputePCA::execute()
 {
     auto input_matrix = getRequiredInput(InputMatrix);
 
     if(needToExecute())
     {        
+        setAlgoOptionFromState(Parameters::SVDMethod);
+        setAlgoIntFromState(Parameters::TruncationRank);
+        setAlgoIntFromState(Parameters::PowerIterations);
+        setAlgoIntFromState(Parameters::Oversampling);
+
         auto output = algo().run(withInputData((InputMatrix,input_matrix)));
 
         sendOutputFromAlgorithm(LeftPrincipalMatrix, output);
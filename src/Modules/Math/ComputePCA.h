@@ -37,7 +37,7 @@ namespace SCIRun {
             {
             public:
                 ComputePCA();
-                virtual void setStateDefaults() override {}
+                virtual void setStateDefaults() override;
                 virtual void execute() override;
 
                 INPUT_PORT(0, InputMatrix, Matrix);
@@ -45,7 +45,7 @@ namespace SCIRun {
                 OUTPUT_PORT(1, PrincipalValues, DenseMatrix);
                 OUTPUT_PORT(2, RightPrincipalMatrix, DenseMatrix);
 
-                MODULE_TRAITS_AND_INFO(ModuleHasAlgorithm)
+                MODULE_TRAITS_AND_INFO(ModuleHasUIAndAlgorithm)
                 NEW_HELP_WEBPAGE_ONLY
             };
 
@@ -49,11 +49,8 @@ void DisplayHistogram::execute()
       THROW_INVALID_ARGUMENT("Empty matrix input.");
     }
     auto dense = castMatrix::toDense(input_matrix);
-    std::vector<double> data;
-    data.reserve(dense->size());
-    for (auto i = 0; i < dense->nrows(); ++i)
-      for (auto j = 0; j < dense->ncols(); ++j)
-        data.push_back((*dense)(i,j));
+    // Bin order does not depend on element order, so the storage is copied in one block.
+    std::vector<double> data(dense->data(), dense->data() + dense->size());
     get_state()->setTransientValue(Variables::InputMatrix, data);
   }
 }
@@ -91,13 +91,18 @@ void SolveLinearSystem::execute()
     if (!precond.empty())
       algo().setOption(Variables::Preconditioner, precond);
 
+    const bool direct = method == "ldlt";
     std::ostringstream ostr;
-    ostr << "Running algorithm Parallel " << method << " Solver with tolerance " << tolerance << " and maximum iterations " << maxIterations;
+    if (direct)
+      ostr << "Running direct LDL^T solver";
+    else
+      ostr << "Running algorithm Parallel " << method << " Solver with tolerance " << tolerance << " and maximum iterations " << maxIterations;
     remark(ostr.str());
 
     {
       ScopedTimeRemarker perf(this, "Linear solver");
-      remark("Using preconditioner: " + precond);
+      if (!direct)
+        remark("Using preconditioner: " + precond);
 
       auto output = algo().run(withInputData((LHS, A)(RHS, rhsCol)));
 
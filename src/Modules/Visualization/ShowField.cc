@@ -29,6 +29,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Modules/Visualization/ShowField.h>
 #include <Core/Datatypes/Geometry.h>
 #include <Core/Algorithms/Visualization/RenderFieldState.h>
+#include <Core/Algorithms/Visualization/DataConversions.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
@@ -37,6 +38,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 #include <Graphics/Glyphs/GlyphGeom.h>
+#include <tuple>
 
 using namespace SCIRun;
 using namespace Modules::Visualization;
@@ -59,6 +61,27 @@ namespace SCIRun {
     namespace Visualization {
 namespace detail
 {
+/// Face geometry of the last execution. The buffers only depend on the
+/// mesh and the normal settings, so a colormap or transparency change can
+/// reuse them and only write a new color VBO.
+struct FaceGeometryCache
+{
+  /// Field id, mesh generation, data basis order, color scheme, and the
+  /// normal settings (with normals, inverted, use face normals).
+  typedef std::tuple<int, int, int, int, bool, bool, bool> Key;
+
+  explicit FaceGeometryCache(const Key& k) : key(k), doubleSided(false), numVBOElements(0) {}
+
+  Key key;
+  bool doubleSided;
+  int64_t numVBOElements;
+  /// Interleaved positions and normals, handed out to every output as is.
+  std::shared_ptr<spire::VarBuffer> vbo;
+  std::shared_ptr<spire::VarBuffer> ibo;
+  /// Data index of the color of every vertex, two per vertex when double sided.
+  std::vector<uint32_t> colorSources;
+};
+
 class GeometryBuilder
 {
 public:
@@ -96,16 +119,35 @@ public:
     unsigned int approxDiv,
     const std::string& id);
 
+  /// Walks the faces once and records everything that does not depend on
+  /// the colormap.
+  void buildFaceGeometry(
+    FieldHandle field,
+    Interruptible* interruptible,
+    ColorScheme colorScheme,
+    bool withNormals,
+    bool invertNormals,
+    bool useFaceNormals,
+    FaceGeometryCache& faces);
+
   void addFaceGeom(
     const std::vector<Point>  &points,
     const std::vector<Vector> &normals,
     bool withNormals,
     uint32_t& iboBufferIndex,
     spire::VarBuffer* iboBuffer,
-    spire::VarBuffer* vboBuffer,
+    FaceGeometryCache& faces,
+    ColorScheme colorScheme,
+    const std::vector<VMesh::index_type> &colorSources,
+    bool doubleSided);
+
+  /// Writes the colors of the cached vertices, aColor and aColorSecondary
+  /// when double sided, for the current colormap.
+  std::shared_ptr<spire::VarBuffer> writeFaceColorVBO(
+    const FaceGeometryCache& faces,
     ColorScheme colorScheme,
-    const std::vector<ColorRGB> &face_colors,
-    const RenderState& state);
+    boost::optional<ColorMapHandle> colorMap,
+    const std::vector<ColorMap::LookupIndex>& colorIndices);
 
   void renderEdges(
     FieldHandle field,
@@ -124,6 +166,8 @@ private:
   float nodeTransparencyValue_ = 0.65f;
   std::string moduleId_;
   ModuleStateHandle state_;
+  boost::shared_ptr<FaceGeometryCache> faceCache_;
+  uint64_t faceColorVersion_ = 0;
 };
 }}}}
 
@@ -385,8 +429,11 @@ GeometryHandle GeometryBuilder::buildGeometryObject(
 
   if (showFaces)
   {
+    // Face buffers are named without the input and state hash of the object
+    // id, so the renderer can keep them across colormap or transparency edits.
+    const std::string faceID = idname + GeometryObject::delimiter + moduleId_;
     int approxDiv = 1;
-    renderFaces(field, colorMap, interruptible, getFaceRenderState(colorMap), geom, approxDiv, geom->uniqueID());
+    renderFaces(field, colorMap, interruptible, getFaceRenderState(colorMap), geom, approxDiv, faceID);
   }
 
   if (showEdges)
@@ -455,10 +502,6 @@ void GeometryBuilder::renderFacesLinear(
 
   bool invertNormals = state_->getValue(ShowField::FaceInvertNormals).toBool();
   ColorScheme colorScheme = ColorScheme::COLOR_UNIFORM;
-  std::vector<double> svals;
-  std::vector<Vector> vvals;
-  std::vector<Tensor> tvals;
-  std::vector<ColorRGB> face_colors;
 
   if (fld->basis_order() < 0 || state.get(RenderState::USE_DEFAULT_COLOR))
   {
@@ -473,261 +516,39 @@ void GeometryBuilder::renderFacesLinear(
     colorScheme = ColorScheme::COLOR_IN_SITU;
   }
 
-  // Three 32 bit ints to index into the VBO
-  uint32_t iboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(uint32_t) * 3);
-  //Seven floats per VBO: Pos (3) XYZ, and Color (4) RGBA
-  uint32_t vboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(float) * 7);
-
-  // Construct VBO and IBO that will be used to render the faces. Once again,
-  // IBOs are not strictly needed. But, we may be able to optimize this code
-  // somewhat.
-  /// \todo Switch to unique_ptrs and move semantics.
-  std::shared_ptr<spire::VarBuffer> iboBufferSPtr(
-    new spire::VarBuffer(vboSize));
-  std::shared_ptr<spire::VarBuffer> vboBufferSPtr(
-    new spire::VarBuffer(iboSize));
-
-  // Accessing the pointers like this is contrived. We only do this for
-  // speed since we will be using the pointers in a tight inner loop.
-  auto iboBuffer = iboBufferSPtr.get();
-  auto vboBuffer = vboBufferSPtr.get();
-
-  uint32_t iboIndex = 0;
-  int64_t numVBOElements = 0;
-
-  VMesh::Face::iterator fiter, fiterEnd;
-  VMesh::Node::array_type nodes;
-
-  mesh->begin(fiter);
-  mesh->end(fiterEnd);
-
-  Point idpt;
-  mesh->get_nodes(nodes, *fiter);
-  mesh->get_point(idpt, nodes[0]);
-
-  while (fiter != fiterEnd)
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  if (colorScheme != ColorScheme::COLOR_UNIFORM && colorMap)
+    colorIndices = colorMapIndices(fld, *colorMap.get());
+
+  // Positions, normals and indices do not depend on the colormap or the
+  // transparency, so they are only rebuilt when the mesh or the normal
+  // settings change. Otherwise only the color attributes are rewritten.
+  bool useFaceNormals = state.get(RenderState::USE_FACE_NORMALS);
+  FaceGeometryCache::Key key(field->id(), mesh->generation(), fld->basis_order(),
+    static_cast<int>(colorScheme), withNormals, invertNormals, useFaceNormals);
+  if (!faceCache_ || faceCache_->key != key)
   {
-    interruptible->checkForInterruption();
-
-    mesh->get_nodes(nodes, *fiter);
-
-    std::vector<Point> points(nodes.size());
-    std::vector<Vector> normals(nodes.size());
-
-    for (size_t i = 0; i < nodes.size(); i++)
-    {
-      mesh->get_point(points[i], nodes[i]);
-    }
-
-    //TODO fix so the withNormals tp be woth lighting is called correctly, and the meshes are fixed.
-    if (withNormals)
-    {
-      bool useFaceNormals = state.get(RenderState::USE_FACE_NORMALS) && mesh->has_normals();
-      if (useFaceNormals)
-      {
-        for (size_t i = 0; i < nodes.size(); i++)
-        {
-          auto norm = normals[i];
-          normals[i] = invertNormals ? -norm : norm;
-          mesh->get_normal(normals[i], nodes[i]);
-        }
-      }
-      else
-      {
-        /// Fix normal of Quads
-        if (points.size() == 4)
-        {
-          Vector edge1 = points[1] - points[0];
-          Vector edge2 = points[2] - points[1];
-          Vector edge3 = points[3] - points[2];
-          Vector edge4 = points[0] - points[3];
-
-          Vector norm = Cross(edge1, edge2) + Cross(edge2, edge3) + Cross(edge3, edge4) + Cross(edge4, edge1);
-
-          norm.normalize();
-
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-            normals[i] = invertNormals ? -norm : norm;
-          }
-        }
-        /// Fix Normals of Tris
-        else
-        {
-          Vector edge1 = points[1] - points[0];
-          Vector edge2 = points[2] - points[1];
-          Vector norm = Cross(edge1, edge2);
-
-          norm.normalize();
-
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-            normals[i] = invertNormals ? -norm : norm;
-          }
-          //For future reference for a try at smoother rendering
-          /*
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-          mesh->get_normal(normals[i], nodes[i]);
-          }
-          */
-        }
-      }
-    }
-    // Default color single face no matter the element data.
-    if (colorScheme == ColorScheme::COLOR_UNIFORM)
-    {
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
-    }
-    // Element data (Cells) so two sided faces.
-    else if (fld->basis_order() == 0 && mesh->dimensionality() == 3)
-    {
-      auto map = colorMap.get();
-      //two possible colors.
-      svals.resize(2);
-      vvals.resize(2);
-      tvals.resize(2);
-      face_colors = {{ColorRGB(1.,1.,1.),ColorRGB(1.,1.,1.)}};
-
-      VMesh::Elem::array_type cells;
-      mesh->get_elems(cells, *fiter);
-
-      if (fld->is_scalar())
-      {
-        fld->get_value(svals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(svals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-        face_colors[0] = map->valueToColor(svals[0]);
-        face_colors[1] = map->valueToColor(svals[1]);
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vvals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(vvals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-
-        face_colors[0] = map->valueToColor(vvals[0]);
-        face_colors[1] = map->valueToColor(vvals[1]);
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tvals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(tvals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-
-        face_colors[0] = map->valueToColor(tvals[0]);
-        face_colors[1] = map->valueToColor(tvals[1]);
-      }
-
-      state.set(RenderState::IS_DOUBLE_SIDED, true);
-
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
-    }
-    // Element data (faces)
-    else if (fld->basis_order() == 0 && mesh->dimensionality() == 2)
-    {
-      auto map = colorMap.get();
-      //one possible color, each node that color.
-      svals.resize(1);
-      vvals.resize(1);
-      tvals.resize(1);
-      face_colors.resize(nodes.size());
-      if (fld->is_scalar())
-      {
-        fld->get_value(svals[0], *fiter);
-        face_colors[0] = map->valueToColor(svals[0]);
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vvals[0], *fiter);
-        face_colors[0] = map->valueToColor(vvals[0]);
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tvals[0], *fiter);
-        face_colors[0] = map->valueToColor(tvals[0]);
-      }
-
-      // Same color at all corners.
-      for (size_t i = 0; i<nodes.size(); ++i)
-      {
-        face_colors[i] = face_colors[0];
-      }
-
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors,  state);
-    }
-
-    // Data at nodes
-    else if (fld->basis_order() == 1)
-    {
-      auto map = colorMap.get();
-      svals.resize(nodes.size());
-      vvals.resize(nodes.size());
-      tvals.resize(nodes.size());
-      face_colors.resize(nodes.size());
-      //node.size() possible colors.
-      if (fld->is_scalar())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(svals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(svals[i]);
-        }
-      }
-      else if (fld->is_vector())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(vvals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(vvals[i]);
-        }
-      }
-      else if (fld->is_tensor())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(tvals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(tvals[i]);
-        }
-      }
+    auto faces = boost::make_shared<FaceGeometryCache>(key);
+    buildFaceGeometry(field, interruptible, colorScheme, withNormals, invertNormals, useFaceNormals, *faces);
+    faceCache_ = faces;
+  }
+  const FaceGeometryCache& faces = *faceCache_;
 
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
-    }
+  if (faces.doubleSided)
+    state.set(RenderState::IS_DOUBLE_SIDED, true);
 
-    ++fiter;
-    ++numVBOElements;
-  }
+  auto iboBufferSPtr = faces.ibo;
+  auto vboBufferSPtr = faces.vbo;
+  int64_t numVBOElements = faces.numVBOElements;
 
+  // The transparency is only passed as a uniform, so changing it keeps the
+  // buffer names and the renderer keeps the buffers that did not change.
   std::stringstream ss;
-  ss << invertNormals << static_cast<int>(colorScheme) << faceTransparencyValue_;
+  ss << invertNormals << static_cast<int>(colorScheme);
 
   std::string uniqueNodeID = id + "face" + ss.str();
   std::string vboName = uniqueNodeID + "VBO";
+  std::string colorVboName = uniqueNodeID + "ColorVBO";
   std::string iboName = uniqueNodeID + "IBO";
   std::string passName = uniqueNodeID + "Pass";
 
@@ -737,6 +558,7 @@ void GeometryBuilder::renderFacesLinear(
   // Construct VBO.
   std::string shader = "Shaders/UniformColor";
   std::vector<SpireVBO::AttributeData> attribs;
+  std::vector<SpireVBO::AttributeData> colorAttribs;
   attribs.push_back(SpireVBO::AttributeData("aPos", 3 * sizeof(float)));
   std::vector<SpireSubPass::Uniform> uniforms;
   if (withNormals)
@@ -749,7 +571,7 @@ void GeometryBuilder::renderFacesLinear(
 
   if (colorScheme == ColorScheme::COLOR_MAP)
   {
-    attribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float)));
+    colorAttribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float)));
 
     if (!state.get(RenderState::IS_DOUBLE_SIDED))
     {
@@ -771,7 +593,7 @@ void GeometryBuilder::renderFacesLinear(
     }
     else
     {
-      attribs.push_back(SpireVBO::AttributeData("aColorSecondary", 4 * sizeof(float)));
+      colorAttribs.push_back(SpireVBO::AttributeData("aColorSecondary", 4 * sizeof(float)));
 
       if (withNormals)
       {
@@ -792,7 +614,7 @@ void GeometryBuilder::renderFacesLinear(
   }
   else if (colorScheme == ColorScheme::COLOR_IN_SITU)
   {
-    attribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float), true));
+    colorAttribs.push_back(SpireVBO::AttributeData("aColor", 4 * sizeof(float), true));
 
     if (state.get(RenderState::IS_DOUBLE_SIDED) == false)
     {
@@ -813,7 +635,7 @@ void GeometryBuilder::renderFacesLinear(
     }
     else
     {
-      attribs.push_back(SpireVBO::AttributeData("aColorSecondary", 4 * sizeof(float), true));
+      colorAttribs.push_back(SpireVBO::AttributeData("aColorSecondary", 4 * sizeof(float), true));
 
       if (withNormals)
       {
@@ -859,6 +681,18 @@ void GeometryBuilder::renderFacesLinear(
 
   geom->mVBOs.push_back(geomVBO);
 
+  // Colors live in a VBO of their own, so that only this buffer changes
+  // with the colormap.
+  if (!colorAttribs.empty())
+  {
+    SpireVBO colorVBO(colorVboName, colorAttribs,
+      writeFaceColorVBO(faces, colorScheme, colorMap, colorIndices),
+      numVBOElements, mesh->get_bounding_box(), true);
+    colorVBO.version = ++faceColorVersion_;
+
+    geom->mVBOs.push_back(colorVBO);
+  }
+
   // Construct IBO.
 
   SpireIBO geomIBO(iboName, SpireIBO::PRIMITIVE::TRIANGLES, sizeof(uint32_t), iboBufferSPtr);
@@ -869,6 +703,8 @@ void GeometryBuilder::renderFacesLinear(
 
   SpireSubPass pass(passName, vboName, iboName, shader,
     colorScheme, state, RenderType::RENDER_VBO_IBO, geomVBO, geomIBO, text);
+  if (!colorAttribs.empty())
+    pass.colorVboName = colorVboName;
 
   // Add all uniforms generated above to the pass.
   for (const auto& uniform : uniforms) { pass.addUniform(uniform); }
@@ -879,326 +715,241 @@ void GeometryBuilder::renderFacesLinear(
   ///       build up to geometry / tessellation shaders if support is present.
 }
 
-// This function needs to be reorganized.
-// The fact that we are only rendering triangles helps us dramatically and
-// we get rid of the quads renderer pointers. Additionally, we can re-order
-// the triangles in ES and perform different rendering based on the
-// transparency of the triangles.
-void GeometryBuilder::addFaceGeom(
-  const std::vector<Point>  &points,
-  const std::vector<Vector> &normals,
-  bool withNormals,
-  uint32_t& iboIndex,
-  spire::VarBuffer* iboBuffer,
-  spire::VarBuffer* vboBuffer,
+void GeometryBuilder::buildFaceGeometry(
+  FieldHandle field,
+  Interruptible* interruptible,
   ColorScheme colorScheme,
-  const std::vector<ColorRGB> &face_colors,
-  const RenderState& state)
+  bool withNormals,
+  bool invertNormals,
+  bool useFaceNormals,
+  FaceGeometryCache& faces)
 {
-  auto writeVBOPoint = [&vboBuffer](const Point& point)
-  {
-    vboBuffer->write(static_cast<float>(point.x()));
-    vboBuffer->write(static_cast<float>(point.y()));
-    vboBuffer->write(static_cast<float>(point.z()));
-  };
+  VField* fld = field->vfield();
+  VMesh*  mesh = field->vmesh();
 
-  auto writeVBONormal = [&vboBuffer](const Vector& normal)
-  {
-    vboBuffer->write(static_cast<float>(normal.x()));
-    vboBuffer->write(static_cast<float>(normal.y()));
-    vboBuffer->write(static_cast<float>(normal.z()));
-  };
+  // Three 32 bit ints to index into the VBO
+  uint32_t iboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(uint32_t) * 3);
+  uint32_t vboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(float) * 3 * (withNormals ? 6 : 3));
+  faces.ibo.reset(new spire::VarBuffer(iboSize));
+  faces.vbo.reset(new spire::VarBuffer(vboSize));
 
-  auto writeVBOColorValue = [&vboBuffer](ColorRGB value)
-  {
-    vboBuffer->write(static_cast<float>(value.r()));
-    vboBuffer->write(static_cast<float>(value.g()));
-    vboBuffer->write(static_cast<float>(value.b()));
-    vboBuffer->write(static_cast<float>(1.f));
-  };
+  auto iboBuffer = faces.ibo.get();
+  uint32_t iboIndex = 0;
 
-  auto writeIBOIndex = [&iboBuffer](uint32_t index)
-  {
-    iboBuffer->write(index);
-  };
+  std::vector<VMesh::index_type> colorSources;
+
+  VMesh::Face::iterator fiter, fiterEnd;
+  VMesh::Node::array_type nodes;
 
-  bool doubleSided = state.get(RenderState::IS_DOUBLE_SIDED);
+  mesh->begin(fiter);
+  mesh->end(fiterEnd);
 
-  if (colorScheme == ColorScheme::COLOR_UNIFORM)
+  while (fiter != fiterEnd)
   {
-    if (points.size() == 4)
-    {
-      if (withNormals)
-      {
-        writeVBOPoint(points[0]);
-        writeVBONormal(normals[0]);
+    interruptible->checkForInterruption();
+
+    mesh->get_nodes(nodes, *fiter);
 
-        writeVBOPoint(points[1]);
-        writeVBONormal(normals[1]);
+    std::vector<Point> points(nodes.size());
+    std::vector<Vector> normals(nodes.size());
 
-        writeVBOPoint(points[2]);
-        writeVBONormal(normals[2]);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      mesh->get_point(points[i], nodes[i]);
+    }
 
-        writeVBOPoint(points[3]);
-        writeVBONormal(normals[3]);
+    //TODO fix so the withNormals tp be woth lighting is called correctly, and the meshes are fixed.
+    if (withNormals)
+    {
+      if (useFaceNormals && mesh->has_normals())
+      {
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+          auto norm = normals[i];
+          normals[i] = invertNormals ? -norm : norm;
+          mesh->get_normal(normals[i], nodes[i]);
+        }
       }
       else
       {
-        writeVBOPoint(points[0]);
-        writeVBOPoint(points[1]);
-        writeVBOPoint(points[2]);
-        writeVBOPoint(points[3]);
-      }
-      writeIBOIndex(iboIndex);
-      writeIBOIndex(iboIndex + 1);
-      writeIBOIndex(iboIndex + 2);
+        /// Fix normal of Quads
+        if (points.size() == 4)
+        {
+          Vector edge1 = points[1] - points[0];
+          Vector edge2 = points[2] - points[1];
+          Vector edge3 = points[3] - points[2];
+          Vector edge4 = points[0] - points[3];
 
-      writeIBOIndex(iboIndex + 2);
-      writeIBOIndex(iboIndex + 3);
-      writeIBOIndex(iboIndex + 0);
+          Vector norm = Cross(edge1, edge2) + Cross(edge2, edge3) + Cross(edge3, edge4) + Cross(edge4, edge1);
 
-      iboIndex += 4;
-    }
-    else
-    {
-      for (size_t i = 2; i < points.size(); i++)
-      {
-        if (withNormals)
-        {
-          // Render points if we are not rendering spheres.
-          writeVBOPoint(points[0]);
-          writeVBONormal(normals[0]);
-          writeIBOIndex(iboIndex);
-
-          writeVBOPoint(points[i - 1]);
-          writeVBONormal(normals[i - 1]);
-          writeIBOIndex(iboIndex + i - 1);
-
-          writeVBOPoint(points[i]);
-          writeVBONormal(normals[i]);
-          writeIBOIndex(iboIndex + i);
+          norm.normalize();
+
+          for (size_t i = 0; i < nodes.size(); i++)
+          {
+            normals[i] = invertNormals ? -norm : norm;
+          }
         }
+        /// Fix Normals of Tris
         else
         {
-          writeVBOPoint(points[0]);
-          writeIBOIndex(iboIndex);
+          Vector edge1 = points[1] - points[0];
+          Vector edge2 = points[2] - points[1];
+          Vector norm = Cross(edge1, edge2);
 
-          writeVBOPoint(points[i - 1]);
-          writeIBOIndex(iboIndex + i - 1);
+          norm.normalize();
 
-          writeVBOPoint(points[i]);
-          writeIBOIndex(iboIndex + i);
+          for (size_t i = 0; i < nodes.size(); i++)
+          {
+            normals[i] = invertNormals ? -norm : norm;
+          }
+          //For future reference for a try at smoother rendering
+          /*
+          for (size_t i = 0; i < nodes.size(); i++)
+          {
+          mesh->get_normal(normals[i], nodes[i]);
+          }
+          */
         }
       }
-      iboIndex += points.size();
     }
-  }
-  else if (colorScheme == ColorScheme::COLOR_MAP)
-  {
-    if (points.size() == 4)
+    // Default color single face no matter the element data.
+    if (colorScheme == ColorScheme::COLOR_UNIFORM)
     {
-      // Note:  For the double sided case, the 0 and 1 indices are not a typo.
-      //        It is a direct translation from old scirun.
-      if (withNormals)
-      {
-        writeVBOPoint(points[0]);
-        writeVBONormal(normals[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[1]);
-        writeVBONormal(normals[1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[2]);
-        writeVBONormal(normals[2]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[2]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[3]);
-        writeVBONormal(normals[3]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[3]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-      }
-      else
-      {
-        writeVBOPoint(points[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
+      colorSources.clear();
+      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, faces,
+        colorScheme, colorSources, false);
+    }
+    // Element data (Cells) so two sided faces, colored by the cell on
+    // either side.
+    else if (fld->basis_order() == 0 && mesh->dimensionality() == 3)
+    {
+      VMesh::Elem::array_type cells;
+      mesh->get_elems(cells, *fiter);
 
-        writeVBOPoint(points[1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
+      colorSources.resize(2);
+      colorSources[0] = cells[0];
+      colorSources[1] = cells.size() > 1 ? cells[1] : cells[0];
 
-        writeVBOPoint(points[2]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[2]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
+      faces.doubleSided = true;
 
-        writeVBOPoint(points[3]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[3]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-      }
-      writeIBOIndex(iboIndex);
-      writeIBOIndex(iboIndex + 1);
-      writeIBOIndex(iboIndex + 2);
-
-      writeIBOIndex(iboIndex + 2);
-      writeIBOIndex(iboIndex + 3);
-      writeIBOIndex(iboIndex + 0);
+      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, faces,
+        colorScheme, colorSources, true);
+    }
+    // Element data (faces), each node gets the face color.
+    else if (fld->basis_order() == 0 && mesh->dimensionality() == 2)
+    {
+      colorSources.assign(nodes.size(), *fiter);
 
-      iboIndex += 4;
+      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, faces,
+        colorScheme, colorSources, false);
     }
-    else
+    // Data at nodes
+    else if (fld->basis_order() == 1)
     {
-      for (size_t i = 2; i < points.size(); i++)
-      {
-        // Note:  For the double sided case, the 0 and 1 indices are not a typo.
-        //        It is a direct translation from old scirun.
-        if (withNormals)
-        {
-          // Render points if we are not rendering spheres.
-          writeVBOPoint(points[0]);
-          writeVBONormal(normals[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex);
-
-          // Apply misc user settings.
-          writeVBOPoint(points[i - 1]);
-          writeVBONormal(normals[i - 1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i-1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i - 1);
-
-          writeVBOPoint(points[i]);
-          writeVBONormal(normals[i]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i);
-        }
-        else
-        {
-          // Render points if we are not rendering spheres.
-          writeVBOPoint(points[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex);
-
-          writeVBOPoint(points[i - 1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i-1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i - 1);
-
-          writeVBOPoint(points[i]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i);
-        }
-      }
-      iboIndex += points.size();
+      colorSources.assign(nodes.begin(), nodes.end());
+
+      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, faces,
+        colorScheme, colorSources, false);
     }
+
+    ++fiter;
+    ++faces.numVBOElements;
   }
-  else if (colorScheme == ColorScheme::COLOR_IN_SITU)
+}
+
+// This function needs to be reorganized.
+// The fact that we are only rendering triangles helps us dramatically and
+// we get rid of the quads renderer pointers. Additionally, we can re-order
+// the triangles in ES and perform different rendering based on the
+// transparency of the triangles.
+void GeometryBuilder::addFaceGeom(
+  const std::vector<Point>  &points,
+  const std::vector<Vector> &normals,
+  bool withNormals,
+  uint32_t& iboIndex,
+  spire::VarBuffer* iboBuffer,
+  FaceGeometryCache& faces,
+  ColorScheme colorScheme,
+  const std::vector<VMesh::index_type> &colorSources,
+  bool doubleSided)
+{
+  // Note:  For the double sided case every vertex carries the colors of
+  //        both cells. It is a direct translation from old scirun.
+  auto addVertex = [&](size_t i)
   {
-    if (points.size() == 4)
+    const float vertex[6] = {
+      static_cast<float>(points[i].x()), static_cast<float>(points[i].y()), static_cast<float>(points[i].z()),
+      static_cast<float>(normals[i].x()), static_cast<float>(normals[i].y()), static_cast<float>(normals[i].z()) };
+    faces.vbo->writeSpan(vertex, withNormals ? 6 : 3);
+    if (colorScheme != ColorScheme::COLOR_UNIFORM)
     {
-      if (withNormals)
-      {
-        writeVBOPoint(points[0]);
-        writeVBONormal(normals[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[1]);
-        writeVBONormal(normals[1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[2]);
-        writeVBONormal(normals[2]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[2]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[3]);
-        writeVBONormal(normals[3]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[3]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-      }
+      if (!doubleSided) { faces.colorSources.push_back(static_cast<uint32_t>(colorSources[i])); }
       else
       {
-        writeVBOPoint(points[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        // Add appropriate uniforms to the pass (in this case, uColor).
-        writeVBOPoint(points[1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[2]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[2]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-
-        writeVBOPoint(points[3]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[3]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
+        faces.colorSources.push_back(static_cast<uint32_t>(colorSources[0]));
+        faces.colorSources.push_back(static_cast<uint32_t>(colorSources[1]));
       }
-      writeIBOIndex(iboIndex);
-      writeIBOIndex(iboIndex + 1);
-      writeIBOIndex(iboIndex + 2);
+    }
+  };
 
-      writeIBOIndex(iboIndex + 2);
-      writeIBOIndex(iboIndex + 3);
-      writeIBOIndex(iboIndex + 0);
+  auto writeIBOIndex = [&iboBuffer](uint32_t index)
+  {
+    iboBuffer->write(index);
+  };
 
-      iboIndex += 4;
-    }
-    else
+  if (points.size() == 4)
+  {
+    addVertex(0);
+    addVertex(1);
+    addVertex(2);
+    addVertex(3);
+
+    const uint32_t quad[6] = { iboIndex, iboIndex + 1, iboIndex + 2, iboIndex + 2, iboIndex + 3, iboIndex };
+    iboBuffer->writeSpan(quad, 6);
+
+    iboIndex += 4;
+  }
+  else
+  {
+    for (size_t i = 2; i < points.size(); i++)
     {
-      for (size_t i = 2; i < points.size(); i++)
-      {
-        if (withNormals)
-        {
-          writeVBOPoint(points[0]);
-          writeVBONormal(normals[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex);
-
-          writeVBOPoint(points[i - 1]);
-          writeVBONormal(normals[i - 1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i - 1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i - 1);
-
-          writeVBOPoint(points[i]);
-          writeVBONormal(normals[i]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i);
-        }
-        else
-        {
-          writeVBOPoint(points[0]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[0]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          iboBuffer->write(iboIndex);
-
-          writeVBOPoint(points[i - 1]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i - 1]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i - 1);
-
-          writeVBOPoint(points[i]);
-        if (!doubleSided) { writeVBOColorValue(face_colors[i]); }
-        else              { writeVBOColorValue(face_colors[0]); writeVBOColorValue(face_colors[1]); }
-          writeIBOIndex(iboIndex + i);
-        }
-      }
-      iboIndex += points.size();
+      addVertex(0);
+      writeIBOIndex(iboIndex);
+
+      addVertex(i - 1);
+      writeIBOIndex(iboIndex + i - 1);
+
+      addVertex(i);
+      writeIBOIndex(iboIndex + i);
     }
+    iboIndex += points.size();
+  }
+}
+
+std::shared_ptr<spire::VarBuffer> GeometryBuilder::writeFaceColorVBO(
+  const FaceGeometryCache& faces,
+  ColorScheme colorScheme,
+  boost::optional<ColorMapHandle> colorMap,
+  const std::vector<ColorMap::LookupIndex>& colorIndices)
+{
+  // Colormapped and in situ faces both carry looked up colors per vertex.
+  const size_t numColors = colorScheme != ColorScheme::COLOR_UNIFORM ? faces.colorSources.size() : 0;
+
+  std::shared_ptr<spire::VarBuffer> vbo(
+    new spire::VarBuffer(static_cast<uint32_t>(numColors * 4 * sizeof(float))));
+  float* out = vbo->allocate<float>(numColors * 4);
+
+  const ColorRGB white(1., 1., 1.);
+  for (size_t c = 0; c < numColors; ++c)
+  {
+    const ColorRGB& color = colorIndices.empty() ? white : (*colorMap)->lookupColor(colorIndices[faces.colorSources[c]]);
+    *out++ = static_cast<float>(color.r());
+    *out++ = static_cast<float>(color.g());
+    *out++ = static_cast<float>(color.b());
+    *out++ = 1.f;
   }
+
+  return vbo;
 }
 
 void GeometryBuilder::renderNodes(
@@ -1213,10 +964,6 @@ void GeometryBuilder::renderNodes(
   VField* fld = field->vfield();
   VMesh*  mesh = field->vmesh();
 
-  double sval;
-  Vector vval;
-  Tensor tval;
-
   ColorScheme colorScheme;
   ColorRGB node_color;
 
@@ -1249,6 +996,14 @@ void GeometryBuilder::renderNodes(
   if (state.get(RenderState::USE_SPHERE))
     primIn = SpireIBO::PRIMITIVE::TRIANGLES;
 
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  ColorMapHandle map;
+  if (colorScheme != ColorScheme::COLOR_UNIFORM)
+  {
+    map = colorMap.get();
+    colorIndices = colorMapIndices(fld, *map);
+  }
+
   GlyphGeom glyphs;
   while (eiter != eiter_end)
   {
@@ -1257,25 +1012,8 @@ void GeometryBuilder::renderNodes(
     Point p;
     mesh->get_point(p, *eiter);
     //coloring options
-    if (colorScheme != ColorScheme::COLOR_UNIFORM)
-    {
-      ColorMapHandle map = colorMap.get();
-      if (fld->is_scalar())
-      {
-        fld->get_value(sval, *eiter);
-        node_color = map->valueToColor(sval);
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vval, *eiter);
-        node_color = map->valueToColor(vval);
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tval, *eiter);
-        node_color = map->valueToColor(tval);
-      }
-    }
+    if (!colorIndices.empty())
+      node_color = map->lookupColor(colorIndices[*eiter]);
     //accumulate VBO or IBO data
     if (state.get(RenderState::USE_SPHERE))
     {
@@ -1305,10 +1043,6 @@ void GeometryBuilder::renderEdges(
   VField* fld = field->vfield();
   VMesh*  mesh = field->vmesh();
 
-  double sval0, sval1;
-  Vector vval0, vval1;
-  Tensor tval0, tval1;
-
   ColorScheme colorScheme;
   ColorRGB edge_colors[2];
 
@@ -1342,6 +1076,14 @@ void GeometryBuilder::renderEdges(
   if (state.get(RenderState::USE_CYLINDER))
     primIn = SpireIBO::PRIMITIVE::TRIANGLES;
 
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  ColorMapHandle map;
+  if (colorScheme != ColorScheme::COLOR_UNIFORM)
+  {
+    map = colorMap.get();
+    colorIndices = colorMapIndices(fld, *map);
+  }
+
   GlyphGeom glyphs;
   while (eiter != eiter_end)
   {
@@ -1354,56 +1096,16 @@ void GeometryBuilder::renderEdges(
     mesh->get_point(p0, nodes[0]);
     mesh->get_point(p1, nodes[1]);
     //coloring options
-    if (colorScheme != ColorScheme::COLOR_UNIFORM)
+    if (!colorIndices.empty())
     {
-      ColorMapHandle map = colorMap.get();
-      if (fld->is_scalar())
+      if (fld->basis_order() == 1)
       {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(sval0, nodes[0]);
-          fld->get_value(sval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(sval0, *eiter);
-
-          sval1 = sval0;
-        }
-        edge_colors[0] = map->valueToColor(sval0);
-        edge_colors[1] = map->valueToColor(sval1);
+        edge_colors[0] = map->lookupColor(colorIndices[nodes[0]]);
+        edge_colors[1] = map->lookupColor(colorIndices[nodes[1]]);
       }
-      else if (fld->is_vector())
+      else //if (mesh->dimensionality() == 1)
       {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(vval0, nodes[0]);
-          fld->get_value(vval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(vval0, *eiter);
-          vval1 = vval0;
-        }
-
-        edge_colors[0] = map->valueToColor(vval0);
-        edge_colors[1] = map->valueToColor(vval1);
-      }
-      else if (fld->is_tensor())
-      {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(tval0, nodes[0]);
-          fld->get_value(tval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(tval0, *eiter);
-          tval1 = tval0;
-        }
-
-        edge_colors[0] = map->valueToColor(tval0);
-        edge_colors[1] = map->valueToColor(tval1);
+        edge_colors[0] = edge_colors[1] = map->lookupColor(colorIndices[*eiter]);
       }
     }
     //accumulate VBO or IBO data
@@ -35,6 +35,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Datatypes/Color.h>
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/Algorithms/Visualization/RenderFieldState.h>
+#include <Core/Algorithms/Visualization/DataConversions.h>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 #include <Graphics/Glyphs/GlyphGeom.h>
@@ -341,6 +342,14 @@ void GlyphBuilder::renderVectors(
   if (resolution < 3) resolution = 5;
 
   GlyphGeom glyphs;
+  // evaluate the colormap for all values at once; the loops below only index the table
+  ColorMapHandle map;
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  if (colorScheme == ColorScheme::COLOR_MAP)
+  {
+    map = colorMap.get();
+    colorIndices = colorMapIndices(fld, *map);
+  }
   auto facade(field->mesh()->getFacade());
 
   //Temporary fix for cloud field data until after IBBM
@@ -363,8 +372,7 @@ void GlyphBuilder::renderVectors(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(inputVector);
+          node_color = map->lookupColor(colorIndices[cell.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -438,8 +446,7 @@ void GlyphBuilder::renderVectors(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(inputVector);
+          node_color = map->lookupColor(colorIndices[node.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -553,6 +560,14 @@ void GlyphBuilder::renderScalars(
   }
 
   GlyphGeom glyphs;
+  // evaluate the colormap for all values at once; the loops below only index the table
+  ColorMapHandle map;
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  if (colorScheme == ColorScheme::COLOR_MAP)
+  {
+    map = colorMap.get();
+    colorIndices = colorMapIndices(fld, *map);
+  }
   auto facade(field->mesh()->getFacade());
 
   bool done = false;
@@ -571,8 +586,7 @@ void GlyphBuilder::renderScalars(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(v);
+          node_color = map->lookupColor(colorIndices[cell.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -625,8 +639,7 @@ void GlyphBuilder::renderScalars(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(v);
+          node_color = map->lookupColor(colorIndices[node.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -713,6 +726,14 @@ void GlyphBuilder::renderTensors(
   SpireIBO::PRIMITIVE primIn = SpireIBO::PRIMITIVE::TRIANGLES;;
 
   GlyphGeom glyphs;
+  // evaluate the colormap for all values at once; the loops below only index the table
+  ColorMapHandle map;
+  std::vector<ColorMap::LookupIndex> colorIndices;
+  if (colorScheme == ColorScheme::COLOR_MAP)
+  {
+    map = colorMap.get();
+    colorIndices = colorMapIndices(fld, *map);
+  }
   auto facade(field->mesh()->getFacade());
   // Render linear data
   if (finfo.is_linear())
@@ -730,8 +751,7 @@ void GlyphBuilder::renderTensors(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(t);
+          node_color = map->lookupColor(colorIndices[node.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -769,8 +789,7 @@ void GlyphBuilder::renderTensors(
       {
         if (colorScheme == ColorScheme::COLOR_MAP)
         {
-          ColorMapHandle map = colorMap.get();
-          node_color = map->valueToColor(t);
+          node_color = map->lookupColor(colorIndices[cell.index()]);
         }
         if (colorScheme == ColorScheme::COLOR_IN_SITU)
         {
@@ -33,6 +33,7 @@
 #include <Core/Utils/Exception.h>
 #include <Core/Logging/Log.h>
 #include <Core/Datatypes/ColorMap.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
 
 using namespace SCIRun::Testing;
 using namespace SCIRun::TestUtils;
@@ -44,6 +45,7 @@ using namespace SCIRun::Modules::Visualization;
 using namespace SCIRun::Core;
 using namespace SCIRun;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Graphics::Datatypes;
 using ::testing::Values;
 using ::testing::Combine;
 using ::testing::Range;
@@ -128,3 +130,154 @@ TEST_F(ShowFieldStateGeometryNameSynchronizationTest, GeometryNameSynchronizesWi
   EXPECT_NE(hash1, addInputShouldBeDifferent);
   EXPECT_NE(inputChangeShouldBeDifferent, hash1);
 }
+
+namespace
+{
+  const SpireIBO* faceIBO(DatatypeHandle data)
+  {
+    auto spire = boost::dynamic_pointer_cast<GeometryObjectSpire>(data);
+    if (!spire)
+      return nullptr;
+    for (const auto& ibo : spire->mIBOs)
+      if (ibo.name.find("face") != std::string::npos)
+        return &ibo;
+    return nullptr;
+  }
+
+  struct FaceBuffers
+  {
+    const SpireSubPass* pass = nullptr;
+    const SpireVBO* vbo = nullptr;
+    const SpireVBO* colorVbo = nullptr;
+    const SpireIBO* ibo = nullptr;
+  };
+
+  // Buffers of the face pass, looked up by the names the pass refers to.
+  FaceBuffers faceBuffers(boost::shared_ptr<GeometryObjectSpire> spire)
+  {
+    FaceBuffers faces;
+    if (!spire)
+      return faces;
+    for (const auto& pass : spire->mPasses)
+      if (pass.passName.find("face") != std::string::npos)
+        faces.pass = &pass;
+    if (!faces.pass)
+      return faces;
+    for (const auto& vbo : spire->mVBOs)
+    {
+      if (vbo.name == faces.pass->vboName)
+        faces.vbo = &vbo;
+      if (vbo.name == faces.pass->colorVboName)
+        faces.colorVbo = &vbo;
+    }
+    for (const auto& ibo : spire->mIBOs)
+      if (ibo.name == faces.pass->iboName)
+        faces.ibo = &ibo;
+    return faces;
+  }
+}
+
+TEST_F(ShowFieldStateGeometryNameSynchronizationTest, ColorMapChangeReusesFaceGeometry)
+{
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Rainbow"));
+  showField->execute();
+  auto geom1 = getDataOnThisOutputPort(showField, 0);
+
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Grayscale"));
+  showField->execute();
+  auto geom2 = getDataOnThisOutputPort(showField, 0);
+
+  auto ibo1 = faceIBO(geom1);
+  auto ibo2 = faceIBO(geom2);
+  ASSERT_TRUE(ibo1 != nullptr);
+  ASSERT_TRUE(ibo2 != nullptr);
+  EXPECT_EQ(ibo1->data, ibo2->data);
+  EXPECT_GT(ibo2->data->getBufferSize(), 0u);
+
+  auto size = 2;
+  stubPortNWithThisData(showField, 0, CreateEmptyLatVol(size, size, size));
+  showField->execute();
+  auto ibo3 = faceIBO(getDataOnThisOutputPort(showField, 0));
+  ASSERT_TRUE(ibo3 != nullptr);
+  EXPECT_NE(ibo2->data, ibo3->data);
+}
+
+TEST_F(ShowFieldStateGeometryNameSynchronizationTest, InSituColoredFacesCarryVertexColors)
+{
+  stubPortNWithThisData(showField, 0, TetrahedronTriSurfLinearBasis(DOUBLE_E));
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Rainbow"));
+  showField->get_state()->setValue(ShowField::FacesColoring, 2);
+  showField->execute();
+
+  auto spire = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+  ASSERT_TRUE(spire != nullptr);
+  auto faces = faceBuffers(spire);
+  ASSERT_TRUE(faces.pass != nullptr);
+  EXPECT_EQ(ColorScheme::COLOR_IN_SITU, faces.pass->mColorScheme);
+  ASSERT_TRUE(faces.vbo != nullptr);
+  ASSERT_TRUE(faces.colorVbo != nullptr);
+  ASSERT_TRUE(faces.ibo != nullptr);
+
+  auto stride = [](const SpireVBO& vbo)
+  {
+    size_t size = 0;
+    for (const auto& attribute : vbo.attributes)
+      size += attribute.sizeInBytes;
+    return size;
+  };
+  ASSERT_EQ(1u, faces.colorVbo->attributes.size());
+  EXPECT_EQ("aColor", faces.colorVbo->attributes[0].name);
+
+  // triangles are written as three new vertices each
+  const size_t numVertices = faces.ibo->data->getBufferSize() / sizeof(uint32_t);
+  EXPECT_GT(numVertices, 0u);
+  EXPECT_EQ(numVertices * stride(*faces.vbo), faces.vbo->data->getBufferSize());
+  EXPECT_EQ(numVertices * stride(*faces.colorVbo), faces.colorVbo->data->getBufferSize());
+}
+
+TEST_F(ShowFieldStateGeometryNameSynchronizationTest, ColorMapAndTransparencyChangesOnlyReplaceFaceColors)
+{
+  stubPortNWithThisData(showField, 0, TetrahedronTriSurfLinearBasis(DOUBLE_E));
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Rainbow"));
+  showField->execute();
+  auto geom1 = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create("Grayscale"));
+  showField->execute();
+  auto geom2 = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+
+  showField->get_state()->setValue(ShowField::FaceTransparency, true);
+  showField->get_state()->setValue(ShowField::FaceTransparencyValue, 0.25);
+  showField->execute();
+  auto geom3 = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+
+  std::vector<FaceBuffers> faces { faceBuffers(geom1), faceBuffers(geom2), faceBuffers(geom3) };
+  for (const auto& f : faces)
+  {
+    ASSERT_TRUE(f.pass != nullptr);
+    ASSERT_TRUE(f.vbo != nullptr);
+    ASSERT_TRUE(f.colorVbo != nullptr);
+    ASSERT_TRUE(f.ibo != nullptr);
+  }
+
+  for (size_t i = 1; i < faces.size(); ++i)
+  {
+    const auto& before = faces[i - 1];
+    const auto& after = faces[i];
+    // positions, normals and indices are the same buffers under the same names
+    EXPECT_EQ(before.vbo->name, after.vbo->name);
+    EXPECT_EQ(before.vbo->data, after.vbo->data);
+    EXPECT_EQ(before.ibo->name, after.ibo->name);
+    EXPECT_EQ(before.ibo->data, after.ibo->data);
+    EXPECT_EQ(before.pass->passName, after.pass->passName);
+    // only the colors are written again, under their own name and a new version
+    EXPECT_EQ(before.colorVbo->name, after.colorVbo->name);
+    EXPECT_NE(before.colorVbo->data, after.colorVbo->data);
+    EXPECT_LT(before.colorVbo->version, after.colorVbo->version);
+  }
+
+  auto transparency = std::find_if(faces[2].pass->mUniforms.begin(), faces[2].pass->mUniforms.end(),
+    [](const SpireSubPass::Uniform& u) { return u.name == "uTransparency"; });
+  ASSERT_TRUE(transparency != faces[2].pass->mUniforms.end());
+  EXPECT_FLOAT_EQ(0.25f, transparency->data.x);
+}